@@ -3,6 +3,41 @@
 struct MdWindowData*   pWindowData	 = MD_NULL;
 struct MdPipeline*	   pPipeline	 = MD_NULL;
 struct MdVertexBuffer* pVertexBuffer = MD_NULL;
+struct MdFrameLoop*	   pFrameLoop	 = MD_NULL;
+struct MdTaskGraph*	   pFrameGraph	 = MD_NULL;
+
+// The simulation steps the frame loop has counted for the frame, run by the simulation task.
+static u32 pendingStepsCount = 0;
+
+// 0 lets the presentation pace the frames, the browser always paces them on the web.
+#ifndef TARGET_FRAME_RATE
+#define TARGET_FRAME_RATE 0.0
+#endif
+
+#if !PLATFORM_IS_WEB
+// The build defines the pack it writes into its own build directory, next to the binaries.
+#ifndef ASSETS_PACK_PATH
+#define ASSETS_PACK_PATH "assets.pack"
+#endif
+
+// A pack replaced by an incomplete one stays unmounted until the next rebuild.
+static b8 isAssetsPackMounted = MD_FALSE;
+#endif
+
+#if MD_DEBUG && !PLATFORM_IS_WEB
+// Rebuilding the assets while the application runs replaces the pack, its shaders are then reloaded.
+struct MdFileWatcher* pAssetsWatcher = MD_NULL;
+
+static void reloadAssets(void* pUserData);
+
+#define FRAME_STATS_CSV_PATH "frame_stats.csv"
+#endif
+
+#if MD_PROFILE_ENABLED && !PLATFORM_IS_WEB
+// The first frames after the startup are captured and written next to the binaries when the application closes.
+#define PROFILE_CAPTURE_FRAMES_COUNT 300
+#define PROFILE_TRACE_PATH			 "profile.json"
+#endif
 
 struct Vertex
 {
@@ -10,7 +45,16 @@ struct Vertex
 	float color[3];
 };
 
+// The resources the tasks of a frame read and write, they order the tasks which share one.
+#define RESOURCE_SIMULATION MD_TASK_RESOURCE(0) ///< The simulation state.
+#define RESOURCE_ASSETS		MD_TASK_RESOURCE(1) ///< The pack and the pipeline.
+
 static void WriteVertexData(u8*, const void*);
+static void queueStep(f64 deltaSeconds, void* pUserData);
+static void executeFrame(f64 alpha, void* pUserData);
+static void pollInput(void* pUserData);
+static void simulate(void* pUserData);
+static void render(void* pUserData);
 
 static enum MdVertexBufferAttributeType vertexLayout[] = {
 	MD_VERTEX_BUFFER_ATTRIBUTE_TYPE_FLOAT2, // position
@@ -28,12 +72,36 @@ void mainLoop();
 int main(void)
 {
 	mdMemoryInitialize();
+	mdJobSystemInitialize(MD_JOB_WORKERS_COUNT_DEFAULT);
 	mdWindowInitialize();
 
+#if MD_PROFILE_ENABLED && !PLATFORM_IS_WEB
+	// The startup is captured as the first frame, it creates the pipeline and opens the assets.
+	mdProfileCaptureStart(PROFILE_CAPTURE_FRAMES_COUNT);
+	mdProfileFrameMark();
+#endif
+
 	struct MdConsoleConfig config;
 	config.color = MD_CONSOLE_COLOR_GREEN;
 	mdSetConsoleConfig(config);
 
+#if !PLATFORM_IS_WEB
+	// Every asset is served from the pack built next to the binaries: one open and one mapping at startup.
+	isAssetsPackMounted = mdPackMount(ASSETS_PACK_PATH, "assets");
+	if (!isAssetsPackMounted)
+	{
+		MD_LOG_FATAL("Cannot mount the assets pack %s, the assets must be built first.", ASSETS_PACK_PATH);
+#if MD_PROFILE_ENABLED
+		mdProfileCaptureStop();
+		mdProfileShutdown();
+#endif
+		mdWindowShutdown();
+		mdJobSystemShutdown();
+		mdMemoryShutdown();
+		return 1;
+	}
+#endif
+
 	pWindowData = mdWindowCreate(800, 600, "MEED Application Window");
 	mdRenderInitialize(pWindowData);
 
@@ -51,17 +119,40 @@ int main(void)
 #if PLATFORM_IS_WEB
 	pPipeline = mdPipelineCreate("shaders/triangle.vert", "shaders/triangle.frag", pVertexBuffer);
 #elif MD_USE_VULKAN
-	pPipeline = mdPipelineCreate(MD_STRINGIFY(PROJECT_BASE_DIR) "/app/build/debug/shaders/triangle.vert.spv",
-								 MD_STRINGIFY(PROJECT_BASE_DIR) "/app/build/debug/shaders/triangle.frag.spv",
-								 pVertexBuffer);
+	pPipeline = mdPipelineCreate(
+		"assets/shaders/vulkan/triangle.vert.spv", "assets/shaders/vulkan/triangle.frag.spv", pVertexBuffer);
 #elif MD_USE_OPENGL
-	pPipeline = mdPipelineCreate(MD_STRINGIFY(PROJECT_BASE_DIR) "/engine/assets/shaders/opengl/triangle.vert",
-								 MD_STRINGIFY(PROJECT_BASE_DIR) "/engine/assets/shaders/opengl/triangle.frag",
-								 pVertexBuffer);
+	pPipeline =
+		mdPipelineCreate("assets/shaders/opengl/triangle.vert", "assets/shaders/opengl/triangle.frag", pVertexBuffer);
 #else
 #error "No rendering backend selected."
 #endif
 
+#if MD_DEBUG && !PLATFORM_IS_WEB
+	pAssetsWatcher = mdFileWatcherCreate(MD_FILE_WATCHER_DEFAULT_DEBOUNCE_MS);
+	mdFileWatcherAdd(pAssetsWatcher, ASSETS_PACK_PATH, MD_FALSE);
+#endif
+
+	// The rendering of a frame overlaps the simulation of the next one: it reads nothing the simulation writes. Once
+	// the simulation has a state to draw, a task extracts it for the rendering at the end of the frame.
+	struct MdTaskDecl frameTasks[] = {
+#if MD_DEBUG && !PLATFORM_IS_WEB
+		{"Assets", reloadAssets, MD_NULL, 0, RESOURCE_ASSETS, MD_TRUE, MD_FALSE},
+#endif
+		{"Simulation", simulate, MD_NULL, 0, RESOURCE_SIMULATION, MD_FALSE, MD_FALSE},
+		{"Render", render, MD_NULL, RESOURCE_ASSETS, 0, MD_TRUE, MD_TRUE},
+	};
+	pFrameGraph = mdTaskGraphCreate(frameTasks, MD_ARRAY_SIZE(frameTasks));
+
+	// The frame loop paces the frames and counts the simulation steps, the frame graph runs them. The input is polled
+	// by the loop on the main thread, latched a second time right before the graph starts the frame.
+	struct MdFrameLoopConfig frameLoopConfig = mdFrameLoopGetDefaultConfig();
+	frameLoopConfig.targetFrameRate			 = PLATFORM_IS_WEB ? 0.0 : TARGET_FRAME_RATE;
+	frameLoopConfig.isLateLatched			 = MD_TRUE;
+
+	struct MdFrameLoopCallbacks frameLoopCallbacks = {pollInput, queueStep, executeFrame, MD_NULL};
+	pFrameLoop = mdFrameLoopCreate(&frameLoopConfig, &frameLoopCallbacks);
+
 #if PLATFORM_IS_WEB
 	emscripten_set_main_loop(mainLoop, 0, MD_TRUE);
 #else
@@ -71,40 +162,147 @@ int main(void)
 	}
 #endif
 
+	mdTaskGraphWaitIdle(pFrameGraph);
 	mdRenderWaitIdle();
+	mdFrameLoopDestroy(pFrameLoop);
+
+#if MD_DEBUG && !PLATFORM_IS_WEB
+	// The phases of the last frames tell whether the application waits for the CPU, the GPU or the display.
+	static const char* boundNames[] = {"unknown", "CPU", "GPU", "vsync"};
+	MD_LOG_INFO("Frames are %s-bound.", boundNames[mdFrameStatsGetBound()]);
+	mdFrameStatsExportCSV(FRAME_STATS_CSV_PATH);
+	MD_LOG_INFO("The critical path of the last frame lasts %.3f ms.",
+				mdTicksToSeconds(mdTaskGraphGetCriticalPathTicks(pFrameGraph)) * 1000.0);
+#endif
+	mdTaskGraphDestroy(pFrameGraph);
 
 	mdPipelineDestroy(pPipeline);
 	mdVertexBufferDestroy(pVertexBuffer);
 	mdRenderShutdown();
 	mdWindowDestroy(pWindowData);
 
+#if MD_DEBUG && !PLATFORM_IS_WEB
+	mdFileWatcherDestroy(pAssetsWatcher);
+#endif
+#if !PLATFORM_IS_WEB
+	if (isAssetsPackMounted)
+	{
+		mdPackUnmount("assets");
+	}
+#endif
+
+#if MD_PROFILE_ENABLED && !PLATFORM_IS_WEB
+	mdProfileCaptureStop();
+	if (mdProfileExportChromeTrace(PROFILE_TRACE_PATH))
+	{
+		MD_LOG_INFO("Profile written to %s.", PROFILE_TRACE_PATH);
+	}
+	mdProfileShutdown();
+#endif
+
 	mdWindowShutdown();
+	mdJobSystemShutdown();
 	mdMemoryShutdown();
 	return 0;
 }
 
 void mainLoop()
 {
+	MD_PROFILE_FRAME_MARK();
+	mdJobSystemBeginFrame();
+	mdFrameLoopRunFrame(pFrameLoop);
+}
+
+static void queueStep(f64 deltaSeconds, void* pUserData)
+{
+	MD_UNUSED(deltaSeconds);
+	MD_UNUSED(pUserData);
+
+	++pendingStepsCount;
+}
+
+static void executeFrame(f64 alpha, void* pUserData)
+{
+	MD_UNUSED(alpha);
+	MD_UNUSED(pUserData);
+
+	mdTaskGraphExecute(pFrameGraph);
+}
+
+static void pollInput(void* pUserData)
+{
+	MD_UNUSED(pUserData);
+
 	struct MdWindowEvent windowEvent = mdWindowPollEvents(pWindowData);
 
 	if (windowEvent.type == MD_WINDOW_EVENT_TYPE_CLOSE)
 	{
 		pWindowData->shouldClose = MD_TRUE;
 	}
+}
+
+static void simulate(void* pUserData)
+{
+	MD_UNUSED(pUserData);
+
+	// The triangle has no simulation state yet, the steps of `fixedTimestep` seconds are only consumed.
+	pendingStepsCount = 0;
+}
+
+static void render(void* pUserData)
+{
+	MD_UNUSED(pUserData);
 
 	mdRenderClearScreen((struct MdColor){0.2f, 0.3f, 0.3f, 1.0f});
 
 	mdRenderStartFrame();
 
+	mdRenderBeginGpuZone("Triangle");
 	mdPipelineUse(pPipeline);
 	mdVertexBufferBind(pVertexBuffer);
 	mdRenderDraw(3, 1, 0, 0);
+	mdRenderEndGpuZone();
 
 	mdRenderEndFrame();
 
 	mdRenderPresent();
 }
 
+#if MD_DEBUG && !PLATFORM_IS_WEB
+static void reloadAssets(void* pUserData)
+{
+	MD_UNUSED(pUserData);
+
+	struct MdFileWatchEvent events[4];
+	u32						eventsCount = mdFileWatcherPoll(pAssetsWatcher, events, MD_ARRAY_SIZE(events));
+	b8						isReplaced	= MD_FALSE;
+	for (u32 i = 0; i < eventsCount; ++i)
+	{
+		isReplaced |= events[i].type != MD_FILE_WATCH_EVENT_TYPE_DELETED;
+	}
+	if (!isReplaced)
+	{
+		return;
+	}
+
+	// No task opens a file from the pack while this one runs, it can be swapped for the new one.
+	if (isAssetsPackMounted)
+	{
+		mdPackUnmount("assets");
+	}
+	isAssetsPackMounted = mdPackMount(ASSETS_PACK_PATH, "assets");
+	if (!isAssetsPackMounted)
+	{
+		MD_LOG_ERROR("Cannot mount the rebuilt assets pack %s, the assets are not reloaded.", ASSETS_PACK_PATH);
+		return;
+	}
+	if (mdPipelineReload(pPipeline))
+	{
+		MD_LOG_INFO("Assets reloaded.");
+	}
+}
+#endif
+
 static void WriteVertexData(u8* pDest, const void* pData)
 {
 #if MD_USE_VULKAN
@@ -0,0 +1,82 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+#define ELEMENTS_COUNT 1000u
+
+static struct MdDynamicArray* s_pArray = MD_NULL;
+static struct MdLinkedList*	  s_pList  = MD_NULL;
+
+static void createArray()
+{
+	s_pArray = mdDynamicArrayCreate(0, MD_NULL);
+}
+
+static void destroyArray()
+{
+	mdDynamicArrayDestroy(s_pArray);
+}
+
+static void createList()
+{
+	s_pList = mdLinkedListCreate(MD_NULL);
+}
+
+static void destroyList()
+{
+	mdLinkedListDestroy(s_pList);
+}
+
+static void createFilledArray()
+{
+	createArray();
+	for (u32 i = 0; i < ELEMENTS_COUNT; ++i)
+	{
+		mdDynamicArrayPush(s_pArray, (void*)(mdSize)i);
+	}
+}
+
+static void createFilledList()
+{
+	createList();
+	for (u32 i = 0; i < ELEMENTS_COUNT; ++i)
+	{
+		mdLinkedListPush(s_pList, (void*)(mdSize)i);
+	}
+}
+
+MD_BENCH_WITH_HOOKS(Containers, DynamicArrayPush, createArray, destroyArray)
+{
+	for (u32 i = 0; i < ELEMENTS_COUNT; ++i)
+	{
+		mdDynamicArrayPush(s_pArray, (void*)(mdSize)i);
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(s_pArray->pData);
+}
+
+MD_BENCH_WITH_HOOKS(Containers, LinkedListPush, createList, destroyList)
+{
+	for (u32 i = 0; i < ELEMENTS_COUNT; ++i)
+	{
+		mdLinkedListPush(s_pList, (void*)(mdSize)i);
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(s_pList->pHead);
+}
+
+MD_BENCH_WITH_FIXTURE(Containers, DynamicArrayTraversal, createFilledArray, destroyArray)
+{
+	mdSize sum = 0;
+	for (u32 i = 0; i < mdDynamicArrayCount(s_pArray); ++i)
+	{
+		sum += (mdSize)mdDynamicArrayAt(s_pArray, i);
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(sum);
+}
+
+MD_BENCH_WITH_FIXTURE(Containers, LinkedListTraversal, createFilledList, destroyList)
+{
+	mdSize sum = 0;
+	for (struct MdLinkedListNode* pNode = s_pList->pHead; pNode != MD_NULL; pNode = pNode->pNext)
+	{
+		sum += (mdSize)pNode->pData;
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(sum);
+}
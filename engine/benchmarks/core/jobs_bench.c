@@ -0,0 +1,91 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+#define JOBS_COUNT		   256u
+#define ITERATIONS_PER_JOB 4096u
+
+// The scaling from 1 to 8 threads, the calling thread included: the same batch of compute-bound jobs, each about ten
+// microseconds long, is run by pools of growing size. On a machine with fewer cores the larger pools measure the
+// oversubscription instead.
+
+static f32 s_results[JOBS_COUNT];
+
+// Not inlined: the serial loop would otherwise interleave the jobs, which the pools cannot.
+__attribute__((noinline)) static void computeJob(void* pUserData)
+{
+	f32* pResult = (f32*)pUserData;
+	f32	 value	 = *pResult;
+	for (u32 i = 0; i < ITERATIONS_PER_JOB; ++i)
+	{
+		value = value * 0.999f + 0.5f;
+	}
+	*pResult = value;
+}
+
+static void runBatch()
+{
+	struct MdJobDecl jobs[JOBS_COUNT];
+	for (u32 i = 0; i < JOBS_COUNT; ++i)
+	{
+		jobs[i].function  = computeJob;
+		jobs[i].pUserData = &s_results[i];
+	}
+
+	struct MdJobCounter counter = {0};
+	mdJobSubmit(jobs, JOBS_COUNT, MD_JOB_PRIORITY_NORMAL, &counter);
+	mdJobWait(&counter);
+	MD_BENCH_DO_NOT_OPTIMIZE(s_results[0]);
+}
+
+static void startOneThread()
+{
+	mdJobSystemInitialize(0);
+}
+
+static void startTwoThreads()
+{
+	mdJobSystemInitialize(1);
+}
+
+static void startFourThreads()
+{
+	mdJobSystemInitialize(3);
+}
+
+static void startEightThreads()
+{
+	mdJobSystemInitialize(7);
+}
+
+static void stopThreads()
+{
+	mdJobSystemShutdown();
+}
+
+MD_BENCH(Jobs, SerialBaseline)
+{
+	for (u32 i = 0; i < JOBS_COUNT; ++i)
+	{
+		computeJob(&s_results[i]);
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(s_results[0]);
+}
+
+MD_BENCH_WITH_FIXTURE(Jobs, Batch1Thread, startOneThread, stopThreads)
+{
+	runBatch();
+}
+
+MD_BENCH_WITH_FIXTURE(Jobs, Batch2Threads, startTwoThreads, stopThreads)
+{
+	runBatch();
+}
+
+MD_BENCH_WITH_FIXTURE(Jobs, Batch4Threads, startFourThreads, stopThreads)
+{
+	runBatch();
+}
+
+MD_BENCH_WITH_FIXTURE(Jobs, Batch8Threads, startEightThreads, stopThreads)
+{
+	runBatch();
+}
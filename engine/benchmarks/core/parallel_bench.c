@@ -0,0 +1,144 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+// The parallel loops against the serial ones on arrays of 1e3, 1e5 and 1e7 elements: below the grain the parallel
+// loops are serial with a call more, above it they scale with the workers until the memory bandwidth is the limit.
+// The job system runs with the default workers, one per core.
+
+static u64	s_elementsCount;
+static u32* s_pInput;
+static u32* s_pOutput;
+
+static void startArrays(u64 elementsCount)
+{
+	s_elementsCount = elementsCount;
+	s_pInput		= MD_MALLOC_ARRAY(u32, elementsCount);
+	s_pOutput		= MD_MALLOC_ARRAY(u32, elementsCount);
+	for (u64 i = 0; i < elementsCount; ++i)
+	{
+		s_pInput[i] = (u32)(i * 2654435761u) >> 24;
+	}
+
+	mdJobSystemInitialize(MD_JOB_WORKERS_COUNT_DEFAULT);
+}
+
+static void startThousand()
+{
+	startArrays(1000);
+}
+
+static void startHundredThousand()
+{
+	startArrays(100000);
+}
+
+static void startTenMillion()
+{
+	startArrays(10000000);
+}
+
+static void stopArrays()
+{
+	mdJobSystemShutdown();
+	MD_FREE_ARRAY(s_pOutput, u32, s_elementsCount);
+	MD_FREE_ARRAY(s_pInput, u32, s_elementsCount);
+}
+
+static void transform(u64 begin, u64 end, void* pUserData)
+{
+	MD_UNUSED(pUserData);
+	for (u64 i = begin; i < end; ++i)
+	{
+		s_pOutput[i] = s_pInput[i] * 3u + 1u;
+	}
+}
+
+static void sum(u64 begin, u64 end, void* pPartial, void* pUserData)
+{
+	MD_UNUSED(pUserData);
+	u64 total = *(u64*)pPartial;
+	for (u64 i = begin; i < end; ++i)
+	{
+		total += s_pInput[i];
+	}
+	*(u64*)pPartial = total;
+}
+
+static void addSums(void* pAccumulator, const void* pPartial, void* pUserData)
+{
+	MD_UNUSED(pUserData);
+	*(u64*)pAccumulator += *(const u64*)pPartial;
+}
+
+static void serialFor()
+{
+	transform(0, s_elementsCount, MD_NULL);
+	MD_BENCH_DO_NOT_OPTIMIZE(s_pOutput[0]);
+}
+
+static void parallelFor()
+{
+	mdParallelFor(0, s_elementsCount, 0, transform, MD_NULL);
+	MD_BENCH_DO_NOT_OPTIMIZE(s_pOutput[0]);
+}
+
+static void serialReduce()
+{
+	u64 total = 0;
+	sum(0, s_elementsCount, &total, MD_NULL);
+	MD_BENCH_DO_NOT_OPTIMIZE(total);
+}
+
+static void parallelReduce()
+{
+	u64 identity = 0;
+	u64 total	 = 0;
+	mdParallelReduce(0, s_elementsCount, 0, sum, addSums, &identity, sizeof(u64), &total, MD_NULL);
+	MD_BENCH_DO_NOT_OPTIMIZE(total);
+}
+
+static void serialScan()
+{
+	u32 total = 0;
+	for (u64 i = 0; i < s_elementsCount; ++i)
+	{
+		s_pOutput[i] = total;
+		total += s_pInput[i];
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(total);
+}
+
+static void parallelScan()
+{
+	u32 total = mdParallelScan(s_pInput, s_pOutput, s_elementsCount, 0);
+	MD_BENCH_DO_NOT_OPTIMIZE(total);
+}
+
+#define PARALLEL_BENCH_SIZE(size, start)                                                                               \
+	MD_BENCH_WITH_FIXTURE(Parallel, SerialFor##size, start, stopArrays)                                                \
+	{                                                                                                                  \
+		serialFor();                                                                                                   \
+	}                                                                                                                  \
+	MD_BENCH_WITH_FIXTURE(Parallel, For##size, start, stopArrays)                                                      \
+	{                                                                                                                  \
+		parallelFor();                                                                                                 \
+	}                                                                                                                  \
+	MD_BENCH_WITH_FIXTURE(Parallel, SerialReduce##size, start, stopArrays)                                             \
+	{                                                                                                                  \
+		serialReduce();                                                                                                \
+	}                                                                                                                  \
+	MD_BENCH_WITH_FIXTURE(Parallel, Reduce##size, start, stopArrays)                                                   \
+	{                                                                                                                  \
+		parallelReduce();                                                                                              \
+	}                                                                                                                  \
+	MD_BENCH_WITH_FIXTURE(Parallel, SerialScan##size, start, stopArrays)                                               \
+	{                                                                                                                  \
+		serialScan();                                                                                                  \
+	}                                                                                                                  \
+	MD_BENCH_WITH_FIXTURE(Parallel, Scan##size, start, stopArrays)                                                     \
+	{                                                                                                                  \
+		parallelScan();                                                                                                \
+	}
+
+PARALLEL_BENCH_SIZE(1e3, startThousand)
+PARALLEL_BENCH_SIZE(1e5, startHundredThousand)
+PARALLEL_BENCH_SIZE(1e7, startTenMillion)
@@ -0,0 +1,16 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+int main(int argc, char** argv)
+{
+	mdMemoryInitialize();
+
+	i32					 exitCode = 1;
+	struct MdBenchConfig config	  = mdBenchGetDefaultConfig();
+	if (mdBenchParseArguments(&config, argc, argv))
+	{
+		exitCode = mdBenchRunAll(&config);
+	}
+
+	mdMemoryShutdown();
+	return exitCode;
+}
@@ -0,0 +1,96 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+// The decoding of a chunk to a dense array against a loop of `mdChunkGetBlock`, for palettes of 2, 16, 256 block types
+// and without palette, and the random accesses to a 4 bits chunk.
+
+static struct MdChunk* s_pChunk;
+static mdBlockId*	   s_pBlocks;
+
+static void startChunk(u32 typesCount)
+{
+	s_pBlocks = MD_MALLOC_ARRAY(mdBlockId, MD_CHUNK_VOLUME);
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+	{
+		s_pBlocks[i] = (mdBlockId)(((i * 2654435761u) >> 16) % typesCount);
+	}
+	s_pChunk = mdChunkCreate(0);
+	mdChunkEncode(s_pChunk, s_pBlocks);
+}
+
+static void startTwoTypes()
+{
+	startChunk(2);
+}
+
+static void startSixteenTypes()
+{
+	startChunk(16);
+}
+
+static void startManyTypes()
+{
+	startChunk(256);
+}
+
+static void startDirect()
+{
+	startChunk(4096);
+}
+
+static void stopChunk()
+{
+	mdChunkDestroy(s_pChunk);
+	MD_FREE_ARRAY(s_pBlocks, mdBlockId, MD_CHUNK_VOLUME);
+}
+
+static void decodeWithGets()
+{
+	for (u32 y = 0; y < MD_CHUNK_SIZE; ++y)
+	{
+		for (u32 z = 0; z < MD_CHUNK_SIZE; ++z)
+		{
+			for (u32 x = 0; x < MD_CHUNK_SIZE; ++x)
+			{
+				s_pBlocks[MD_CHUNK_BLOCK_INDEX(x, y, z)] = mdChunkGetBlock(s_pChunk, x, y, z);
+			}
+		}
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(s_pBlocks[0]);
+}
+
+static void decode()
+{
+	mdChunkDecode(s_pChunk, s_pBlocks);
+	MD_BENCH_DO_NOT_OPTIMIZE(s_pBlocks[0]);
+}
+
+#define CHUNK_BENCH_PALETTE(name, start)                                                                               \
+	MD_BENCH_WITH_FIXTURE(Chunk, GetAll##name, start, stopChunk)                                                       \
+	{                                                                                                                  \
+		decodeWithGets();                                                                                              \
+	}                                                                                                                  \
+	MD_BENCH_WITH_FIXTURE(Chunk, Decode##name, start, stopChunk)                                                       \
+	{                                                                                                                  \
+		decode();                                                                                                      \
+	}
+
+CHUNK_BENCH_PALETTE(TwoTypes, startTwoTypes)
+CHUNK_BENCH_PALETTE(SixteenTypes, startSixteenTypes)
+CHUNK_BENCH_PALETTE(ManyTypes, startManyTypes)
+CHUNK_BENCH_PALETTE(Direct, startDirect)
+
+MD_BENCH_WITH_FIXTURE(Chunk, RandomGetSet, startSixteenTypes, stopChunk)
+{
+	u32 seed = 1;
+	u32 sum	 = 0;
+	for (u32 i = 0; i < 1024; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		u32 x = seed >> 27;
+		u32 y = (seed >> 22) & 31;
+		u32 z = (seed >> 17) & 31;
+		sum += mdChunkGetBlock(s_pChunk, x, y, z);
+		mdChunkSetBlock(s_pChunk, z, x, y, (mdBlockId)(seed & 15));
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(sum);
+}
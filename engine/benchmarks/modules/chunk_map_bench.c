@@ -0,0 +1,112 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+// The lookups in a map of 100k loaded chunks (a 50 x 40 x 50 region): random loaded and unloaded coordinates, the 26
+// neighbors of a chunk through the links and through lookups, a box query, and loading and unloading a chunk.
+
+#define SIZE_X		  50
+#define SIZE_Y		  40
+#define SIZE_Z		  50
+#define LOOKUPS_COUNT 1024u
+
+static struct MdChunkMap* s_pMap;
+
+static void startMap()
+{
+	s_pMap = mdChunkMapCreate(SIZE_X * SIZE_Y * SIZE_Z, MD_NULL);
+	for (i32 x = 0; x < SIZE_X; ++x)
+	{
+		for (i32 y = 0; y < SIZE_Y; ++y)
+		{
+			for (i32 z = 0; z < SIZE_Z; ++z)
+			{
+				mdChunkMapInsert(s_pMap, x, y, z, (void*)(mdSize)(1 + x + y + z));
+			}
+		}
+	}
+}
+
+static void stopMap()
+{
+	mdChunkMapDestroy(s_pMap);
+}
+
+/**
+ * Random coordinates in the region, or just past it.
+ */
+static void findRandom(i32 offset)
+{
+	u32 seed  = 1;
+	u32 found = 0;
+	for (u32 i = 0; i < LOOKUPS_COUNT; ++i)
+	{
+		seed  = seed * 1664525u + 1013904223u;
+		i32 x = (i32)((seed >> 8) % SIZE_X) + offset;
+		i32 y = (i32)((seed >> 16) % SIZE_Y);
+		i32 z = (i32)((seed >> 22) % SIZE_Z);
+		found += mdChunkMapFind(s_pMap, x, y, z) != MD_CHUNK_MAP_NOT_FOUND_INDEX;
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(found);
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMap, Find1024Loaded, startMap, stopMap)
+{
+	findRandom(0);
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMap, Find1024Unloaded, startMap, stopMap)
+{
+	findRandom(SIZE_X);
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMap, NeighborsByLinks, startMap, stopMap)
+{
+	u32	   slotIndex = mdChunkMapFind(s_pMap, SIZE_X / 2, SIZE_Y / 2, SIZE_Z / 2);
+	mdSize sum		 = 0;
+	for (i32 dx = -1; dx <= 1; ++dx)
+	{
+		for (i32 dy = -1; dy <= 1; ++dy)
+		{
+			for (i32 dz = -1; dz <= 1; ++dz)
+			{
+				if (dx != 0 || dy != 0 || dz != 0)
+				{
+					sum += (mdSize)mdChunkMapGetNeighbor(s_pMap, slotIndex, dx, dy, dz);
+				}
+			}
+		}
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(sum);
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMap, NeighborsByLookups, startMap, stopMap)
+{
+	mdSize sum = 0;
+	for (i32 dx = -1; dx <= 1; ++dx)
+	{
+		for (i32 dy = -1; dy <= 1; ++dy)
+		{
+			for (i32 dz = -1; dz <= 1; ++dz)
+			{
+				if (dx != 0 || dy != 0 || dz != 0)
+				{
+					sum += (mdSize)mdChunkMapGet(s_pMap, SIZE_X / 2 + dx, SIZE_Y / 2 + dy, SIZE_Z / 2 + dz);
+				}
+			}
+		}
+	}
+	MD_BENCH_DO_NOT_OPTIMIZE(sum);
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMap, QueryBox8x8x8, startMap, stopMap)
+{
+	u32 slotIndices[512];
+	u32 count = mdChunkMapQueryBox(s_pMap, 10, 10, 10, 17, 17, 17, slotIndices, MD_ARRAY_SIZE(slotIndices));
+	MD_BENCH_DO_NOT_OPTIMIZE(count);
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMap, UnloadAndLoad, startMap, stopMap)
+{
+	mdChunkMapRemove(s_pMap, SIZE_X / 2, SIZE_Y / 2, SIZE_Z / 2);
+	u32 slotIndex = mdChunkMapInsert(s_pMap, SIZE_X / 2, SIZE_Y / 2, SIZE_Z / 2, (void*)(mdSize)1);
+	MD_BENCH_DO_NOT_OPTIMIZE(slotIndex);
+}
@@ -0,0 +1,112 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+// The greedy meshing of one chunk without neighbors: flat terrain, which merges into a few large quads, noisy terrain
+// of mixed blocks and caves, and a checkerboard, the worst case with a quad for every face of half the blocks.
+
+static mdBlockId*		   s_pBlocks;
+static struct MdChunkMesh* s_pMesh;
+static const mdBlockId*	   s_pNeighborFaces[MD_CHUNK_FACE_COUNT];
+
+static u32 hash(u32 value)
+{
+	value ^= value >> 16;
+	value *= 0x7feb352du;
+	value ^= value >> 15;
+	value *= 0x846ca68bu;
+	return value ^ (value >> 16);
+}
+
+/**
+ * Stone below, a layer of dirt, grass on top at the given height for each column.
+ */
+static mdBlockId terrainBlock(u32 y, u32 height)
+{
+	if (y > height)
+	{
+		return MD_BLOCK_ID_EMPTY;
+	}
+	return y == height ? 3 : (y + 3 > height ? 2 : 1);
+}
+
+static mdBlockId flatBlock(u32 x, u32 y, u32 z)
+{
+	MD_UNUSED(x);
+	MD_UNUSED(z);
+	return terrainBlock(y, MD_CHUNK_SIZE / 2);
+}
+
+static mdBlockId noisyBlock(u32 x, u32 y, u32 z)
+{
+	u32 height = MD_CHUNK_SIZE / 4 + hash(x / 4 * 131 + z / 4) % (MD_CHUNK_SIZE / 2);
+	if (hash(MD_CHUNK_BLOCK_INDEX(x, y, z)) % 8 == 0)
+	{
+		return MD_BLOCK_ID_EMPTY;
+	}
+	return terrainBlock(y, height);
+}
+
+static mdBlockId checkerboardBlock(u32 x, u32 y, u32 z)
+{
+	return (x + y + z) % 2 == 0 ? 1 : MD_BLOCK_ID_EMPTY;
+}
+
+static void startChunk(mdBlockId (*blockFunction)(u32, u32, u32))
+{
+	s_pBlocks = MD_MALLOC_ARRAY(mdBlockId, MD_CHUNK_VOLUME);
+	for (u32 y = 0; y < MD_CHUNK_SIZE; ++y)
+	{
+		for (u32 z = 0; z < MD_CHUNK_SIZE; ++z)
+		{
+			for (u32 x = 0; x < MD_CHUNK_SIZE; ++x)
+			{
+				s_pBlocks[MD_CHUNK_BLOCK_INDEX(x, y, z)] = blockFunction(x, y, z);
+			}
+		}
+	}
+
+	// A first build allocates the vertices, the measured builds reuse them.
+	s_pMesh = mdChunkMeshCreate();
+	mdChunkMeshBuild(s_pMesh, s_pBlocks, s_pNeighborFaces, MD_NULL, MD_NULL);
+}
+
+static void startFlat()
+{
+	startChunk(flatBlock);
+}
+
+static void startNoisy()
+{
+	startChunk(noisyBlock);
+}
+
+static void startCheckerboard()
+{
+	startChunk(checkerboardBlock);
+}
+
+static void stopChunk()
+{
+	mdChunkMeshDestroy(s_pMesh);
+	MD_FREE_ARRAY(s_pBlocks, mdBlockId, MD_CHUNK_VOLUME);
+}
+
+static void buildMesh()
+{
+	mdChunkMeshBuild(s_pMesh, s_pBlocks, s_pNeighborFaces, MD_NULL, MD_NULL);
+	MD_BENCH_DO_NOT_OPTIMIZE(s_pMesh->verticesCount);
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMesh, BuildFlat, startFlat, stopChunk)
+{
+	buildMesh();
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMesh, BuildNoisy, startNoisy, stopChunk)
+{
+	buildMesh();
+}
+
+MD_BENCH_WITH_FIXTURE(ChunkMesh, BuildCheckerboard, startCheckerboard, stopChunk)
+{
+	buildMesh();
+}
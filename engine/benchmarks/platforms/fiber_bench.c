@@ -0,0 +1,31 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+static struct MdFiber* s_pThreadFiber = MD_NULL;
+static struct MdFiber* s_pFiber		  = MD_NULL;
+
+static void switchBack(void* pArgument)
+{
+	MD_UNUSED(pArgument);
+	for (;;)
+	{
+		mdFiberSwitch(s_pFiber, s_pThreadFiber);
+	}
+}
+
+static void createFibers()
+{
+	s_pThreadFiber = mdFiberCreateFromThread();
+	s_pFiber	   = mdFiberCreate(MD_FIBER_MIN_STACK_SIZE, switchBack, MD_NULL);
+}
+
+static void destroyFibers()
+{
+	mdFiberDestroy(s_pFiber);
+	mdFiberDestroy(s_pThreadFiber);
+}
+
+// Two switches: a suspended job costs one round trip, against a blocked worker thread.
+MD_BENCH_WITH_FIXTURE(Fiber, SwitchRoundTrip, createFibers, destroyFibers)
+{
+	mdFiberSwitch(s_pThreadFiber, s_pFiber);
+}
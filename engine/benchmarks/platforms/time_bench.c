@@ -0,0 +1,14 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+// The clock is read twice by every profiling zone and by every frame phase, its cost bounds their overhead.
+MD_BENCH(Time, GetTicks)
+{
+	mdTicks ticks = mdGetTicks();
+	MD_BENCH_DO_NOT_OPTIMIZE(ticks);
+}
+
+// Outside of a capture a zone only checks the capture flag.
+MD_BENCH(Profile, IdleScope)
+{
+	MD_PROFILE_SCOPE("Idle Scope");
+}
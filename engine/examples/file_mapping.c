@@ -0,0 +1,113 @@
+#include "MEEDEngine/MEEDEngine.h"
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * Compares `MD_FILE_MODE_READ` (copy into a heap buffer) with `MD_FILE_MODE_READ_MAPPED` (mmap) by opening a file,
+ * reading every byte of its content and closing it. The files are written right before the measurements so they are
+ * served from the page cache, the numbers show the cost of the copy and not of the storage device.
+ *
+ * Usage: file_mapping [max size in MB, default 1024]
+ */
+
+#define MD_BENCH_CHUNK_SIZE	 (1024u * 1024u)
+#define MD_BENCH_REPETITIONS 3
+
+static f64 getSeconds()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (f64)now.tv_sec + (f64)now.tv_nsec * 1e-9;
+}
+
+static void writeTestFile(const char* filePath, u32 sizeInMB)
+{
+	char* chunk = MD_MALLOC_ARRAY(char, MD_BENCH_CHUNK_SIZE);
+	for (u32 i = 0; i < MD_BENCH_CHUNK_SIZE; ++i)
+	{
+		chunk[i] = (char)(i * 31u);
+	}
+
+	struct MdFileData* pFile = mdFileOpen(filePath, MD_FILE_MODE_WRITE);
+	for (u32 i = 0; i < sizeInMB; ++i)
+	{
+		mdFileWrite(pFile, chunk, MD_BENCH_CHUNK_SIZE);
+	}
+	mdFileClose(pFile);
+
+	MD_FREE_ARRAY(chunk, char, MD_BENCH_CHUNK_SIZE);
+}
+
+static u64 checksumContent(const struct MdFileData* pFile)
+{
+	const u64* pWords	 = (const u64*)pFile->content;
+	u64		   checksum	 = 0;
+	mdSize	   wordCount = pFile->size / sizeof(u64);
+
+	for (mdSize i = 0; i < wordCount; ++i)
+	{
+		checksum += pWords[i];
+	}
+
+	return checksum;
+}
+
+static f64 measureMode(const char* filePath, enum MdFileMode mode, u64* pChecksum)
+{
+	f64 best = 1e30;
+
+	for (u32 repetition = 0; repetition < MD_BENCH_REPETITIONS; ++repetition)
+	{
+		f64 start = getSeconds();
+
+		struct MdFileData* pFile = mdFileOpen(filePath, mode);
+		*pChecksum				 = checksumContent(pFile);
+		mdFileClose(pFile);
+
+		f64 elapsed = getSeconds() - start;
+		best		= elapsed < best ? elapsed : best;
+	}
+
+	return best;
+}
+
+int main(int argc, char** argv)
+{
+	mdMemoryInitialize();
+
+	u32 maxSizeInMB = argc > 1 ? (u32)atoi(argv[1]) : 1024u;
+
+	const char* filePath = "./file_mapping_bench.bin";
+
+	mdFormatPrint("%10s | %12s | %12s | %10s | %10s\n", "size", "read (ms)", "mapped (ms)", "read GB/s", "map GB/s");
+
+	for (u32 sizeInMB = 1; sizeInMB <= maxSizeInMB; sizeInMB *= 4)
+	{
+		writeTestFile(filePath, sizeInMB);
+
+		u64 readChecksum   = 0;
+		u64 mappedChecksum = 0;
+		f64 readSeconds	   = measureMode(filePath, MD_FILE_MODE_READ, &readChecksum);
+		f64 mappedSeconds  = measureMode(filePath, MD_FILE_MODE_READ_MAPPED, &mappedChecksum);
+		MD_ASSERT_MSG(readChecksum == mappedChecksum, "Both modes must see the same content.");
+
+		f64 gigabytes = (f64)sizeInMB / 1024.0;
+		mdFormatPrint("%7u MB | %12.3f | %12.3f | %10.2f | %10.2f\n",
+					  sizeInMB,
+					  readSeconds * 1e3,
+					  mappedSeconds * 1e3,
+					  gigabytes / readSeconds,
+					  gigabytes / mappedSeconds);
+
+		// Stop at the requested maximum even when it is not a power of 4.
+		if (sizeInMB < maxSizeInMB && sizeInMB * 4 > maxSizeInMB)
+		{
+			sizeInMB = maxSizeInMB / 4;
+		}
+	}
+
+	mdFileRemove(filePath);
+
+	mdMemoryShutdown();
+	return 0;
+}
@@ -1,12 +1,23 @@
 #include "MEEDEngine/MEEDEngine.h"
 
+static u32 expensiveValue(const char* name)
+{
+	mdFormatPrint("[EXAMPLE] Evaluating %s\n", name);
+	return 42;
+}
+
 int main(void)
 {
 	mdMemoryInitialize();
-	mdInitializeConsoleLogHandler(MD_LOG_LEVEL_DEBUG);
+	mdInitializeConsoleLogHandler(MD_LOG_LEVEL_VERBOSE);
 	mdLogInitialize(MD_LOG_LEVEL_DEBUG);
 	mdLogAddHandler(MD_LOG_CONSOLE_HANDLER);
 
+	// The file handler keeps the records in memory and writes them in batches, errors are written immediately.
+	struct MdFileLogHandlerConfig fileConfig = mdFileLogHandlerGetDefaultConfig("meed_example.log");
+	mdInitializeFileLogHandler(MD_LOG_LEVEL_VERBOSE, &fileConfig);
+	mdLogAddHandler(MD_LOG_FILE_HANDLER);
+
 	MD_LOG_VERBOSE("MEED Verbose");
 	MD_LOG_DEBUG("MEED Debug");
 	MD_LOG_INFO("MEED Info");
@@ -14,8 +25,22 @@ int main(void)
 	MD_LOG_ERROR("MEED Error");
 	MD_LOG_FATAL("MEED Fatal");
 
+	// Only the render category is switched to verbose, the arguments of the disabled statements are not evaluated.
+	mdLogSetCategoryLevel(MD_LOG_CATEGORY_RENDER, MD_LOG_LEVEL_VERBOSE);
+	mdLogSetCategoryLevel(MD_LOG_CATEGORY_PLATFORM, MD_LOG_LEVEL_WARNING);
+
+	MD_LOG_VERBOSE_CAT(MD_LOG_CATEGORY_RENDER, "Render verbose: %u", expensiveValue("render"));
+	MD_LOG_INFO_CAT(MD_LOG_CATEGORY_PLATFORM, "Platform info: %u", expensiveValue("platform"));
+
+	// Only one record per second passes, the rest are counted and reported by the next record of a new window.
+	for (u32 i = 0; i < 1000; ++i)
+	{
+		MD_LOG_WARNING_THROTTLED_CAT(MD_LOG_CATEGORY_RENDER, 1, "Flooding warning %u", i);
+	}
+
 	mdLogShutdown();
+	mdShutdownFileLogHandler();
 	mdShutdownConsoleLogHandler();
 	mdMemoryShutdown();
 	return 0;
-}
\ No newline at end of file
+}
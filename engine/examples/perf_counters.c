@@ -0,0 +1,85 @@
+#include "MEEDEngine/MEEDEngine.h"
+
+#define ELEMENTS_COUNT 200000u
+
+static void report(const char* label, struct MdPerfCounters* pCounters, mdTicks elapsedTicks)
+{
+	struct MdPerfCounterValues values;
+	mdPerfCountersRead(pCounters, &values);
+
+	mdFormatPrint("[PERF] %-24s %8.3f ms", label, mdTicksToMilliseconds(elapsedTicks));
+	for (u32 i = 0; i < MD_PERF_COUNTER_COUNT; ++i)
+	{
+		if (values.availableMask & MD_PERF_COUNTER_BIT(i))
+		{
+			const char* name = mdPerfCounterGetName((enum MdPerfCounter)i);
+			mdFormatPrint(", %s %llu", name, (unsigned long long)values.values[i]);
+		}
+	}
+	if (mdPerfCountersGetIPC(&values) > 0.0)
+	{
+		mdFormatPrint(", IPC %.2f", mdPerfCountersGetIPC(&values));
+	}
+	mdFormatPrint("%s\n", values.isScaled ? " (scaled)" : "");
+}
+
+int main(void)
+{
+	mdMemoryInitialize();
+
+	struct MdPerfCounters* pCounters = mdPerfCountersCreate();
+	if (!mdPerfCountersIsAvailable(pCounters, MD_PERF_COUNTER_CYCLES))
+	{
+		mdFormatPrint("[PERF] Hardware counters unavailable (container or perf_event_paranoid), wall time only.\n");
+	}
+
+	struct MdDynamicArray* pArray = mdDynamicArrayCreate(0, MD_NULL);
+	struct MdLinkedList*   pList  = mdLinkedListCreate(MD_NULL);
+	u64					   sum	  = 0;
+
+	mdTicks start = mdGetTicks();
+	mdPerfCountersStart(pCounters);
+	for (u32 i = 0; i < ELEMENTS_COUNT; ++i)
+	{
+		mdDynamicArrayPush(pArray, (void*)(mdSize)i);
+	}
+	mdPerfCountersStop(pCounters);
+	report("Dynamic array push", pCounters, mdGetTicks() - start);
+
+	start = mdGetTicks();
+	mdPerfCountersStart(pCounters);
+	for (u32 i = 0; i < ELEMENTS_COUNT; ++i)
+	{
+		mdLinkedListPush(pList, (void*)(mdSize)i);
+	}
+	mdPerfCountersStop(pCounters);
+	report("Linked list push", pCounters, mdGetTicks() - start);
+
+	// The array reads contiguous memory, the list chases one pointer per element.
+	start = mdGetTicks();
+	mdPerfCountersStart(pCounters);
+	for (u32 i = 0; i < mdDynamicArrayCount(pArray); ++i)
+	{
+		sum += (mdSize)mdDynamicArrayAt(pArray, i);
+	}
+	mdPerfCountersStop(pCounters);
+	report("Dynamic array traversal", pCounters, mdGetTicks() - start);
+
+	start = mdGetTicks();
+	mdPerfCountersStart(pCounters);
+	for (struct MdLinkedListNode* pNode = pList->pHead; pNode != MD_NULL; pNode = pNode->pNext)
+	{
+		sum += (mdSize)pNode->pData;
+	}
+	mdPerfCountersStop(pCounters);
+	report("Linked list traversal", pCounters, mdGetTicks() - start);
+
+	mdFormatPrint("[PERF] Checksum %llu\n", (unsigned long long)sum);
+
+	mdLinkedListDestroy(pList);
+	mdDynamicArrayDestroy(pArray);
+	mdPerfCountersDestroy(pCounters);
+
+	mdMemoryShutdown();
+	return 0;
+}
@@ -10,6 +10,29 @@ int main(void)
 
 	mdFormatPrint("[TIME] Current time is: %s\n", timeString);
 
+	// Measure a few fake frames of ~1 ms each.
+	struct MdFrameTimer* pTimer = mdFrameTimerCreate(0);
+	mdFrameTimerTick(pTimer);
+	for (u32 frame = 0; frame < 60; ++frame)
+	{
+		mdTicks end = mdGetTicks() + MD_TICKS_PER_MILLISECOND;
+		while (mdGetTicks() < end)
+		{
+		}
+		mdFrameTimerTick(pTimer);
+	}
+
+	struct MdFrameTimerStats stats;
+	mdFrameTimerGetStats(pTimer, &stats);
+	mdFormatPrint("[TIME] %u frames: avg %.3f ms, min %.3f ms, max %.3f ms, p95 %.3f ms, p99 %.3f ms\n",
+				  stats.samplesCount,
+				  stats.averageMilliseconds,
+				  stats.minMilliseconds,
+				  stats.maxMilliseconds,
+				  stats.p95Milliseconds,
+				  stats.p99Milliseconds);
+	mdFrameTimerDestroy(pTimer);
+
 	mdMemoryShutdown();
 	return 0;
 }
\ No newline at end of file
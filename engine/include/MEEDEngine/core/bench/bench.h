@@ -0,0 +1,214 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "MEEDEngine/platforms/common.h"
+
+/**
+ * @file bench.h
+ *
+ * Micro-benchmark harness. The benchmarks register themselves like the gtest tests, with `MD_BENCH` in any source
+ * file of the benchmark executable, and `mdBenchRunAll` runs them.
+ *
+ * Every benchmark is warmed up first, which also measures it: the number of iterations of a repetition is then
+ * chosen so a repetition lasts at least `minRepetitionMilliseconds`, long enough for the clock resolution to not
+ * matter. The statistics are computed over the repetitions, per iteration: the median and the median absolute
+ * deviation (MAD) are robust to the repetitions an interrupt or a page fault slowed down, unlike the mean.
+ *
+ * The results are printed as a table, optionally written as JSON and compared with a baseline JSON written by a
+ * previous run: a benchmark whose median is slower than the baseline by more than the threshold fails the run.
+ *
+ * @example
+ * ```c
+ * static struct MdDynamicArray* s_pArray = MD_NULL;
+ *
+ * static void createArray() { s_pArray = mdDynamicArrayCreate(0, MD_NULL); }
+ * static void destroyArray() { mdDynamicArrayDestroy(s_pArray); }
+ *
+ * MD_BENCH_WITH_HOOKS(DynamicArray, Push1000, createArray, destroyArray)
+ * {
+ *     for (u32 i = 0; i < 1000; ++i)
+ *     {
+ *         mdDynamicArrayPush(s_pArray, MD_NULL);
+ *     }
+ *     MD_BENCH_DO_NOT_OPTIMIZE(s_pArray->pData);
+ * }
+ *
+ * int main(int argc, char** argv)
+ * {
+ *     struct MdBenchConfig config = mdBenchGetDefaultConfig();
+ *     return mdBenchParseArguments(&config, argc, argv) ? mdBenchRunAll(&config) : 1;
+ * }
+ * ```
+ */
+
+#define MD_BENCH_DEFAULT_REPETITIONS					15u
+#define MD_BENCH_DEFAULT_WARMUP_MILLISECONDS			50.0
+#define MD_BENCH_DEFAULT_MIN_REPETITION_MILLISECONDS	10.0
+#define MD_BENCH_DEFAULT_THRESHOLD						0.10 ///< A median 10% slower than the baseline fails.
+
+typedef void (*MdBenchFunction)(void);
+
+/**
+ * A registered benchmark, defined by `MD_BENCH` or `MD_BENCH_WITH_HOOKS`.
+ */
+struct MdBench
+{
+	const char*		suite;			 ///< The group of the benchmark, usually the benchmarked subsystem.
+	const char*		name;			 ///< The name of the benchmark inside its suite.
+	MdBenchFunction run;			 ///< One iteration, the only timed function.
+	MdBenchFunction setup;			 ///< Called before every iteration, optional.
+	MdBenchFunction teardown;		 ///< Called after every iteration, optional.
+	MdBenchFunction fixtureSetup;	 ///< Called once before the warmup, optional.
+	MdBenchFunction fixtureTeardown; ///< Called once after the repetitions, optional.
+	struct MdBench* pNext;			 ///< The next registered benchmark.
+};
+
+/**
+ * The settings of a run, see `mdBenchParseArguments` for the matching command line options.
+ */
+struct MdBenchConfig
+{
+	const char* filter;					   ///< Runs the benchmarks whose "Suite.Name" contains it, MD_NULL for all.
+	u32			repetitions;			   ///< The number of timed repetitions.
+	f64			warmupMilliseconds;		   ///< How long each benchmark runs untimed before the repetitions.
+	f64			minRepetitionMilliseconds; ///< The minimum duration of a repetition.
+	const char* jsonPath;				   ///< Writes the results to this file, MD_NULL to not write them.
+	const char* baselinePath;			   ///< Compares the results with this file, MD_NULL to not compare.
+	f64			threshold;				   ///< The relative slowdown of a median which fails the comparison.
+};
+
+/**
+ * The measure of a benchmark, the durations are per iteration.
+ */
+struct MdBenchResult
+{
+	const struct MdBench* pBench;
+	u64					  iterations;  ///< The iterations of every repetition.
+	u32					  repetitions; ///< The number of repetitions.
+	f64					  medianNanoseconds;
+	f64					  madNanoseconds; ///< The median absolute deviation from the median.
+	f64					  meanNanoseconds;
+	f64					  minNanoseconds;
+	f64					  p5Nanoseconds;
+	f64					  p95Nanoseconds;
+};
+
+/**
+ * Keeps the compiler from removing the computation of a value which is not used otherwise, and from assuming the
+ * memory is unchanged across it. The value must fit in a register (scalar or pointer).
+ */
+#define MD_BENCH_DO_NOT_OPTIMIZE(value) __asm__ volatile("" : : "g"(value) : "memory")
+
+/**
+ * Defines and registers a benchmark, followed by the body of one iteration. The missing hooks are given as `0`
+ * rather than `MD_NULL`, which is not a function pointer in C++.
+ */
+#define MD_BENCH(suite, name) MD_BENCH_DEFINE(suite, name, 0, 0, 0, 0)
+
+/**
+ * Defines and registers a benchmark whose `setup` and `teardown` run around every iteration, outside of the timing.
+ * They cost two clock reads per iteration, the iterations should last a microsecond or more.
+ */
+#define MD_BENCH_WITH_HOOKS(suite, name, setup, teardown)                                                              \
+	MD_BENCH_DEFINE(suite, name, setup, teardown, 0, 0)
+
+/**
+ * Defines and registers a benchmark whose `setup` and `teardown` run once around its whole measure, for the data the
+ * iterations only read.
+ */
+#define MD_BENCH_WITH_FIXTURE(suite, name, setup, teardown)                                                            \
+	MD_BENCH_DEFINE(suite, name, 0, 0, setup, teardown)
+
+#define MD_BENCH_DEFINE(benchSuite, benchName, benchSetup, benchTeardown, benchFixtureSetup, benchFixtureTeardown)     \
+	static void mdBench_##benchSuite##_##benchName(void);                                                              \
+	__attribute__((constructor)) static void mdBenchRegister_##benchSuite##_##benchName(void)                          \
+	{                                                                                                                  \
+		static struct MdBench bench = {                                                                                \
+			.suite			 = #benchSuite,                                                                            \
+			.name			 = #benchName,                                                                             \
+			.run			 = mdBench_##benchSuite##_##benchName,                                                     \
+			.setup			 = benchSetup,                                                                             \
+			.teardown		 = benchTeardown,                                                                          \
+			.fixtureSetup	 = benchFixtureSetup,                                                                      \
+			.fixtureTeardown = benchFixtureTeardown,                                                                   \
+			.pNext			 = 0,                                                                                      \
+		};                                                                                                             \
+		mdBenchRegister(&bench);                                                                                       \
+	}                                                                                                                  \
+	static void mdBench_##benchSuite##_##benchName(void)
+
+/**
+ * @brief Registers a benchmark, called before `main` by `MD_BENCH`: it does not allocate.
+ * @param pBench Pointer to the benchmark, must outlive the runs.
+ */
+void mdBenchRegister(struct MdBench* pBench);
+
+/**
+ * @brief Gets the registered benchmarks, in the registration order.
+ * @return The first benchmark, the others follow `pNext`.
+ */
+const struct MdBench* mdBenchGetRegistered();
+
+/**
+ * @brief Gets the default settings: every benchmark, no JSON, no baseline.
+ * @return The default settings.
+ */
+struct MdBenchConfig mdBenchGetDefaultConfig();
+
+/**
+ * @brief Reads the settings from the command line: `--filter=<text>`, `--repetitions=<count>`,
+ * `--warmup-ms=<milliseconds>`, `--min-time-ms=<milliseconds>`, `--json=<path>`, `--baseline=<path>` and
+ * `--threshold=<ratio>`. The strings are not copied.
+ * @param pConfig The settings to fill, the options which are not given are kept.
+ * @param argc The number of arguments, as given to `main`.
+ * @param argv The arguments, as given to `main`.
+ * @return MD_FALSE when an argument is unknown, the usage is then printed.
+ */
+b8 mdBenchParseArguments(struct MdBenchConfig* pConfig, i32 argc, char** argv);
+
+/**
+ * @brief Warms up and measures one benchmark.
+ * @param pBench The benchmark.
+ * @param pConfig The settings.
+ * @param pResult Receives the measure.
+ */
+void mdBenchMeasure(const struct MdBench* pBench, const struct MdBenchConfig* pConfig, struct MdBenchResult* pResult);
+
+/**
+ * @brief Writes results as JSON, the format read by `mdBenchCompareBaseline`.
+ * @param filePath The path of the file, replaced atomically.
+ * @param pResults The results.
+ * @param resultsCount The number of results.
+ * @return MD_TRUE if the file was written.
+ */
+b8 mdBenchWriteJSON(const char* filePath, const struct MdBenchResult* pResults, u32 resultsCount);
+
+/**
+ * @brief Compares results with a baseline written by `mdBenchWriteJSON` and prints the verdict of each benchmark. A
+ * benchmark fails when its median is slower than the baseline by more than `threshold` and by more than three MADs,
+ * so the noise alone does not fail it. The benchmarks missing from the baseline are skipped.
+ * @param filePath The path of the baseline.
+ * @param pResults The results.
+ * @param resultsCount The number of results.
+ * @param threshold The relative slowdown which fails, e.g. 0.1 for 10%.
+ * @return The number of failed benchmarks, `resultsCount` when the baseline cannot be read.
+ */
+u32 mdBenchCompareBaseline(const char*				   filePath,
+						   const struct MdBenchResult* pResults,
+						   u32						   resultsCount,
+						   f64						   threshold);
+
+/**
+ * @brief Measures every registered benchmark which matches the filter, prints the table, then writes the JSON and
+ * compares with the baseline when they are configured.
+ * @param pConfig The settings.
+ * @return The process exit code: 0 on success, 1 when a benchmark regressed or a file could not be used.
+ */
+i32 mdBenchRunAll(const struct MdBenchConfig* pConfig);
+
+#if __cplusplus
+}
+#endif
@@ -1,4 +1,8 @@
+#include "bench/bench.h"
 #include "containers/containers.h"
 #include "data/data.h"
+#include "jobs/jobs.h"
+#include "jobs/parallel.h"
+#include "jobs/task_graph.h"
 #include "log/log.h"
 #include "string/string.h"
\ No newline at end of file
@@ -0,0 +1,156 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "MEEDEngine/platforms/common.h"
+#include "MEEDEngine/platforms/time.h"
+
+/**
+ * @file jobs.h
+ *
+ * Work-stealing job system. A pool of worker threads, one per physical core minus the calling thread, runs the jobs
+ * submitted in batches. Each batch counts down a counter which the submitter waits on.
+ *
+ * The workers are pinned to their physical core when there are enough of them (see `mdThreadGetCpuTopology`): the SMT
+ * siblings are left to the other processes, and the threads which share an L3 cache steal from each other first.
+ *
+ * Every job runs on a fiber of a pool. A job which waits on a counter suspends its fiber, the thread runs the other
+ * jobs meanwhile, and the first thread to see the counter at zero resumes the fiber: the jobs can nest submissions and
+ * waits (generate, then light, then mesh) without blocking a worker. The resumed job may run on another thread, it
+ * must not keep thread-local state across a wait. Outside of a job, or when every fiber of the pool is in use, a
+ * waiting thread does not sleep either: it runs the queued jobs on its own stack until its counter reaches zero.
+ *
+ * The jobs are queued in three lanes, tried in this order by an idle thread:
+ * - `MD_JOB_PRIORITY_HIGH`: a shared FIFO queue, for the frame-critical work.
+ * - `MD_JOB_PRIORITY_NORMAL`: a Chase-Lev deque per thread. The owner pushes and pops at the bottom, in LIFO order
+ *   which keeps its data in the cache, the other threads steal the oldest jobs from the top of a random victim.
+ * - `MD_JOB_PRIORITY_BACKGROUND`: a shared FIFO queue, for the streaming and the generation. The workers only start
+ *   background jobs while the background time spent since `mdJobSystemBeginFrame` is within the budget, so they
+ *   cannot delay the next frame. A thread waiting on a counter ignores the budget.
+ *
+ * Without workers (single core, browser build) the jobs run on the waiting thread, inside `mdJobWait`. Without fibers
+ * (browser build) they all run on the thread stacks.
+ *
+ * @example
+ * ```c
+ * static void square(void* pUserData) { f32* pValue = (f32*)pUserData; *pValue *= *pValue; }
+ *
+ * mdJobSystemInitialize(MD_JOB_WORKERS_COUNT_DEFAULT);
+ * f32 values[64];
+ * struct MdJobDecl jobs[64];
+ * for (u32 i = 0; i < 64; ++i)
+ * {
+ *     values[i] = (f32)i;
+ *     jobs[i]   = (struct MdJobDecl){square, &values[i]};
+ * }
+ * struct MdJobCounter counter = {0};
+ * mdJobSubmit(jobs, 64, MD_JOB_PRIORITY_NORMAL, &counter);
+ * mdJobWait(&counter);
+ * mdJobSystemShutdown();
+ * ```
+ */
+
+#define MD_JOB_DEQUE_CAPACITY		 4096u		 ///< The jobs a thread queues, the overflow goes to a shared queue.
+#define MD_JOB_WORKERS_COUNT_DEFAULT 0xFFFFFFFFu ///< One worker per physical core, minus the calling thread.
+#define MD_JOB_FIBERS_COUNT			 128u		 ///< The jobs which can run or wait on a fiber at once.
+#define MD_JOB_FIBER_STACK_SIZE		 (128u * 1024u)
+
+typedef void (*MdJobFunction)(void* pUserData);
+
+/**
+ * The lanes of the jobs, see the file documentation.
+ */
+enum MdJobPriority
+{
+	MD_JOB_PRIORITY_HIGH,
+	MD_JOB_PRIORITY_NORMAL,
+	MD_JOB_PRIORITY_BACKGROUND,
+
+	MD_JOB_PRIORITY_COUNT
+};
+
+/**
+ * A job to submit: the function and its argument, copied by `mdJobSubmit`.
+ */
+struct MdJobDecl
+{
+	MdJobFunction function;
+	void*		  pUserData;
+};
+
+/**
+ * The number of unfinished jobs of the batches which were submitted with it. Zero-initialized, owned by the caller
+ * and only modified by the job system: it must outlive the wait on it.
+ */
+struct MdJobCounter
+{
+	u32 pendingCount;
+};
+
+/**
+ * @brief Starts the workers. The calling thread becomes the main thread of the job system: it has a deque and runs
+ * jobs while it waits.
+ * @param workersCount The number of worker threads, `MD_JOB_WORKERS_COUNT_DEFAULT` for one per physical core minus
+ * the calling thread, 0 to run the jobs on the waiting threads only.
+ */
+void mdJobSystemInitialize(u32 workersCount);
+
+/**
+ * @brief Stops and joins the workers. Every submitted job must have been waited on.
+ */
+void mdJobSystemShutdown();
+
+/**
+ * @brief Tells whether the job system is initialized.
+ * @return MD_TRUE between `mdJobSystemInitialize` and `mdJobSystemShutdown`.
+ */
+b8 mdJobSystemIsInitialized();
+
+/**
+ * @brief Gets the number of worker threads, without the main thread.
+ * @return The number of workers, 0 when the platform has no threads.
+ */
+u32 mdJobSystemGetWorkersCount();
+
+/**
+ * @brief Sets the time the workers spend on background jobs per frame.
+ * @param budgetTicks The budget, 0 for no limit, the default.
+ */
+void mdJobSystemSetBackgroundBudget(mdTicks budgetTicks);
+
+/**
+ * @brief Starts a frame: resets the background time spent, once per frame by the main loop.
+ */
+void mdJobSystemBeginFrame();
+
+/**
+ * @brief Queues a batch of jobs and wakes the sleeping workers. Any thread can submit, from inside a job too.
+ * @param pJobs The jobs, copied.
+ * @param jobsCount The number of jobs.
+ * @param priority The lane of the jobs.
+ * @param pCounter Increased by the number of jobs and decreased as each finishes, MD_NULL to not wait on them.
+ */
+void mdJobSubmit(const struct MdJobDecl* pJobs,
+				 u32					 jobsCount,
+				 enum MdJobPriority		 priority,
+				 struct MdJobCounter*	 pCounter);
+
+/**
+ * @brief Runs the queued jobs until every job counted by the counter has finished. The finished jobs' writes are
+ * visible to the caller after it returns.
+ * @param pCounter Pointer to the counter.
+ */
+void mdJobWait(struct MdJobCounter* pCounter);
+
+/**
+ * @brief Tells whether every job counted by the counter has finished, without waiting.
+ * @param pCounter Pointer to the counter.
+ * @return MD_TRUE when the counter is zero.
+ */
+b8 mdJobIsDone(const struct MdJobCounter* pCounter);
+
+#if __cplusplus
+}
+#endif
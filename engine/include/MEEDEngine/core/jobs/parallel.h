@@ -0,0 +1,111 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "MEEDEngine/platforms/common.h"
+
+/**
+ * @file parallel.h
+ *
+ * Data-parallel loops on the job system: the range is split in chunks of at least `grainSize` elements, one job per
+ * chunk, and the calling thread runs chunks too until the loop is done. The functions receive a whole chunk rather
+ * than an element, so the loop body stays a tight loop the compiler can vectorize.
+ *
+ * A range which fits in one grain runs serially on the calling thread, without any job. A grain size of 0 chooses
+ * one: about `MD_PARALLEL_CHUNKS_PER_THREAD` chunks per thread, no smaller than `MD_PARALLEL_MIN_AUTO_GRAIN_SIZE`.
+ * The chunks are also never more than `MD_PARALLEL_MAX_CHUNKS_PER_THREAD` per thread: the grain grows instead.
+ *
+ * The first parallel loop starts the job system with the default workers if it is not initialized, once even when
+ * several threads start loops together. The thread of that loop becomes its main thread. `mdParallelShutdown` stops a
+ * job system started this way.
+ *
+ * @example
+ * ```c
+ * static void scale(u64 begin, u64 end, void* pUserData)
+ * {
+ *     f32* pValues = (f32*)pUserData;
+ *     for (u64 i = begin; i < end; ++i)
+ *     {
+ *         pValues[i] *= 2.0f;
+ *     }
+ * }
+ *
+ * mdParallelFor(0, valuesCount, 0, scale, pValues);
+ * ```
+ */
+
+#define MD_PARALLEL_CHUNKS_PER_THREAD	  4u	///< The automatic grain: enough chunks for the stealing to even out.
+#define MD_PARALLEL_MAX_CHUNKS_PER_THREAD 64u	///< Bounds the jobs of a loop with a too small grain.
+#define MD_PARALLEL_MIN_AUTO_GRAIN_SIZE	  1024u ///< Smaller automatic chunks cost more to schedule than to run.
+
+/**
+ * Runs the loop body over the elements [begin, end) of a chunk.
+ */
+typedef void (*MdParallelForFunction)(u64 begin, u64 end, void* pUserData);
+
+/**
+ * Accumulates the elements [begin, end) of a chunk into `pPartial`, a value initialized to the identity.
+ */
+typedef void (*MdParallelReduceFunction)(u64 begin, u64 end, void* pPartial, void* pUserData);
+
+/**
+ * Combines `pPartial` into `pAccumulator`. It must be associative, it need not be commutative: the partials are
+ * combined in the order of their chunks.
+ */
+typedef void (*MdParallelCombineFunction)(void* pAccumulator, const void* pPartial, void* pUserData);
+
+/**
+ * @brief Runs a loop body over a range, in parallel chunks.
+ * @param begin The first element.
+ * @param end The element past the last one.
+ * @param grainSize The minimum number of elements of a chunk, 0 to choose one.
+ * @param function The loop body, called once per chunk.
+ * @param pUserData Given to the function.
+ */
+void mdParallelFor(u64 begin, u64 end, u64 grainSize, MdParallelForFunction function, void* pUserData);
+
+/**
+ * @brief Reduces a range to a single value, in parallel chunks: each chunk is reduced to a partial value, then the
+ * partials are combined in order.
+ * @param begin The first element.
+ * @param end The element past the last one.
+ * @param grainSize The minimum number of elements of a chunk, 0 to choose one.
+ * @param reduce Reduces a chunk to its partial value.
+ * @param combine Combines two values.
+ * @param pIdentity The identity of the combination (0 for a sum), copied into every partial before its reduction.
+ * @param valueSize The size of a value in bytes.
+ * @param pResult Receives the value, the identity for an empty range.
+ * @param pUserData Given to the functions.
+ */
+void mdParallelReduce(u64						 begin,
+					  u64						 end,
+					  u64						 grainSize,
+					  MdParallelReduceFunction	 reduce,
+					  MdParallelCombineFunction	 combine,
+					  const void*				 pIdentity,
+					  mdSize					 valueSize,
+					  void*						 pResult,
+					  void*						 pUserData);
+
+/**
+ * @brief Computes the exclusive prefix sum of an array in parallel: `pOutput[i]` is the sum of the inputs before `i`.
+ * Two passes over the chunks: their sums, then their prefix sums offset by the sum of the chunks before them.
+ * @param pInput The values to sum.
+ * @param pOutput Receives the prefix sums, may be `pInput` for an in-place scan.
+ * @param count The number of values.
+ * @param grainSize The minimum number of values of a chunk, 0 to choose one.
+ * @return The sum of every value, the prefix sum past the last one.
+ */
+u32 mdParallelScan(const u32* pInput, u32* pOutput, u64 count, u64 grainSize);
+
+/**
+ * @brief Stops the job system if the parallel loops started it, a job system initialized by its owner is left
+ * running. The next loop starts it again.
+ */
+void mdParallelShutdown();
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,136 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "MEEDEngine/core/jobs/jobs.h"
+#include "MEEDEngine/platforms/common.h"
+#include "MEEDEngine/platforms/time.h"
+
+/**
+ * @file task_graph.h
+ *
+ * A frame described as a graph of tasks, built once and executed every frame on the job system. Each task declares
+ * the resources it reads and writes, as bits of a mask the application numbers: a task runs after every task declared
+ * before it which writes what it reads or writes, or reads what it writes. The other tasks run in parallel.
+ *
+ * A task marked `isOverlapped` is not waited on by its frame: it finishes during the next execution, in parallel with
+ * the tasks of the next frame which do not conflict with it. The render submission of frame N-1 then overlaps the
+ * simulation of frame N, as long as the simulation does not write what the rendering reads. The next instance of a
+ * task always runs after the previous one, and an execution returns once the previous frame is done: at most two
+ * frames are in flight.
+ *
+ * The tasks marked `isMainThread` run on the thread which executes the graph, for the window and the graphics APIs
+ * which are bound to it. The thread runs the other jobs while it waits for them.
+ *
+ * Each execution measures the tasks: their duration, and their place on the critical path, the longest chain of
+ * dependent tasks which bounds the frame whatever the number of threads.
+ *
+ * @example
+ * ```c
+ * #define RESOURCE_INPUT MD_TASK_RESOURCE(0)
+ * #define RESOURCE_WORLD MD_TASK_RESOURCE(1)
+ * #define RESOURCE_FRAME MD_TASK_RESOURCE(2) // The state the rendering reads, extracted from the world.
+ *
+ * struct MdTaskDecl tasks[] = {
+ *     {"Input", pollInput, MD_NULL, 0, RESOURCE_INPUT, MD_TRUE, MD_FALSE},
+ *     {"Simulation", simulate, pWorld, RESOURCE_INPUT, RESOURCE_WORLD, MD_FALSE, MD_FALSE},
+ *     {"Extract", extract, pWorld, RESOURCE_WORLD, RESOURCE_FRAME, MD_FALSE, MD_FALSE},
+ *     {"Render", render, MD_NULL, RESOURCE_FRAME, 0, MD_TRUE, MD_TRUE},
+ * };
+ * struct MdTaskGraph* pGraph = mdTaskGraphCreate(tasks, MD_ARRAY_SIZE(tasks));
+ * while (isRunning)
+ * {
+ *     mdTaskGraphExecute(pGraph);
+ * }
+ * mdTaskGraphWaitIdle(pGraph);
+ * mdTaskGraphDestroy(pGraph);
+ * ```
+ */
+
+#define MD_TASK_GRAPH_MAX_TASKS		64u ///< The dependencies of a task are a mask of the tasks.
+#define MD_TASK_GRAPH_MAX_RESOURCES 64u ///< The accesses of a task are a mask of the resources.
+
+/**
+ * The bit of a resource in the access masks of the tasks.
+ */
+#define MD_TASK_RESOURCE(index) (1ull << (index))
+
+/**
+ * A task of a graph, copied by `mdTaskGraphCreate`.
+ */
+struct MdTaskDecl
+{
+	const char*	  name;			///< Shown by the profiler, must outlive the graph.
+	MdJobFunction function;		///< Runs the task, once per execution.
+	void*		  pUserData;	///< Given to the function.
+	u64			  reads;		///< The resources the task reads, `MD_TASK_RESOURCE` bits.
+	u64			  writes;		///< The resources the task writes.
+	b8			  isMainThread;	///< Runs on the thread which executes the graph.
+	b8			  isOverlapped;	///< Finishes during the next execution, see the file documentation.
+};
+
+/**
+ * The measures of a task, updated once its frame is done.
+ */
+struct MdTaskStats
+{
+	mdTicks durationTicks;		  ///< The run time of the task in the last measured frame.
+	mdTicks averageDurationTicks; ///< The run time averaged over the last frames (exponential moving average).
+	mdTicks pathTicks;			  ///< The longest chain of dependent tasks ending with this one, included.
+	mdTicks slackTicks;			  ///< How much longer the task could run without lengthening the critical path.
+	u64		criticalFramesCount;  ///< The frames in which the task was on the critical path.
+};
+
+/**
+ * An opaque task graph.
+ */
+struct MdTaskGraph;
+
+/**
+ * @brief Builds a task graph: orders the tasks which conflict, in the order of their declaration. The job system
+ * must be initialized.
+ * @param pTasks The tasks, copied.
+ * @param tasksCount The number of tasks, at most `MD_TASK_GRAPH_MAX_TASKS`.
+ * @return Pointer to the task graph.
+ */
+struct MdTaskGraph* mdTaskGraphCreate(const struct MdTaskDecl* pTasks, u32 tasksCount);
+
+/**
+ * @brief Executes the graph for a frame: starts its tasks, then runs the main thread tasks and the other jobs until
+ * the previous frame and the tasks of this one which are not overlapped are done. Called by a single thread.
+ * @param pGraph Pointer to the task graph.
+ */
+void mdTaskGraphExecute(struct MdTaskGraph* pGraph);
+
+/**
+ * @brief Waits for the overlapped tasks of the last execution, before the resources they use are destroyed.
+ * @param pGraph Pointer to the task graph.
+ */
+void mdTaskGraphWaitIdle(struct MdTaskGraph* pGraph);
+
+/**
+ * @brief Gets the measures of a task.
+ * @param pGraph Pointer to the task graph.
+ * @param taskIndex The index of the task in the declaration.
+ * @return The measures of the task, all zero before its first frame is done.
+ */
+struct MdTaskStats mdTaskGraphGetTaskStats(const struct MdTaskGraph* pGraph, u32 taskIndex);
+
+/**
+ * @brief Gets the critical path of the last measured frame: the duration of the frame with unlimited threads.
+ * @param pGraph Pointer to the task graph.
+ * @return The length of the critical path.
+ */
+mdTicks mdTaskGraphGetCriticalPathTicks(const struct MdTaskGraph* pGraph);
+
+/**
+ * @brief Destroys a task graph, which has no task in flight (see `mdTaskGraphWaitIdle`).
+ * @param pGraph Pointer to the task graph.
+ */
+void mdTaskGraphDestroy(struct MdTaskGraph* pGraph);
+
+#if __cplusplus
+}
+#endif
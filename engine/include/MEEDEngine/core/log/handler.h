@@ -19,9 +19,10 @@ extern "C" {
  */
 struct MdLogRecord
 {
-	enum MdLogLevel level; ///< The log level of the message.
-	const char*		file;  ///< The source file where the log message originated.
-	u32				line;  ///< The line number in the source file where the log message originated.
+	enum MdLogCategory category; ///< The category which owns the message.
+	enum MdLogLevel	   level;	 ///< The log level of the message.
+	const char*		   file;	 ///< The source file where the log message originated.
+	u32				   line;	 ///< The line number in the source file where the log message originated.
 
 	char message[MD_LOG_MESSAGE_MAX_LENGTH]; ///< The log message.
 };
@@ -43,6 +44,12 @@ typedef void (*MdLogHandlerRecordHandleCallback)(const struct MdLogRecord* pReco
  */
 typedef void (*MdLogHandlerShutdownCallback)();
 
+/**
+ * The log handler flush callback type, called by `mdLogFlush` so a handler which buffers the records can write them
+ * even when no record arrives.
+ */
+typedef void (*MdLogHandlerFlushCallback)();
+
 /**
  * The log handler structure.
  */
@@ -51,6 +58,7 @@ struct MdLogHandler
 	MdLogHandlerInitCallback		 init;		   ///< The initialization callback.
 	MdLogHandlerRecordHandleCallback recordHandle; ///< The log record callback.
 	MdLogHandlerShutdownCallback	 shutdown;	   ///< The shutdown callback.
+	MdLogHandlerFlushCallback		 flush;		   ///< The flush callback, `MD_NULL` when nothing is buffered.
 	enum MdLogLevel					 level;		   ///< The log level threshold for this handler.
 };
 
@@ -66,6 +74,66 @@ void mdInitializeConsoleLogHandler(enum MdLogLevel level);
  */
 void mdShutdownConsoleLogHandler();
 
+/**
+ * The moments when the file log handler forces the written data to reach the storage device.
+ */
+enum MdFileLogSyncPolicy
+{
+	MD_FILE_LOG_SYNC_POLICY_NONE,	   ///< Never sync, the operating system decides when the data is persisted.
+	MD_FILE_LOG_SYNC_POLICY_ON_ROTATE, ///< Sync before a log file is rotated or closed.
+	MD_FILE_LOG_SYNC_POLICY_ON_FLUSH,  ///< Sync after every flush of the user-space buffer.
+};
+
+/**
+ * The configuration of the file log handler. Use `mdFileLogHandlerGetDefaultConfig` for the default values.
+ */
+struct MdFileLogHandlerConfig
+{
+	const char* filePath; ///< The path of the active log file, the rotated files get the ".1", ".2", ... suffixes.
+
+	u32				bufferSize;			  ///< The size of the user-space buffer in bytes, flushed when it is full.
+	u32				flushIntervalSeconds; ///< The buffer is flushed when it is older than this value, 0 disables it.
+	enum MdLogLevel flushLevel;			  ///< The records at or above this level are flushed immediately.
+
+	u64 maxFileSize;			 ///< The active file is rotated when it grows above this size, 0 disables it.
+	u32 rotationIntervalSeconds; ///< The active file is rotated when it is older than this value, 0 disables it.
+	u32 maxRetainedFiles;		 ///< The number of rotated files which are kept, the oldest ones are removed.
+
+	enum MdFileLogSyncPolicy syncPolicy; ///< When the written data is forced to the storage device.
+};
+
+extern struct MdLogHandler* MD_LOG_FILE_HANDLER; ///< The file log handler instance.
+
+/**
+ * Gets the default configuration of the file log handler: 1 MB buffer flushed every second or on errors,
+ * 64 MB rotation size with 5 retained files and syncing on rotation only.
+ *
+ * @param filePath The path of the active log file.
+ * @return The default configuration for the path.
+ */
+struct MdFileLogHandlerConfig mdFileLogHandlerGetDefaultConfig(const char* filePath);
+
+/**
+ * Initializes the file log handler. The records are collected in a user-space buffer and written with a single
+ * vectored write when the buffer is full, too old or when an important record arrives. The age of the buffer is
+ * checked by each record and by `mdLogFlush`. An existing file at the path is rotated so the logs of the previous
+ * run are kept. The records can be logged from any thread.
+ *
+ * @param level The log level threshold of the handler.
+ * @param pConfig The configuration of the handler, copied by the handler.
+ */
+void mdInitializeFileLogHandler(enum MdLogLevel level, const struct MdFileLogHandlerConfig* pConfig);
+
+/**
+ * Writes every buffered record of the file log handler to the active file, whatever the age of the buffer.
+ */
+void mdFileLogHandlerFlush();
+
+/**
+ * Shuts down the file log handler, the buffered records are flushed and the active file is closed.
+ */
+void mdShutdownFileLogHandler();
+
 #if __cplusplus
 }
 #endif
\ No newline at end of file
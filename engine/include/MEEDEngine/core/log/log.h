@@ -1,10 +1,150 @@
+#pragma once
+
 #include "handler.h"
 #include "logger.h"
 #include "types.h"
 
-#define MD_LOG_VERBOSE(format, ...) mdLogPrint(MD_LOG_LEVEL_VERBOSE, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define MD_LOG_DEBUG(format, ...)	mdLogPrint(MD_LOG_LEVEL_DEBUG, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define MD_LOG_INFO(format, ...)	mdLogPrint(MD_LOG_LEVEL_INFO, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define MD_LOG_WARNING(format, ...) mdLogPrint(MD_LOG_LEVEL_WARNING, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define MD_LOG_ERROR(format, ...)	mdLogPrint(MD_LOG_LEVEL_ERROR, __FILE__, __LINE__, format, ##__VA_ARGS__)
-#define MD_LOG_FATAL(format, ...)	mdLogPrint(MD_LOG_LEVEL_FATAL, __FILE__, __LINE__, format, ##__VA_ARGS__)
\ No newline at end of file
+/**
+ * @file log.h
+ * The logging macros of the `MEEDEngine`.
+ *
+ * Statements whose level is below `MD_LOG_COMPILE_LEVEL` are removed by the preprocessor, the others only
+ * evaluate their arguments when the runtime threshold of their category (see `mdLogSetCategoryLevel`) allows it.
+ *
+ * @example
+ * ```c
+ * mdLogSetCategoryLevel(MD_LOG_CATEGORY_RENDER, MD_LOG_LEVEL_VERBOSE);
+ * MD_LOG_VERBOSE_CAT(MD_LOG_CATEGORY_RENDER, "Frame %u recorded", frameIndex);
+ * MD_LOG_INFO("Engine started"); // MD_LOG_CATEGORY_ENGINE
+ * ```
+ *
+ * The `_THROTTLED` variants forward at most `maxPerSecond` records per second from their call site, the dropped
+ * records are not formatted and are reported once as "message repeated N times in last Ns", by the next record of
+ * the statement or by `mdLogFlush`.
+ *
+ * @example
+ * ```c
+ * MD_LOG_WARNING_THROTTLED_CAT(MD_LOG_CATEGORY_RENDER, 1, "Validation: %s", pMessage);
+ * ```
+ */
+
+/**
+ * The lowest log level which is compiled into the binary, the numeric values follow `enum MdLogLevel`
+ * (0 = VERBOSE ... 5 = FATAL, 6 = nothing). Can be overridden with a compile definition.
+ */
+#ifndef MD_LOG_COMPILE_LEVEL
+#if MD_DEBUG
+#define MD_LOG_COMPILE_LEVEL 0
+#else
+#define MD_LOG_COMPILE_LEVEL 2
+#endif
+#endif
+
+#define _MD_LOG(category, level, format, ...)                                                                          \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		if (MD_LOG_IS_ENABLED(category, level))                                                                        \
+		{                                                                                                              \
+			mdLogPrint((struct MdLogCallSite*)0, category, level, __FILE__, __LINE__, format, ##__VA_ARGS__);          \
+		}                                                                                                              \
+	} while (0)
+
+#define _MD_LOG_THROTTLED(category, level, maxPerSecond, format, ...)                                                  \
+	do                                                                                                                 \
+	{                                                                                                                  \
+		static struct MdLogCallSite _mdLogCallSite = {(maxPerSecond), 0, 0, 0};                                        \
+		if (MD_LOG_IS_ENABLED(category, level))                                                                        \
+		{                                                                                                              \
+			mdLogPrint(&_mdLogCallSite, category, level, __FILE__, __LINE__, format, ##__VA_ARGS__);                   \
+		}                                                                                                              \
+	} while (0)
+
+#define _MD_LOG_DISABLED(category, format, ...)                                                                        \
+	do                                                                                                                 \
+	{                                                                                                                  \
+	} while (0)
+
+#define _MD_LOG_THROTTLED_DISABLED(category, maxPerSecond, format, ...)                                                \
+	do                                                                                                                 \
+	{                                                                                                                  \
+	} while (0)
+
+#if MD_LOG_COMPILE_LEVEL <= 0
+#define MD_LOG_VERBOSE_CAT(category, format, ...) _MD_LOG(category, MD_LOG_LEVEL_VERBOSE, format, ##__VA_ARGS__)
+#define MD_LOG_VERBOSE_THROTTLED_CAT(category, maxPerSecond, format, ...)                                              \
+	_MD_LOG_THROTTLED(category, MD_LOG_LEVEL_VERBOSE, maxPerSecond, format, ##__VA_ARGS__)
+#else
+#define MD_LOG_VERBOSE_CAT(category, format, ...) _MD_LOG_DISABLED(category, format, ##__VA_ARGS__)
+#define MD_LOG_VERBOSE_THROTTLED_CAT(category, maxPerSecond, format, ...)                                              \
+	_MD_LOG_THROTTLED_DISABLED(category, maxPerSecond, format, ##__VA_ARGS__)
+#endif
+
+#if MD_LOG_COMPILE_LEVEL <= 1
+#define MD_LOG_DEBUG_CAT(category, format, ...) _MD_LOG(category, MD_LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#define MD_LOG_DEBUG_THROTTLED_CAT(category, maxPerSecond, format, ...)                                                \
+	_MD_LOG_THROTTLED(category, MD_LOG_LEVEL_DEBUG, maxPerSecond, format, ##__VA_ARGS__)
+#else
+#define MD_LOG_DEBUG_CAT(category, format, ...) _MD_LOG_DISABLED(category, format, ##__VA_ARGS__)
+#define MD_LOG_DEBUG_THROTTLED_CAT(category, maxPerSecond, format, ...)                                                \
+	_MD_LOG_THROTTLED_DISABLED(category, maxPerSecond, format, ##__VA_ARGS__)
+#endif
+
+#if MD_LOG_COMPILE_LEVEL <= 2
+#define MD_LOG_INFO_CAT(category, format, ...) _MD_LOG(category, MD_LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#define MD_LOG_INFO_THROTTLED_CAT(category, maxPerSecond, format, ...)                                                 \
+	_MD_LOG_THROTTLED(category, MD_LOG_LEVEL_INFO, maxPerSecond, format, ##__VA_ARGS__)
+#else
+#define MD_LOG_INFO_CAT(category, format, ...) _MD_LOG_DISABLED(category, format, ##__VA_ARGS__)
+#define MD_LOG_INFO_THROTTLED_CAT(category, maxPerSecond, format, ...)                                                 \
+	_MD_LOG_THROTTLED_DISABLED(category, maxPerSecond, format, ##__VA_ARGS__)
+#endif
+
+#if MD_LOG_COMPILE_LEVEL <= 3
+#define MD_LOG_WARNING_CAT(category, format, ...) _MD_LOG(category, MD_LOG_LEVEL_WARNING, format, ##__VA_ARGS__)
+#define MD_LOG_WARNING_THROTTLED_CAT(category, maxPerSecond, format, ...)                                              \
+	_MD_LOG_THROTTLED(category, MD_LOG_LEVEL_WARNING, maxPerSecond, format, ##__VA_ARGS__)
+#else
+#define MD_LOG_WARNING_CAT(category, format, ...) _MD_LOG_DISABLED(category, format, ##__VA_ARGS__)
+#define MD_LOG_WARNING_THROTTLED_CAT(category, maxPerSecond, format, ...)                                              \
+	_MD_LOG_THROTTLED_DISABLED(category, maxPerSecond, format, ##__VA_ARGS__)
+#endif
+
+#if MD_LOG_COMPILE_LEVEL <= 4
+#define MD_LOG_ERROR_CAT(category, format, ...) _MD_LOG(category, MD_LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#define MD_LOG_ERROR_THROTTLED_CAT(category, maxPerSecond, format, ...)                                                \
+	_MD_LOG_THROTTLED(category, MD_LOG_LEVEL_ERROR, maxPerSecond, format, ##__VA_ARGS__)
+#else
+#define MD_LOG_ERROR_CAT(category, format, ...) _MD_LOG_DISABLED(category, format, ##__VA_ARGS__)
+#define MD_LOG_ERROR_THROTTLED_CAT(category, maxPerSecond, format, ...)                                                \
+	_MD_LOG_THROTTLED_DISABLED(category, maxPerSecond, format, ##__VA_ARGS__)
+#endif
+
+#if MD_LOG_COMPILE_LEVEL <= 5
+#define MD_LOG_FATAL_CAT(category, format, ...) _MD_LOG(category, MD_LOG_LEVEL_FATAL, format, ##__VA_ARGS__)
+#define MD_LOG_FATAL_THROTTLED_CAT(category, maxPerSecond, format, ...)                                                \
+	_MD_LOG_THROTTLED(category, MD_LOG_LEVEL_FATAL, maxPerSecond, format, ##__VA_ARGS__)
+#else
+#define MD_LOG_FATAL_CAT(category, format, ...) _MD_LOG_DISABLED(category, format, ##__VA_ARGS__)
+#define MD_LOG_FATAL_THROTTLED_CAT(category, maxPerSecond, format, ...)                                                \
+	_MD_LOG_THROTTLED_DISABLED(category, maxPerSecond, format, ##__VA_ARGS__)
+#endif
+
+#define MD_LOG_VERBOSE(format, ...) MD_LOG_VERBOSE_CAT(MD_LOG_CATEGORY_ENGINE, format, ##__VA_ARGS__)
+#define MD_LOG_DEBUG(format, ...)	MD_LOG_DEBUG_CAT(MD_LOG_CATEGORY_ENGINE, format, ##__VA_ARGS__)
+#define MD_LOG_INFO(format, ...)	MD_LOG_INFO_CAT(MD_LOG_CATEGORY_ENGINE, format, ##__VA_ARGS__)
+#define MD_LOG_WARNING(format, ...) MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_ENGINE, format, ##__VA_ARGS__)
+#define MD_LOG_ERROR(format, ...)	MD_LOG_ERROR_CAT(MD_LOG_CATEGORY_ENGINE, format, ##__VA_ARGS__)
+#define MD_LOG_FATAL(format, ...)	MD_LOG_FATAL_CAT(MD_LOG_CATEGORY_ENGINE, format, ##__VA_ARGS__)
+
+#define MD_LOG_VERBOSE_THROTTLED(maxPerSecond, format, ...)                                                            \
+	MD_LOG_VERBOSE_THROTTLED_CAT(MD_LOG_CATEGORY_ENGINE, maxPerSecond, format, ##__VA_ARGS__)
+#define MD_LOG_DEBUG_THROTTLED(maxPerSecond, format, ...)                                                              \
+	MD_LOG_DEBUG_THROTTLED_CAT(MD_LOG_CATEGORY_ENGINE, maxPerSecond, format, ##__VA_ARGS__)
+#define MD_LOG_INFO_THROTTLED(maxPerSecond, format, ...)                                                               \
+	MD_LOG_INFO_THROTTLED_CAT(MD_LOG_CATEGORY_ENGINE, maxPerSecond, format, ##__VA_ARGS__)
+#define MD_LOG_WARNING_THROTTLED(maxPerSecond, format, ...)                                                            \
+	MD_LOG_WARNING_THROTTLED_CAT(MD_LOG_CATEGORY_ENGINE, maxPerSecond, format, ##__VA_ARGS__)
+#define MD_LOG_ERROR_THROTTLED(maxPerSecond, format, ...)                                                              \
+	MD_LOG_ERROR_THROTTLED_CAT(MD_LOG_CATEGORY_ENGINE, maxPerSecond, format, ##__VA_ARGS__)
+#define MD_LOG_FATAL_THROTTLED(maxPerSecond, format, ...)                                                              \
+	MD_LOG_FATAL_THROTTLED_CAT(MD_LOG_CATEGORY_ENGINE, maxPerSecond, format, ##__VA_ARGS__)
@@ -8,9 +8,29 @@ extern "C" {
 #include "handler.h"
 #include "types.h"
 
+/**
+ * The runtime thresholds of every log category, indexed by `enum MdLogCategory` and storing `enum MdLogLevel`
+ * values. Only read through `MD_LOG_IS_ENABLED` and only modified through `mdLogSetCategoryLevel`.
+ */
+extern i32 g_mdLogCategoryLevels[MD_LOG_CATEGORY_COUNT];
+
+#if defined(_MSC_VER)
+#define _MD_LOG_LOAD_LEVEL(pLevel) (*(volatile const i32*)(pLevel))
+#else
+#define _MD_LOG_LOAD_LEVEL(pLevel) __atomic_load_n((pLevel), __ATOMIC_RELAXED)
+#endif
+
+/**
+ * Check whether a message of the `level` inside the `category` passes the runtime threshold. Only a relaxed atomic
+ * load is performed, so the check can be done before evaluating any argument of the log statement.
+ */
+#define MD_LOG_IS_ENABLED(category, level) ((i32)(level) >= _MD_LOG_LOAD_LEVEL(&g_mdLogCategoryLevels[(category)]))
+
 /**
  * Initializes the logging system.
  * Must be called before using any logging functions.
+ *
+ * @param level The initial threshold of every log category.
  */
 void mdLogInitialize(enum MdLogLevel level);
 
@@ -22,18 +42,72 @@ void mdLogInitialize(enum MdLogLevel level);
 void mdLogAddHandler(const struct MdLogHandler* pHandler);
 
 /**
- * Logs a message with the specified log level.
+ * Modifies the runtime threshold of a single log category, messages below the threshold are dropped
+ * before their arguments are evaluated. Can be called from any thread at any time.
  *
+ * @param category The category to modify.
+ * @param level The new threshold, `MD_LOG_LEVEL_NONE` disables the category.
+ */
+void mdLogSetCategoryLevel(enum MdLogCategory category, enum MdLogLevel level);
+
+/**
+ * Retrieves the current runtime threshold of a log category.
+ *
+ * @param category The category to query.
+ * @return The current threshold of the category.
+ */
+enum MdLogLevel mdLogGetCategoryLevel(enum MdLogCategory category);
+
+/**
+ * Modifies the runtime threshold of every log category at once.
+ *
+ * @param level The new threshold, `MD_LOG_LEVEL_NONE` disables all categories.
+ */
+void mdLogSetAllCategoriesLevel(enum MdLogLevel level);
+
+/**
+ * Retrieves the printable name of a log category (e.g. "RENDER").
+ *
+ * @param category The category to query.
+ * @return The name of the category as a null-terminated string.
+ */
+const char* mdLogGetCategoryName(enum MdLogCategory category);
+
+/**
+ * Logs a message with the specified category and log level. Prefer the `MD_LOG_*` macros which check the
+ * compile-time and runtime thresholds before calling this function.
+ *
+ * When a call site is given, the records above its `maxPerSecond` limit are counted without being formatted or
+ * forwarded. The first record of a later window reports the count as "message repeated N times in last Ns", N
+ * seconds being the time since the window of the dropped records started, before being handled itself. The count
+ * of a statement which is not called again is reported by `mdLogFlush`.
+ *
+ * @param pCallSite The throttling state of the calling statement, or `MD_NULL` to forward every record.
+ * @param category The category which owns the message.
  * @param level The log level of the message.
  * @param file The source file where the log message originated.
  * @param line The line number in the source file where the log message originated.
  * @param format The format string (printf-style) for the log message.
  * @param ... Additional arguments for the format string.
  */
-void mdLogPrint(enum MdLogLevel level, const char* file, u32 line, const char* format, ...);
+void mdLogPrint(struct MdLogCallSite* pCallSite,
+				enum MdLogCategory	  category,
+				enum MdLogLevel		  level,
+				const char*			  file,
+				u32					  line,
+				const char*			  format,
+				...);
+
+/**
+ * Reports the records dropped by the throttled call sites since their last summary, as "message repeated N times in
+ * last Ns", then calls the `flush` callback of every handler. Called by `mdLogShutdown`, and worth calling
+ * periodically (e.g. once per frame) so a burst which stopped is not only reported at shutdown and the buffered
+ * handlers honor their flush interval when no record arrives.
+ */
+void mdLogFlush();
 
 /**
- * Shuts down the logging system.
+ * Shuts down the logging system, after reporting the pending dropped records (`mdLogFlush`).
  * Should be called when logging is no longer needed.
  */
 void mdLogShutdown();
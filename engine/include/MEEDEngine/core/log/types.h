@@ -5,6 +5,7 @@ extern "C" {
 #endif
 
 #include "MEEDEngine/platforms/common.h"
+#include "MEEDEngine/platforms/time.h"
 
 /**
  * Enumeration of log levels used for categorizing log messages.
@@ -17,6 +18,44 @@ enum MdLogLevel
 	MD_LOG_LEVEL_WARNING, ///< Indication of potential issues or important situations that are not errors.
 	MD_LOG_LEVEL_ERROR,	  ///< Errors that might still allow the application to continue running.
 	MD_LOG_LEVEL_FATAL,	  ///< Severe errors that will presumably lead the application to abort.
+	MD_LOG_LEVEL_NONE,	  ///< Not a message level, used as a threshold for disabling every message.
+};
+
+/**
+ * The subsystems which own the log messages. Each category has its own runtime threshold so the verbose
+ * logging can be enabled for one subsystem without paying the formatting cost for the others.
+ */
+enum MdLogCategory
+{
+	MD_LOG_CATEGORY_ENGINE,	  ///< General engine messages, used by the `MD_LOG_*` macros without category.
+	MD_LOG_CATEGORY_CORE,	  ///< Containers, strings and other core utilities.
+	MD_LOG_CATEGORY_PLATFORM, ///< Platform layer (files, windows, memory, time).
+	MD_LOG_CATEGORY_RENDER,	  ///< Rendering module (Vulkan, OpenGL).
+	MD_LOG_CATEGORY_APP,	  ///< Messages coming from the application which uses the engine.
+	MD_LOG_CATEGORY_COUNT
+};
+
+/**
+ * The state of one throttled log statement. Every `MD_LOG_*_THROTTLED` statement owns a static instance, so the
+ * limit is applied per call site and not per message text. Only modified by the logger, the counters through atomic
+ * operations since any thread can log.
+ *
+ * The first throttled record registers the call site in the logger, which reports its dropped records on
+ * `mdLogFlush`: a call site must outlive the logging system or its next `mdLogShutdown`.
+ */
+struct MdLogCallSite
+{
+	u32		maxPerSecond;	 ///< The number of records forwarded to the handlers inside one window, 0 for no limit.
+	mdTicks windowStart;	 ///< When the current window started, on the monotonic clock.
+	u32		emittedCount;	 ///< The number of records forwarded inside the current window.
+	u32		suppressedCount; ///< The number of records dropped and not reported yet.
+
+	u32					  isRegistered; ///< Set once the call site is in the registry of the logger.
+	enum MdLogCategory	  category;		///< The category of the statement, for its summary records.
+	enum MdLogLevel		  level;		///< The level of the statement.
+	const char*			  file;			///< The source file of the statement.
+	u32					  line;			///< The line of the statement.
+	struct MdLogCallSite* pNext;		///< The next call site of the registry.
 };
 
 #if __cplusplus
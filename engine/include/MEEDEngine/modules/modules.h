@@ -1,2 +1,3 @@
 #include "release_stack/release_stack.h"
-#include "render/render.h"
\ No newline at end of file
+#include "render/render.h"
+#include "voxel/voxel.h"
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+#include "MEEDEngine/platforms/platforms.h"
+
+/**
+ * @file frame_stats.h
+ * Breaks every frame down into the CPU phases of the renderer, measured by the backends around their blocking calls,
+ * next to the GPU duration of the frame when the backend supports timestamps. Each phase keeps its statistics and a
+ * histogram over a rolling window of frames, which tells where the frames go without an external profiler:
+ * - a long `MD_FRAME_PHASE_WAIT_FENCE` means the CPU waits for the GPU to finish an older frame (GPU-bound),
+ * - a long `MD_FRAME_PHASE_ACQUIRE` or `MD_FRAME_PHASE_PRESENT` means the CPU waits for the display (vsync-bound),
+ * - otherwise the frame is spent recording or outside the renderer (CPU-bound).
+ *
+ * The renderer initializes the statistics with `mdRenderInitialize` and records the phases every frame.
+ */
+
+/**
+ * The measured phases of a frame.
+ */
+enum MdFramePhase
+{
+	MD_FRAME_PHASE_WAIT_FENCE, ///< Blocked until the GPU released the resources of the frame (`vkWaitForFences`).
+	MD_FRAME_PHASE_ACQUIRE,	   ///< Blocked until a swapchain image is available (`vkAcquireNextImageKHR`).
+	MD_FRAME_PHASE_RECORD,	   ///< Recording the commands, from the start of the frame to its submission.
+	MD_FRAME_PHASE_SUBMIT,	   ///< Submitting the commands (`vkQueueSubmit`).
+	MD_FRAME_PHASE_PRESENT,	   ///< Presenting the image (`vkQueuePresentKHR`, `glfwSwapBuffers` with OpenGL).
+	MD_FRAME_PHASE_GPU,		   ///< The GPU execution of a previous frame, read from timestamp queries (Vulkan only).
+	MD_FRAME_PHASE_FRAME,	   ///< The whole frame, from the end of the previous presentation to the end of this one.
+	MD_FRAME_PHASE_COUNT,
+};
+
+/**
+ * What limits the frame rate, deduced from the phases.
+ */
+enum MdFrameBound
+{
+	MD_FRAME_BOUND_UNKNOWN, ///< No frame was measured yet.
+	MD_FRAME_BOUND_CPU,		///< The CPU rarely waits, the frame is spent recording or in the application.
+	MD_FRAME_BOUND_GPU,		///< The CPU mostly waits for the fences of the previous frames.
+	MD_FRAME_BOUND_VSYNC,	///< The CPU mostly waits for the swapchain images or the presentation.
+};
+
+#define MD_FRAME_STATS_DEFAULT_WINDOW	 MD_FRAME_TIMER_DEFAULT_WINDOW
+#define MD_FRAME_STATS_HISTOGRAM_BUCKETS 12u ///< The last bucket has no upper bound.
+
+/**
+ * The upper bound of the first histogram bucket, each following bucket doubles it: 0.125 ms, 0.25 ms ... 128 ms.
+ */
+#define MD_FRAME_STATS_HISTOGRAM_FIRST_BOUND_MICROSECONDS 125u
+
+/**
+ * The statistics of a phase over the rolling window.
+ */
+struct MdFramePhaseStats
+{
+	struct MdFrameTimerStats timing; ///< The duration of the phase: last, average, min, max and percentiles.
+	u32 histogram[MD_FRAME_STATS_HISTOGRAM_BUCKETS]; ///< The number of frames of the window in each bucket.
+};
+
+/**
+ * @brief Initializes the frame statistics, called by `mdRenderInitialize`.
+ * @param windowSize The number of frames of the rolling window, 0 for `MD_FRAME_STATS_DEFAULT_WINDOW`.
+ */
+void mdFrameStatsInitialize(u32 windowSize);
+
+/**
+ * @brief Adds the duration of a phase to the current frame, called by the rendering backends. Ignored before the
+ * initialization.
+ * @param phase The measured phase, `MD_FRAME_PHASE_FRAME` is measured by `mdFrameStatsEndFrame`.
+ * @param durationTicks The time spent in the phase.
+ */
+void mdFrameStatsRecordPhase(enum MdFramePhase phase, mdTicks durationTicks);
+
+/**
+ * @brief Closes the current frame, called by the rendering backends once the frame is presented. The phases recorded
+ * during the frame enter the window, the phases a backend does not measure stay without samples.
+ */
+void mdFrameStatsEndFrame();
+
+/**
+ * @brief Computes the statistics of a phase, meant to be called at most once per frame (e.g. for an overlay).
+ * @param phase The phase to query.
+ * @param pStats Receives the statistics, all zero when the phase has no sample.
+ */
+void mdFrameStatsGetPhase(enum MdFramePhase phase, struct MdFramePhaseStats* pStats);
+
+/**
+ * @brief Deduces what limits the frame rate from the averages of the window. The CPU is considered waiting when
+ * the blocking phases take more than a quarter of the frame, the longest wait tells whether it waits for the GPU or
+ * for the display.
+ * @return The limiting factor, `MD_FRAME_BOUND_UNKNOWN` before the first frame.
+ */
+enum MdFrameBound mdFrameStatsGetBound();
+
+/**
+ * @brief Gets the lower bound of a histogram bucket.
+ * @param bucket The index of the bucket, lower than `MD_FRAME_STATS_HISTOGRAM_BUCKETS`.
+ * @return The shortest duration counted by the bucket in milliseconds.
+ */
+f64 mdFrameStatsGetBucketLowerBound(u32 bucket);
+
+/**
+ * @brief Gets the name of a phase, used for the CSV rows.
+ * @param phase The phase.
+ * @return The name in snake case, e.g. "wait_fence".
+ */
+const char* mdFrameStatsGetPhaseName(enum MdFramePhase phase);
+
+/**
+ * @brief Writes the statistics and histograms of every phase as CSV, one row per phase.
+ * @param filePath The path of the CSV file, replaced atomically.
+ * @return MD_TRUE if the file was written, MD_FALSE if it cannot be created.
+ */
+b8 mdFrameStatsExportCSV(const char* filePath);
+
+/**
+ * @brief Releases the frame statistics, called by `mdRenderShutdown`.
+ */
+void mdFrameStatsShutdown();
+
+#if __cplusplus
+}
+#endif
@@ -40,6 +40,17 @@ mdPipelineCreate(const char* vertexShaderPath, const char* fragmentShaderPath, s
  */
 void mdPipelineUse(struct MdPipeline* pPipeline);
 
+/**
+ * @brief Rebuilds the specified render pipeline from its shader files, used to hot reload the shaders.
+ *
+ * The new pipeline replaces the current one only once it is fully built, so a shader with errors keeps the previous
+ * pipeline in use. The frames in flight keep using the previous pipeline, it is destroyed once they are done.
+ *
+ * @param pPipeline Pointer to the MdPipeline to reload.
+ * @return MD_TRUE if the pipeline was rebuilt, MD_FALSE if a shader cannot be loaded or the pipeline cannot be built.
+ */
+b8 mdPipelineReload(struct MdPipeline* pPipeline);
+
 /**
  * @brief Destroys the specified render pipeline and releases its resources.
  *
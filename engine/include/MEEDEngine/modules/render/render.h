@@ -1,3 +1,4 @@
+#include "frame_stats.h"
 #include "pipeline.h"
 #include "renderer.h"
 #include "shader.h"
@@ -6,6 +6,18 @@ extern "C" {
 #include "MEEDEngine/platforms/platforms.h"
 #include "pipeline.h"
 
+#define MD_RENDER_GPU_ZONES_CAPACITY 32u ///< The GPU zones measured per frame, the next ones are ignored.
+
+/**
+ * @brief The GPU duration of a zone, see `mdRenderBeginGpuZone`.
+ */
+struct MdGpuZoneTiming
+{
+	const char* name;		  ///< The name given to `mdRenderBeginGpuZone`.
+	f64			milliseconds; ///< The time the GPU spent between the beginning and the end of the zone.
+	u32			depth;		  ///< The number of zones enclosing this one.
+};
+
 /**
  * @brief Initializes the rendering module.
  * This function sets up all necessary resources for rendering.
@@ -39,6 +51,28 @@ void mdRenderClearScreen(struct MdColor color);
  */
 void mdRenderDraw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance);
 
+/**
+ * @brief Opens a GPU zone: the commands recorded until `mdRenderEndGpuZone` are timed on the GPU with timestamp
+ * queries. The zones can be nested and must be closed before `mdRenderEndFrame`.
+ * @param name The name of the zone, must stay valid until the results are read (usually a string literal).
+ */
+void mdRenderBeginGpuZone(const char* name);
+
+/**
+ * @brief Closes the GPU zone opened last.
+ */
+void mdRenderEndGpuZone();
+
+/**
+ * @brief Gets the GPU zones of the most recent frame whose results are available. The results are read once the
+ * frame is known to be finished, without stalling, so they lag a few frames behind. The GPU duration of the whole
+ * frame is recorded in the frame statistics as `MD_FRAME_PHASE_GPU`.
+ * @param pZones Receives the zones in the order they were opened.
+ * @param maxZones The capacity of `pZones`.
+ * @return The number of zones written, 0 when the backend has no GPU timestamps.
+ */
+u32 mdRenderGetGpuZones(struct MdGpuZoneTiming* pZones, u32 maxZones);
+
 /**
  * @brief Presents the rendered frame to the display.
  * This function submits the rendered frame to the swapchain for presentation.
@@ -38,6 +38,15 @@ struct MdShader
  */
 struct MdShader* mdShaderCreate(enum MdShaderType type, const char* filePath);
 
+/**
+ * Recompiles a shader from its file, the shader is left untouched if the file cannot be read or compiled.
+ * @note The pipelines already built from the shader keep the previous code, see `mdPipelineReload`.
+ * @param pShader A pointer to the `MdShader` structure to reload.
+ * @param filePath The file path to the shader source code.
+ * @return MD_TRUE if the shader was reloaded, MD_FALSE otherwise.
+ */
+b8 mdShaderReload(struct MdShader* pShader, const char* filePath);
+
 /**
  * Destroys a previously created shader.
  * @param pShader A pointer to the `MdShader` structure to destroy.
@@ -0,0 +1,155 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "MEEDEngine/platforms/common.h"
+
+/**
+ * @file chunk.h
+ *
+ * The block storage of a cubic chunk of `MD_CHUNK_SIZE` blocks per side. The chunk keeps a palette of the distinct
+ * block IDs it contains, and stores each block as a bit-packed index into the palette: an index takes 0, 1, 2, 4, 8 or
+ * 16 bits, the fewest which hold the palette. A chunk of a single block type has no index at all and takes a few
+ * bytes, a terrain chunk of less than 16 block types takes 4 bits per block rather than the 16 bits of a dense array.
+ *
+ * Setting a block which is not in the palette widens the indices once the palette is full. Beyond 256 block types the
+ * chunk drops the palette and stores the block IDs themselves in 16 bits. The palette counts the blocks of each entry:
+ * an entry no block uses anymore is reused by the next new block type, and a chunk set back to a single block type
+ * drops its indices. `mdChunkCompact` narrows the indices to the entries still in use, once the edits are done.
+ *
+ * The blocks are ordered by y, then z, then x (`MD_CHUNK_BLOCK_INDEX`), the layout of the dense arrays of
+ * `mdChunkDecode` and `mdChunkEncode`.
+ *
+ * @example
+ * ```c
+ * struct MdChunk* pChunk = mdChunkCreate(BLOCK_AIR);
+ * mdChunkFillBox(pChunk, 0, 0, 0, MD_CHUNK_SIZE, 16, MD_CHUNK_SIZE, BLOCK_STONE);
+ * mdChunkSetBlock(pChunk, 4, 16, 4, BLOCK_GRASS);
+ *
+ * mdBlockId* pBlocks = MD_MALLOC_ARRAY(mdBlockId, MD_CHUNK_VOLUME);
+ * mdChunkDecode(pChunk, pBlocks);
+ * ```
+ */
+
+#define MD_CHUNK_SIZE			  32u	 ///< The blocks along a side of a chunk.
+#define MD_CHUNK_VOLUME			  32768u ///< The blocks of a chunk, `MD_CHUNK_SIZE` cubed.
+#define MD_CHUNK_MAX_BITS		  16u	 ///< The index width of a chunk without palette.
+#define MD_CHUNK_MAX_PALETTE_SIZE 256u	 ///< A chunk with more block types drops its palette.
+
+/**
+ * The index of the block at the coordinates (x, y, z) in a dense array of the blocks of a chunk.
+ */
+#define MD_CHUNK_BLOCK_INDEX(x, y, z) (((y) << 10) | ((z) << 5) | (x))
+
+/**
+ * The type of a block, defined by the application.
+ */
+typedef u16 mdBlockId;
+
+/**
+ * An entry of the palette of a chunk.
+ */
+struct MdChunkPaletteEntry
+{
+	mdBlockId blockId;	   ///< The block type of the entry.
+	u16		  blocksCount; ///< The number of blocks of the chunk which use the entry, 0 for a free entry.
+};
+
+/**
+ * A chunk of blocks.
+ */
+struct MdChunk
+{
+	u64*						pIndices;	  ///< The packed indices, 64 / `bitsPerIndex` per word. NULL for 0 bits.
+	struct MdChunkPaletteEntry* pPalette;	  ///< `1 << bitsPerIndex` entries, NULL for 16 bits.
+	u32							paletteCount; ///< The number of entries in use or freed, the others are unused.
+	u32							bitsPerIndex; ///< 0, 1, 2, 4, 8 or 16 (the block IDs themselves).
+};
+
+/**
+ * @brief Creates a chunk filled with a single block type.
+ * @param blockId The block type of every block.
+ * @return Pointer to the newly created chunk.
+ */
+struct MdChunk* mdChunkCreate(mdBlockId blockId);
+
+/**
+ * @brief Gets the block at the given coordinates.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ * @param x The x coordinate, less than `MD_CHUNK_SIZE`.
+ * @param y The y coordinate, less than `MD_CHUNK_SIZE`.
+ * @param z The z coordinate, less than `MD_CHUNK_SIZE`.
+ * @return The block type.
+ */
+mdBlockId mdChunkGetBlock(const struct MdChunk* pChunk, u32 x, u32 y, u32 z);
+
+/**
+ * @brief Sets the block at the given coordinates, widening the indices if the palette is full.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ * @param x The x coordinate, less than `MD_CHUNK_SIZE`.
+ * @param y The y coordinate, less than `MD_CHUNK_SIZE`.
+ * @param z The z coordinate, less than `MD_CHUNK_SIZE`.
+ * @param blockId The block type.
+ */
+void mdChunkSetBlock(struct MdChunk* pChunk, u32 x, u32 y, u32 z, mdBlockId blockId);
+
+/**
+ * @brief Fills the whole chunk with a single block type, which drops its indices.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ * @param blockId The block type.
+ */
+void mdChunkFill(struct MdChunk* pChunk, mdBlockId blockId);
+
+/**
+ * @brief Fills the blocks of a box with a single block type.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ * @param minX The first x coordinate of the box.
+ * @param minY The first y coordinate of the box.
+ * @param minZ The first z coordinate of the box.
+ * @param maxX The x coordinate past the box, at most `MD_CHUNK_SIZE`.
+ * @param maxY The y coordinate past the box, at most `MD_CHUNK_SIZE`.
+ * @param maxZ The z coordinate past the box, at most `MD_CHUNK_SIZE`.
+ * @param blockId The block type.
+ */
+void mdChunkFillBox(
+	struct MdChunk* pChunk, u32 minX, u32 minY, u32 minZ, u32 maxX, u32 maxY, u32 maxZ, mdBlockId blockId);
+
+/**
+ * @brief Rebuilds the palette from the block types still in use and narrows the indices to fit it. A chunk without
+ * palette gets one back if it holds at most `MD_CHUNK_MAX_PALETTE_SIZE` block types.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ */
+void mdChunkCompact(struct MdChunk* pChunk);
+
+/**
+ * @brief Decodes the chunk to a dense array of block types.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ * @param pBlocks Receives the `MD_CHUNK_VOLUME` blocks, in the order of `MD_CHUNK_BLOCK_INDEX`.
+ */
+void mdChunkDecode(const struct MdChunk* pChunk, mdBlockId* pBlocks);
+
+/**
+ * @brief Replaces the blocks of the chunk by a dense array of block types, with the narrowest indices which fit.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ * @param pBlocks The `MD_CHUNK_VOLUME` blocks, in the order of `MD_CHUNK_BLOCK_INDEX`.
+ */
+void mdChunkEncode(struct MdChunk* pChunk, const mdBlockId* pBlocks);
+
+/**
+ * @brief Gets the memory used by the chunk: the structure, its palette and its indices.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ * @return The size in bytes.
+ */
+mdSize mdChunkGetMemorySize(const struct MdChunk* pChunk);
+
+/**
+ * @brief Destroys a chunk.
+ * @param pChunk Pointer to the chunk. If NULL, raises an assertion.
+ */
+void mdChunkDestroy(struct MdChunk* pChunk);
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,191 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "MEEDEngine/core/containers/callback.h"
+#include "MEEDEngine/platforms/common.h"
+
+#define MD_DEFAULT_CHUNK_MAP_CAPACITY 64
+
+/**
+ * @file chunk_map.h
+ *
+ * The loaded chunks of a world, by chunk coordinates. The chunks are slots of a dense array, found by an
+ * open-addressing hash table (linear probing) of their coordinates packed in 64 bits, 21 bits per axis. Each slot
+ * keeps the indices of its 26 loaded neighbors, updated as the chunks are loaded and unloaded, so the meshing and the
+ * lighting of a chunk reach its neighbors without a lookup.
+ *
+ * Unloading a chunk moves the last slot in its place: slot indices are valid until the next unload. The payload of a
+ * slot, usually the blocks of the chunk (`struct MdChunk`), belongs to the map once loaded: the delete callback frees
+ * it when it is replaced or unloaded, and when the map is destroyed.
+ *
+ * @example
+ * ```c
+ * struct MdChunkMap* pMap = mdChunkMapCreate(0, deleteChunk);
+ * mdChunkMapInsert(pMap, 0, 0, 0, mdChunkCreate(BLOCK_STONE));
+ * u32 slotIndex = mdChunkMapFind(pMap, 0, 0, 0);
+ * void* pAbove = mdChunkMapGetNeighbor(pMap, slotIndex, 0, 1, 0); // NULL, not loaded.
+ * mdChunkMapDestroy(pMap);
+ * ```
+ */
+
+#define MD_CHUNK_MAP_NOT_FOUND_INDEX ((u32)(-1))	 ///< No such chunk, or no loaded neighbor.
+#define MD_CHUNK_MAP_NEIGHBORS_COUNT 26u			 ///< The chunks around a chunk, faces, edges and corners.
+#define MD_CHUNK_MAP_COORDINATE_BITS 21u			 ///< The bits of a packed coordinate.
+#define MD_CHUNK_MAP_MIN_COORDINATE	 (-(1 << 20))	 ///< The smallest chunk coordinate on an axis.
+#define MD_CHUNK_MAP_MAX_COORDINATE	 ((1 << 20) - 1) ///< The largest chunk coordinate on an axis.
+
+/**
+ * The index of the neighbor at the offset (dx, dy, dz), each in [-1, 1] and not all 0, in the neighbors of a slot.
+ * The offsets are ordered by x, then y, then z, without the chunk itself: the opposite of the neighbor i is 25 - i.
+ */
+#define MD_CHUNK_MAP_NEIGHBOR_INDEX(dx, dy, dz)                                                                        \
+	((u32)(((dx) + 1) * 9 + ((dy) + 1) * 3 + ((dz) + 1)) - ((dx) * 9 + (dy) * 3 + (dz) > 0 ? 1u : 0u))
+
+/**
+ * A loaded chunk.
+ */
+struct MdChunkMapSlot
+{
+	i32	  x;										   ///< The chunk x coordinate.
+	i32	  y;										   ///< The chunk y coordinate.
+	i32	  z;										   ///< The chunk z coordinate.
+	void* pData;									   ///< The payload, owned by the map.
+	u32	  neighborSlots[MD_CHUNK_MAP_NEIGHBORS_COUNT]; ///< By `MD_CHUNK_MAP_NEIGHBOR_INDEX`, or not found.
+};
+
+/**
+ * An entry of the hash table: the packed coordinates of a chunk and its slot.
+ */
+struct MdChunkMapEntry
+{
+	u64 key;	   ///< The packed coordinates, all bits set for an empty entry.
+	u32 slotIndex; ///< The slot of the chunk.
+};
+
+/**
+ * Needed information for the chunk map container.
+ */
+struct MdChunkMap
+{
+	u32					   count;	 ///< The number of loaded chunks, the used slots.
+	u32					   capacity; ///< The number of allocated slots, doubled when full.
+	struct MdChunkMapSlot* pSlots;	 ///< The dense array of the loaded chunks.
+
+	u32						 entriesCapacity; ///< A power of 2, at least twice the number of chunks.
+	u32						 hashShift;		  ///< Keeps the top bits of the hash, as many as the capacity needs.
+	struct MdChunkMapEntry*	 pEntries;		  ///< The hash table.
+	MdNodeDataDeleteCallback pDeleteCallback; ///< Callback function to delete the payloads.
+};
+
+/**
+ * @brief Creates and initializes a new chunk map.
+ * @param initialCapacity The number of chunks the map holds before it grows. If zero, a default capacity is used.
+ * @param pDeleteCallback Optional callback function to delete the payloads. Can be NULL.
+ * @return Pointer to the newly created MdChunkMap.
+ */
+struct MdChunkMap* mdChunkMapCreate(u32 initialCapacity, MdNodeDataDeleteCallback pDeleteCallback);
+
+/**
+ * @brief Retrieves the number of loaded chunks.
+ * @param pMap Pointer to the MdChunkMap. If NULL, raises an assertion.
+ * @return The number of loaded chunks.
+ */
+u32 mdChunkMapCount(struct MdChunkMap* pMap);
+
+/**
+ * @brief Loads a chunk: adds its slot and links it with its loaded neighbors. A chunk already loaded at these
+ * coordinates gets the new payload, the old one is deleted.
+ * @param pMap Pointer to the MdChunkMap. If NULL, raises an assertion.
+ * @param x The chunk x coordinate, between `MD_CHUNK_MAP_MIN_COORDINATE` and `MD_CHUNK_MAP_MAX_COORDINATE`.
+ * @param y The chunk y coordinate.
+ * @param z The chunk z coordinate.
+ * @param pData The payload of the chunk.
+ * @return The slot index of the chunk.
+ */
+u32 mdChunkMapInsert(struct MdChunkMap* pMap, i32 x, i32 y, i32 z, void* pData);
+
+/**
+ * @brief Unloads a chunk: deletes its payload, unlinks it from its neighbors and moves the last slot in its place.
+ * @param pMap Pointer to the MdChunkMap. If NULL, raises an assertion.
+ * @param x The chunk x coordinate.
+ * @param y The chunk y coordinate.
+ * @param z The chunk z coordinate.
+ * @return MD_TRUE if the chunk was loaded.
+ */
+b8 mdChunkMapRemove(struct MdChunkMap* pMap, i32 x, i32 y, i32 z);
+
+/**
+ * @brief Finds the slot of a chunk. The coordinates past the range of the map are never loaded.
+ * @param pMap Pointer to the MdChunkMap. If NULL, raises an assertion.
+ * @param x The chunk x coordinate.
+ * @param y The chunk y coordinate.
+ * @param z The chunk z coordinate.
+ * @return The slot index of the chunk if loaded; otherwise, returns `MD_CHUNK_MAP_NOT_FOUND_INDEX`.
+ */
+u32 mdChunkMapFind(const struct MdChunkMap* pMap, i32 x, i32 y, i32 z);
+
+/**
+ * @brief Retrieves the payload of a chunk.
+ * @param pMap Pointer to the MdChunkMap. If NULL, raises an assertion.
+ * @param x The chunk x coordinate.
+ * @param y The chunk y coordinate.
+ * @param z The chunk z coordinate.
+ * @return The payload of the chunk, or NULL if it is not loaded.
+ */
+void* mdChunkMapGet(const struct MdChunkMap* pMap, i32 x, i32 y, i32 z);
+
+/**
+ * @brief Retrieves a slot.
+ * @param pMap Pointer to the MdChunkMap. If NULL, raises an assertion.
+ * @param slotIndex The index of the slot. If out of bounds, raises an assertion.
+ * @return Pointer to the slot, valid until the next load or unload.
+ */
+struct MdChunkMapSlot* mdChunkMapAt(struct MdChunkMap* pMap, u32 slotIndex);
+
+/**
+ * @brief Retrieves the payload of a neighbor of a chunk, through the links of its slot.
+ * @param pMap Pointer to the MdChunkMap. If NULL, raises an assertion.
+ * @param slotIndex The index of the slot of the chunk. If out of bounds, raises an assertion.
+ * @param dx The x offset of the neighbor, in [-1, 1].
+ * @param dy The y offset of the neighbor, in [-1, 1].
+ * @param dz The z offset of the neighbor, in [-1, 1]. The offsets are not all 0.
+ * @return The payload of the neighbor, or NULL if it is not loaded.
+ */
+void* mdChunkMapGetNeighbor(const struct MdChunkMap* pMap, u32 slotIndex, i32 dx, i32 dy, i32 dz);
+
+/**
+ * @brief Finds the loaded chunks in a box of chunk coordinates, bounds included. Probes the coordinates of a box
+ * smaller than the number of chunks, scans the slots otherwise.
+ * @param pMap Pointer to the MdChunkMap. If NULL, raises an assertion.
+ * @param minX The smallest x coordinate of the box.
+ * @param minY The smallest y coordinate of the box.
+ * @param minZ The smallest z coordinate of the box.
+ * @param maxX The largest x coordinate of the box.
+ * @param maxY The largest y coordinate of the box.
+ * @param maxZ The largest z coordinate of the box.
+ * @param pSlotIndices Receives the slot indices of the chunks, at most `maxCount`. Can be NULL if `maxCount` is 0.
+ * @param maxCount The capacity of `pSlotIndices`.
+ * @return The number of loaded chunks in the box, which may exceed `maxCount`.
+ */
+u32 mdChunkMapQueryBox(const struct MdChunkMap* pMap,
+					   i32						minX,
+					   i32						minY,
+					   i32						minZ,
+					   i32						maxX,
+					   i32						maxY,
+					   i32						maxZ,
+					   u32*						pSlotIndices,
+					   u32						maxCount);
+
+/**
+ * @brief Destroys a chunk map, deleting the payloads with the delete callback.
+ * @param pMap Pointer to the MdChunkMap to be destroyed. If NULL, raises an assertion.
+ */
+void mdChunkMapDestroy(struct MdChunkMap* pMap);
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "MEEDEngine/modules/render/vertex_buffer.h"
+#include "MEEDEngine/platforms/common.h"
+#include "MEEDEngine/platforms/time.h"
+#include "chunk.h"
+
+/**
+ * @file chunk_mesh.h
+ *
+ * Builds the geometry of a chunk from its dense blocks (`mdChunkDecode`). A face of a block is visible when the block
+ * beside it is empty (`MD_BLOCK_ID_EMPTY`): inside the chunk, or on the facing layer of the neighbor chunk for the
+ * blocks on a side. The visible faces of each slice of the chunk are merged greedily into rectangles of the same block
+ * type, and each rectangle becomes a quad of two triangles.
+ *
+ * The vertices follow the layout `MD_CHUNK_MESH_VERTEX_LAYOUT`: a vertex buffer created with it and with
+ * `mdChunkMeshWriteVertex` as write callback takes the vertices of the mesh as they are, and draws them as a triangle
+ * list. The front faces are counter-clockwise seen from outside the block.
+ *
+ * @example
+ * ```c
+ * enum MdVertexBufferAttributeType layout[] = MD_CHUNK_MESH_VERTEX_LAYOUT;
+ * const mdBlockId* pNeighborFaces[MD_CHUNK_FACE_COUNT] = {MD_NULL}; // No loaded neighbor, every side is visible.
+ *
+ * struct MdChunkMesh* pMesh = mdChunkMeshCreate();
+ * mdChunkMeshBuild(pMesh, pBlocks, pNeighborFaces, MD_NULL, MD_NULL);
+ * struct MdVertexBuffer* pVertexBuffer = mdVertexBufferCreate(
+ *     layout, MD_ARRAY_SIZE(layout), pMesh->verticesCount, mdChunkMeshWriteVertex, MD_VERTEX_BUFFER_TYPE_STATIC);
+ * for (u32 i = 0; i < pMesh->verticesCount; ++i)
+ * {
+ *     mdVertexBufferWrite(pVertexBuffer, &pMesh->pVertices[i]);
+ * }
+ * ```
+ */
+
+#define MD_BLOCK_ID_EMPTY				0u ///< The block type without faces, which shows the faces beside it.
+#define MD_CHUNK_MESH_VERTICES_PER_QUAD 6u ///< Two triangles, the vertex buffers have no index buffer.
+
+/**
+ * The attributes of `struct MdChunkMeshVertex`, to initialize the layout of a vertex buffer.
+ */
+#define MD_CHUNK_MESH_VERTEX_LAYOUT                                                                                    \
+	{                                                                                                                  \
+		MD_VERTEX_BUFFER_ATTRIBUTE_TYPE_FLOAT3, MD_VERTEX_BUFFER_ATTRIBUTE_TYPE_FLOAT2,                                \
+			MD_VERTEX_BUFFER_ATTRIBUTE_TYPE_UNSIGNED_INT3                                                              \
+	}
+
+/**
+ * The sides of a block or of a chunk, by the direction they face.
+ */
+enum MdChunkFace
+{
+	MD_CHUNK_FACE_NEGATIVE_X,
+	MD_CHUNK_FACE_POSITIVE_X,
+	MD_CHUNK_FACE_NEGATIVE_Y,
+	MD_CHUNK_FACE_POSITIVE_Y,
+	MD_CHUNK_FACE_NEGATIVE_Z,
+	MD_CHUNK_FACE_POSITIVE_Z,
+	MD_CHUNK_FACE_COUNT,
+};
+
+/**
+ * The index of a block in a layer of blocks along a side of a chunk: `u` and `v` are the two other axes in the order
+ * x, y, z (y and z for a side along x).
+ */
+#define MD_CHUNK_FACE_BLOCK_INDEX(u, v) (((v) << 5) | (u))
+
+/**
+ * Gives the texture of a face of a block type, for the blocks which have different textures on their sides.
+ */
+typedef u32 (*MdChunkMeshTextureFunction)(mdBlockId blockId, enum MdChunkFace face, void* pUserData);
+
+/**
+ * A vertex of a chunk mesh, `MD_CHUNK_MESH_VERTEX_LAYOUT`.
+ */
+struct MdChunkMeshVertex
+{
+	f32 position[3]; ///< In blocks, from the corner of the chunk.
+	f32 uv[2];		 ///< In blocks across the quad: a repeated texture covers each block once.
+	u32 blockId;	 ///< The block type of the quad.
+	u32 textureId;	 ///< The texture of the face, the block type without texture function.
+	u32 face;		 ///< The `enum MdChunkFace` the quad faces.
+};
+
+/**
+ * The geometry of a chunk, rebuilt in place.
+ */
+struct MdChunkMesh
+{
+	struct MdChunkMeshVertex* pVertices;		///< `MD_CHUNK_MESH_VERTICES_PER_QUAD` per quad.
+	u32						  verticesCount;	///< The number of vertices of the last build.
+	u32						  verticesCapacity; ///< The allocated vertices, kept by the next builds.
+	u32						  quadsCount;		///< The number of quads of the last build.
+	mdTicks					  buildTicks;		///< The duration of the last build.
+};
+
+/**
+ * @brief Creates an empty chunk mesh.
+ * @return Pointer to the newly created chunk mesh.
+ */
+struct MdChunkMesh* mdChunkMeshCreate();
+
+/**
+ * @brief Builds the mesh of a chunk, replacing the previous geometry.
+ * @param pMesh Pointer to the chunk mesh. If NULL, raises an assertion.
+ * @param pBlocks The `MD_CHUNK_VOLUME` blocks of the chunk, in the order of `MD_CHUNK_BLOCK_INDEX`.
+ * @param pNeighborFaces For each side, the layer of the neighbor chunk which touches it (`mdChunkMeshExtractFace` on
+ * the opposite side of the neighbor), in the order of `MD_CHUNK_FACE_BLOCK_INDEX`. NULL for a missing neighbor, whose
+ * blocks are empty.
+ * @param textureFunction Gives the texture of the faces. Can be NULL, the texture is then the block type.
+ * @param pUserData Given to the texture function.
+ */
+void mdChunkMeshBuild(struct MdChunkMesh*		 pMesh,
+					  const mdBlockId*			 pBlocks,
+					  const mdBlockId* const	 pNeighborFaces[MD_CHUNK_FACE_COUNT],
+					  MdChunkMeshTextureFunction textureFunction,
+					  void*						 pUserData);
+
+/**
+ * @brief Copies the layer of blocks along a side of a chunk, for the mesh of the neighbor on that side.
+ * @param pBlocks The `MD_CHUNK_VOLUME` blocks of the chunk, in the order of `MD_CHUNK_BLOCK_INDEX`.
+ * @param face The side of the chunk.
+ * @param pFace Receives the `MD_CHUNK_SIZE` * `MD_CHUNK_SIZE` blocks, in the order of `MD_CHUNK_FACE_BLOCK_INDEX`.
+ */
+void mdChunkMeshExtractFace(const mdBlockId* pBlocks, enum MdChunkFace face, mdBlockId* pFace);
+
+/**
+ * @brief The write callback of a vertex buffer with the layout `MD_CHUNK_MESH_VERTEX_LAYOUT`.
+ * @param pDest The vertex in the buffer.
+ * @param pSrc The `struct MdChunkMeshVertex` to write.
+ */
+void mdChunkMeshWriteVertex(u8* pDest, const void* pSrc);
+
+/**
+ * @brief Destroys a chunk mesh.
+ * @param pMesh Pointer to the chunk mesh. If NULL, raises an assertion.
+ */
+void mdChunkMeshDestroy(struct MdChunkMesh* pMesh);
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,3 @@
+#include "chunk.h"
+#include "chunk_map.h"
+#include "chunk_mesh.h"
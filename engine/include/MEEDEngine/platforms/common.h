@@ -146,6 +146,17 @@ typedef MD_BINDING int	  mdPid;
 #define MD_STRINGIFY(x)	 _MD_STRINGIFY(x)
 #define _MD_STRINGIFY(x) #x
 
+/**
+ * Concatenate two tokens after expanding them, used to build unique identifiers inside macros.
+ *
+ * @example
+ * ```c
+ * MD_CONCAT(scope, __LINE__) -> scope42
+ * ```
+ */
+#define MD_CONCAT(a, b)	 _MD_CONCAT(a, b)
+#define _MD_CONCAT(a, b) a##b
+
 #include "console.h"
 #include "exceptions.h"
 #include "memory.h"
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "common.h"
+#include <stdarg.h>
 
 #if __cplusplus
 extern "C" {
@@ -47,6 +48,17 @@ void mdSetConsoleConfig(struct MdConsoleConfig config) MD_BINDING;
  */
 void mdFormatString(char* buffer, mdSize length, const char* format, ...);
 
+/**
+ * Same as `mdFormatString` but receives the already started variadic argument list, used by
+ * the wrappers which forward their own `...` arguments (e.g. the logger).
+ * @param buffer The buffer to print to.
+ * @param length The length of the buffer.
+ * @param format The format string.
+ * @param args The format arguments.
+ * @return The number of characters which would have been written without the truncation.
+ */
+i32 mdFormatStringArgs(char* buffer, mdSize length, const char* format, va_list args);
+
 /**
  * Print formatted content to the console.
  * @param format The format string.
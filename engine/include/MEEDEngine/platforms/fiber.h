@@ -0,0 +1,86 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+
+/**
+ * @file fiber.h
+ * Fibers: execution contexts with their own stack, switched cooperatively on the same thread. A switch only saves
+ * the callee-saved registers, it costs tens of nanoseconds against the microseconds of a thread context switch.
+ *
+ * The switch is written in assembly on x86-64 and AArch64, other Linux architectures use `ucontext`, which also
+ * saves the signal mask with a system call. The browser build has no fibers: `mdFiberCreate` fails.
+ *
+ * The stacks are mapped on demand, so a large stack only costs the pages it touches. The debug builds put a
+ * protected guard page below every stack: an overflow crashes at once instead of corrupting the next stack.
+ *
+ * A fiber can be resumed on another thread than the one which suspended it. The compilers may keep the address of a
+ * thread-local variable across the switch, so the functions which run on a fiber must read their thread-local
+ * variables through a function which is not inlined.
+ *
+ * @example
+ * ```c
+ * static struct MdFiber* s_pThreadFiber;
+ *
+ * static void run(void* pArgument)
+ * {
+ *     struct MdFiber* pSelf = (struct MdFiber*)pArgument;
+ *     mdFiberSwitch(pSelf, s_pThreadFiber); // Suspends, a fiber function never returns.
+ * }
+ *
+ * s_pThreadFiber        = mdFiberCreateFromThread();
+ * struct MdFiber* pFiber = mdFiberCreate(64 * 1024, run, MD_NULL);
+ * mdFiberSwitch(s_pThreadFiber, pFiber);
+ * mdFiberDestroy(pFiber);
+ * mdFiberDestroy(s_pThreadFiber);
+ * ```
+ */
+
+#define MD_FIBER_MIN_STACK_SIZE (16u * 1024u)
+
+/**
+ * The function a fiber runs. It must not return: it switches to another fiber when it is done, and the fiber is then
+ * destroyed or reused by a next switch.
+ */
+typedef void (*MdFiberFunction)(void* pArgument);
+
+/**
+ * An opaque fiber: a stack and the saved registers of its suspended context.
+ */
+struct MdFiber;
+
+/**
+ * @brief Creates a suspended fiber, started by the first switch to it.
+ * @param stackSize The size of the stack, rounded up to the pages, at least `MD_FIBER_MIN_STACK_SIZE`.
+ * @param function The function the fiber runs.
+ * @param pArgument Given to the function, MD_NULL to give the fiber itself.
+ * @return Pointer to the fiber, MD_NULL when the platform has no fibers or the stack cannot be mapped.
+ */
+struct MdFiber* mdFiberCreate(mdSize stackSize, MdFiberFunction function, void* pArgument);
+
+/**
+ * @brief Creates the fiber of the calling thread, without a stack of its own: the context the other fibers switch
+ * back to.
+ * @return Pointer to the fiber, MD_NULL when the platform has no fibers.
+ */
+struct MdFiber* mdFiberCreateFromThread();
+
+/**
+ * @brief Destroys a fiber which is not running, and unmaps its stack.
+ * @param pFiber Pointer to the fiber.
+ */
+void mdFiberDestroy(struct MdFiber* pFiber);
+
+/**
+ * @brief Suspends the running fiber and resumes another one, on the calling thread.
+ * @param pFrom The running fiber, receives the suspended context.
+ * @param pTo The fiber to resume, suspended or not started.
+ */
+void mdFiberSwitch(struct MdFiber* pFrom, struct MdFiber* pTo);
+
+#if __cplusplus
+}
+#endif
@@ -13,9 +13,12 @@ extern "C" {
 
 enum MD_BINDING MdFileMode
 {
-	MD_FILE_MODE_READ,	///< Open the file in read mode.
-	MD_FILE_MODE_WRITE, ///< Open the file in write mode.
-	MD_FILE_MODE_APPEND ///< Open the file in append mode.
+	MD_FILE_MODE_READ,			  ///< Open the file in read mode.
+	MD_FILE_MODE_WRITE,			  ///< Open the file in write mode.
+	MD_FILE_MODE_APPEND,		  ///< Open the file in append mode.
+	MD_FILE_MODE_READ_MAPPED,	  ///< Map the file read-only, `content` points to the mapping without a copy.
+	MD_FILE_MODE_READ_NO_PRELOAD, ///< Open the file for reading without loading it, see `mdFileReadAt`.
+	MD_FILE_MODE_WRITE_ATOMIC	  ///< Write a new file which replaces the existing one on `mdFileClose`.
 };
 
 /**
@@ -24,16 +27,36 @@ enum MD_BINDING MdFileMode
 struct MD_BINDING MdFileData
 {
 	void* pInternal MD_HIDDEN; ///< Used for storing custom file system data (e.g., file handles).
+	b8	  isPacked	MD_HIDDEN; ///< Whether the file was opened from a mounted pack, see `pack.h`.
 
 	b8				isOpen;	  ///< Flag indicating whether the file is currently open.
 	const char*		filePath; ///< The path of the file.
-	u32				size;	  ///< The size of the file in bytes.
+	u64				size;	  ///< The size of the file in bytes, only filled in the read modes.
 	char*			content;  ///< Pointer to the file content in memory.
 	enum MdFileMode mode;	  ///< The mode in which the file was opened.
 };
 
 /**
  * Opens a file at the specified path with the given mode.
+ *
+ * In `MD_FILE_MODE_READ` the whole file is copied into a null-terminated `content` buffer, a file which cannot be
+ * read entirely (e.g. it shrank while being read) is reported as not open. In `MD_FILE_MODE_READ_MAPPED` the file
+ * is mapped instead, the pages are loaded by the OS on first access and `content` must not be modified nor assumed
+ * to be null-terminated. Empty files have no mapping and a `MD_NULL` content, a file which cannot be mapped is
+ * reported as not open. The mapping is released by `mdFileClose`.
+ *
+ * In `MD_FILE_MODE_READ_NO_PRELOAD` only the size is queried, the content stays `MD_NULL` and the data is read on
+ * demand with `mdFileReadAt` or a `MdFileStreamReader`.
+ *
+ * In the read modes, the paths starting with the mount point of a mounted pack are resolved inside the pack, see
+ * `mdPackMount`.
+ *
+ * `MD_FILE_MODE_WRITE` truncates the file in place, a crash while writing leaves a partial file. In
+ * `MD_FILE_MODE_WRITE_ATOMIC` the data is written to `<filePath>.tmp` instead, which `mdFileClose` renames over
+ * `filePath`: the readers see either the previous file or the complete new one. The path is copied in this mode,
+ * and `mdFileClose` flushes the rename to the storage device. Call `mdFileSync` before `mdFileClose` for the new
+ * content to reach the storage device before the rename, so that a power loss cannot leave an empty file either.
+ *
  * @param filePath The path of the file to open.
  * @param mode The mode in which to open the file.
  * @return Pointer to the MdFileData representing the opened file.
@@ -47,6 +70,71 @@ struct MdFileData* mdFileOpen(const char* filePath, enum MdFileMode mode);
  */
 b8 mdFileIsOpen(struct MdFileData* pFileData);
 
+/**
+ * Reads a region of the specified file without moving any file cursor (`pread` on POSIX), can be used from several
+ * threads at once. Works in every read mode.
+ * @param pFileData Pointer to the MdFileData representing the file.
+ * @param offset The position of the first byte to read, in bytes from the start of the file.
+ * @param pDestination Pointer to the memory which receives at least `size` bytes.
+ * @param size The number of bytes to read.
+ * @return The number of bytes read, smaller than `size` only when the end of the file is reached.
+ */
+u64 mdFileReadAt(struct MdFileData* pFileData, u64 offset, void* pDestination, u64 size);
+
+/**
+ * Hints the OS that a region of the specified file will be read soon, the data is loaded in the background
+ * (`posix_fadvise(POSIX_FADV_WILLNEED)` on Linux). Does nothing on the platforms without such a hint.
+ * @param pFileData Pointer to the MdFileData representing the file.
+ * @param offset The position of the first byte of the region.
+ * @param size The size of the region in bytes.
+ */
+void mdFilePrefetch(struct MdFileData* pFileData, u64 offset, u64 size);
+
+/**
+ * Reads a file block by block. Two blocks are kept, so the previously returned block is still valid while the
+ * next one is used (e.g. for records crossing a block boundary). The blocks are read synchronously by
+ * `mdFileStreamReaderNext`: the only readahead is the OS page cache, hinted with `mdFilePrefetch` for the block after
+ * the current one. Use `file_async.h` to read blocks in the background.
+ */
+struct MdFileStreamReader
+{
+	struct MdFileData* pFile;		  ///< The file which is read, owned by the caller.
+	u64				   offset;		  ///< The file position of the next block.
+	u32				   blockSize;	  ///< The size of each block in bytes.
+	u32				   currentBuffer; ///< The index of the buffer which received the last block.
+	u8*				   pBuffers[2];	  ///< The two block buffers.
+};
+
+/**
+ * Creates a stream reader over an open file.
+ * @param pFileData Pointer to the MdFileData to read, usually opened with `MD_FILE_MODE_READ_NO_PRELOAD`.
+ * @param offset The position of the first block.
+ * @param blockSize The size of each block in bytes.
+ * @return Pointer to the created stream reader.
+ */
+struct MdFileStreamReader* mdFileStreamReaderCreate(struct MdFileData* pFileData, u64 offset, u32 blockSize);
+
+/**
+ * Reads the next block of the file.
+ * @param pReader Pointer to the stream reader.
+ * @param pSize Receives the size of the block, smaller than the block size for the last block of the file.
+ * @return Pointer to the block data valid until the second next call, or `MD_NULL` at the end of the file.
+ */
+const void* mdFileStreamReaderNext(struct MdFileStreamReader* pReader, u64* pSize);
+
+/**
+ * Moves the stream reader, the next call to `mdFileStreamReaderNext` starts reading at the given position.
+ * @param pReader Pointer to the stream reader.
+ * @param offset The new position in bytes from the start of the file.
+ */
+void mdFileStreamReaderSeek(struct MdFileStreamReader* pReader, u64 offset);
+
+/**
+ * Destroys a stream reader, the file stays open.
+ * @param pReader Pointer to the stream reader to destroy.
+ */
+void mdFileStreamReaderDestroy(struct MdFileStreamReader* pReader);
+
 /**
  * Writes data to the specified file.
  * @param pFileData Pointer to the MdFileData representing the file.
@@ -55,12 +143,117 @@ b8 mdFileIsOpen(struct MdFileData* pFileData);
  */
 void mdFileWrite(struct MdFileData* pFileData, const char* data, mdSize size);
 
+#define MD_FILE_BUFFERED_WRITER_DEFAULT_SIZE (64u * 1024u)
+
+/**
+ * Gathers many small writes into large ones, the buffer is written once full or when flushed. A write which does not
+ * fit into the buffer is sent together with the buffered data in one vectored write, without any copy, so the
+ * number of system calls only depends on the buffer size.
+ */
+struct MdFileBufferedWriter
+{
+	struct MdFileData* pFile;	   ///< The file which is written, owned by the caller.
+	u8*				   pBuffer;	   ///< The buffered data, not yet written.
+	u32				   bufferSize; ///< The capacity of `pBuffer` in bytes.
+	u32				   usedSize;   ///< The number of bytes inside `pBuffer`.
+};
+
+/**
+ * Creates a buffered writer over an open file.
+ * @param pFileData Pointer to the MdFileData to write, opened in a write mode.
+ * @param bufferSize The size of the buffer in bytes, 0 for `MD_FILE_BUFFERED_WRITER_DEFAULT_SIZE`.
+ * @return Pointer to the created buffered writer.
+ */
+struct MdFileBufferedWriter* mdFileBufferedWriterCreate(struct MdFileData* pFileData, u32 bufferSize);
+
+/**
+ * Appends data to the buffered writer.
+ * @param pWriter Pointer to the buffered writer.
+ * @param pData Pointer to the data to write.
+ * @param size The size of the data in bytes.
+ */
+void mdFileBufferedWriterWrite(struct MdFileBufferedWriter* pWriter, const void* pData, mdSize size);
+
 /**
- * Closes the specified file.
+ * Writes the buffered data to the file.
+ * @param pWriter Pointer to the buffered writer.
+ */
+void mdFileBufferedWriterFlush(struct MdFileBufferedWriter* pWriter);
+
+/**
+ * Flushes then destroys a buffered writer, the file stays open.
+ * @param pWriter Pointer to the buffered writer to destroy.
+ */
+void mdFileBufferedWriterDestroy(struct MdFileBufferedWriter* pWriter);
+
+/**
+ * Writes data at a position of the specified file without moving any file cursor (`pwrite` on POSIX).
+ * @param pFileData Pointer to the MdFileData representing the file.
+ * @param offset The position of the first byte to write, in bytes from the start of the file.
+ * @param pSource Pointer to the data to write.
+ * @param size The size of the data to write in bytes.
+ */
+void mdFileWriteAt(struct MdFileData* pFileData, u64 offset, const void* pSource, u64 size);
+
+/**
+ * One contiguous memory region which is written by `mdFileWriteVector`.
+ */
+struct MdFileBuffer
+{
+	const void* pData; ///< Pointer to the first byte of the region.
+	mdSize		size;  ///< The size of the region in bytes.
+};
+
+/**
+ * Writes multiple memory regions to the specified file with as few system calls as possible (`writev` on POSIX).
+ * The regions are written in order, exactly as if `mdFileWrite` was called for each of them.
+ * @param pFileData Pointer to the MdFileData representing the file.
+ * @param pBuffers Pointer to the array of regions to write.
+ * @param buffersCount The number of regions inside `pBuffers`.
+ */
+void mdFileWriteVector(struct MdFileData* pFileData, const struct MdFileBuffer* pBuffers, u32 buffersCount);
+
+/**
+ * Forces the written data of the specified file to reach the storage device (`fdatasync` on Linux).
+ * @param pFileData Pointer to the MdFileData representing the file.
+ */
+void mdFileSync(struct MdFileData* pFileData);
+
+/**
+ * Checks whether a file exists at the specified path.
+ * @param filePath The path of the file.
+ * @return MD_TRUE if the file exists, MD_FALSE otherwise.
+ */
+b8 mdFileExists(const char* filePath);
+
+/**
+ * Renames (moves) a file, replacing the destination if it already exists.
+ * @param oldPath The current path of the file.
+ * @param newPath The new path of the file.
+ * @return MD_TRUE if the file was renamed, MD_FALSE otherwise.
+ */
+b8 mdFileRename(const char* oldPath, const char* newPath);
+
+/**
+ * Removes the file at the specified path.
+ * @param filePath The path of the file to remove.
+ * @return MD_TRUE if the file was removed, MD_FALSE otherwise.
+ */
+b8 mdFileRemove(const char* filePath);
+
+/**
+ * Closes the specified file. In `MD_FILE_MODE_WRITE_ATOMIC` the written file replaces the one at `filePath`.
  * @param pFileData Pointer to the MdFileData representing the file to close.
  */
 void mdFileClose(struct MdFileData* pFileData);
 
+/**
+ * Closes a file opened in `MD_FILE_MODE_WRITE_ATOMIC` without replacing the one at `filePath`, the written data is
+ * removed.
+ * @param pFileData Pointer to the MdFileData representing the file to discard.
+ */
+void mdFileDiscard(struct MdFileData* pFileData);
+
 #if __cplusplus
 }
 #endif
\ No newline at end of file
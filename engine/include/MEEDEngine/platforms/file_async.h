@@ -0,0 +1,165 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+#include "file.h"
+
+/**
+ * @file file_async.h
+ * The asynchronous file queue of the `MEEDEngine`. Reads and writes are submitted with their buffers and executed in
+ * the background, the results are collected from the main loop with `mdFileAsyncPoll`.
+ *
+ * On Linux the requests go through io_uring when the kernel allows it, otherwise a pool of worker threads executes
+ * them with `pread`/`pwrite`. The other platforms execute the requests synchronously inside `mdFileAsyncPoll`.
+ *
+ * Submitting, cancelling and polling must be done from the same thread, only the I/O itself runs elsewhere.
+ *
+ * @example
+ * ```c
+ * struct MdFileRequestDesc desc = {};
+ * desc.pFile	  = pRegionFile;
+ * desc.type	  = MD_FILE_REQUEST_TYPE_READ;
+ * desc.priority = MD_FILE_REQUEST_PRIORITY_HIGH;
+ * desc.offset	  = sectorIndex * SECTOR_SIZE;
+ * desc.pBuffer	  = pChunkBuffer;
+ * desc.size	  = SECTOR_SIZE;
+ * desc.callback = onChunkLoaded;
+ * mdFileRequestId request = mdFileAsyncSubmit(&desc);
+ * ...
+ * mdFileAsyncCancel(request); // The chunk went out of view.
+ * ...
+ * mdFileAsyncPoll(MD_NULL, 0); // Once per frame, calls `onChunkLoaded`.
+ * ```
+ */
+
+typedef u64 mdFileRequestId; ///< Identifies a submitted request, never reused while the queue is alive.
+
+#define MD_FILE_REQUEST_INVALID_ID ((mdFileRequestId)0)
+
+enum MdFileRequestType
+{
+	MD_FILE_REQUEST_TYPE_READ,	///< Read `size` bytes at `offset` into the buffer.
+	MD_FILE_REQUEST_TYPE_WRITE, ///< Write `size` bytes of the buffer at `offset`.
+};
+
+/**
+ * The order in which the waiting requests are started, a request of a higher priority is always started before the
+ * requests of the lower ones. The requests already executing are not interrupted.
+ */
+enum MdFileRequestPriority
+{
+	MD_FILE_REQUEST_PRIORITY_HIGH,	 ///< Needed for the current frame (e.g. visible chunks).
+	MD_FILE_REQUEST_PRIORITY_NORMAL, ///< Needed soon.
+	MD_FILE_REQUEST_PRIORITY_LOW,	 ///< Background work (e.g. prefetching, saving).
+	MD_FILE_REQUEST_PRIORITY_COUNT
+};
+
+enum MdFileRequestStatus
+{
+	MD_FILE_REQUEST_STATUS_COMPLETED, ///< Every byte was transferred, or the end of the file was reached on a read.
+	MD_FILE_REQUEST_STATUS_FAILED,	  ///< The OS reported an error, see `error`.
+	MD_FILE_REQUEST_STATUS_CANCELLED, ///< Cancelled by `mdFileAsyncCancel`, the buffer content is undefined.
+};
+
+/**
+ * The result of a finished request.
+ */
+struct MdFileCompletion
+{
+	mdFileRequestId			 id;
+	enum MdFileRequestStatus status;
+	u64						 bytesTransferred; ///< Can be smaller than the requested size when reading past the end.
+	i32						 error;			   ///< The OS error code of a failed request, 0 otherwise.
+	void*					 pBuffer;		   ///< The buffer given at submission.
+	void*					 pUserData;		   ///< The user data given at submission.
+};
+
+/**
+ * Called from `mdFileAsyncPoll` on the polling thread when a request finishes.
+ */
+typedef void (*MdFileRequestCallback)(const struct MdFileCompletion* pCompletion);
+
+/**
+ * Describes one request. The file and the buffer must stay valid until the request finishes.
+ */
+struct MdFileRequestDesc
+{
+	struct MdFileData*		   pFile;	 ///< Opened in a read mode for reads, in a write mode for writes.
+	enum MdFileRequestType	   type;
+	enum MdFileRequestPriority priority;
+	u64						   offset; ///< The position in the file, in bytes.
+	void*					   pBuffer;
+	u64						   size;
+	MdFileRequestCallback	   callback;  ///< Optional, the completions without callback are returned by the poll.
+	void*					   pUserData; ///< Passed back inside the completion.
+};
+
+/**
+ * The options of the asynchronous file queue.
+ */
+struct MdFileAsyncConfig
+{
+	u32 queueDepth;			///< The maximum number of requests executing at the same time.
+	u32 workerThreadsCount; ///< The number of threads of the fallback pool.
+	b8	disableIoUring;		///< Forces the fallback pool even when io_uring is available.
+};
+
+/**
+ * Retrieves the default configuration: 64 requests in flight, 4 fallback threads, io_uring when available.
+ * @return The default configuration.
+ */
+struct MdFileAsyncConfig mdFileAsyncGetDefaultConfig();
+
+/**
+ * Starts the asynchronous file queue.
+ * @param pConfig The configuration, `MD_NULL` for the default one.
+ */
+void mdFileAsyncInitialize(const struct MdFileAsyncConfig* pConfig);
+
+/**
+ * Checks whether the requests are executed by io_uring.
+ * @return MD_TRUE for io_uring, MD_FALSE for the fallback.
+ */
+b8 mdFileAsyncIsUsingIoUring();
+
+/**
+ * Submits a request, it is started as soon as a slot of the queue is free.
+ * @param pDesc The description of the request, copied.
+ * @return The identifier of the request.
+ */
+mdFileRequestId mdFileAsyncSubmit(const struct MdFileRequestDesc* pDesc);
+
+/**
+ * Cancels a request. A waiting request is dropped immediately, an executing one is interrupted when the OS allows it.
+ * The request is still reported by `mdFileAsyncPoll`, with the cancelled status unless it finished first.
+ * @param id The identifier of the request.
+ * @return MD_TRUE if the request was found unfinished, MD_FALSE if it already finished or is unknown.
+ */
+b8 mdFileAsyncCancel(mdFileRequestId id);
+
+/**
+ * Starts the waiting requests and collects the finished ones. The callbacks of the finished requests are called,
+ * the finished requests without callback are written into `pCompletions`.
+ * @param pCompletions Receives the completions without callback, can be `MD_NULL` when `maxCompletions` is 0.
+ * @param maxCompletions The capacity of `pCompletions`, the remaining completions are kept for the next poll.
+ * @return The number of completions written into `pCompletions`.
+ */
+u32 mdFileAsyncPoll(struct MdFileCompletion* pCompletions, u32 maxCompletions);
+
+/**
+ * Blocks until every submitted request finished, the completions are then collected by the next `mdFileAsyncPoll`.
+ */
+void mdFileAsyncWaitIdle();
+
+/**
+ * Cancels the remaining requests, waits for the executing ones and stops the queue. The completions which were not
+ * polled are dropped without calling their callbacks.
+ */
+void mdFileAsyncShutdown();
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,106 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+
+/**
+ * @file file_watcher.h
+ * Watches files and directories for changes, used to reload shaders and assets while the application runs.
+ *
+ * The OS notifications are read without blocking by `mdFileWatcherPoll`, once per frame. Editors usually save a file
+ * in several steps (truncate, write, rename over the original), so the notifications of a path are coalesced into a
+ * single event which is reported once the path stayed quiet for the debounce delay. A file created then removed
+ * before the delay (e.g. the swap files of editors) is not reported at all.
+ *
+ * Only Linux is supported (inotify), on the other platforms the watches are accepted but never report any event.
+ *
+ * @example
+ * ```c
+ * struct MdFileWatcher* pWatcher = mdFileWatcherCreate(MD_FILE_WATCHER_DEFAULT_DEBOUNCE_MS);
+ * mdFileWatcherAdd(pWatcher, "engine/assets/shaders", MD_TRUE);
+ * ...
+ * struct MdFileWatchEvent events[16];
+ * u32 eventsCount = mdFileWatcherPoll(pWatcher, events, MD_ARRAY_SIZE(events)); // Once per frame.
+ * for (u32 i = 0; i < eventsCount; ++i)
+ * {
+ *     reloadAsset(events[i].path);
+ * }
+ * ...
+ * mdFileWatcherDestroy(pWatcher);
+ * ```
+ */
+
+#define MD_FILE_WATCHER_DEFAULT_DEBOUNCE_MS 100u
+#define MD_FILE_WATCHER_MAX_PATH_LENGTH		256u
+
+typedef u32 mdFileWatchId; ///< Identifies a watch added by `mdFileWatcherAdd`.
+
+#define MD_FILE_WATCH_INVALID_ID ((mdFileWatchId)0)
+
+enum MdFileWatchEventType
+{
+	MD_FILE_WATCH_EVENT_TYPE_CREATED,  ///< The file was created.
+	MD_FILE_WATCH_EVENT_TYPE_MODIFIED, ///< The file was written, or another file was renamed onto its path.
+	MD_FILE_WATCH_EVENT_TYPE_DELETED,  ///< The file was removed, or renamed to another path.
+	MD_FILE_WATCH_EVENT_TYPE_OVERFLOW, ///< Notifications were lost, everything under `path` may have changed.
+};
+
+/**
+ * A change of a watched file, after coalescing.
+ */
+struct MdFileWatchEvent
+{
+	mdFileWatchId			  watchId; ///< The watch which contains the file.
+	enum MdFileWatchEventType type;
+	char					  path[MD_FILE_WATCHER_MAX_PATH_LENGTH]; ///< The watched path joined with the file name.
+};
+
+/**
+ * The state of a file watcher.
+ */
+struct MdFileWatcher;
+
+/**
+ * Creates a file watcher.
+ * @param debounceMilliseconds The time a path must stay quiet before its event is reported.
+ * @return Pointer to the file watcher.
+ */
+struct MdFileWatcher* mdFileWatcherCreate(u32 debounceMilliseconds);
+
+/**
+ * Watches a file or a directory. A file keeps being watched when it is replaced by a rename, as editors do on save.
+ * @param pWatcher Pointer to the file watcher.
+ * @param path The path of the file or of the directory, copied.
+ * @param recursive For a directory, whether its subdirectories are watched too, including the ones created later.
+ * @return The identifier of the watch, or `MD_FILE_WATCH_INVALID_ID` if the path cannot be watched.
+ */
+mdFileWatchId mdFileWatcherAdd(struct MdFileWatcher* pWatcher, const char* path, b8 recursive);
+
+/**
+ * Stops a watch, its pending events are dropped.
+ * @param pWatcher Pointer to the file watcher.
+ * @param id The identifier returned by `mdFileWatcherAdd`.
+ */
+void mdFileWatcherRemove(struct MdFileWatcher* pWatcher, mdFileWatchId id);
+
+/**
+ * Reads the OS notifications without blocking and reports the events which stayed quiet for the debounce delay.
+ * @param pWatcher Pointer to the file watcher.
+ * @param pEvents Receives the events.
+ * @param maxEvents The capacity of `pEvents`, the remaining events are kept for the next poll.
+ * @return The number of events written into `pEvents`.
+ */
+u32 mdFileWatcherPoll(struct MdFileWatcher* pWatcher, struct MdFileWatchEvent* pEvents, u32 maxEvents);
+
+/**
+ * Destroys a file watcher and all its watches.
+ * @param pWatcher Pointer to the file watcher.
+ */
+void mdFileWatcherDestroy(struct MdFileWatcher* pWatcher);
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,136 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+#include "time.h"
+
+/**
+ * @file frame_loop.h
+ * Drives the main loop of an application: a fixed simulation timestep, an interpolation factor for the rendering
+ * and an optional target frame rate.
+ *
+ * The simulation advances by steps of exactly `fixedTimestep` seconds, the elapsed time accumulates between the
+ * frames and is consumed step by step, so the simulation does not depend on the frame rate. The remainder of the
+ * accumulator is given to the rendering as `alpha`, the fraction of a step to interpolate the last two simulation
+ * states with.
+ *
+ * With a target frame rate, every frame starts at a deadline: the loop sleeps until shortly before it and spins for
+ * the rest (see `mdSleepUntil`), the margin adapts to how late the scheduler wakes the thread up. The input is
+ * polled right after the wait, and once more before the rendering with the late latch, so the input is as recent as
+ * possible when the frame is recorded.
+ *
+ * @example
+ * ```c
+ * struct MdFrameLoopConfig config = mdFrameLoopGetDefaultConfig();
+ * config.targetFrameRate = 120.0;
+ *
+ * struct MdFrameLoopCallbacks callbacks = {pollInput, update, render, pGame};
+ * struct MdFrameLoop*         pLoop     = mdFrameLoopCreate(&config, &callbacks);
+ * while (isRunning)
+ * {
+ *     mdFrameLoopRunFrame(pLoop);
+ * }
+ * mdFrameLoopDestroy(pLoop);
+ * ```
+ */
+
+#ifndef MD_FRAME_LOOP_MAX_DELTA_SECONDS
+#define MD_FRAME_LOOP_MAX_DELTA_SECONDS 0.25 ///< Longer frames (breakpoint, loading) are clamped to it.
+#endif
+
+#define MD_FRAME_LOOP_MIN_SPIN_MICROSECONDS 50ull	///< The smallest margin spun before a deadline.
+#define MD_FRAME_LOOP_MAX_SPIN_MICROSECONDS 2000ull ///< The largest margin spun before a deadline.
+
+/**
+ * The settings of a frame loop.
+ */
+struct MdFrameLoopConfig
+{
+	f64 fixedTimestep;	  ///< The duration of a simulation step in seconds, 0 for one variable step per frame.
+	f64 targetFrameRate;  ///< The frames per second to pace the loop to, 0 to let the presentation (vsync) pace it.
+	u32 maxStepsPerFrame; ///< The simulation steps run at most per frame, the late time is dropped beyond.
+	b8	isLateLatched;	  ///< Polls the input a second time, right before the rendering.
+};
+
+/**
+ * The application side of a frame loop, the callbacks are optional.
+ */
+struct MdFrameLoopCallbacks
+{
+	void (*pollInput)(void* pUserData);				   ///< Polls the window events and the input devices.
+	void (*update)(f64 deltaSeconds, void* pUserData); ///< Advances the simulation by one step.
+	void (*render)(f64 alpha, void* pUserData);		   ///< Records and presents a frame, `alpha` is in [0, 1].
+	void* pUserData;								   ///< Given to every callback.
+};
+
+/**
+ * A frame loop, the fields are read-only for the callers.
+ */
+struct MdFrameLoop
+{
+	struct MdFrameLoopConfig	config;
+	struct MdFrameLoopCallbacks callbacks;
+	mdTicks						fixedStepTicks;	   ///< `fixedTimestep` in ticks, 0 for variable steps.
+	mdTicks						targetFrameTicks;  ///< The duration of a paced frame, 0 when the loop is not paced.
+	mdTicks						accumulatorTicks;  ///< The elapsed time not consumed by a simulation step yet.
+	mdTicks						lastFrameTicks;	   ///< When the last frame started, 0 before the first frame.
+	mdTicks						nextDeadlineTicks; ///< When the next paced frame starts.
+	mdTicks						spinTicks;		   ///< The margin spun before a deadline.
+	mdTicks						lastLatenessTicks; ///< How late the last paced frame started after its deadline.
+	f64							alpha;			   ///< The interpolation factor given to the last rendering.
+	u64							framesCount;	   ///< The frames run since the creation.
+	u64							stepsCount;		   ///< The simulation steps run since the creation.
+	u64							droppedStepsCount; ///< The simulation steps skipped by `maxStepsPerFrame`.
+};
+
+/**
+ * @brief Get the default settings: 60 simulation steps per second, at most 8 per frame, not paced, no late latch.
+ * @return The default settings.
+ */
+struct MdFrameLoopConfig mdFrameLoopGetDefaultConfig();
+
+/**
+ * @brief Create a frame loop.
+ * @param pConfig The settings, copied.
+ * @param pCallbacks The application callbacks, copied.
+ * @return Pointer to the frame loop.
+ */
+struct MdFrameLoop* mdFrameLoopCreate(const struct MdFrameLoopConfig* pConfig,
+									  const struct MdFrameLoopCallbacks* pCallbacks);
+
+/**
+ * @brief Run one frame: waits for the deadline of the frame when the loop is paced, then advances by the time
+ * elapsed since the previous frame. The first frame advances by 0.
+ * @param pLoop Pointer to the frame loop.
+ */
+void mdFrameLoopRunFrame(struct MdFrameLoop* pLoop);
+
+/**
+ * @brief Advance by an elapsed duration without waiting: polls the input, runs the simulation steps the duration
+ * completes, then renders. `mdFrameLoopRunFrame` calls it with the measured duration, the callers which own the
+ * timing (e.g. the browser main loop, the tests) call it directly.
+ * @param pLoop Pointer to the frame loop.
+ * @param elapsedTicks The time elapsed since the previous frame.
+ * @return The number of simulation steps run.
+ */
+u32 mdFrameLoopAdvance(struct MdFrameLoop* pLoop, mdTicks elapsedTicks);
+
+/**
+ * @brief Change the target frame rate, the next frame starts a new schedule.
+ * @param pLoop Pointer to the frame loop.
+ * @param targetFrameRate The frames per second, 0 to stop pacing the loop.
+ */
+void mdFrameLoopSetTargetFrameRate(struct MdFrameLoop* pLoop, f64 targetFrameRate);
+
+/**
+ * @brief Destroy a frame loop.
+ * @param pLoop Pointer to the frame loop.
+ */
+void mdFrameLoopDestroy(struct MdFrameLoop* pLoop);
+
+#if __cplusplus
+}
+#endif
@@ -0,0 +1,153 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+#include "file.h"
+
+/**
+ * @file pack.h
+ * The packed archives of the `MEEDEngine`. A pack stores many assets inside one file, so loading them costs one
+ * `open` and one mapping at startup instead of one `open` per asset.
+ *
+ * Layout of a pack, every integer is little-endian:
+ * - `MdPackHeader` at offset 0.
+ * - The data of the entries, each one starting at a multiple of the pack alignment.
+ * - The table of contents: `entriesCount` `MdPackEntry` sorted by path hash, searched with a binary search.
+ * - The names: the paths of the entries, not null-terminated, used to resolve hash collisions.
+ *
+ * Once mounted, the paths starting with the mount point are resolved inside the pack by `mdFileOpen`. The read modes
+ * of the packed files behave like those of regular files, `MD_FILE_MODE_READ_MAPPED` points into the pack mapping
+ * without any copy for the uncompressed entries. The write modes always target the regular file system.
+ *
+ * @example
+ * ```c
+ * mdPackMount(MD_STRINGIFY(PROJECT_BASE_DIR) "/app/build/debug/assets.pack", "assets");
+ * struct MdFileData* pShader = mdFileOpen("assets/shaders/vulkan/triangle.vert.spv", MD_FILE_MODE_READ_MAPPED);
+ * ...
+ * mdFileClose(pShader);
+ * mdPackUnmount("assets");
+ * ```
+ */
+
+#define MD_PACK_MAGIC			  0x4B50444Du ///< "MDPK".
+#define MD_PACK_VERSION			  1u
+#define MD_PACK_DEFAULT_ALIGNMENT 64u ///< The cache line size, the entries can be read with aligned loads.
+
+/**
+ * The flags of a packed entry.
+ */
+enum MdPackEntryFlags
+{
+	MD_PACK_ENTRY_FLAG_NONE		  = 0,
+	MD_PACK_ENTRY_FLAG_COMPRESSED = 1 << 0, ///< The data is LZ compressed, `storedSize` differs from `size`.
+};
+
+/**
+ * The header at the beginning of a pack.
+ */
+struct MdPackHeader
+{
+	u32 magic;		  ///< Always `MD_PACK_MAGIC`.
+	u32 version;	  ///< Always `MD_PACK_VERSION`.
+	u32 entriesCount; ///< The number of entries of the table of contents.
+	u32 alignment;	  ///< The alignment of the entries data, a power of two.
+	u64 tocOffset;	  ///< The position of the table of contents.
+	u64 namesOffset;  ///< The position of the names.
+	u64 namesSize;	  ///< The size of the names in bytes.
+};
+
+/**
+ * One entry of the table of contents.
+ */
+struct MdPackEntry
+{
+	u64 pathHash;	///< The hash of the path, see `mdPackHashPath`.
+	u64 offset;		///< The position of the data inside the pack.
+	u64 size;		///< The size of the file once decompressed.
+	u64 storedSize; ///< The size of the data inside the pack.
+	u32 nameOffset; ///< The position of the path inside the names.
+	u16 nameLength; ///< The length of the path.
+	u16 flags;		///< A combination of `MdPackEntryFlags`.
+};
+
+/**
+ * Builds a pack, the data is written as the entries are added and the table of contents is written at the end.
+ */
+struct MdPackWriter;
+
+/**
+ * Hashes the path of an entry (64-bit FNV-1a).
+ * @param path The path relative to the mount point, with '/' separators.
+ * @return The hash of the path.
+ */
+u64 mdPackHashPath(const char* path);
+
+/**
+ * Creates a pack writer.
+ * @param packPath The path of the pack to write, replaced if it exists.
+ * @param alignment The alignment of the entries data, a power of two, 0 for `MD_PACK_DEFAULT_ALIGNMENT`.
+ * @return Pointer to the pack writer, or `MD_NULL` if the file cannot be created.
+ */
+struct MdPackWriter* mdPackWriterCreate(const char* packPath, u32 alignment);
+
+/**
+ * Adds an entry from memory.
+ * @param pWriter Pointer to the pack writer.
+ * @param path The path of the entry relative to the mount point, copied.
+ * @param pData Pointer to the data of the entry.
+ * @param size The size of the data in bytes.
+ * @param compress Whether the data is compressed, it is stored as is when the compression does not save space.
+ */
+void mdPackWriterAddData(struct MdPackWriter* pWriter, const char* path, const void* pData, u64 size, b8 compress);
+
+/**
+ * Adds an entry from a file.
+ * @param pWriter Pointer to the pack writer.
+ * @param path The path of the entry relative to the mount point, copied.
+ * @param sourcePath The path of the file to add.
+ * @param compress Whether the data is compressed, see `mdPackWriterAddData`.
+ * @return MD_TRUE if the file was added, MD_FALSE if it cannot be read.
+ */
+b8 mdPackWriterAddFile(struct MdPackWriter* pWriter, const char* path, const char* sourcePath, b8 compress);
+
+/**
+ * Writes the table of contents and the header, then destroys the pack writer.
+ * @param pWriter Pointer to the pack writer.
+ */
+void mdPackWriterFinish(struct MdPackWriter* pWriter);
+
+/**
+ * Destroys the pack writer without writing the pack, a previous pack at the same path is left as it was.
+ * @param pWriter Pointer to the pack writer.
+ */
+void mdPackWriterDiscard(struct MdPackWriter* pWriter);
+
+/**
+ * Mounts a pack, the pack file is opened and mapped once and stays mapped until it is unmounted. The packs mounted
+ * last are searched first, so a patch pack can override the entries of a base pack.
+ * @param packPath The path of the pack.
+ * @param mountPoint The prefix of the paths resolved inside the pack (e.g. "assets" for "assets/shaders/a.vert"),
+ * an empty string resolves every relative path. Copied.
+ * @return MD_TRUE if the pack was mounted, MD_FALSE if it cannot be opened or is not a valid pack.
+ */
+b8 mdPackMount(const char* packPath, const char* mountPoint);
+
+/**
+ * Unmounts the pack mounted last at a mount point. Every file opened from it must be closed.
+ * @param mountPoint The mount point given to `mdPackMount`.
+ */
+void mdPackUnmount(const char* mountPoint);
+
+/**
+ * Finds the entry of a path inside the mounted packs.
+ * @param path The path as given to `mdFileOpen`.
+ * @return Pointer to the entry inside the pack mapping, or `MD_NULL` if no mounted pack contains the path.
+ */
+const struct MdPackEntry* mdPackFindEntry(const char* path);
+
+#if __cplusplus
+}
+#endif
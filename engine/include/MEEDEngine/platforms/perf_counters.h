@@ -0,0 +1,121 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+
+/**
+ * @file perf_counters.h
+ * Hardware performance counters around a code region: cycles, instructions, cache misses and branch misses. They
+ * explain a wall time (e.g. a container layout which misses the cache) where a timer only measures it.
+ *
+ * On Linux the counters are read with `perf_event_open`, as one group so every counter covers exactly the same
+ * instructions. The counters are often unavailable: in containers, virtual machines, or when
+ * `/proc/sys/kernel/perf_event_paranoid` forbids them. The API then keeps working and reports the counters as
+ * unavailable, the callers do not need any platform check.
+ *
+ * @example
+ * ```c
+ * struct MdPerfCounters* pCounters = mdPerfCountersCreate();
+ * mdPerfCountersStart(pCounters);
+ * work();
+ * mdPerfCountersStop(pCounters);
+ *
+ * struct MdPerfCounterValues values;
+ * mdPerfCountersRead(pCounters, &values);
+ * if (values.availableMask & MD_PERF_COUNTER_BIT(MD_PERF_COUNTER_INSTRUCTIONS))
+ * {
+ *     mdFormatPrint("IPC: %.2f\n", mdPerfCountersGetIPC(&values));
+ * }
+ * mdPerfCountersDestroy(pCounters);
+ * ```
+ */
+
+/**
+ * The sampled counters, only the user space is counted.
+ */
+enum MdPerfCounter
+{
+	MD_PERF_COUNTER_CYCLES,		   ///< CPU cycles.
+	MD_PERF_COUNTER_INSTRUCTIONS,  ///< Retired instructions.
+	MD_PERF_COUNTER_L1D_MISSES,	   ///< Level 1 data cache read misses.
+	MD_PERF_COUNTER_LLC_MISSES,	   ///< Last level cache misses, the accesses which go to the memory.
+	MD_PERF_COUNTER_BRANCH_MISSES, ///< Mispredicted branches.
+	MD_PERF_COUNTER_COUNT,
+};
+
+#define MD_PERF_COUNTER_BIT(counter) (1u << (counter)) ///< The bit of a counter in `availableMask`.
+
+/**
+ * The values counted between `mdPerfCountersStart` and `mdPerfCountersStop`.
+ */
+struct MdPerfCounterValues
+{
+	u64 values[MD_PERF_COUNTER_COUNT]; ///< Indexed by `MdPerfCounter`, 0 for the unavailable counters.
+	u32 availableMask;				   ///< The `MD_PERF_COUNTER_BIT` of the counters which were measured.
+	b8	isScaled; ///< The kernel shared the hardware with other counters, the values are extrapolated.
+};
+
+/**
+ * An opaque group of counters.
+ */
+struct MdPerfCounters;
+
+/**
+ * @brief Opens the counters supported by the CPU and allowed by the system, the counters do not count yet.
+ * @return Pointer to the counters, never MD_NULL even when no counter is available.
+ */
+struct MdPerfCounters* mdPerfCountersCreate();
+
+/**
+ * @brief Checks whether a counter can be measured.
+ * @param pCounters Pointer to the counters.
+ * @param counter The counter to check.
+ * @return MD_TRUE if the counter was opened, MD_FALSE otherwise.
+ */
+b8 mdPerfCountersIsAvailable(const struct MdPerfCounters* pCounters, enum MdPerfCounter counter);
+
+/**
+ * @brief Resets the counters to zero and starts counting.
+ * @param pCounters Pointer to the counters.
+ */
+void mdPerfCountersStart(struct MdPerfCounters* pCounters);
+
+/**
+ * @brief Stops counting, the values are kept until the next start.
+ * @param pCounters Pointer to the counters.
+ */
+void mdPerfCountersStop(struct MdPerfCounters* pCounters);
+
+/**
+ * @brief Reads the values counted since the last start.
+ * @param pCounters Pointer to the counters.
+ * @param pValues Receives the values.
+ */
+void mdPerfCountersRead(struct MdPerfCounters* pCounters, struct MdPerfCounterValues* pValues);
+
+/**
+ * @brief Destroys the counters.
+ * @param pCounters Pointer to the counters.
+ */
+void mdPerfCountersDestroy(struct MdPerfCounters* pCounters);
+
+/**
+ * @brief Computes the instructions per cycle.
+ * @param pValues The values read from the counters.
+ * @return The instructions per cycle, 0 when the cycles or the instructions are unavailable.
+ */
+f64 mdPerfCountersGetIPC(const struct MdPerfCounterValues* pValues);
+
+/**
+ * @brief Gets the name of a counter.
+ * @param counter The counter.
+ * @return The name of the counter, e.g. "cycles".
+ */
+const char* mdPerfCounterGetName(enum MdPerfCounter counter);
+
+#if __cplusplus
+}
+#endif
@@ -1,6 +1,14 @@
 #include "common.h"
 #include "console.h"
+#include "fiber.h"
 #include "file.h"
+#include "file_async.h"
+#include "file_watcher.h"
+#include "frame_loop.h"
 #include "memory.h"
+#include "pack.h"
+#include "perf_counters.h"
+#include "profile.h"
+#include "thread.h"
 #include "time.h"
 #include "window.h"
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+#include "time.h"
+
+/**
+ * @file profile.h
+ * The instrumented profiler of the `MEEDEngine`: named zones measured with the monotonic clock, exported as a
+ * Chrome Trace Event file which can be opened in Perfetto (https://ui.perfetto.dev) or `chrome://tracing`.
+ *
+ * Each thread writes its events into its own buffer, without any lock nor atomic read-modify-write, so a zone costs
+ * two clock reads and two stores. The events are only recorded during a capture, which covers whole frames: it
+ * starts at a frame mark and stops after the requested number of frames.
+ *
+ * The macros compile to nothing when `MD_PROFILE_ENABLED` is 0, the functions stay available.
+ *
+ * @example
+ * ```c
+ * mdProfileCaptureStart(120);
+ * while (isRunning)
+ * {
+ *     MD_PROFILE_FRAME_MARK();
+ *     MD_PROFILE_SCOPE("Update"); // Ends with the enclosing block.
+ *     update();
+ * }
+ * mdProfileExportChromeTrace("profile.json");
+ * mdProfileShutdown();
+ * ```
+ */
+
+/**
+ * Whether the profiling macros are compiled in, enabled by default in debug. Can be overridden with a compile
+ * definition.
+ */
+#ifndef MD_PROFILE_ENABLED
+#if MD_DEBUG
+#define MD_PROFILE_ENABLED 1
+#else
+#define MD_PROFILE_ENABLED 0
+#endif
+#endif
+
+#define MD_PROFILE_THREAD_EVENTS_CAPACITY (64u * 1024u) ///< The events kept per thread during one capture.
+
+/**
+ * Opens a zone on the calling thread.
+ * @param name The name of the zone, must stay valid until the export (usually a string literal).
+ */
+void mdProfileBegin(const char* name);
+
+/**
+ * Closes the zone opened last on the calling thread.
+ */
+void mdProfileEnd();
+
+/**
+ * Marks the start of a frame, called once per frame by the main loop. Starts and stops the captures.
+ */
+void mdProfileFrameMark();
+
+/**
+ * Requests a capture, the events are recorded from the next frame mark on, the events of the previous capture are
+ * discarded.
+ * @param framesCount The number of frames to capture, 0 to capture until `mdProfileCaptureStop`.
+ */
+void mdProfileCaptureStart(u32 framesCount);
+
+/**
+ * Stops the current capture, the recorded events are kept for the export.
+ */
+void mdProfileCaptureStop();
+
+/**
+ * Checks whether the events are currently recorded.
+ * @return MD_TRUE during a capture, MD_FALSE otherwise.
+ */
+b8 mdProfileIsCapturing();
+
+/**
+ * Writes the events of the last capture in the Chrome Trace Event format, the capture must be stopped. The zones
+ * still open when the capture stopped are closed at the last event of their thread.
+ * @param filePath The path of the JSON file to write.
+ * @return MD_TRUE if the file was written, MD_FALSE if it cannot be created.
+ */
+b8 mdProfileExportChromeTrace(const char* filePath);
+
+/**
+ * Releases the buffers of every thread, the other threads must not record events anymore.
+ */
+void mdProfileShutdown();
+
+/**
+ * Used by `MD_PROFILE_SCOPE` to close the zone when the variable goes out of scope.
+ */
+void mdProfileScopeEnd(const char** pName);
+
+#if MD_PROFILE_ENABLED
+/**
+ * Profiles the rest of the enclosing block (relies on the `cleanup` attribute of GCC and Clang).
+ */
+#define MD_PROFILE_SCOPE(name)                                                                                         \
+	const char* MD_CONCAT(_mdProfileScope, __LINE__) __attribute__((cleanup(mdProfileScopeEnd), unused)) = (name);     \
+	mdProfileBegin(name)
+#define MD_PROFILE_BEGIN(name)	 mdProfileBegin(name)
+#define MD_PROFILE_END()		 mdProfileEnd()
+#define MD_PROFILE_FRAME_MARK() mdProfileFrameMark()
+#else
+#define MD_PROFILE_SCOPE(name)
+#define MD_PROFILE_BEGIN(name)                                                                                         \
+	do                                                                                                                 \
+	{                                                                                                                  \
+	} while (0)
+#define MD_PROFILE_END()                                                                                               \
+	do                                                                                                                 \
+	{                                                                                                                  \
+	} while (0)
+#define MD_PROFILE_FRAME_MARK()                                                                                        \
+	do                                                                                                                 \
+	{                                                                                                                  \
+	} while (0)
+#endif
+
+#if __cplusplus
+}
+#endif
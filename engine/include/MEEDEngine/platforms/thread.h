@@ -0,0 +1,395 @@
+#pragma once
+
+#if __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+#include "time.h"
+
+/**
+ * @file thread.h
+ * Threads and the synchronization primitives every multithreaded feature of the engine builds on: mutexes, an
+ * adaptive spinlock, condition variables, counting semaphores, atomics and thread-local storage.
+ *
+ * The mutexes, condition variables and semaphores are stored by value, inside the structure which uses them, and
+ * are initialized and destroyed explicitly. The spinlock needs no initialization: a zeroed spinlock is unlocked.
+ *
+ * The browser build has no threads: `mdThreadCreate` fails, the locks always succeed and a wait which would block
+ * forever is an error.
+ *
+ * @example
+ * ```c
+ * struct Shared { struct MdMutex mutex; u32 counter; };
+ *
+ * static void work(void* pArgument)
+ * {
+ *     struct Shared* pShared = (struct Shared*)pArgument;
+ *     mdMutexLock(&pShared->mutex);
+ *     ++pShared->counter;
+ *     mdMutexUnlock(&pShared->mutex);
+ * }
+ *
+ * struct Shared shared = {0};
+ * mdMutexInitialize(&shared.mutex);
+ * struct MdThread* pThread = mdThreadCreate(work, &shared, "Worker");
+ * mdThreadJoin(pThread);
+ * mdMutexDestroy(&shared.mutex);
+ * ```
+ */
+
+#define MD_THREAD_NAME_MAX_LENGTH 15u ///< Longer names are truncated, the Linux limit.
+
+/**
+ * Declares a variable with one instance per thread, e.g. `static MD_THREAD_LOCAL u32 s_depth;`.
+ */
+#define MD_THREAD_LOCAL __thread
+
+// ================ Atomics ================
+
+/**
+ * The memory orders of the atomic operations, the same as the C11 `memory_order`.
+ */
+enum MdMemoryOrder
+{
+	MD_MEMORY_ORDER_RELAXED = __ATOMIC_RELAXED, ///< Only the operation itself is atomic.
+	MD_MEMORY_ORDER_ACQUIRE = __ATOMIC_ACQUIRE, ///< The later accesses are not moved before the operation.
+	MD_MEMORY_ORDER_RELEASE = __ATOMIC_RELEASE, ///< The earlier accesses are not moved after the operation.
+	MD_MEMORY_ORDER_ACQ_REL = __ATOMIC_ACQ_REL, ///< Both acquire and release.
+	MD_MEMORY_ORDER_SEQ_CST = __ATOMIC_SEQ_CST, ///< A single total order with the other sequentially consistent ones.
+};
+
+/**
+ * The atomic operations on integers and pointers of 1, 2, 4 or 8 bytes, like the C11 `atomic_*_explicit`
+ * functions. The objects are plain variables, only accessed through these operations.
+ */
+#define MD_ATOMIC_LOAD(pObject, order)				__atomic_load_n((pObject), (order))
+#define MD_ATOMIC_STORE(pObject, value, order)		__atomic_store_n((pObject), (value), (order))
+#define MD_ATOMIC_EXCHANGE(pObject, value, order)	__atomic_exchange_n((pObject), (value), (order))
+#define MD_ATOMIC_FETCH_ADD(pObject, value, order)	__atomic_fetch_add((pObject), (value), (order))
+#define MD_ATOMIC_FETCH_SUB(pObject, value, order)	__atomic_fetch_sub((pObject), (value), (order))
+#define MD_ATOMIC_FETCH_AND(pObject, value, order)	__atomic_fetch_and((pObject), (value), (order))
+#define MD_ATOMIC_FETCH_OR(pObject, value, order)	__atomic_fetch_or((pObject), (value), (order))
+#define MD_ATOMIC_THREAD_FENCE(order)				__atomic_thread_fence(order)
+
+/**
+ * Replaces `*pObject` with `desired` if it equals `*pExpected`, otherwise loads it into `*pExpected`. Evaluates to
+ * whether the object was replaced. The weak form may fail spuriously, it is cheaper inside a retry loop.
+ */
+#define MD_ATOMIC_COMPARE_EXCHANGE(pObject, pExpected, desired, successOrder, failureOrder)                            \
+	__atomic_compare_exchange_n((pObject), (pExpected), (desired), 0, (successOrder), (failureOrder))
+#define MD_ATOMIC_COMPARE_EXCHANGE_WEAK(pObject, pExpected, desired, successOrder, failureOrder)                       \
+	__atomic_compare_exchange_n((pObject), (pExpected), (desired), 1, (successOrder), (failureOrder))
+
+/**
+ * Tells the CPU the thread is spinning on a lock, which saves power and lets the other hyper-thread of the core run.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#define MD_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define MD_CPU_RELAX() __asm__ volatile("yield")
+#else
+#define MD_CPU_RELAX() ((void)0)
+#endif
+
+// ================ Threads ================
+
+typedef void (*MdThreadFunction)(void* pArgument);
+
+/**
+ * An opaque running thread.
+ */
+struct MdThread;
+
+/**
+ * @brief Starts a thread.
+ * @param function The function the thread runs.
+ * @param pArgument Given to the function.
+ * @param name The name shown by the debuggers and profilers, MD_NULL for none.
+ * @return Pointer to the thread, MD_NULL when the platform cannot start one.
+ */
+struct MdThread* mdThreadCreate(MdThreadFunction function, void* pArgument, const char* name);
+
+/**
+ * @brief Waits for a thread to return, then releases it.
+ * @param pThread Pointer to the thread.
+ */
+void mdThreadJoin(struct MdThread* pThread);
+
+/**
+ * @brief Names the calling thread.
+ * @param name The name, truncated to `MD_THREAD_NAME_MAX_LENGTH` characters.
+ */
+void mdThreadSetCurrentName(const char* name);
+
+/**
+ * @brief Gets the id of the calling thread, the one the system tools (`top -H`, `perf`, `gdb`) show.
+ * @return The id of the thread, unique among the running threads of the system.
+ */
+mdPid mdThreadGetCurrentId();
+
+/**
+ * @brief Gives the rest of the time slice of the calling thread to the other threads.
+ */
+void mdThreadYield();
+
+/**
+ * @brief Gets the number of threads the hardware runs at once: the logical cores available to the process.
+ * @return The number of logical cores, at least 1.
+ */
+u32 mdThreadGetHardwareConcurrency();
+
+// ================ CPU Topology ================
+
+#define MD_CPU_TOPOLOGY_MAX_LOGICAL_CORES 256u ///< The logical cores described, the next ones are left out.
+
+/**
+ * A logical core (a hardware thread) and the hardware it shares with the other logical cores. The indices number
+ * the groups of the topology densely, from 0.
+ */
+struct MdLogicalCore
+{
+	u32 cpuId;			   ///< The number of the core for the system (`cpuN`), the one the affinity uses.
+	u32 physicalCoreIndex; ///< The physical core, shared by the SMT siblings.
+	u32 siblingIndex;	   ///< The rank among the SMT siblings of the physical core, 0 for the first.
+	u32 l2GroupIndex;	   ///< The logical cores which share an L2 cache.
+	u32 l3GroupIndex;	   ///< The logical cores which share an L3 cache, the package when it has none.
+	u32 packageIndex;	   ///< The socket.
+};
+
+/**
+ * The logical cores available to the process, and how they share the physical cores and the caches.
+ */
+struct MdCpuTopology
+{
+	u32					 logicalCoresCount;
+	u32					 physicalCoresCount;
+	u32					 l2GroupsCount;
+	u32					 l3GroupsCount;
+	u32					 packagesCount;
+	u64					 l2CacheSize; ///< The size of one L2 cache in bytes, 0 when unknown.
+	u64					 l3CacheSize; ///< The size of one L3 cache in bytes, 0 when unknown.
+	struct MdLogicalCore logicalCores[MD_CPU_TOPOLOGY_MAX_LOGICAL_CORES]; ///< By package, L3, L2, physical core.
+};
+
+/**
+ * @brief Detects the topology of the logical cores available to the process (see `mdThreadGetHardwareConcurrency`).
+ * On Linux it is read from `/sys/devices/system/cpu`, each logical core is its own physical core when it cannot be.
+ * The browser build describes a single core.
+ * @param pTopology Receives the topology, the logical cores ordered so that the ones which share hardware follow
+ * each other.
+ */
+void mdThreadGetCpuTopology(struct MdCpuTopology* pTopology);
+
+/**
+ * @brief Pins the calling thread to one logical core: the scheduler stops moving it, and its caches stay warm. The
+ * threads it starts afterwards are not pinned, and the topology still describes every core of the process.
+ * @param cpuId The `cpuId` of a logical core of the topology.
+ * @return MD_TRUE if the thread is pinned, MD_FALSE when the core is not available or the platform cannot pin.
+ */
+b8 mdThreadSetCurrentAffinity(u32 cpuId);
+
+// ================ Mutex ================
+
+/**
+ * A mutual exclusion lock which puts the waiting threads to sleep, not recursive.
+ */
+struct MdMutex
+{
+	u64 storage[8]; ///< The platform lock.
+};
+
+/**
+ * @brief Initializes a mutex, unlocked.
+ * @param pMutex Pointer to the mutex.
+ */
+void mdMutexInitialize(struct MdMutex* pMutex);
+
+/**
+ * @brief Destroys a mutex, which must be unlocked.
+ * @param pMutex Pointer to the mutex.
+ */
+void mdMutexDestroy(struct MdMutex* pMutex);
+
+/**
+ * @brief Locks a mutex, sleeps while another thread holds it.
+ * @param pMutex Pointer to the mutex.
+ */
+void mdMutexLock(struct MdMutex* pMutex);
+
+/**
+ * @brief Locks a mutex if no other thread holds it.
+ * @param pMutex Pointer to the mutex.
+ * @return MD_TRUE if the mutex was locked, MD_FALSE at once otherwise.
+ */
+b8 mdMutexTryLock(struct MdMutex* pMutex);
+
+/**
+ * @brief Unlocks a mutex held by the calling thread.
+ * @param pMutex Pointer to the mutex.
+ */
+void mdMutexUnlock(struct MdMutex* pMutex);
+
+// ================ Spinlock ================
+
+#define MD_SPINLOCK_SPINS_BEFORE_YIELD 64u ///< The failed attempts after which a waiting thread yields.
+
+/**
+ * A lock which the waiting threads spin on, for the sections of a few instructions where sleeping and waking a
+ * thread up costs more than the wait. The backoff doubles the pauses between the attempts, then yields the thread
+ * when the lock stays held, e.g. when its owner was preempted.
+ */
+struct MdSpinlock
+{
+	u32 isLocked;
+};
+
+/**
+ * @brief Locks a spinlock, spins then yields while another thread holds it.
+ * @param pSpinlock Pointer to the spinlock.
+ */
+void mdSpinlockLock(struct MdSpinlock* pSpinlock);
+
+/**
+ * @brief Locks a spinlock if no other thread holds it.
+ * @param pSpinlock Pointer to the spinlock.
+ * @return MD_TRUE if the spinlock was locked, MD_FALSE at once otherwise.
+ */
+b8 mdSpinlockTryLock(struct MdSpinlock* pSpinlock);
+
+/**
+ * @brief Unlocks a spinlock held by the calling thread.
+ * @param pSpinlock Pointer to the spinlock.
+ */
+void mdSpinlockUnlock(struct MdSpinlock* pSpinlock);
+
+// ================ Condition Variable ================
+
+/**
+ * Puts threads to sleep until another thread signals a change of a state protected by a mutex. The waits may wake
+ * up spuriously: the state is checked again in a loop.
+ */
+struct MdConditionVariable
+{
+	u64 storage[8]; ///< The platform condition variable.
+};
+
+/**
+ * @brief Initializes a condition variable, its waits are measured on the monotonic clock.
+ * @param pCondition Pointer to the condition variable.
+ */
+void mdConditionVariableInitialize(struct MdConditionVariable* pCondition);
+
+/**
+ * @brief Destroys a condition variable no thread waits on.
+ * @param pCondition Pointer to the condition variable.
+ */
+void mdConditionVariableDestroy(struct MdConditionVariable* pCondition);
+
+/**
+ * @brief Releases the mutex, sleeps until the condition is signaled, then locks the mutex again.
+ * @param pCondition Pointer to the condition variable.
+ * @param pMutex Pointer to the mutex, locked by the calling thread.
+ */
+void mdConditionVariableWait(struct MdConditionVariable* pCondition, struct MdMutex* pMutex);
+
+/**
+ * @brief Like `mdConditionVariableWait`, but gives up after a timeout.
+ * @param pCondition Pointer to the condition variable.
+ * @param pMutex Pointer to the mutex, locked by the calling thread.
+ * @param timeoutTicks The longest wait.
+ * @return MD_FALSE if the wait timed out, MD_TRUE otherwise.
+ */
+b8 mdConditionVariableWaitFor(struct MdConditionVariable* pCondition, struct MdMutex* pMutex, mdTicks timeoutTicks);
+
+/**
+ * @brief Wakes one of the waiting threads up.
+ * @param pCondition Pointer to the condition variable.
+ */
+void mdConditionVariableSignal(struct MdConditionVariable* pCondition);
+
+/**
+ * @brief Wakes every waiting thread up.
+ * @param pCondition Pointer to the condition variable.
+ */
+void mdConditionVariableBroadcast(struct MdConditionVariable* pCondition);
+
+// ================ Semaphore ================
+
+/**
+ * A counter the waiting threads decrement, sleeping while it is zero.
+ */
+struct MdSemaphore
+{
+	u64 storage[4]; ///< The platform semaphore.
+};
+
+/**
+ * @brief Initializes a semaphore.
+ * @param pSemaphore Pointer to the semaphore.
+ * @param initialCount The initial count.
+ */
+void mdSemaphoreInitialize(struct MdSemaphore* pSemaphore, u32 initialCount);
+
+/**
+ * @brief Destroys a semaphore no thread waits on.
+ * @param pSemaphore Pointer to the semaphore.
+ */
+void mdSemaphoreDestroy(struct MdSemaphore* pSemaphore);
+
+/**
+ * @brief Sleeps until the count is positive, then decrements it.
+ * @param pSemaphore Pointer to the semaphore.
+ */
+void mdSemaphoreWait(struct MdSemaphore* pSemaphore);
+
+/**
+ * @brief Decrements the count if it is positive.
+ * @param pSemaphore Pointer to the semaphore.
+ * @return MD_TRUE if the count was decremented, MD_FALSE at once otherwise.
+ */
+b8 mdSemaphoreTryWait(struct MdSemaphore* pSemaphore);
+
+/**
+ * @brief Increments the count, which wakes up to `count` waiting threads.
+ * @param pSemaphore Pointer to the semaphore.
+ * @param count The increment.
+ */
+void mdSemaphorePost(struct MdSemaphore* pSemaphore, u32 count);
+
+// ================ Thread-local Storage ================
+
+typedef u32 mdThreadLocalKey;
+
+/**
+ * @brief Creates a slot with one value per thread, for the values created at run time (`MD_THREAD_LOCAL` covers the
+ * static ones). The value of every thread starts as MD_NULL.
+ * @param pKey Receives the key of the slot.
+ * @param destructor Called with the non-null value of a thread when the thread exits, MD_NULL for none.
+ * @return MD_FALSE when the system has no free slot.
+ */
+b8 mdThreadLocalCreate(mdThreadLocalKey* pKey, void (*destructor)(void*));
+
+/**
+ * @brief Destroys a slot, the destructor is not called for the values left.
+ * @param key The key of the slot.
+ */
+void mdThreadLocalDestroy(mdThreadLocalKey key);
+
+/**
+ * @brief Gets the value of the calling thread.
+ * @param key The key of the slot.
+ * @return The value, MD_NULL when the thread did not set one.
+ */
+void* mdThreadLocalGet(mdThreadLocalKey key);
+
+/**
+ * @brief Sets the value of the calling thread.
+ * @param key The key of the slot.
+ * @param pValue The value.
+ */
+void mdThreadLocalSet(mdThreadLocalKey key, void* pValue);
+
+#if __cplusplus
+}
+#endif
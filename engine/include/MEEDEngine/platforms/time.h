@@ -9,6 +9,10 @@ extern "C" {
 /**
  * @file time.h
  * @brief Platform-independent time utilities.
+ *
+ * The UNIX timestamps give the calendar time with a one second resolution. The ticks come from a monotonic clock
+ * with a nanosecond resolution, they are used to measure durations (frames, profiling zones, timeouts) and are not
+ * affected by changes of the system time.
  */
 struct MdTime
 {
@@ -84,6 +88,131 @@ f64 mdGetTimeDifferenceInMilliseconds(mdUNIXTime start, mdUNIXTime end);
  */
 f64 mdGetTimeDifferenceInMicroseconds(mdUNIXTime start, mdUNIXTime end);
 
+typedef u64 mdTicks; ///< Type representing a point of the monotonic clock, in nanoseconds since an arbitrary origin.
+
+#define MD_TICKS_PER_SECOND		 1000000000ull
+#define MD_TICKS_PER_MILLISECOND 1000000ull
+#define MD_TICKS_PER_MICROSECOND 1000ull
+
+/**
+ * @brief Get the current point of the monotonic clock (`CLOCK_MONOTONIC` on POSIX).
+ * @return The current ticks, only meaningful when compared with other ticks of the same process.
+ */
+mdTicks mdGetTicks();
+
+/**
+ * @brief Convert a duration in ticks to seconds.
+ * @param ticks The duration in ticks.
+ * @return The duration in seconds.
+ */
+f64 mdTicksToSeconds(mdTicks ticks);
+
+/**
+ * @brief Convert a duration in ticks to milliseconds.
+ * @param ticks The duration in ticks.
+ * @return The duration in milliseconds.
+ */
+f64 mdTicksToMilliseconds(mdTicks ticks);
+
+/**
+ * @brief Convert a duration in seconds to ticks.
+ * @param seconds The duration in seconds, must be positive.
+ * @return The duration in ticks.
+ */
+mdTicks mdSecondsToTicks(f64 seconds);
+
+/**
+ * @brief Wait until a point of the monotonic clock with a sub-millisecond precision. The thread sleeps until
+ * `spinTicks` before the deadline, then spins on the clock: the scheduler wakes a sleeping thread up late by a
+ * variable amount, the spin absorbs it.
+ * @param deadlineTicks The point of the monotonic clock to wait for, returns at once when it is already past.
+ * @param spinTicks How long before the deadline to stop sleeping and start spinning, 0 to only sleep.
+ * @return How late the scheduler woke the thread up after the sleep, 0 when the thread did not sleep. Callers
+ * adapt `spinTicks` to it.
+ */
+mdTicks mdSleepUntil(mdTicks deadlineTicks, mdTicks spinTicks);
+
+#define MD_FRAME_TIMER_DEFAULT_WINDOW 240u ///< Four seconds at 60 frames per second.
+
+/**
+ * Measures the frames: the last delta time and statistics over a sliding window of the last frames. The statistics
+ * expose the frame time spikes which an average alone hides.
+ */
+struct MdFrameTimer
+{
+	mdTicks	 lastTicks;	   ///< When `mdFrameTimerTick` was last called, 0 before the first call.
+	mdTicks	 deltaTicks;   ///< The duration of the last frame.
+	mdTicks	 windowTicks;  ///< The sum of the samples of the window, for the moving average.
+	mdTicks* pSamples;	   ///< The durations of the last frames, a ring buffer of `windowSize` elements.
+	mdTicks* pSorted;	   ///< Scratch buffer used to compute the percentiles.
+	u32		 windowSize;   ///< The number of frames of the window.
+	u32		 samplesCount; ///< The number of valid samples, up to `windowSize`.
+	u32		 nextSample;   ///< The index of the ring buffer which receives the next sample.
+	u64		 framesCount;  ///< The number of frames measured since the creation.
+};
+
+/**
+ * The statistics of a frame timer, in milliseconds.
+ */
+struct MdFrameTimerStats
+{
+	f64 deltaMilliseconds;	 ///< The duration of the last frame.
+	f64 averageMilliseconds; ///< The average frame duration over the window.
+	f64 minMilliseconds;	 ///< The shortest frame of the window.
+	f64 maxMilliseconds;	 ///< The longest frame of the window.
+	f64 p95Milliseconds;	 ///< 95% of the frames of the window are at most this long.
+	f64 p99Milliseconds;	 ///< 99% of the frames of the window are at most this long.
+	u32 samplesCount;		 ///< The number of frames the statistics are computed from.
+};
+
+/**
+ * @brief Create a frame timer.
+ * @param windowSize The number of frames of the statistics window, 0 for `MD_FRAME_TIMER_DEFAULT_WINDOW`.
+ * @return Pointer to the frame timer.
+ *
+ * @example
+ * ```c
+ * struct MdFrameTimer* pTimer = mdFrameTimerCreate(0);
+ * while (isRunning)
+ * {
+ *     f64 deltaSeconds = mdFrameTimerTick(pTimer); // Once per frame.
+ *     update(deltaSeconds);
+ * }
+ * struct MdFrameTimerStats stats;
+ * mdFrameTimerGetStats(pTimer, &stats);
+ * mdFrameTimerDestroy(pTimer);
+ * ```
+ */
+struct MdFrameTimer* mdFrameTimerCreate(u32 windowSize);
+
+/**
+ * @brief Mark the start of a new frame, the time elapsed since the previous call is recorded as a frame.
+ * @param pTimer Pointer to the frame timer.
+ * @return The duration of the frame which just ended in seconds, 0 on the first call.
+ */
+f64 mdFrameTimerTick(struct MdFrameTimer* pTimer);
+
+/**
+ * @brief Record a frame duration measured by the caller, `mdFrameTimerTick` calls it with the measured delta.
+ * @param pTimer Pointer to the frame timer.
+ * @param deltaTicks The duration of the frame.
+ */
+void mdFrameTimerAddSample(struct MdFrameTimer* pTimer, mdTicks deltaTicks);
+
+/**
+ * @brief Compute the statistics of the window, sorts a copy of the window so it is meant to be called at most once
+ * per frame (e.g. for an overlay), not for every sample.
+ * @param pTimer Pointer to the frame timer.
+ * @param pStats Receives the statistics, all zero when no frame was recorded.
+ */
+void mdFrameTimerGetStats(const struct MdFrameTimer* pTimer, struct MdFrameTimerStats* pStats);
+
+/**
+ * @brief Destroy a frame timer.
+ * @param pTimer Pointer to the frame timer.
+ */
+void mdFrameTimerDestroy(struct MdFrameTimer* pTimer);
+
 #if __cplusplus
 }
 #endif
\ No newline at end of file
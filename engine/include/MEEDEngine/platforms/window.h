@@ -97,7 +97,8 @@ void mdWindowDestroyVulkanSurface(struct MdWindowData* pWindowData, VkInstance i
 #endif
 
 /**
- * Poll for window events (e.g., input, close events).
+ * Poll for window events (e.g., input, close events). Does not wait: every queued event is processed and the call
+ * returns at once when there is none.
  *
  * @param pWindowData A pointer to the window data to poll events from.
  * @return A `MdWindowEvent` structure containing the polled event information.
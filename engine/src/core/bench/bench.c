@@ -0,0 +1,436 @@
+#include "MEEDEngine/core/bench/bench.h"
+#include "MEEDEngine/platforms/console.h"
+#include "MEEDEngine/platforms/file.h"
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/time.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_NAME_MAX_LENGTH 128
+#define BENCH_LINE_MAX_LENGTH 512
+#define BENCH_NOISE_MADS	  3.0 ///< A slowdown within this many MADs of the baseline is noise.
+
+static struct MdBench* s_pFirstBench = MD_NULL;
+static struct MdBench* s_pLastBench	 = MD_NULL;
+
+void mdBenchRegister(struct MdBench* pBench)
+{
+	MD_ASSERT(pBench != MD_NULL);
+	MD_ASSERT(pBench->run != MD_NULL);
+
+	// Called from the constructors, before `main` initializes the memory: the registry is an intrusive list.
+	pBench->pNext = MD_NULL;
+	if (s_pLastBench == MD_NULL)
+	{
+		s_pFirstBench = pBench;
+	}
+	else
+	{
+		s_pLastBench->pNext = pBench;
+	}
+	s_pLastBench = pBench;
+}
+
+const struct MdBench* mdBenchGetRegistered()
+{
+	return s_pFirstBench;
+}
+
+struct MdBenchConfig mdBenchGetDefaultConfig()
+{
+	struct MdBenchConfig config;
+	config.filter					 = MD_NULL;
+	config.repetitions				 = MD_BENCH_DEFAULT_REPETITIONS;
+	config.warmupMilliseconds		 = MD_BENCH_DEFAULT_WARMUP_MILLISECONDS;
+	config.minRepetitionMilliseconds = MD_BENCH_DEFAULT_MIN_REPETITION_MILLISECONDS;
+	config.jsonPath					 = MD_NULL;
+	config.baselinePath				 = MD_NULL;
+	config.threshold				 = MD_BENCH_DEFAULT_THRESHOLD;
+	return config;
+}
+
+static const char* getOptionValue(const char* argument, const char* option)
+{
+	mdSize length = strlen(option);
+	return strncmp(argument, option, length) == 0 ? argument + length : MD_NULL;
+}
+
+b8 mdBenchParseArguments(struct MdBenchConfig* pConfig, i32 argc, char** argv)
+{
+	MD_ASSERT(pConfig != MD_NULL);
+
+	for (i32 i = 1; i < argc; ++i)
+	{
+		const char* value = MD_NULL;
+		if ((value = getOptionValue(argv[i], "--filter=")) != MD_NULL)
+		{
+			pConfig->filter = value;
+		}
+		else if ((value = getOptionValue(argv[i], "--repetitions=")) != MD_NULL && atoi(value) > 0)
+		{
+			pConfig->repetitions = (u32)atoi(value);
+		}
+		else if ((value = getOptionValue(argv[i], "--warmup-ms=")) != MD_NULL)
+		{
+			pConfig->warmupMilliseconds = atof(value);
+		}
+		else if ((value = getOptionValue(argv[i], "--min-time-ms=")) != MD_NULL)
+		{
+			pConfig->minRepetitionMilliseconds = atof(value);
+		}
+		else if ((value = getOptionValue(argv[i], "--json=")) != MD_NULL)
+		{
+			pConfig->jsonPath = value;
+		}
+		else if ((value = getOptionValue(argv[i], "--baseline=")) != MD_NULL)
+		{
+			pConfig->baselinePath = value;
+		}
+		else if ((value = getOptionValue(argv[i], "--threshold=")) != MD_NULL)
+		{
+			pConfig->threshold = atof(value);
+		}
+		else
+		{
+			mdFormatPrint("Unknown argument \"%s\".\n"
+						  "Usage: %s [--filter=<text>] [--repetitions=<count>] [--warmup-ms=<milliseconds>]\n"
+						  "       [--min-time-ms=<milliseconds>] [--json=<path>] [--baseline=<path>] "
+						  "[--threshold=<ratio>]\n",
+						  argv[i],
+						  argv[0]);
+			return MD_FALSE;
+		}
+	}
+
+	return MD_TRUE;
+}
+
+/**
+ * Runs iterations and returns their timed duration: one clock read around the whole batch, or around every
+ * iteration when hooks have to run outside of the timing.
+ */
+static mdTicks runIterations(const struct MdBench* pBench, u64 iterations)
+{
+	if (pBench->setup == MD_NULL && pBench->teardown == MD_NULL)
+	{
+		mdTicks start = mdGetTicks();
+		for (u64 i = 0; i < iterations; ++i)
+		{
+			pBench->run();
+		}
+		return mdGetTicks() - start;
+	}
+
+	mdTicks timedTicks = 0;
+	for (u64 i = 0; i < iterations; ++i)
+	{
+		if (pBench->setup != MD_NULL)
+		{
+			pBench->setup();
+		}
+
+		mdTicks start = mdGetTicks();
+		pBench->run();
+		timedTicks += mdGetTicks() - start;
+
+		if (pBench->teardown != MD_NULL)
+		{
+			pBench->teardown();
+		}
+	}
+	return timedTicks;
+}
+
+static int compareF64(const void* pLeft, const void* pRight)
+{
+	f64 left  = *(const f64*)pLeft;
+	f64 right = *(const f64*)pRight;
+	return (left > right) - (left < right);
+}
+
+/**
+ * The same nearest-rank percentile as the frame timer, `pSorted` is sorted in increasing order.
+ */
+static f64 getPercentile(const f64* pSorted, u32 count, u32 percent)
+{
+	u32 rank = (count * percent + 99) / 100;
+	return pSorted[rank > 0 ? rank - 1 : 0];
+}
+
+static f64 getMedian(const f64* pSorted, u32 count)
+{
+	return (count % 2) != 0 ? pSorted[count / 2] : (pSorted[count / 2 - 1] + pSorted[count / 2]) * 0.5;
+}
+
+void mdBenchMeasure(const struct MdBench* pBench, const struct MdBenchConfig* pConfig, struct MdBenchResult* pResult)
+{
+	MD_ASSERT(pBench != MD_NULL);
+	MD_ASSERT(pConfig != MD_NULL);
+	MD_ASSERT(pResult != MD_NULL);
+	MD_ASSERT(pConfig->repetitions > 0);
+
+	if (pBench->fixtureSetup != MD_NULL)
+	{
+		pBench->fixtureSetup();
+	}
+
+	// The warmup doubles the batch until it has run long enough: the caches, the branch predictors and the CPU
+	// frequency settle, and the last batch gives the duration of an iteration.
+	mdTicks warmupTicks	 = mdSecondsToTicks(pConfig->warmupMilliseconds * 1e-3);
+	mdTicks elapsedTicks = 0;
+	mdTicks batchTicks	 = 0;
+	u64		batchSize	 = 1;
+	for (;;)
+	{
+		batchTicks = runIterations(pBench, batchSize);
+		elapsedTicks += batchTicks;
+		if (elapsedTicks >= warmupTicks)
+		{
+			break;
+		}
+		batchSize *= 2;
+	}
+
+	f64 iterationNanoseconds = batchTicks > 0 ? (f64)batchTicks / (f64)batchSize : 1.0;
+	f64 iterations			 = pConfig->minRepetitionMilliseconds * 1e6 / iterationNanoseconds;
+
+	mdMemorySet(pResult, 0, sizeof(struct MdBenchResult));
+	pResult->pBench		 = pBench;
+	pResult->iterations	 = iterations > 1.0 ? (u64)(iterations + 0.5) : 1;
+	pResult->repetitions = pConfig->repetitions;
+
+	f64* pSamples = MD_MALLOC_ARRAY(f64, pConfig->repetitions);
+	MD_ASSERT(pSamples != MD_NULL);
+	for (u32 i = 0; i < pConfig->repetitions; ++i)
+	{
+		pSamples[i] = (f64)runIterations(pBench, pResult->iterations) / (f64)pResult->iterations;
+		pResult->meanNanoseconds += pSamples[i];
+	}
+	pResult->meanNanoseconds /= pConfig->repetitions;
+
+	qsort(pSamples, pConfig->repetitions, sizeof(f64), compareF64);
+	pResult->medianNanoseconds = getMedian(pSamples, pConfig->repetitions);
+	pResult->minNanoseconds	   = pSamples[0];
+	pResult->p5Nanoseconds	   = getPercentile(pSamples, pConfig->repetitions, 5);
+	pResult->p95Nanoseconds	   = getPercentile(pSamples, pConfig->repetitions, 95);
+
+	for (u32 i = 0; i < pConfig->repetitions; ++i)
+	{
+		f64 deviation = pSamples[i] - pResult->medianNanoseconds;
+		pSamples[i]	  = deviation < 0.0 ? -deviation : deviation;
+	}
+	qsort(pSamples, pConfig->repetitions, sizeof(f64), compareF64);
+	pResult->madNanoseconds = getMedian(pSamples, pConfig->repetitions);
+
+	MD_FREE_ARRAY(pSamples, f64, pConfig->repetitions);
+
+	if (pBench->fixtureTeardown != MD_NULL)
+	{
+		pBench->fixtureTeardown();
+	}
+}
+
+static void getFullName(const struct MdBench* pBench, char* buffer, mdSize bufferSize)
+{
+	mdFormatString(buffer, bufferSize, "%s.%s", pBench->suite, pBench->name);
+}
+
+b8 mdBenchWriteJSON(const char* filePath, const struct MdBenchResult* pResults, u32 resultsCount)
+{
+	MD_ASSERT(filePath != MD_NULL);
+	MD_ASSERT(pResults != MD_NULL || resultsCount == 0);
+
+	struct MdFileData* pFile = mdFileOpen(filePath, MD_FILE_MODE_WRITE_ATOMIC);
+	if (!mdFileIsOpen(pFile))
+	{
+		mdFileClose(pFile);
+		return MD_FALSE;
+	}
+
+	struct MdFileBufferedWriter* pWriter  = mdFileBufferedWriterCreate(pFile, 0);
+	const char					 header[] = "{\"benchmarks\":[";
+	mdFileBufferedWriterWrite(pWriter, header, sizeof(header) - 1);
+
+	// The benchmark names are C identifiers, they never need to be escaped.
+	char name[BENCH_NAME_MAX_LENGTH];
+	char line[BENCH_LINE_MAX_LENGTH];
+	for (u32 i = 0; i < resultsCount; ++i)
+	{
+		const struct MdBenchResult* pResult = &pResults[i];
+		getFullName(pResult->pBench, name, sizeof(name));
+		mdFormatString(line,
+					   sizeof(line),
+					   "%s\n{\"name\":\"%s\",\"iterations\":%llu,\"repetitions\":%u,\"median_ns\":%.3f,\"mad_ns\":%.3f,"
+					   "\"mean_ns\":%.3f,\"min_ns\":%.3f,\"p5_ns\":%.3f,\"p95_ns\":%.3f}",
+					   i == 0 ? "" : ",",
+					   name,
+					   (unsigned long long)pResult->iterations,
+					   pResult->repetitions,
+					   pResult->medianNanoseconds,
+					   pResult->madNanoseconds,
+					   pResult->meanNanoseconds,
+					   pResult->minNanoseconds,
+					   pResult->p5Nanoseconds,
+					   pResult->p95Nanoseconds);
+		mdFileBufferedWriterWrite(pWriter, line, strlen(line));
+	}
+
+	const char footer[] = "\n]}\n";
+	mdFileBufferedWriterWrite(pWriter, footer, sizeof(footer) - 1);
+	mdFileBufferedWriterDestroy(pWriter);
+	mdFileClose(pFile);
+	return MD_TRUE;
+}
+
+/**
+ * Finds the median of a benchmark in a file written by `mdBenchWriteJSON`. The file format is known, a search for
+ * the name then for the next median is enough.
+ */
+static b8 findBaselineMedian(const char* content, const char* name, f64* pMedian)
+{
+	char key[BENCH_NAME_MAX_LENGTH + 16];
+	mdFormatString(key, sizeof(key), "\"name\":\"%s\"", name);
+
+	const char* pEntry = strstr(content, key);
+	if (pEntry == MD_NULL)
+	{
+		return MD_FALSE;
+	}
+
+	const char* pEntryEnd  = strchr(pEntry, '}');
+	const char* pMedianKey = strstr(pEntry, "\"median_ns\":");
+	if (pMedianKey == MD_NULL || (pEntryEnd != MD_NULL && pMedianKey > pEntryEnd))
+	{
+		return MD_FALSE;
+	}
+
+	*pMedian = atof(pMedianKey + strlen("\"median_ns\":"));
+	return MD_TRUE;
+}
+
+u32 mdBenchCompareBaseline(const char*				   filePath,
+						   const struct MdBenchResult* pResults,
+						   u32						   resultsCount,
+						   f64						   threshold)
+{
+	MD_ASSERT(filePath != MD_NULL);
+	MD_ASSERT(pResults != MD_NULL || resultsCount == 0);
+
+	struct MdFileData* pFile = mdFileOpen(filePath, MD_FILE_MODE_READ);
+	if (!mdFileIsOpen(pFile) || pFile->content == MD_NULL)
+	{
+		mdFormatPrint("Failed to read the baseline \"%s\".\n", filePath);
+		mdFileClose(pFile);
+		return resultsCount;
+	}
+
+	u32	 failedCount = 0;
+	char name[BENCH_NAME_MAX_LENGTH];
+	for (u32 i = 0; i < resultsCount; ++i)
+	{
+		const struct MdBenchResult* pResult = &pResults[i];
+		getFullName(pResult->pBench, name, sizeof(name));
+
+		f64 baselineMedian = 0.0;
+		if (!findBaselineMedian(pFile->content, name, &baselineMedian) || baselineMedian <= 0.0)
+		{
+			mdFormatPrint("[ SKIP ] %-40s not in the baseline\n", name);
+			continue;
+		}
+
+		f64 ratio		 = pResult->medianNanoseconds / baselineMedian;
+		f64 slowdown	 = pResult->medianNanoseconds - baselineMedian;
+		b8	isRegression = ratio > 1.0 + threshold && slowdown > BENCH_NOISE_MADS * pResult->madNanoseconds;
+		failedCount += isRegression ? 1 : 0;
+
+		mdFormatPrint("[%s] %-40s %12.1f ns -> %12.1f ns (%+.1f%%)\n",
+					  isRegression ? " FAIL " : "  OK  ",
+					  name,
+					  baselineMedian,
+					  pResult->medianNanoseconds,
+					  (ratio - 1.0) * 100.0);
+	}
+
+	mdFileClose(pFile);
+	return failedCount;
+}
+
+static void printResult(const struct MdBenchResult* pResult)
+{
+	char name[BENCH_NAME_MAX_LENGTH];
+	getFullName(pResult->pBench, name, sizeof(name));
+
+	f64 madPercent = pResult->medianNanoseconds > 0.0 ? pResult->madNanoseconds / pResult->medianNanoseconds * 100.0
+													  : 0.0;
+	mdFormatPrint("%-40s %12llu %14.1f %8.2f %14.1f %14.1f\n",
+				  name,
+				  (unsigned long long)pResult->iterations,
+				  pResult->medianNanoseconds,
+				  madPercent,
+				  pResult->p5Nanoseconds,
+				  pResult->p95Nanoseconds);
+}
+
+static b8 isSelected(const struct MdBench* pBench, const char* filter)
+{
+	if (filter == MD_NULL)
+	{
+		return MD_TRUE;
+	}
+
+	char name[BENCH_NAME_MAX_LENGTH];
+	getFullName(pBench, name, sizeof(name));
+	return strstr(name, filter) != MD_NULL;
+}
+
+i32 mdBenchRunAll(const struct MdBenchConfig* pConfig)
+{
+	MD_ASSERT(pConfig != MD_NULL);
+
+	u32 benchesCount = 0;
+	for (const struct MdBench* pBench = s_pFirstBench; pBench != MD_NULL; pBench = pBench->pNext)
+	{
+		benchesCount += isSelected(pBench, pConfig->filter) ? 1 : 0;
+	}
+	if (benchesCount == 0)
+	{
+		mdFormatPrint("No benchmark matches the filter.\n");
+		return 1;
+	}
+
+	mdFormatPrint("%-40s %12s %14s %8s %14s %14s\n",
+				  "Benchmark",
+				  "Iterations",
+				  "Median (ns)",
+				  "MAD (%)",
+				  "p5 (ns)",
+				  "p95 (ns)");
+
+	struct MdBenchResult* pResults	   = MD_MALLOC_ARRAY(struct MdBenchResult, benchesCount);
+	u32					  resultsCount = 0;
+	MD_ASSERT(pResults != MD_NULL);
+	for (const struct MdBench* pBench = s_pFirstBench; pBench != MD_NULL; pBench = pBench->pNext)
+	{
+		if (isSelected(pBench, pConfig->filter))
+		{
+			mdBenchMeasure(pBench, pConfig, &pResults[resultsCount]);
+			printResult(&pResults[resultsCount]);
+			++resultsCount;
+		}
+	}
+
+	i32 exitCode = 0;
+	if (pConfig->jsonPath != MD_NULL && !mdBenchWriteJSON(pConfig->jsonPath, pResults, resultsCount))
+	{
+		mdFormatPrint("Failed to write \"%s\".\n", pConfig->jsonPath);
+		exitCode = 1;
+	}
+	if (pConfig->baselinePath != MD_NULL &&
+		mdBenchCompareBaseline(pConfig->baselinePath, pResults, resultsCount, pConfig->threshold) != 0)
+	{
+		exitCode = 1;
+	}
+
+	MD_FREE_ARRAY(pResults, struct MdBenchResult, benchesCount);
+	return exitCode;
+}
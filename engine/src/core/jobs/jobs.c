@@ -0,0 +1,844 @@
+#include "MEEDEngine/core/jobs/jobs.h"
+#include "MEEDEngine/platforms/console.h"
+#include "MEEDEngine/platforms/fiber.h"
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/thread.h"
+
+#define CACHE_LINE_SIZE				 64u
+#define SHARED_QUEUE_MIN_CAPACITY	 64u
+#define WAIT_SPINS_BEFORE_YIELD		 64u
+#define WORKER_SPINS_BEFORE_SLEEPING 256u
+#define SUBMIT_BATCH_SIZE			 64u ///< The jobs copied to a shared queue per lock.
+
+struct Job
+{
+	MdJobFunction		 function;
+	void*				 pUserData;
+	struct MdJobCounter* pCounter;
+};
+
+/**
+ * The Chase-Lev deque of a thread, with a fixed capacity (Lê et al., "Correct and Efficient Work-Stealing for Weak
+ * Memory Models"). Only the owner moves `bottom`, the thieves race on `top` with a compare-exchange. The slots are
+ * accessed atomically: a thief may read a slot the owner is overwriting, its compare-exchange then fails.
+ */
+struct JobDeque
+{
+	i64	 top;
+	char padding[CACHE_LINE_SIZE - sizeof(i64)]; ///< Keeps the thieves and the owner on different cache lines.
+	i64	 bottom;
+	struct Job jobs[MD_JOB_DEQUE_CAPACITY];
+};
+
+/**
+ * A FIFO queue shared by every thread, a growing ring buffer behind a spinlock.
+ */
+struct JobQueue
+{
+	struct MdSpinlock lock;
+	u32				  count; ///< Also read without the lock, to skip the empty queues.
+	u32				  head;
+	u32				  capacity;
+	struct Job*		  pJobs;
+};
+
+/**
+ * A pooled fiber and the job it runs, or the counter it waits on while it is suspended.
+ */
+struct JobFiber
+{
+	struct MdFiber*		 pFiber;
+	struct Job			 job;
+	enum MdJobPriority	 priority;
+	struct MdJobCounter* pWaitedCounter;
+	struct JobFiber*	 pNext; ///< In the free list or in the waiting list.
+};
+
+struct Worker
+{
+	struct JobDeque* pDeque;
+	struct MdThread* pThread;
+	u32				 randomState;	   ///< Chooses the steal victims.
+	struct MdFiber*	 pThreadFiber;	   ///< The thread stack, which schedules the job fibers.
+	struct JobFiber* pRunningFiber;	   ///< The job fiber running on the thread, MD_NULL on the thread stack.
+	struct JobFiber* pSuspendingFiber; ///< The job fiber which suspended, waiting to be published.
+	u32				 l3GroupIndex;	   ///< The thieves steal from the threads of their L3 group first.
+	u32				 cpuId;			   ///< The logical core the worker is pinned to.
+	b8				 isPinned;
+};
+
+static b8				  s_isInitialized = MD_FALSE;
+static b8				  s_isRunning	  = MD_FALSE;
+static struct Worker*	  s_pWorkers	  = MD_NULL; ///< The main thread, then the worker threads.
+static u32				  s_threadsCount  = 0;
+static u32				  s_workersCount  = 0; ///< The worker threads which could be started.
+static struct JobQueue	  s_queues[MD_JOB_PRIORITY_COUNT]; ///< The normal queue receives the deque overflows.
+static struct MdSemaphore s_wakeSemaphore;
+static u32				  s_sleepingCount = 0;
+
+static struct JobFiber*	 s_pJobFibers			 = MD_NULL;
+static u32				 s_jobFibersCount		 = 0;
+static struct MdSpinlock s_jobFibersLock		 = {0}; ///< Guards the free and the waiting lists.
+static struct JobFiber*	 s_pFreeJobFibers		 = MD_NULL;
+static struct JobFiber*	 s_pWaitingJobFibers	 = MD_NULL;
+static u32				 s_waitingJobFibersCount = 0;
+
+static mdTicks s_backgroundBudgetTicks = 0;
+static mdTicks s_backgroundSpentTicks  = 0;
+
+static MD_THREAD_LOCAL struct Worker* s_pCurrentWorker = MD_NULL; ///< MD_NULL on the threads the system does not own.
+
+/**
+ * Not inlined: a job fiber can resume on another thread, the address of the thread-local variable it computed before
+ * suspending would be the one of its previous thread.
+ */
+__attribute__((noinline)) static struct Worker* getCurrentWorker()
+{
+	return s_pCurrentWorker;
+}
+
+static b8 dequePush(struct JobDeque* pDeque, const struct Job* pJob)
+{
+	i64 bottom = MD_ATOMIC_LOAD(&pDeque->bottom, MD_MEMORY_ORDER_RELAXED);
+	i64 top	   = MD_ATOMIC_LOAD(&pDeque->top, MD_MEMORY_ORDER_ACQUIRE);
+	if (bottom - top >= (i64)MD_JOB_DEQUE_CAPACITY)
+	{
+		return MD_FALSE;
+	}
+
+	struct Job* pSlot = &pDeque->jobs[bottom & (MD_JOB_DEQUE_CAPACITY - 1)];
+	MD_ATOMIC_STORE(&pSlot->function, pJob->function, MD_MEMORY_ORDER_RELAXED);
+	MD_ATOMIC_STORE(&pSlot->pUserData, pJob->pUserData, MD_MEMORY_ORDER_RELAXED);
+	MD_ATOMIC_STORE(&pSlot->pCounter, pJob->pCounter, MD_MEMORY_ORDER_RELAXED);
+	MD_ATOMIC_THREAD_FENCE(MD_MEMORY_ORDER_RELEASE);
+	MD_ATOMIC_STORE(&pDeque->bottom, bottom + 1, MD_MEMORY_ORDER_RELAXED);
+	return MD_TRUE;
+}
+
+static void readSlot(struct JobDeque* pDeque, i64 index, struct Job* pJob)
+{
+	struct Job* pSlot = &pDeque->jobs[index & (MD_JOB_DEQUE_CAPACITY - 1)];
+	pJob->function	  = MD_ATOMIC_LOAD(&pSlot->function, MD_MEMORY_ORDER_RELAXED);
+	pJob->pUserData	  = MD_ATOMIC_LOAD(&pSlot->pUserData, MD_MEMORY_ORDER_RELAXED);
+	pJob->pCounter	  = MD_ATOMIC_LOAD(&pSlot->pCounter, MD_MEMORY_ORDER_RELAXED);
+}
+
+static b8 dequeTake(struct JobDeque* pDeque, struct Job* pJob)
+{
+	i64 bottom = MD_ATOMIC_LOAD(&pDeque->bottom, MD_MEMORY_ORDER_RELAXED) - 1;
+	MD_ATOMIC_STORE(&pDeque->bottom, bottom, MD_MEMORY_ORDER_RELAXED);
+	MD_ATOMIC_THREAD_FENCE(MD_MEMORY_ORDER_SEQ_CST);
+	i64 top = MD_ATOMIC_LOAD(&pDeque->top, MD_MEMORY_ORDER_RELAXED);
+
+	if (top > bottom)
+	{
+		MD_ATOMIC_STORE(&pDeque->bottom, bottom + 1, MD_MEMORY_ORDER_RELAXED);
+		return MD_FALSE;
+	}
+
+	readSlot(pDeque, bottom, pJob);
+	if (top < bottom)
+	{
+		return MD_TRUE;
+	}
+
+	// The last job: the thieves may be taking it too.
+	b8 isTaken =
+		MD_ATOMIC_COMPARE_EXCHANGE(&pDeque->top, &top, top + 1, MD_MEMORY_ORDER_SEQ_CST, MD_MEMORY_ORDER_RELAXED);
+	MD_ATOMIC_STORE(&pDeque->bottom, bottom + 1, MD_MEMORY_ORDER_RELAXED);
+	return isTaken;
+}
+
+static b8 dequeSteal(struct JobDeque* pDeque, struct Job* pJob)
+{
+	i64 top = MD_ATOMIC_LOAD(&pDeque->top, MD_MEMORY_ORDER_ACQUIRE);
+	MD_ATOMIC_THREAD_FENCE(MD_MEMORY_ORDER_SEQ_CST);
+	i64 bottom = MD_ATOMIC_LOAD(&pDeque->bottom, MD_MEMORY_ORDER_ACQUIRE);
+	if (top >= bottom)
+	{
+		return MD_FALSE;
+	}
+
+	readSlot(pDeque, top, pJob);
+	return MD_ATOMIC_COMPARE_EXCHANGE(&pDeque->top, &top, top + 1, MD_MEMORY_ORDER_SEQ_CST, MD_MEMORY_ORDER_RELAXED);
+}
+
+static void queuePush(struct JobQueue* pQueue, const struct Job* pJobs, u32 jobsCount)
+{
+	mdSpinlockLock(&pQueue->lock);
+	if (pQueue->count + jobsCount > pQueue->capacity)
+	{
+		u32 capacity = pQueue->capacity == 0 ? SHARED_QUEUE_MIN_CAPACITY : pQueue->capacity;
+		while (capacity < pQueue->count + jobsCount)
+		{
+			capacity *= 2;
+		}
+
+		struct Job* pNewJobs = MD_MALLOC_ARRAY(struct Job, capacity);
+		for (u32 i = 0; i < pQueue->count; ++i)
+		{
+			pNewJobs[i] = pQueue->pJobs[(pQueue->head + i) % pQueue->capacity];
+		}
+		if (pQueue->pJobs != MD_NULL)
+		{
+			MD_FREE_ARRAY(pQueue->pJobs, struct Job, pQueue->capacity);
+		}
+		pQueue->pJobs	 = pNewJobs;
+		pQueue->head	 = 0;
+		pQueue->capacity = capacity;
+	}
+
+	for (u32 i = 0; i < jobsCount; ++i)
+	{
+		pQueue->pJobs[(pQueue->head + pQueue->count + i) % pQueue->capacity] = pJobs[i];
+	}
+	MD_ATOMIC_STORE(&pQueue->count, pQueue->count + jobsCount, MD_MEMORY_ORDER_RELAXED);
+	mdSpinlockUnlock(&pQueue->lock);
+}
+
+static b8 queuePop(struct JobQueue* pQueue, struct Job* pJob)
+{
+	if (MD_ATOMIC_LOAD(&pQueue->count, MD_MEMORY_ORDER_RELAXED) == 0)
+	{
+		return MD_FALSE;
+	}
+
+	b8 isPopped = MD_FALSE;
+	mdSpinlockLock(&pQueue->lock);
+	if (pQueue->count > 0)
+	{
+		*pJob		 = pQueue->pJobs[pQueue->head];
+		pQueue->head = (pQueue->head + 1) % pQueue->capacity;
+		MD_ATOMIC_STORE(&pQueue->count, pQueue->count - 1, MD_MEMORY_ORDER_RELAXED);
+		isPopped = MD_TRUE;
+	}
+	mdSpinlockUnlock(&pQueue->lock);
+	return isPopped;
+}
+
+static u32 nextRandom(u32* pState)
+{
+	// xorshift32, the quality does not matter, only that the thieves spread over the victims.
+	u32 x = *pState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*pState = x;
+	return x;
+}
+
+static b8 stealJob(struct Worker* pThief, struct Job* pJob)
+{
+	u32 randomState = pThief != MD_NULL ? pThief->randomState : (u32)mdThreadGetCurrentId() | 1u;
+	u32 firstVictim = nextRandom(&randomState) % s_threadsCount;
+	if (pThief != MD_NULL)
+	{
+		pThief->randomState = randomState;
+	}
+
+	// The victims which share the L3 cache of the thief first: the jobs of a batch and their data stay in the cache
+	// of the thread which submitted them, the other groups only take the overflow.
+	for (u32 pass = pThief != MD_NULL ? 0 : 1; pass < 2; ++pass)
+	{
+		for (u32 i = 0; i < s_threadsCount; ++i)
+		{
+			struct Worker* pVictim	   = &s_pWorkers[(firstVictim + i) % s_threadsCount];
+			b8			   isSameGroup = pThief != MD_NULL && pVictim->l3GroupIndex == pThief->l3GroupIndex;
+			if (pVictim != pThief && isSameGroup == (pass == 0) && dequeSteal(pVictim->pDeque, pJob))
+			{
+				return MD_TRUE;
+			}
+		}
+	}
+	return MD_FALSE;
+}
+
+static b8 isBackgroundBudgetLeft()
+{
+	mdTicks budgetTicks = MD_ATOMIC_LOAD(&s_backgroundBudgetTicks, MD_MEMORY_ORDER_RELAXED);
+	return budgetTicks == 0 || MD_ATOMIC_LOAD(&s_backgroundSpentTicks, MD_MEMORY_ORDER_RELAXED) < budgetTicks;
+}
+
+/**
+ * Finds the next job of the calling thread, in the lanes order.
+ * @param pJob Receives the job.
+ * @param pPriority Receives the lane of the job.
+ * @param isBudgetIgnored Whether the background jobs can start beyond the budget.
+ * @return MD_FALSE when every lane is empty.
+ */
+static b8 findJob(struct Job* pJob, enum MdJobPriority* pPriority, b8 isBudgetIgnored)
+{
+	*pPriority = MD_JOB_PRIORITY_NORMAL;
+	if (queuePop(&s_queues[MD_JOB_PRIORITY_HIGH], pJob))
+	{
+		*pPriority = MD_JOB_PRIORITY_HIGH;
+		return MD_TRUE;
+	}
+	struct Worker* pWorker = getCurrentWorker();
+	if ((pWorker != MD_NULL && dequeTake(pWorker->pDeque, pJob)) || queuePop(&s_queues[MD_JOB_PRIORITY_NORMAL], pJob) ||
+		stealJob(pWorker, pJob))
+	{
+		return MD_TRUE;
+	}
+	if ((isBudgetIgnored || isBackgroundBudgetLeft()) && queuePop(&s_queues[MD_JOB_PRIORITY_BACKGROUND], pJob))
+	{
+		*pPriority = MD_JOB_PRIORITY_BACKGROUND;
+		return MD_TRUE;
+	}
+	return MD_FALSE;
+}
+
+/**
+ * Wakes up to `count` sleeping workers. The sleepers are claimed by decreasing their count, so two submitters do not
+ * wake the same sleeper twice.
+ */
+static void wakeWorkers(u32 count)
+{
+	// Pairs with the fence of the workers between announcing their sleep and checking the lanes a last time: either
+	// this sees the sleeper or the sleeper sees the jobs.
+	MD_ATOMIC_THREAD_FENCE(MD_MEMORY_ORDER_SEQ_CST);
+	u32 sleepingCount = MD_ATOMIC_LOAD(&s_sleepingCount, MD_MEMORY_ORDER_RELAXED);
+	while (sleepingCount > 0)
+	{
+		u32 wokenCount = count < sleepingCount ? count : sleepingCount;
+		if (MD_ATOMIC_COMPARE_EXCHANGE_WEAK(&s_sleepingCount,
+											&sleepingCount,
+											sleepingCount - wokenCount,
+											MD_MEMORY_ORDER_RELAXED,
+											MD_MEMORY_ORDER_RELAXED))
+		{
+			mdSemaphorePost(&s_wakeSemaphore, wokenCount);
+			return;
+		}
+	}
+}
+
+static void executeJob(const struct Job* pJob, enum MdJobPriority priority)
+{
+	if (priority == MD_JOB_PRIORITY_BACKGROUND)
+	{
+		mdTicks startTicks = mdGetTicks();
+		pJob->function(pJob->pUserData);
+		MD_ATOMIC_FETCH_ADD(&s_backgroundSpentTicks, mdGetTicks() - startTicks, MD_MEMORY_ORDER_RELAXED);
+	}
+	else
+	{
+		pJob->function(pJob->pUserData);
+	}
+
+	// Release: the waiter which sees the counter reach zero sees the writes of the job. A job fiber may be waiting
+	// on it while every worker sleeps, when the job ran on a thread which does not resume fibers.
+	if (pJob->pCounter != MD_NULL &&
+		MD_ATOMIC_FETCH_SUB(&pJob->pCounter->pendingCount, 1u, MD_MEMORY_ORDER_RELEASE) == 1)
+	{
+		// Pairs with the fence of `switchToJobFiber` between publishing a waiting fiber and checking its counter:
+		// either this sees the fiber or the publisher sees the counter at zero.
+		MD_ATOMIC_THREAD_FENCE(MD_MEMORY_ORDER_SEQ_CST);
+		if (MD_ATOMIC_LOAD(&s_waitingJobFibersCount, MD_MEMORY_ORDER_RELAXED) > 0)
+		{
+			wakeWorkers(1);
+		}
+	}
+}
+
+static void jobFiberMain(void* pArgument)
+{
+	struct JobFiber* pJobFiber = (struct JobFiber*)pArgument;
+	for (;;)
+	{
+		executeJob(&pJobFiber->job, pJobFiber->priority);
+
+		// Back to the thread which runs the fiber now, not necessarily the one which started the job.
+		struct Worker* pWorker = getCurrentWorker();
+		mdFiberSwitch(pJobFiber->pFiber, pWorker->pThreadFiber);
+	}
+}
+
+/**
+ * Runs a job fiber on the calling thread until its job finishes or waits, from the thread stack.
+ */
+static void switchToJobFiber(struct Worker* pWorker, struct JobFiber* pJobFiber)
+{
+	MD_ASSERT(pWorker->pRunningFiber == MD_NULL);
+
+	pWorker->pRunningFiber = pJobFiber;
+	mdFiberSwitch(pWorker->pThreadFiber, pJobFiber->pFiber);
+	pWorker->pRunningFiber = MD_NULL;
+
+	// The fiber is switched out: it can be given to the other threads now, not before.
+	b8 isReady = MD_FALSE;
+	mdSpinlockLock(&s_jobFibersLock);
+	if (pWorker->pSuspendingFiber == pJobFiber)
+	{
+		pJobFiber->pNext	= s_pWaitingJobFibers;
+		s_pWaitingJobFibers = pJobFiber;
+		MD_ATOMIC_STORE(&s_waitingJobFibersCount, s_waitingJobFibersCount + 1, MD_MEMORY_ORDER_RELAXED);
+		pWorker->pSuspendingFiber = MD_NULL;
+
+		// The counter may have reached zero before the fiber was published, the job which finished it then saw no
+		// waiting fiber and woke nobody. Checked under the lock: once resumed, the fiber may release its counter.
+		MD_ATOMIC_THREAD_FENCE(MD_MEMORY_ORDER_SEQ_CST);
+		isReady = MD_ATOMIC_LOAD(&pJobFiber->pWaitedCounter->pendingCount, MD_MEMORY_ORDER_RELAXED) == 0;
+	}
+	else
+	{
+		pJobFiber->pNext = s_pFreeJobFibers;
+		s_pFreeJobFibers = pJobFiber;
+	}
+	mdSpinlockUnlock(&s_jobFibersLock);
+
+	if (isReady)
+	{
+		wakeWorkers(1);
+	}
+}
+
+static void runJob(const struct Job* pJob, enum MdJobPriority priority)
+{
+	struct Worker*	 pWorker   = getCurrentWorker();
+	struct JobFiber* pJobFiber = MD_NULL;
+	if (pWorker != MD_NULL && pWorker->pThreadFiber != MD_NULL)
+	{
+		mdSpinlockLock(&s_jobFibersLock);
+		pJobFiber = s_pFreeJobFibers;
+		if (pJobFiber != MD_NULL)
+		{
+			s_pFreeJobFibers = pJobFiber->pNext;
+		}
+		mdSpinlockUnlock(&s_jobFibersLock);
+	}
+
+	// Without a free fiber the job runs on the thread stack, where its waits run the other jobs.
+	if (pJobFiber == MD_NULL)
+	{
+		executeJob(pJob, priority);
+		return;
+	}
+
+	pJobFiber->job		= *pJob;
+	pJobFiber->priority = priority;
+	switchToJobFiber(pWorker, pJobFiber);
+}
+
+/**
+ * @return MD_TRUE when a suspended job fiber waits on a counter which reached zero.
+ */
+static b8 isJobFiberReady()
+{
+	if (MD_ATOMIC_LOAD(&s_waitingJobFibersCount, MD_MEMORY_ORDER_RELAXED) == 0)
+	{
+		return MD_FALSE;
+	}
+
+	b8 isReady = MD_FALSE;
+	mdSpinlockLock(&s_jobFibersLock);
+	for (struct JobFiber* pJobFiber = s_pWaitingJobFibers; pJobFiber != MD_NULL && !isReady;
+		 pJobFiber					= pJobFiber->pNext)
+	{
+		isReady = MD_ATOMIC_LOAD(&pJobFiber->pWaitedCounter->pendingCount, MD_MEMORY_ORDER_RELAXED) == 0;
+	}
+	mdSpinlockUnlock(&s_jobFibersLock);
+	return isReady;
+}
+
+/**
+ * Resumes a suspended job fiber whose counter reached zero, if any.
+ * @return MD_FALSE when no waiting fiber is ready.
+ */
+static b8 resumeReadyJobFiber()
+{
+	struct Worker* pWorker = getCurrentWorker();
+	if (pWorker == MD_NULL || pWorker->pThreadFiber == MD_NULL ||
+		MD_ATOMIC_LOAD(&s_waitingJobFibersCount, MD_MEMORY_ORDER_RELAXED) == 0)
+	{
+		return MD_FALSE;
+	}
+
+	struct JobFiber* pReadyFiber = MD_NULL;
+	mdSpinlockLock(&s_jobFibersLock);
+	for (struct JobFiber** ppLink = &s_pWaitingJobFibers; *ppLink != MD_NULL; ppLink = &(*ppLink)->pNext)
+	{
+		if (MD_ATOMIC_LOAD(&(*ppLink)->pWaitedCounter->pendingCount, MD_MEMORY_ORDER_ACQUIRE) == 0)
+		{
+			pReadyFiber = *ppLink;
+			*ppLink		= pReadyFiber->pNext;
+			MD_ATOMIC_STORE(&s_waitingJobFibersCount, s_waitingJobFibersCount - 1, MD_MEMORY_ORDER_RELAXED);
+			break;
+		}
+	}
+	mdSpinlockUnlock(&s_jobFibersLock);
+
+	if (pReadyFiber == MD_NULL)
+	{
+		return MD_FALSE;
+	}
+
+	pReadyFiber->pWaitedCounter = MD_NULL;
+	switchToJobFiber(pWorker, pReadyFiber);
+	return MD_TRUE;
+}
+
+static void workerMain(void* pArgument)
+{
+	struct Worker* pWorker = (struct Worker*)pArgument;
+	s_pCurrentWorker	   = pWorker;
+	pWorker->pThreadFiber  = mdFiberCreateFromThread();
+	if (pWorker->isPinned)
+	{
+		mdThreadSetCurrentAffinity(pWorker->cpuId);
+	}
+
+	struct Job		   job;
+	enum MdJobPriority priority;
+	u32				   idleSpins = 0;
+	while (MD_ATOMIC_LOAD(&s_isRunning, MD_MEMORY_ORDER_ACQUIRE))
+	{
+		if (resumeReadyJobFiber())
+		{
+			idleSpins = 0;
+			continue;
+		}
+		if (findJob(&job, &priority, MD_FALSE))
+		{
+			runJob(&job, priority);
+			idleSpins = 0;
+			continue;
+		}
+
+		// A short spin first: the next batch of a frame often comes within microseconds.
+		if (idleSpins < WORKER_SPINS_BEFORE_SLEEPING)
+		{
+			++idleSpins;
+			MD_CPU_RELAX();
+			continue;
+		}
+
+		MD_ATOMIC_FETCH_ADD(&s_sleepingCount, 1u, MD_MEMORY_ORDER_SEQ_CST);
+		MD_ATOMIC_THREAD_FENCE(MD_MEMORY_ORDER_SEQ_CST);
+		// The fibers still waiting on their counter do not keep the worker awake: the job which ends their wait
+		// wakes one.
+		b8 isJobFound = findJob(&job, &priority, MD_FALSE);
+		if (isJobFound || isJobFiberReady())
+		{
+			// Takes back the sleep announcement, unless a submitter already claimed it: its post then only causes a
+			// spurious wake up.
+			u32 sleepingCount = MD_ATOMIC_LOAD(&s_sleepingCount, MD_MEMORY_ORDER_RELAXED);
+			while (sleepingCount > 0 && !MD_ATOMIC_COMPARE_EXCHANGE_WEAK(&s_sleepingCount,
+																		 &sleepingCount,
+																		 sleepingCount - 1,
+																		 MD_MEMORY_ORDER_RELAXED,
+																		 MD_MEMORY_ORDER_RELAXED))
+			{
+			}
+			if (isJobFound)
+			{
+				runJob(&job, priority);
+			}
+			idleSpins = 0;
+			continue;
+		}
+
+		if (MD_ATOMIC_LOAD(&s_isRunning, MD_MEMORY_ORDER_ACQUIRE))
+		{
+			mdSemaphoreWait(&s_wakeSemaphore);
+		}
+		idleSpins = 0;
+	}
+
+	if (pWorker->pThreadFiber != MD_NULL)
+	{
+		mdFiberDestroy(pWorker->pThreadFiber);
+	}
+}
+
+/**
+ * Gives each thread a physical core, its first logical core, in the order of the topology: the threads which follow
+ * each other share the L3 caches. The main thread keeps the first core, unpinned, the workers are pinned to the next
+ * ones. With more threads than physical cores, the scheduler places them: the extra threads take the L3 group of the
+ * physical cores again, round-robin, as they share them with the first threads.
+ */
+static void placeWorkers(const struct MdCpuTopology* pTopology)
+{
+	u32 threadIndex = 0;
+	for (u32 i = 0; i < pTopology->logicalCoresCount && threadIndex < s_threadsCount; ++i)
+	{
+		const struct MdLogicalCore* pCore = &pTopology->logicalCores[i];
+		if (pCore->siblingIndex != 0)
+		{
+			continue;
+		}
+
+		struct Worker* pWorker = &s_pWorkers[threadIndex];
+		pWorker->l3GroupIndex  = pCore->l3GroupIndex;
+		pWorker->cpuId		   = pCore->cpuId;
+		pWorker->isPinned	   = threadIndex > 0 && s_threadsCount <= pTopology->physicalCoresCount;
+		++threadIndex;
+	}
+
+	u32 placedCount = threadIndex;
+	for (; threadIndex < s_threadsCount && placedCount > 0; ++threadIndex)
+	{
+		struct Worker*		 pWorker	   = &s_pWorkers[threadIndex];
+		const struct Worker* pSharedWorker = &s_pWorkers[threadIndex % placedCount];
+		pWorker->l3GroupIndex			   = pSharedWorker->l3GroupIndex;
+		pWorker->cpuId					   = pSharedWorker->cpuId;
+	}
+}
+
+void mdJobSystemInitialize(u32 workersCount)
+{
+	MD_ASSERT(s_isInitialized == MD_FALSE);
+
+	struct MdCpuTopology* pTopology = MD_MALLOC(struct MdCpuTopology);
+	mdThreadGetCpuTopology(pTopology);
+	if (workersCount == MD_JOB_WORKERS_COUNT_DEFAULT)
+	{
+		workersCount = pTopology->physicalCoresCount - 1;
+	}
+
+	s_threadsCount = workersCount + 1;
+	s_pWorkers	   = MD_MALLOC_ARRAY(struct Worker, s_threadsCount);
+	mdMemorySet(s_pWorkers, 0, sizeof(struct Worker) * s_threadsCount);
+	for (u32 i = 0; i < s_threadsCount; ++i)
+	{
+		s_pWorkers[i].pDeque = MD_MALLOC(struct JobDeque);
+		mdMemorySet(s_pWorkers[i].pDeque, 0, sizeof(struct JobDeque));
+		s_pWorkers[i].randomState = 0x9E3779B9u * (i + 1);
+	}
+	placeWorkers(pTopology);
+	MD_FREE(pTopology, struct MdCpuTopology);
+	mdMemorySet(s_queues, 0, sizeof(s_queues));
+	mdSemaphoreInitialize(&s_wakeSemaphore, 0);
+	s_sleepingCount			= 0;
+	s_backgroundBudgetTicks = 0;
+	s_backgroundSpentTicks	= 0;
+	s_isRunning				= MD_TRUE;
+	MD_ATOMIC_STORE(&s_isInitialized, MD_TRUE, MD_MEMORY_ORDER_RELEASE);
+	s_pCurrentWorker		= &s_pWorkers[0];
+	s_pWorkers[0].pThreadFiber = mdFiberCreateFromThread();
+
+	// The stacks are mapped on demand, the unused part of the pool costs address space only.
+	s_pJobFibers = MD_MALLOC_ARRAY(struct JobFiber, MD_JOB_FIBERS_COUNT);
+	mdMemorySet(s_pJobFibers, 0, sizeof(struct JobFiber) * MD_JOB_FIBERS_COUNT);
+	s_jobFibersCount		= 0;
+	s_pFreeJobFibers		= MD_NULL;
+	s_pWaitingJobFibers		= MD_NULL;
+	s_waitingJobFibersCount = 0;
+	while (s_pWorkers[0].pThreadFiber != MD_NULL && s_jobFibersCount < MD_JOB_FIBERS_COUNT)
+	{
+		struct JobFiber* pJobFiber = &s_pJobFibers[s_jobFibersCount];
+		pJobFiber->pFiber		   = mdFiberCreate(MD_JOB_FIBER_STACK_SIZE, jobFiberMain, pJobFiber);
+		if (pJobFiber->pFiber == MD_NULL)
+		{
+			break;
+		}
+		pJobFiber->pNext = s_pFreeJobFibers;
+		s_pFreeJobFibers = pJobFiber;
+		++s_jobFibersCount;
+	}
+
+	for (u32 i = 1; i < s_threadsCount; ++i)
+	{
+		char name[MD_THREAD_NAME_MAX_LENGTH + 1];
+		mdFormatString(name, sizeof(name), "MEEDWorker%u", i);
+		s_pWorkers[i].pThread = mdThreadCreate(workerMain, &s_pWorkers[i], name);
+		if (s_pWorkers[i].pThread == MD_NULL)
+		{
+			// No threads on this platform (or no more): the created workers and the waiting threads run the jobs.
+			break;
+		}
+		++s_workersCount;
+	}
+}
+
+void mdJobSystemShutdown()
+{
+	MD_ASSERT(s_isInitialized == MD_TRUE);
+	MD_ASSERT(s_pCurrentWorker == &s_pWorkers[0]);
+
+	MD_ATOMIC_STORE(&s_isRunning, MD_FALSE, MD_MEMORY_ORDER_RELEASE);
+	mdSemaphorePost(&s_wakeSemaphore, s_threadsCount);
+	for (u32 i = 1; i < s_threadsCount; ++i)
+	{
+		if (s_pWorkers[i].pThread != MD_NULL)
+		{
+			mdThreadJoin(s_pWorkers[i].pThread);
+		}
+	}
+
+	for (u32 i = 0; i < s_threadsCount; ++i)
+	{
+		MD_ASSERT_MSG(s_pWorkers[i].pDeque->top == s_pWorkers[i].pDeque->bottom, "Jobs were never waited on.");
+		MD_FREE(s_pWorkers[i].pDeque, struct JobDeque);
+	}
+	for (u32 i = 0; i < MD_JOB_PRIORITY_COUNT; ++i)
+	{
+		MD_ASSERT_MSG(s_queues[i].count == 0, "Jobs were never waited on.");
+		if (s_queues[i].pJobs != MD_NULL)
+		{
+			MD_FREE_ARRAY(s_queues[i].pJobs, struct Job, s_queues[i].capacity);
+		}
+	}
+	MD_ASSERT_MSG(s_pWaitingJobFibers == MD_NULL, "Jobs were never waited on.");
+	for (u32 i = 0; i < s_jobFibersCount; ++i)
+	{
+		mdFiberDestroy(s_pJobFibers[i].pFiber);
+	}
+	MD_FREE_ARRAY(s_pJobFibers, struct JobFiber, MD_JOB_FIBERS_COUNT);
+	if (s_pWorkers[0].pThreadFiber != MD_NULL)
+	{
+		mdFiberDestroy(s_pWorkers[0].pThreadFiber);
+	}
+	MD_FREE_ARRAY(s_pWorkers, struct Worker, s_threadsCount);
+	mdSemaphoreDestroy(&s_wakeSemaphore);
+
+	s_pJobFibers	 = MD_NULL;
+	s_jobFibersCount = 0;
+	s_pFreeJobFibers = MD_NULL;
+	s_pWorkers		 = MD_NULL;
+	s_threadsCount	 = 0;
+	s_workersCount	 = 0;
+	s_pCurrentWorker = MD_NULL;
+	MD_ATOMIC_STORE(&s_isInitialized, MD_FALSE, MD_MEMORY_ORDER_RELEASE);
+}
+
+b8 mdJobSystemIsInitialized()
+{
+	return MD_ATOMIC_LOAD(&s_isInitialized, MD_MEMORY_ORDER_ACQUIRE);
+}
+
+u32 mdJobSystemGetWorkersCount()
+{
+	MD_ASSERT(s_isInitialized == MD_TRUE);
+
+	return s_workersCount;
+}
+
+void mdJobSystemSetBackgroundBudget(mdTicks budgetTicks)
+{
+	MD_ATOMIC_STORE(&s_backgroundBudgetTicks, budgetTicks, MD_MEMORY_ORDER_RELAXED);
+}
+
+void mdJobSystemBeginFrame()
+{
+	MD_ASSERT(s_isInitialized == MD_TRUE);
+
+	MD_ATOMIC_STORE(&s_backgroundSpentTicks, 0, MD_MEMORY_ORDER_RELAXED);
+
+	// The workers which went to sleep over the exhausted budget are not woken by any submission.
+	u32 backgroundCount = MD_ATOMIC_LOAD(&s_queues[MD_JOB_PRIORITY_BACKGROUND].count, MD_MEMORY_ORDER_RELAXED);
+	if (backgroundCount > 0)
+	{
+		wakeWorkers(backgroundCount);
+	}
+}
+
+void mdJobSubmit(const struct MdJobDecl* pJobs,
+				 u32					 jobsCount,
+				 enum MdJobPriority		 priority,
+				 struct MdJobCounter*	 pCounter)
+{
+	MD_ASSERT(s_isInitialized == MD_TRUE);
+	MD_ASSERT(pJobs != MD_NULL || jobsCount == 0);
+	MD_ASSERT(priority < MD_JOB_PRIORITY_COUNT);
+
+	if (jobsCount == 0)
+	{
+		return;
+	}
+
+	// Counted before any job can run and finish.
+	if (pCounter != MD_NULL)
+	{
+		MD_ATOMIC_FETCH_ADD(&pCounter->pendingCount, jobsCount, MD_MEMORY_ORDER_RELAXED);
+	}
+
+	u32			   pushedCount = 0;
+	struct Worker* pWorker	   = getCurrentWorker();
+	if (priority == MD_JOB_PRIORITY_NORMAL && pWorker != MD_NULL)
+	{
+		struct Job job;
+		job.pCounter = pCounter;
+		for (; pushedCount < jobsCount; ++pushedCount)
+		{
+			job.function  = pJobs[pushedCount].function;
+			job.pUserData = pJobs[pushedCount].pUserData;
+			if (!dequePush(pWorker->pDeque, &job))
+			{
+				break;
+			}
+		}
+	}
+
+	// The shared lanes, and the overflow of a full deque (usually a deep recursion of submissions).
+	struct Job jobs[SUBMIT_BATCH_SIZE];
+	while (pushedCount < jobsCount)
+	{
+		u32 batchCount = jobsCount - pushedCount < SUBMIT_BATCH_SIZE ? jobsCount - pushedCount : SUBMIT_BATCH_SIZE;
+		for (u32 i = 0; i < batchCount; ++i)
+		{
+			jobs[i].function  = pJobs[pushedCount + i].function;
+			jobs[i].pUserData = pJobs[pushedCount + i].pUserData;
+			jobs[i].pCounter  = pCounter;
+		}
+		queuePush(&s_queues[priority], jobs, batchCount);
+		pushedCount += batchCount;
+	}
+
+	wakeWorkers(jobsCount);
+}
+
+void mdJobWait(struct MdJobCounter* pCounter)
+{
+	MD_ASSERT(s_isInitialized == MD_TRUE);
+	MD_ASSERT(pCounter != MD_NULL);
+
+	if (MD_ATOMIC_LOAD(&pCounter->pendingCount, MD_MEMORY_ORDER_ACQUIRE) == 0)
+	{
+		return;
+	}
+
+	// Inside a job fiber: suspends it, the thread runs the other jobs and a thread resumes it once the counter is zero.
+	struct Worker* pWorker = getCurrentWorker();
+	if (pWorker != MD_NULL && pWorker->pRunningFiber != MD_NULL)
+	{
+		struct JobFiber* pJobFiber = pWorker->pRunningFiber;
+		pJobFiber->pWaitedCounter  = pCounter;
+		pWorker->pSuspendingFiber  = pJobFiber;
+		mdFiberSwitch(pJobFiber->pFiber, pWorker->pThreadFiber);
+		return;
+	}
+
+	// On a thread stack: runs the jobs until the counter is zero.
+	struct Job		   job;
+	enum MdJobPriority priority;
+	u32				   idleSpins = 0;
+	while (MD_ATOMIC_LOAD(&pCounter->pendingCount, MD_MEMORY_ORDER_ACQUIRE) != 0)
+	{
+		if (resumeReadyJobFiber())
+		{
+			idleSpins = 0;
+		}
+		else if (findJob(&job, &priority, MD_TRUE))
+		{
+			runJob(&job, priority);
+			idleSpins = 0;
+		}
+		else if (idleSpins < WAIT_SPINS_BEFORE_YIELD)
+		{
+			// The last jobs are running on other threads.
+			++idleSpins;
+			MD_CPU_RELAX();
+		}
+		else
+		{
+			mdThreadYield();
+		}
+	}
+}
+
+b8 mdJobIsDone(const struct MdJobCounter* pCounter)
+{
+	MD_ASSERT(pCounter != MD_NULL);
+	return MD_ATOMIC_LOAD(&pCounter->pendingCount, MD_MEMORY_ORDER_ACQUIRE) == 0;
+}
@@ -0,0 +1,303 @@
+#include "MEEDEngine/core/jobs/parallel.h"
+#include "MEEDEngine/core/jobs/jobs.h"
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/thread.h"
+
+/**
+ * The split of a range in chunks, the last one may be shorter.
+ */
+struct ChunkLayout
+{
+	u64 begin;
+	u64 end;
+	u64 grainSize;
+	u32 chunksCount;
+};
+
+/**
+ * The arguments of the job of one chunk, shared by the three loops.
+ */
+struct ChunkJob
+{
+	const struct ChunkLayout* pLayout;
+	u32						  chunkIndex;
+	void*					  pLoop; ///< The arguments of the loop, specific to each of them.
+};
+
+struct ForLoop
+{
+	MdParallelForFunction function;
+	void*				  pUserData;
+};
+
+struct ReduceLoop
+{
+	MdParallelReduceFunction reduce;
+	u8*						 pPartials;
+	mdSize					 valueSize;
+	void*					 pUserData;
+};
+
+struct ScanLoop
+{
+	const u32* pInput;
+	u32*	   pOutput;
+	u32*	   pChunkSums; ///< The sums of the chunks, then their offsets.
+};
+
+static struct MdSpinlock s_startLock		= {0};	    ///< Serializes the start of the job system by the loops.
+static b8				 s_isStartedByLoops = MD_FALSE; ///< Whether `mdParallelShutdown` owns the job system.
+
+/**
+ * Starts the job system with the default workers on the first loop, once even when several threads start loops.
+ */
+static void startJobSystem()
+{
+	if (mdJobSystemIsInitialized())
+	{
+		return;
+	}
+
+	mdSpinlockLock(&s_startLock);
+	if (!mdJobSystemIsInitialized())
+	{
+		mdJobSystemInitialize(MD_JOB_WORKERS_COUNT_DEFAULT);
+		s_isStartedByLoops = MD_TRUE;
+	}
+	mdSpinlockUnlock(&s_startLock);
+}
+
+static void computeLayout(u64 begin, u64 end, u64 grainSize, struct ChunkLayout* pLayout)
+{
+	u64 count	   = end - begin;
+	pLayout->begin = begin;
+	pLayout->end   = end;
+
+	startJobSystem();
+	u64 threadsCount = (u64)mdJobSystemGetWorkersCount() + 1;
+
+	if (grainSize == 0)
+	{
+		grainSize = (count + threadsCount * MD_PARALLEL_CHUNKS_PER_THREAD - 1) /
+					(threadsCount * MD_PARALLEL_CHUNKS_PER_THREAD);
+		if (grainSize < MD_PARALLEL_MIN_AUTO_GRAIN_SIZE)
+		{
+			grainSize = MD_PARALLEL_MIN_AUTO_GRAIN_SIZE;
+		}
+	}
+
+	u64 maxChunksCount = threadsCount * MD_PARALLEL_MAX_CHUNKS_PER_THREAD;
+	if ((count + grainSize - 1) / grainSize > maxChunksCount)
+	{
+		grainSize = (count + maxChunksCount - 1) / maxChunksCount;
+	}
+
+	// Without workers the chunks would only add the scheduling to the serial loop.
+	pLayout->grainSize	 = grainSize;
+	pLayout->chunksCount = threadsCount == 1 || count <= grainSize ? 1 : (u32)((count + grainSize - 1) / grainSize);
+}
+
+static void getChunkRange(const struct ChunkLayout* pLayout, u32 chunkIndex, u64* pBegin, u64* pEnd)
+{
+	if (pLayout->chunksCount == 1)
+	{
+		*pBegin = pLayout->begin;
+		*pEnd	= pLayout->end;
+		return;
+	}
+
+	*pBegin = pLayout->begin + chunkIndex * pLayout->grainSize;
+	*pEnd	= *pBegin + pLayout->grainSize < pLayout->end ? *pBegin + pLayout->grainSize : pLayout->end;
+}
+
+/**
+ * Runs a job per chunk and waits for them, or runs the only chunk on the calling thread.
+ */
+static void runChunks(const struct ChunkLayout* pLayout, MdJobFunction function, void* pLoop)
+{
+	if (pLayout->chunksCount == 1)
+	{
+		struct ChunkJob chunkJob = {pLayout, 0, pLoop};
+		function(&chunkJob);
+		return;
+	}
+
+	struct ChunkJob*  pChunkJobs = MD_MALLOC_ARRAY(struct ChunkJob, pLayout->chunksCount);
+	struct MdJobDecl* pJobs		 = MD_MALLOC_ARRAY(struct MdJobDecl, pLayout->chunksCount);
+	for (u32 i = 0; i < pLayout->chunksCount; ++i)
+	{
+		pChunkJobs[i].pLayout	 = pLayout;
+		pChunkJobs[i].chunkIndex = i;
+		pChunkJobs[i].pLoop		 = pLoop;
+		pJobs[i].function		 = function;
+		pJobs[i].pUserData		 = &pChunkJobs[i];
+	}
+
+	struct MdJobCounter counter = {0};
+	mdJobSubmit(pJobs, pLayout->chunksCount, MD_JOB_PRIORITY_NORMAL, &counter);
+	mdJobWait(&counter);
+
+	MD_FREE_ARRAY(pJobs, struct MdJobDecl, pLayout->chunksCount);
+	MD_FREE_ARRAY(pChunkJobs, struct ChunkJob, pLayout->chunksCount);
+}
+
+static void runForChunk(void* pUserData)
+{
+	struct ChunkJob* pChunkJob = (struct ChunkJob*)pUserData;
+	struct ForLoop*	 pLoop	   = (struct ForLoop*)pChunkJob->pLoop;
+	u64				 begin;
+	u64				 end;
+	getChunkRange(pChunkJob->pLayout, pChunkJob->chunkIndex, &begin, &end);
+	pLoop->function(begin, end, pLoop->pUserData);
+}
+
+void mdParallelFor(u64 begin, u64 end, u64 grainSize, MdParallelForFunction function, void* pUserData)
+{
+	MD_ASSERT(begin <= end);
+	MD_ASSERT(function != MD_NULL);
+
+	if (begin == end)
+	{
+		return;
+	}
+
+	struct ChunkLayout layout;
+	computeLayout(begin, end, grainSize, &layout);
+	struct ForLoop loop = {function, pUserData};
+	runChunks(&layout, runForChunk, &loop);
+}
+
+static void runReduceChunk(void* pUserData)
+{
+	struct ChunkJob*   pChunkJob = (struct ChunkJob*)pUserData;
+	struct ReduceLoop* pLoop	 = (struct ReduceLoop*)pChunkJob->pLoop;
+	u64				   begin;
+	u64				   end;
+	getChunkRange(pChunkJob->pLayout, pChunkJob->chunkIndex, &begin, &end);
+	pLoop->reduce(begin, end, pLoop->pPartials + pChunkJob->chunkIndex * pLoop->valueSize, pLoop->pUserData);
+}
+
+void mdParallelReduce(u64						 begin,
+					  u64						 end,
+					  u64						 grainSize,
+					  MdParallelReduceFunction	 reduce,
+					  MdParallelCombineFunction	 combine,
+					  const void*				 pIdentity,
+					  mdSize					 valueSize,
+					  void*						 pResult,
+					  void*						 pUserData)
+{
+	MD_ASSERT(begin <= end);
+	MD_ASSERT(reduce != MD_NULL && combine != MD_NULL);
+	MD_ASSERT(pIdentity != MD_NULL && pResult != MD_NULL && valueSize > 0);
+
+	mdMemoryCopy(pResult, pIdentity, valueSize);
+	if (begin == end)
+	{
+		return;
+	}
+
+	struct ChunkLayout layout;
+	computeLayout(begin, end, grainSize, &layout);
+	if (layout.chunksCount == 1)
+	{
+		reduce(begin, end, pResult, pUserData);
+		return;
+	}
+
+	struct ReduceLoop loop = {reduce, MD_MALLOC_ARRAY(u8, layout.chunksCount * valueSize), valueSize, pUserData};
+	for (u32 i = 0; i < layout.chunksCount; ++i)
+	{
+		mdMemoryCopy(loop.pPartials + i * valueSize, pIdentity, valueSize);
+	}
+	runChunks(&layout, runReduceChunk, &loop);
+
+	for (u32 i = 0; i < layout.chunksCount; ++i)
+	{
+		combine(pResult, loop.pPartials + i * valueSize, pUserData);
+	}
+	MD_FREE_ARRAY(loop.pPartials, u8, layout.chunksCount * valueSize);
+}
+
+static void sumScanChunk(void* pUserData)
+{
+	struct ChunkJob* pChunkJob = (struct ChunkJob*)pUserData;
+	struct ScanLoop* pLoop	   = (struct ScanLoop*)pChunkJob->pLoop;
+	u64				 begin;
+	u64				 end;
+	getChunkRange(pChunkJob->pLayout, pChunkJob->chunkIndex, &begin, &end);
+
+	u32 sum = 0;
+	for (u64 i = begin; i < end; ++i)
+	{
+		sum += pLoop->pInput[i];
+	}
+	pLoop->pChunkSums[pChunkJob->chunkIndex] = sum;
+}
+
+static void scanChunk(void* pUserData)
+{
+	struct ChunkJob* pChunkJob = (struct ChunkJob*)pUserData;
+	struct ScanLoop* pLoop	   = (struct ScanLoop*)pChunkJob->pLoop;
+	u64				 begin;
+	u64				 end;
+	getChunkRange(pChunkJob->pLayout, pChunkJob->chunkIndex, &begin, &end);
+
+	// The input is read before the output is written, the scan can be in place.
+	u32 sum = pLoop->pChunkSums[pChunkJob->chunkIndex];
+	for (u64 i = begin; i < end; ++i)
+	{
+		u32 value		  = pLoop->pInput[i];
+		pLoop->pOutput[i] = sum;
+		sum += value;
+	}
+
+	// The end of the chunk, the total of the scan when it is the only chunk.
+	pLoop->pChunkSums[pChunkJob->chunkIndex] = sum;
+}
+
+u32 mdParallelScan(const u32* pInput, u32* pOutput, u64 count, u64 grainSize)
+{
+	MD_ASSERT((pInput != MD_NULL && pOutput != MD_NULL) || count == 0);
+
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	struct ChunkLayout layout;
+	computeLayout(0, count, grainSize, &layout);
+
+	u32				total = 0;
+	struct ScanLoop loop  = {pInput, pOutput, &total};
+	if (layout.chunksCount == 1)
+	{
+		runChunks(&layout, scanChunk, &loop);
+		return total;
+	}
+
+	loop.pChunkSums = MD_MALLOC_ARRAY(u32, layout.chunksCount);
+	runChunks(&layout, sumScanChunk, &loop);
+
+	for (u32 i = 0; i < layout.chunksCount; ++i)
+	{
+		u32 chunkSum	   = loop.pChunkSums[i];
+		loop.pChunkSums[i] = total;
+		total += chunkSum;
+	}
+
+	runChunks(&layout, scanChunk, &loop);
+	MD_FREE_ARRAY(loop.pChunkSums, u32, layout.chunksCount);
+	return total;
+}
+
+void mdParallelShutdown()
+{
+	mdSpinlockLock(&s_startLock);
+	if (s_isStartedByLoops && mdJobSystemIsInitialized())
+	{
+		mdJobSystemShutdown();
+	}
+	s_isStartedByLoops = MD_FALSE;
+	mdSpinlockUnlock(&s_startLock);
+}
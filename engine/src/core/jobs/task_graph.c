@@ -0,0 +1,388 @@
+#include "MEEDEngine/core/jobs/task_graph.h"
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/profile.h"
+#include "MEEDEngine/platforms/thread.h"
+
+#define FRAME_SLOTS_COUNT		3u ///< The two frames in flight, and the next one whose counters are set up ahead.
+#define AVERAGE_FRAMES_COUNT	8u ///< The weight of the last frame in the average durations is 1 / 8.
+
+/**
+ * The argument of the job of a task in a frame.
+ */
+struct TaskInstance
+{
+	struct MdTaskGraph* pGraph;
+	u32					slotIndex;
+	u32					taskIndex;
+};
+
+/**
+ * The state of the tasks of one frame, the slots are reused in turn.
+ */
+struct FrameSlot
+{
+	u32					pendingCounts[MD_TASK_GRAPH_MAX_TASKS]; ///< The dependencies left, and the frame start.
+	mdTicks				startTicks[MD_TASK_GRAPH_MAX_TASKS];
+	mdTicks				endTicks[MD_TASK_GRAPH_MAX_TASKS];
+	struct TaskInstance instances[MD_TASK_GRAPH_MAX_TASKS];
+	u64					readyMainThreadTasks;	 ///< The main thread tasks which can run, a bit per task.
+	u32					unfinishedCount;		 ///< The tasks of the frame which have not finished.
+	u32					unfinishedBlockingCount; ///< The same, without the overlapped tasks.
+};
+
+struct MdTaskGraph
+{
+	struct MdTaskDecl tasks[MD_TASK_GRAPH_MAX_TASKS];
+	u32				  tasksCount;
+	u32				  blockingTasksCount; ///< The tasks which are not overlapped.
+	u64				  predecessors[MD_TASK_GRAPH_MAX_TASKS];
+	u64				  successors[MD_TASK_GRAPH_MAX_TASKS];
+	u64				  nextFrameSuccessors[MD_TASK_GRAPH_MAX_TASKS]; ///< What an overlapped task blocks next frame.
+	u32				  nextFramePredecessorsCounts[MD_TASK_GRAPH_MAX_TASKS];
+
+	struct FrameSlot slots[FRAME_SLOTS_COUNT];
+	u64				 framesCount;		  ///< The executions started.
+	u64				 measuredFramesCount; ///< The frames whose measures are in the statistics.
+
+	// The executing thread waits on the counter, at 1, while the jobs run: a task which readies a main thread task or
+	// finishes a frame sets it back to 0. The job system only counts down the counters it is given to submit.
+	struct MdJobCounter wakeCounter;
+	u32					runningCount; ///< The task jobs which have started and not returned yet.
+
+	struct MdTaskStats stats[MD_TASK_GRAPH_MAX_TASKS];
+	mdTicks			   criticalPathTicks;
+};
+
+static b8 areConflicting(const struct MdTaskDecl* pFirst, const struct MdTaskDecl* pSecond)
+{
+	return (pFirst->writes & (pSecond->reads | pSecond->writes)) != 0 || (pFirst->reads & pSecond->writes) != 0;
+}
+
+static void prepareSlot(struct MdTaskGraph* pGraph, u32 slotIndex, b8 isAfterFrame)
+{
+	struct FrameSlot* pSlot = &pGraph->slots[slotIndex];
+	for (u32 i = 0; i < pGraph->tasksCount; ++i)
+	{
+		u32 pendingCount = 1u + (u32)__builtin_popcountll(pGraph->predecessors[i]);
+		if (isAfterFrame)
+		{
+			pendingCount += pGraph->nextFramePredecessorsCounts[i];
+		}
+		pSlot->pendingCounts[i] = pendingCount;
+	}
+	pSlot->readyMainThreadTasks	   = 0;
+	pSlot->unfinishedCount		   = pGraph->tasksCount;
+	pSlot->unfinishedBlockingCount = pGraph->blockingTasksCount;
+}
+
+static void wakeExecutingThread(struct MdTaskGraph* pGraph)
+{
+	MD_ATOMIC_STORE(&pGraph->wakeCounter.pendingCount, 0u, MD_MEMORY_ORDER_SEQ_CST);
+}
+
+static void runTask(void* pUserData);
+
+static void resolveDependency(struct MdTaskGraph* pGraph, u32 slotIndex, u32 taskIndex)
+{
+	// Acquire and release: the task sees the writes of every task it waited on, wherever it runs.
+	struct FrameSlot* pSlot = &pGraph->slots[slotIndex];
+	if (MD_ATOMIC_FETCH_SUB(&pSlot->pendingCounts[taskIndex], 1u, MD_MEMORY_ORDER_ACQ_REL) != 1)
+	{
+		return;
+	}
+
+	if (pGraph->tasks[taskIndex].isMainThread)
+	{
+		MD_ATOMIC_FETCH_OR(&pSlot->readyMainThreadTasks, 1ull << taskIndex, MD_MEMORY_ORDER_SEQ_CST);
+		wakeExecutingThread(pGraph);
+		return;
+	}
+
+	struct MdJobDecl job = {runTask, &pSlot->instances[taskIndex]};
+	mdJobSubmit(&job, 1, MD_JOB_PRIORITY_HIGH, MD_NULL);
+}
+
+static void runTask(void* pUserData)
+{
+	struct TaskInstance*	 pInstance = (struct TaskInstance*)pUserData;
+	struct MdTaskGraph*		 pGraph	   = pInstance->pGraph;
+	struct FrameSlot*		 pSlot	   = &pGraph->slots[pInstance->slotIndex];
+	const struct MdTaskDecl* pTask	   = &pGraph->tasks[pInstance->taskIndex];
+	u32						 taskIndex = pInstance->taskIndex;
+	MD_ATOMIC_FETCH_ADD(&pGraph->runningCount, 1u, MD_MEMORY_ORDER_RELAXED);
+
+	pSlot->startTicks[taskIndex] = mdGetTicks();
+	MD_PROFILE_BEGIN(pTask->name);
+	pTask->function(pTask->pUserData);
+	MD_PROFILE_END();
+	pSlot->endTicks[taskIndex] = mdGetTicks();
+
+	for (u64 successors = pGraph->successors[taskIndex]; successors != 0; successors &= successors - 1)
+	{
+		resolveDependency(pGraph, pInstance->slotIndex, (u32)__builtin_ctzll(successors));
+	}
+	u32 nextSlotIndex = (pInstance->slotIndex + 1) % FRAME_SLOTS_COUNT;
+	for (u64 successors = pGraph->nextFrameSuccessors[taskIndex]; successors != 0; successors &= successors - 1)
+	{
+		resolveDependency(pGraph, nextSlotIndex, (u32)__builtin_ctzll(successors));
+	}
+
+	b8 isFrameDone = MD_ATOMIC_FETCH_SUB(&pSlot->unfinishedCount, 1u, MD_MEMORY_ORDER_SEQ_CST) == 1;
+	if (!pTask->isOverlapped)
+	{
+		isFrameDone |= MD_ATOMIC_FETCH_SUB(&pSlot->unfinishedBlockingCount, 1u, MD_MEMORY_ORDER_SEQ_CST) == 1;
+	}
+	if (isFrameDone)
+	{
+		wakeExecutingThread(pGraph);
+	}
+
+	// The last access to the graph: it can be destroyed once no task job is running.
+	MD_ATOMIC_FETCH_SUB(&pGraph->runningCount, 1u, MD_MEMORY_ORDER_RELEASE);
+}
+
+static b8 runMainThreadTasks(struct FrameSlot* pSlot)
+{
+	if (pSlot == MD_NULL)
+	{
+		return MD_FALSE;
+	}
+
+	u64 readyTasks = MD_ATOMIC_EXCHANGE(&pSlot->readyMainThreadTasks, 0ull, MD_MEMORY_ORDER_ACQUIRE);
+	for (u64 tasks = readyTasks; tasks != 0; tasks &= tasks - 1)
+	{
+		runTask(&pSlot->instances[__builtin_ctzll(tasks)]);
+	}
+	return readyTasks != 0;
+}
+
+static b8 isWaitOver(const struct FrameSlot* pPreviousSlot, const struct FrameSlot* pSlot)
+{
+	return (pPreviousSlot == MD_NULL ||
+			MD_ATOMIC_LOAD(&pPreviousSlot->unfinishedCount, MD_MEMORY_ORDER_SEQ_CST) == 0) &&
+		   (pSlot == MD_NULL || MD_ATOMIC_LOAD(&pSlot->unfinishedBlockingCount, MD_MEMORY_ORDER_SEQ_CST) == 0);
+}
+
+static b8 hasReadyMainThreadTasks(const struct FrameSlot* pPreviousSlot, const struct FrameSlot* pSlot)
+{
+	return (pPreviousSlot != MD_NULL &&
+			MD_ATOMIC_LOAD(&pPreviousSlot->readyMainThreadTasks, MD_MEMORY_ORDER_SEQ_CST) != 0) ||
+		   (pSlot != MD_NULL && MD_ATOMIC_LOAD(&pSlot->readyMainThreadTasks, MD_MEMORY_ORDER_SEQ_CST) != 0);
+}
+
+/**
+ * Runs the main thread tasks and the other jobs until every task of the previous frame and the blocking tasks of the
+ * current one are done.
+ */
+static void waitForFrames(struct MdTaskGraph* pGraph, struct FrameSlot* pPreviousSlot, struct FrameSlot* pSlot)
+{
+	for (;;)
+	{
+		// The older frame first, its tasks block the ones of the current frame.
+		if (runMainThreadTasks(pPreviousSlot) || runMainThreadTasks(pSlot))
+		{
+			continue;
+		}
+		if (isWaitOver(pPreviousSlot, pSlot))
+		{
+			return;
+		}
+
+		// Armed before the checks: a task which finishes or readies a main thread task after them disarms it.
+		MD_ATOMIC_STORE(&pGraph->wakeCounter.pendingCount, 1u, MD_MEMORY_ORDER_SEQ_CST);
+		if (!isWaitOver(pPreviousSlot, pSlot) && !hasReadyMainThreadTasks(pPreviousSlot, pSlot))
+		{
+			mdJobWait(&pGraph->wakeCounter);
+		}
+	}
+}
+
+static void measureFrame(struct MdTaskGraph* pGraph, u64 frameIndex)
+{
+	if (frameIndex < pGraph->measuredFramesCount)
+	{
+		return;
+	}
+	pGraph->measuredFramesCount = frameIndex + 1;
+
+	// The declaration order is a topological order: the longest chains ending with each task forward, then the
+	// longest chains starting with each task backward.
+	const struct FrameSlot* pSlot = &pGraph->slots[frameIndex % FRAME_SLOTS_COUNT];
+	mdTicks					durations[MD_TASK_GRAPH_MAX_TASKS];
+	mdTicks					headTicks[MD_TASK_GRAPH_MAX_TASKS];
+	mdTicks					tailTicks[MD_TASK_GRAPH_MAX_TASKS];
+	mdTicks					criticalPathTicks = 0;
+	for (u32 i = 0; i < pGraph->tasksCount; ++i)
+	{
+		durations[i]		 = pSlot->endTicks[i] - pSlot->startTicks[i];
+		mdTicks longestTicks = 0;
+		for (u64 predecessors = pGraph->predecessors[i]; predecessors != 0; predecessors &= predecessors - 1)
+		{
+			u32 predecessor = (u32)__builtin_ctzll(predecessors);
+			longestTicks	= headTicks[predecessor] > longestTicks ? headTicks[predecessor] : longestTicks;
+		}
+		headTicks[i]	  = longestTicks + durations[i];
+		criticalPathTicks = headTicks[i] > criticalPathTicks ? headTicks[i] : criticalPathTicks;
+	}
+	for (u32 i = pGraph->tasksCount; i-- > 0;)
+	{
+		mdTicks longestTicks = 0;
+		for (u64 successors = pGraph->successors[i]; successors != 0; successors &= successors - 1)
+		{
+			u32 successor = (u32)__builtin_ctzll(successors);
+			longestTicks  = tailTicks[successor] > longestTicks ? tailTicks[successor] : longestTicks;
+		}
+		tailTicks[i] = longestTicks + durations[i];
+	}
+
+	for (u32 i = 0; i < pGraph->tasksCount; ++i)
+	{
+		struct MdTaskStats* pStats = &pGraph->stats[i];
+		pStats->durationTicks	   = durations[i];
+		pStats->pathTicks		   = headTicks[i];
+		pStats->slackTicks		   = criticalPathTicks - (headTicks[i] + tailTicks[i] - durations[i]);
+		if (frameIndex == 0)
+		{
+			pStats->averageDurationTicks = durations[i];
+		}
+		else
+		{
+			pStats->averageDurationTicks -= pStats->averageDurationTicks / AVERAGE_FRAMES_COUNT;
+			pStats->averageDurationTicks += durations[i] / AVERAGE_FRAMES_COUNT;
+		}
+		if (pStats->slackTicks == 0)
+		{
+			++pStats->criticalFramesCount;
+		}
+	}
+	pGraph->criticalPathTicks = criticalPathTicks;
+}
+
+struct MdTaskGraph* mdTaskGraphCreate(const struct MdTaskDecl* pTasks, u32 tasksCount)
+{
+	MD_ASSERT(mdJobSystemIsInitialized());
+	MD_ASSERT(pTasks != MD_NULL || tasksCount == 0);
+	MD_ASSERT(tasksCount <= MD_TASK_GRAPH_MAX_TASKS);
+
+	struct MdTaskGraph* pGraph = MD_MALLOC(struct MdTaskGraph);
+	MD_ASSERT(pGraph != MD_NULL);
+	mdMemorySet(pGraph, 0, sizeof(struct MdTaskGraph));
+	mdMemoryCopy(pGraph->tasks, pTasks, tasksCount * sizeof(struct MdTaskDecl));
+	pGraph->tasksCount = tasksCount;
+
+	for (u32 i = 0; i < tasksCount; ++i)
+	{
+		MD_ASSERT(pTasks[i].function != MD_NULL);
+
+		// The conflicts with the tasks declared before, in the frame and with the next frame.
+		for (u32 j = 0; j < i; ++j)
+		{
+			if (areConflicting(&pTasks[j], &pTasks[i]))
+			{
+				pGraph->predecessors[i] |= 1ull << j;
+				pGraph->successors[j] |= 1ull << i;
+			}
+		}
+		if (pTasks[i].isOverlapped)
+		{
+			for (u32 j = 0; j < tasksCount; ++j)
+			{
+				if (j == i || areConflicting(&pTasks[i], &pTasks[j]))
+				{
+					pGraph->nextFrameSuccessors[i] |= 1ull << j;
+					++pGraph->nextFramePredecessorsCounts[j];
+				}
+			}
+		}
+		else
+		{
+			++pGraph->blockingTasksCount;
+		}
+	}
+
+	for (u32 slotIndex = 0; slotIndex < FRAME_SLOTS_COUNT; ++slotIndex)
+	{
+		for (u32 i = 0; i < tasksCount; ++i)
+		{
+			struct TaskInstance* pInstance = &pGraph->slots[slotIndex].instances[i];
+			pInstance->pGraph			   = pGraph;
+			pInstance->slotIndex		   = slotIndex;
+			pInstance->taskIndex		   = i;
+		}
+	}
+
+	// The first frame follows no other.
+	prepareSlot(pGraph, 0, MD_FALSE);
+	return pGraph;
+}
+
+void mdTaskGraphExecute(struct MdTaskGraph* pGraph)
+{
+	MD_ASSERT(pGraph != MD_NULL);
+
+	u64				  frameIndex	= pGraph->framesCount++;
+	u32				  slotIndex		= (u32)(frameIndex % FRAME_SLOTS_COUNT);
+	struct FrameSlot* pSlot			= &pGraph->slots[slotIndex];
+	struct FrameSlot* pPreviousSlot = MD_NULL;
+	if (frameIndex > 0)
+	{
+		pPreviousSlot = &pGraph->slots[(frameIndex - 1) % FRAME_SLOTS_COUNT];
+	}
+
+	// The slot of the next frame was the one of the frame before the previous, which is done. Its counters must be
+	// ready before the overlapped tasks of this frame start, they count them down.
+	prepareSlot(pGraph, (slotIndex + 1) % FRAME_SLOTS_COUNT, MD_TRUE);
+
+	// Removes the frame start from the dependencies: the tasks which only waited for it start.
+	for (u32 i = 0; i < pGraph->tasksCount; ++i)
+	{
+		resolveDependency(pGraph, slotIndex, i);
+	}
+
+	waitForFrames(pGraph, pPreviousSlot, pSlot);
+	if (frameIndex > 0)
+	{
+		measureFrame(pGraph, frameIndex - 1);
+	}
+}
+
+void mdTaskGraphWaitIdle(struct MdTaskGraph* pGraph)
+{
+	MD_ASSERT(pGraph != MD_NULL);
+
+	if (pGraph->framesCount == 0)
+	{
+		return;
+	}
+
+	u64 frameIndex = pGraph->framesCount - 1;
+	waitForFrames(pGraph, &pGraph->slots[frameIndex % FRAME_SLOTS_COUNT], MD_NULL);
+	measureFrame(pGraph, frameIndex);
+}
+
+struct MdTaskStats mdTaskGraphGetTaskStats(const struct MdTaskGraph* pGraph, u32 taskIndex)
+{
+	MD_ASSERT(pGraph != MD_NULL);
+	MD_ASSERT(taskIndex < pGraph->tasksCount);
+	return pGraph->stats[taskIndex];
+}
+
+mdTicks mdTaskGraphGetCriticalPathTicks(const struct MdTaskGraph* pGraph)
+{
+	MD_ASSERT(pGraph != MD_NULL);
+	return pGraph->criticalPathTicks;
+}
+
+void mdTaskGraphDestroy(struct MdTaskGraph* pGraph)
+{
+	MD_ASSERT(pGraph != MD_NULL);
+	MD_ASSERT(pGraph->framesCount == 0 ||
+			  pGraph->slots[(pGraph->framesCount - 1) % FRAME_SLOTS_COUNT].unfinishedCount == 0);
+
+	// The jobs of the last tasks may still be returning.
+	while (MD_ATOMIC_LOAD(&pGraph->runningCount, MD_MEMORY_ORDER_ACQUIRE) != 0)
+	{
+		mdThreadYield();
+	}
+	MD_FREE(pGraph, struct MdTaskGraph);
+}
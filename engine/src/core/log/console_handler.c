@@ -42,7 +42,7 @@ static void mdConsoleLogHandlerRecordHandle(const struct MdLogRecord* pRecord)
 	}
 
 	mdSetConsoleConfig(config);
-	mdFormatPrint("[%7s] - [%7s] - %s\n", "ENGINE", levelStr, pRecord->message);
+	mdFormatPrint("[%8s] - [%7s] - %s\n", mdLogGetCategoryName(pRecord->category), levelStr, pRecord->message);
 
 	config.color = MD_CONSOLE_COLOR_RESET;
 	mdSetConsoleConfig(config);
@@ -63,7 +63,8 @@ void mdInitializeConsoleLogHandler(enum MdLogLevel level)
 	MD_LOG_CONSOLE_HANDLER->init		 = mdConsoleLogHandlerInit;
 	MD_LOG_CONSOLE_HANDLER->recordHandle = mdConsoleLogHandlerRecordHandle;
 	MD_LOG_CONSOLE_HANDLER->shutdown	 = mdConsoleLogHandlerShutdown;
-	MD_LOG_CONSOLE_HANDLER->level		 = MD_LOG_LEVEL_DEBUG; // Default log level
+	MD_LOG_CONSOLE_HANDLER->flush		 = MD_NULL;
+	MD_LOG_CONSOLE_HANDLER->level		 = level;
 }
 
 void mdShutdownConsoleLogHandler()
@@ -0,0 +1,352 @@
+#include "MEEDEngine/core/log/log.h"
+#include "MEEDEngine/core/string/string.h"
+#include "MEEDEngine/platforms/platforms.h"
+
+#define MD_FILE_LOG_SEGMENT_SIZE	 (64u * 1024u)
+#define MD_FILE_LOG_MAX_PATH_LENGTH	 512
+#define MD_FILE_LOG_MAX_LINE_LENGTH	 (MD_LOG_MESSAGE_MAX_LENGTH + 256)
+#define MD_FILE_LOG_TIME_STRING_SIZE 20
+
+/**
+ * The internal state of the file log handler. The user-space buffer is split into fixed-size segments, the
+ * records are appended to the current segment and all the filled segments are written with one vectored write.
+ * The records are logged from any thread, everything below `mutex` is only accessed with it locked.
+ */
+struct FileLogData
+{
+	struct MdFileLogHandlerConfig config;
+	char						  filePath[MD_FILE_LOG_MAX_PATH_LENGTH];
+	struct MdMutex				  mutex;
+
+	struct MdFileData* pFile;
+	u64				   fileSize;	  ///< The number of bytes written to the active file.
+	mdUNIXTime		   fileOpenTime;  ///< When the active file was opened, used for the time based rotation.
+	mdUNIXTime		   oldestPending; ///< When the oldest buffered record arrived, used for the time based flush.
+
+	u8*					 pBuffer;		///< The whole user-space buffer, `segmentsCount` segments.
+	u32*				 pSegmentSizes; ///< The used bytes of each segment.
+	struct MdFileBuffer* pWriteBuffers; ///< Describes the filled segments for the vectored write.
+	u32					 segmentsCount;
+	u32					 currentSegment;
+	u64					 pendingBytes;
+
+	mdUNIXTime cachedTime; ///< The second which is formatted inside `timeString`.
+	char	   timeString[MD_FILE_LOG_TIME_STRING_SIZE];
+};
+
+static struct FileLogData* s_pFileLogData = MD_NULL;
+
+struct MdLogHandler* MD_LOG_FILE_HANDLER = MD_NULL;
+
+static const char* s_levelNames[] = {
+	[MD_LOG_LEVEL_VERBOSE] = "VERBOSE",
+	[MD_LOG_LEVEL_DEBUG]   = "DEBUG",
+	[MD_LOG_LEVEL_INFO]	   = "INFO",
+	[MD_LOG_LEVEL_WARNING] = "WARNING",
+	[MD_LOG_LEVEL_ERROR]   = "ERROR",
+	[MD_LOG_LEVEL_FATAL]   = "FATAL",
+};
+
+static void openActiveFile();
+static void closeActiveFile();
+static void rotateFiles();
+static void flushBuffer();
+static void appendLine(const char* line, u32 length);
+
+struct MdFileLogHandlerConfig mdFileLogHandlerGetDefaultConfig(const char* filePath)
+{
+	struct MdFileLogHandlerConfig config;
+	mdMemorySet(&config, 0, sizeof(struct MdFileLogHandlerConfig));
+
+	config.filePath				   = filePath;
+	config.bufferSize			   = 1024u * 1024u;
+	config.flushIntervalSeconds	   = 1;
+	config.flushLevel			   = MD_LOG_LEVEL_ERROR;
+	config.maxFileSize			   = 64ull * 1024ull * 1024ull;
+	config.rotationIntervalSeconds = 0;
+	config.maxRetainedFiles		   = 5;
+	config.syncPolicy			   = MD_FILE_LOG_SYNC_POLICY_ON_ROTATE;
+
+	return config;
+}
+
+static void mdFileLogHandlerInit()
+{
+	// The file is opened by `mdInitializeFileLogHandler` because the configuration is needed.
+}
+
+static void mdFileLogHandlerRecordHandle(const struct MdLogRecord* pRecord)
+{
+	MD_ASSERT(s_pFileLogData != MD_NULL);
+	MD_ASSERT(pRecord->level < MD_LOG_LEVEL_NONE);
+
+	mdMutexLock(&s_pFileLogData->mutex);
+
+	mdUNIXTime now = mdGetUNIXTimestamp();
+	if (now != s_pFileLogData->cachedTime)
+	{
+		mdGetTimeString(s_pFileLogData->timeString, MD_FILE_LOG_TIME_STRING_SIZE, mdGetTimeFromUNIXTimestamp(now));
+		s_pFileLogData->cachedTime = now;
+	}
+
+	char line[MD_FILE_LOG_MAX_LINE_LENGTH];
+	mdFormatString(line,
+				   sizeof(line),
+				   "%s [%8s] [%7s] %s:%u - %s\n",
+				   s_pFileLogData->timeString,
+				   mdLogGetCategoryName(pRecord->category),
+				   s_levelNames[pRecord->level],
+				   pRecord->file,
+				   pRecord->line,
+				   pRecord->message);
+
+	if (s_pFileLogData->pendingBytes == 0)
+	{
+		s_pFileLogData->oldestPending = now;
+	}
+
+	appendLine(line, mdGetStringLength(line));
+
+	const struct MdFileLogHandlerConfig* pConfig = &s_pFileLogData->config;
+
+	if (pRecord->level >= pConfig->flushLevel ||
+		(pConfig->flushIntervalSeconds > 0 &&
+		 now - s_pFileLogData->oldestPending >= (mdUNIXTime)pConfig->flushIntervalSeconds))
+	{
+		flushBuffer();
+	}
+
+	mdMutexUnlock(&s_pFileLogData->mutex);
+}
+
+static void mdFileLogHandlerShutdown()
+{
+	MD_ASSERT(s_pFileLogData != MD_NULL);
+
+	mdMutexLock(&s_pFileLogData->mutex);
+	flushBuffer();
+	mdMutexUnlock(&s_pFileLogData->mutex);
+}
+
+static void mdFileLogHandlerFlushExpired()
+{
+	MD_ASSERT(s_pFileLogData != MD_NULL);
+
+	mdMutexLock(&s_pFileLogData->mutex);
+
+	// The same time threshold as the one checked by the records, for a logger which stopped receiving them.
+	u32 flushIntervalSeconds = s_pFileLogData->config.flushIntervalSeconds;
+	if (flushIntervalSeconds > 0 && s_pFileLogData->pendingBytes > 0 &&
+		mdGetUNIXTimestamp() - s_pFileLogData->oldestPending >= (mdUNIXTime)flushIntervalSeconds)
+	{
+		flushBuffer();
+	}
+
+	mdMutexUnlock(&s_pFileLogData->mutex);
+}
+
+void mdInitializeFileLogHandler(enum MdLogLevel level, const struct MdFileLogHandlerConfig* pConfig)
+{
+	MD_ASSERT(MD_LOG_FILE_HANDLER == MD_NULL);
+	MD_ASSERT(s_pFileLogData == MD_NULL);
+	MD_ASSERT(pConfig != MD_NULL);
+	MD_ASSERT(pConfig->filePath != MD_NULL);
+	MD_ASSERT_MSG(mdGetStringLength(pConfig->filePath) + 16 < MD_FILE_LOG_MAX_PATH_LENGTH,
+				  "Log file path \"%s\" is too long.",
+				  pConfig->filePath);
+
+	s_pFileLogData = MD_MALLOC(struct FileLogData);
+	mdMemorySet(s_pFileLogData, 0, sizeof(struct FileLogData));
+
+	s_pFileLogData->config = *pConfig;
+	mdFormatString(s_pFileLogData->filePath, MD_FILE_LOG_MAX_PATH_LENGTH, "%s", pConfig->filePath);
+	s_pFileLogData->config.filePath = s_pFileLogData->filePath;
+	s_pFileLogData->cachedTime		= -1;
+
+	s_pFileLogData->segmentsCount = pConfig->bufferSize / MD_FILE_LOG_SEGMENT_SIZE;
+	if (s_pFileLogData->segmentsCount == 0)
+	{
+		s_pFileLogData->segmentsCount = 1;
+	}
+
+	s_pFileLogData->pBuffer		  = MD_MALLOC_ARRAY(u8, s_pFileLogData->segmentsCount * MD_FILE_LOG_SEGMENT_SIZE);
+	s_pFileLogData->pSegmentSizes = MD_MALLOC_ARRAY(u32, s_pFileLogData->segmentsCount);
+	mdMemorySet(s_pFileLogData->pSegmentSizes, 0, sizeof(u32) * s_pFileLogData->segmentsCount);
+	s_pFileLogData->pWriteBuffers = MD_MALLOC_ARRAY(struct MdFileBuffer, s_pFileLogData->segmentsCount);
+
+	mdMutexInitialize(&s_pFileLogData->mutex);
+
+	if (mdFileExists(s_pFileLogData->filePath))
+	{
+		rotateFiles();
+	}
+	openActiveFile();
+
+	MD_LOG_FILE_HANDLER				  = MD_MALLOC(struct MdLogHandler);
+	MD_LOG_FILE_HANDLER->init		  = mdFileLogHandlerInit;
+	MD_LOG_FILE_HANDLER->recordHandle = mdFileLogHandlerRecordHandle;
+	MD_LOG_FILE_HANDLER->shutdown	  = mdFileLogHandlerShutdown;
+	MD_LOG_FILE_HANDLER->flush		  = mdFileLogHandlerFlushExpired;
+	MD_LOG_FILE_HANDLER->level		  = level;
+}
+
+void mdFileLogHandlerFlush()
+{
+	MD_ASSERT(s_pFileLogData != MD_NULL);
+
+	mdMutexLock(&s_pFileLogData->mutex);
+	flushBuffer();
+	mdMutexUnlock(&s_pFileLogData->mutex);
+}
+
+void mdShutdownFileLogHandler()
+{
+	MD_ASSERT(MD_LOG_FILE_HANDLER != MD_NULL);
+	MD_ASSERT(s_pFileLogData != MD_NULL);
+
+	mdMutexLock(&s_pFileLogData->mutex);
+	flushBuffer();
+	closeActiveFile();
+	mdMutexUnlock(&s_pFileLogData->mutex);
+	mdMutexDestroy(&s_pFileLogData->mutex);
+
+	MD_FREE_ARRAY(s_pFileLogData->pWriteBuffers, struct MdFileBuffer, s_pFileLogData->segmentsCount);
+	MD_FREE_ARRAY(s_pFileLogData->pSegmentSizes, u32, s_pFileLogData->segmentsCount);
+	MD_FREE_ARRAY(s_pFileLogData->pBuffer, u8, s_pFileLogData->segmentsCount * MD_FILE_LOG_SEGMENT_SIZE);
+	MD_FREE(s_pFileLogData, struct FileLogData);
+	s_pFileLogData = MD_NULL;
+
+	MD_FREE(MD_LOG_FILE_HANDLER, struct MdLogHandler);
+	MD_LOG_FILE_HANDLER = MD_NULL;
+}
+
+static void appendLine(const char* line, u32 length)
+{
+	MD_ASSERT(length <= MD_FILE_LOG_SEGMENT_SIZE);
+
+	u32 segment = s_pFileLogData->currentSegment;
+
+	if (s_pFileLogData->pSegmentSizes[segment] + length > MD_FILE_LOG_SEGMENT_SIZE)
+	{
+		segment++;
+		if (segment == s_pFileLogData->segmentsCount)
+		{
+			// Size threshold, every segment is used.
+			flushBuffer();
+			segment = 0;
+		}
+		s_pFileLogData->currentSegment = segment;
+	}
+
+	u8* pDest = s_pFileLogData->pBuffer + (mdSize)segment * MD_FILE_LOG_SEGMENT_SIZE;
+	mdMemoryCopy(pDest + s_pFileLogData->pSegmentSizes[segment], line, length);
+	s_pFileLogData->pSegmentSizes[segment] += length;
+	s_pFileLogData->pendingBytes += length;
+}
+
+static void flushBuffer()
+{
+	if (s_pFileLogData->pendingBytes == 0)
+	{
+		return;
+	}
+
+	struct MdFileBuffer* buffers	  = s_pFileLogData->pWriteBuffers;
+	u32					 buffersCount = 0u;
+
+	for (u32 segment = 0u; segment <= s_pFileLogData->currentSegment; ++segment)
+	{
+		if (s_pFileLogData->pSegmentSizes[segment] == 0)
+		{
+			continue;
+		}
+
+		buffers[buffersCount].pData = s_pFileLogData->pBuffer + (mdSize)segment * MD_FILE_LOG_SEGMENT_SIZE;
+		buffers[buffersCount].size	= s_pFileLogData->pSegmentSizes[segment];
+		buffersCount++;
+
+		s_pFileLogData->pSegmentSizes[segment] = 0;
+	}
+
+	mdFileWriteVector(s_pFileLogData->pFile, buffers, buffersCount);
+
+	s_pFileLogData->fileSize += s_pFileLogData->pendingBytes;
+	s_pFileLogData->pendingBytes   = 0;
+	s_pFileLogData->currentSegment = 0;
+
+	const struct MdFileLogHandlerConfig* pConfig = &s_pFileLogData->config;
+
+	if (pConfig->syncPolicy == MD_FILE_LOG_SYNC_POLICY_ON_FLUSH)
+	{
+		mdFileSync(s_pFileLogData->pFile);
+	}
+
+	b8 sizeExceeded = pConfig->maxFileSize > 0 && s_pFileLogData->fileSize >= pConfig->maxFileSize;
+	b8 timeExceeded = pConfig->rotationIntervalSeconds > 0 &&
+					  mdGetUNIXTimestamp() - s_pFileLogData->fileOpenTime >=
+						  (mdUNIXTime)pConfig->rotationIntervalSeconds;
+
+	if (sizeExceeded || timeExceeded)
+	{
+		closeActiveFile();
+		rotateFiles();
+		openActiveFile();
+	}
+}
+
+static void openActiveFile()
+{
+	MD_ASSERT(s_pFileLogData->pFile == MD_NULL);
+
+	s_pFileLogData->pFile = mdFileOpen(s_pFileLogData->filePath, MD_FILE_MODE_WRITE);
+	MD_ASSERT_MSG(mdFileIsOpen(s_pFileLogData->pFile), "Failed to open log file \"%s\".", s_pFileLogData->filePath);
+
+	s_pFileLogData->fileSize	 = 0;
+	s_pFileLogData->fileOpenTime = mdGetUNIXTimestamp();
+}
+
+static void closeActiveFile()
+{
+	MD_ASSERT(s_pFileLogData->pFile != MD_NULL);
+
+	if (s_pFileLogData->config.syncPolicy != MD_FILE_LOG_SYNC_POLICY_NONE)
+	{
+		mdFileSync(s_pFileLogData->pFile);
+	}
+
+	mdFileClose(s_pFileLogData->pFile);
+	s_pFileLogData->pFile = MD_NULL;
+}
+
+static void rotateFiles()
+{
+	const char* filePath		 = s_pFileLogData->filePath;
+	u32			maxRetainedFiles = s_pFileLogData->config.maxRetainedFiles;
+
+	if (maxRetainedFiles == 0)
+	{
+		mdFileRemove(filePath);
+		return;
+	}
+
+	char sourcePath[MD_FILE_LOG_MAX_PATH_LENGTH];
+	char targetPath[MD_FILE_LOG_MAX_PATH_LENGTH];
+
+	// The oldest file falls out of the retained window, the others are shifted by one.
+	mdFormatString(targetPath, sizeof(targetPath), "%s.%u", filePath, maxRetainedFiles);
+	mdFileRemove(targetPath);
+
+	for (u32 index = maxRetainedFiles - 1; index > 0; --index)
+	{
+		mdFormatString(sourcePath, sizeof(sourcePath), "%s.%u", filePath, index);
+		mdFormatString(targetPath, sizeof(targetPath), "%s.%u", filePath, index + 1);
+
+		if (mdFileExists(sourcePath))
+		{
+			mdFileRename(sourcePath, targetPath);
+		}
+	}
+
+	mdFormatString(targetPath, sizeof(targetPath), "%s.1", filePath);
+	mdFileRename(filePath, targetPath);
+}
@@ -2,6 +2,8 @@
 #include "MEEDEngine/core/log/handler.h"
 #include "MEEDEngine/core/log/log.h"
 #include "MEEDEngine/platforms/platforms.h"
+#include "MEEDEngine/platforms/thread.h"
+#include "MEEDEngine/platforms/time.h"
 #include <stdarg.h>
 
 /**
@@ -10,10 +12,21 @@
 struct MdLogData
 {
 	struct MdLinkedList* pHandlers; ///< The linked list of log handlers.
-	enum MdLogLevel		 level;		///< The current log level threshold.
+	enum MdLogLevel		 level;		///< The default threshold of every category.
 };
 
-static struct MdLogData* s_pLogData = MD_NULL; ///< The global log data instance.
+static struct MdLogData*	 s_pLogData			   = MD_NULL; ///< The global log data instance.
+static struct MdLogCallSite* s_pThrottledCallSites = MD_NULL; ///< The registry of the throttled call sites.
+
+i32 g_mdLogCategoryLevels[MD_LOG_CATEGORY_COUNT];
+
+static const char* s_categoryNames[] = {
+	[MD_LOG_CATEGORY_ENGINE]   = "ENGINE",
+	[MD_LOG_CATEGORY_CORE]	   = "CORE",
+	[MD_LOG_CATEGORY_PLATFORM] = "PLATFORM",
+	[MD_LOG_CATEGORY_RENDER]   = "RENDER",
+	[MD_LOG_CATEGORY_APP]	   = "APP",
+};
 
 void mdLogInitialize(enum MdLogLevel level)
 {
@@ -21,8 +34,10 @@ void mdLogInitialize(enum MdLogLevel level)
 	s_pLogData = MD_MALLOC(struct MdLogData);
 	mdMemorySet(s_pLogData, 0, sizeof(struct MdLogData));
 
-	s_pLogData->pHandlers = MD_MALLOC(struct MdLinkedList);
+	s_pLogData->pHandlers = mdLinkedListCreate(MD_NULL);
 	s_pLogData->level	  = level;
+
+	mdLogSetAllCategoriesLevel(level);
 }
 
 void mdLogAddHandler(const struct MdLogHandler* pHandler)
@@ -39,28 +54,210 @@ void mdLogAddHandler(const struct MdLogHandler* pHandler)
 	}
 }
 
-void mdLogPrint(enum MdLogLevel level, const char* file, u32 line, const char* format, ...)
+void mdLogSetCategoryLevel(enum MdLogCategory category, enum MdLogLevel level)
+{
+	MD_ASSERT(category < MD_LOG_CATEGORY_COUNT);
+	MD_ASSERT(level <= MD_LOG_LEVEL_NONE);
+
+#if defined(_MSC_VER)
+	*(volatile i32*)&g_mdLogCategoryLevels[category] = (i32)level;
+#else
+	__atomic_store_n(&g_mdLogCategoryLevels[category], (i32)level, __ATOMIC_RELAXED);
+#endif
+}
+
+enum MdLogLevel mdLogGetCategoryLevel(enum MdLogCategory category)
+{
+	MD_ASSERT(category < MD_LOG_CATEGORY_COUNT);
+	return (enum MdLogLevel)_MD_LOG_LOAD_LEVEL(&g_mdLogCategoryLevels[category]);
+}
+
+void mdLogSetAllCategoriesLevel(enum MdLogLevel level)
+{
+	for (u32 category = 0u; category < MD_LOG_CATEGORY_COUNT; ++category)
+	{
+		mdLogSetCategoryLevel((enum MdLogCategory)category, level);
+	}
+}
+
+const char* mdLogGetCategoryName(enum MdLogCategory category)
+{
+	MD_ASSERT(category < MD_LOG_CATEGORY_COUNT);
+	return s_categoryNames[category];
+}
+
+/**
+ * Forwards the record to every handler which accepts its level. The message is only formatted from `pArgs` when
+ * at least one handler accepts the record, `pArgs` can be `MD_NULL` when the message is already filled.
+ */
+static void dispatchRecord(struct MdLogRecord* pRecord, const char* format, va_list* pArgs)
+{
+	b8						 formatted = pArgs == MD_NULL;
+	struct MdLinkedListNode* pCurrent  = s_pLogData->pHandlers->pHead;
+
+	while (pCurrent != MD_NULL)
+	{
+		struct MdLogHandler* pHandler = (struct MdLogHandler*)pCurrent->pData;
+		if (pRecord->level >= pHandler->level)
+		{
+			if (!formatted)
+			{
+				mdFormatStringArgs(pRecord->message, MD_LOG_MESSAGE_MAX_LENGTH, format, *pArgs);
+				formatted = MD_TRUE;
+			}
+
+			pHandler->recordHandle(pRecord);
+		}
+		pCurrent = pCurrent->pNext;
+	}
+}
+
+/**
+ * Adds the call site to the registry the first time it throttles a record, so `mdLogFlush` can report its dropped
+ * records. The description of the statement is written before the push publishes the call site.
+ */
+static void registerCallSite(struct MdLogCallSite* pCallSite, const struct MdLogRecord* pRecord)
+{
+	u32 isRegistered = MD_ATOMIC_LOAD(&pCallSite->isRegistered, MD_MEMORY_ORDER_ACQUIRE);
+	if (isRegistered != 0 || !MD_ATOMIC_COMPARE_EXCHANGE(&pCallSite->isRegistered,
+														 &isRegistered,
+														 1u,
+														 MD_MEMORY_ORDER_ACQ_REL,
+														 MD_MEMORY_ORDER_ACQUIRE))
+	{
+		return;
+	}
+
+	pCallSite->category = pRecord->category;
+	pCallSite->level	= pRecord->level;
+	pCallSite->file		= pRecord->file;
+	pCallSite->line		= pRecord->line;
+
+	struct MdLogCallSite* pHead = MD_ATOMIC_LOAD(&s_pThrottledCallSites, MD_MEMORY_ORDER_RELAXED);
+	do
+	{
+		pCallSite->pNext = pHead;
+	} while (!MD_ATOMIC_COMPARE_EXCHANGE_WEAK(
+		&s_pThrottledCallSites, &pHead, pCallSite, MD_MEMORY_ORDER_RELEASE, MD_MEMORY_ORDER_RELAXED));
+}
+
+/**
+ * Dispatches the "message repeated N times" record of a call site. The window is the time since the start of the
+ * window of the dropped records, at least the 1s of a window.
+ */
+static void dispatchSummary(const struct MdLogCallSite* pCallSite, u32 suppressedCount, mdTicks elapsedTicks)
+{
+	u64 elapsedSeconds = elapsedTicks / MD_TICKS_PER_SECOND;
+	struct MdLogRecord summary;
+	summary.category = pCallSite->category;
+	summary.level	 = pCallSite->level;
+	summary.file	 = pCallSite->file;
+	summary.line	 = pCallSite->line;
+	mdFormatString(summary.message,
+				   MD_LOG_MESSAGE_MAX_LENGTH,
+				   "message repeated %u times in last %llus",
+				   suppressedCount,
+				   (unsigned long long)(elapsedSeconds > 1 ? elapsedSeconds : 1));
+	dispatchRecord(&summary, MD_NULL, MD_NULL);
+}
+
+/**
+ * Applies the limit of the call site. Returns MD_FALSE when the record must be dropped, in which case it is only
+ * counted. The thread which starts a new window dispatches the summary of the records dropped since the last one.
+ * The counters are updated atomically: a record racing with the start of a window may be counted in either one.
+ */
+static b8 throttleCallSite(struct MdLogCallSite* pCallSite, const struct MdLogRecord* pRecord)
+{
+	if (pCallSite->maxPerSecond == 0)
+	{
+		return MD_TRUE;
+	}
+
+	registerCallSite(pCallSite, pRecord);
+
+	mdTicks now			= mdGetTicks();
+	mdTicks windowStart = MD_ATOMIC_LOAD(&pCallSite->windowStart, MD_MEMORY_ORDER_ACQUIRE);
+	if (now - windowStart >= MD_TICKS_PER_SECOND && MD_ATOMIC_COMPARE_EXCHANGE(&pCallSite->windowStart,
+																			   &windowStart,
+																			   now,
+																			   MD_MEMORY_ORDER_ACQ_REL,
+																			   MD_MEMORY_ORDER_ACQUIRE))
+	{
+		MD_ATOMIC_STORE(&pCallSite->emittedCount, 0u, MD_MEMORY_ORDER_RELAXED);
+		u32 suppressedCount = MD_ATOMIC_EXCHANGE(&pCallSite->suppressedCount, 0u, MD_MEMORY_ORDER_ACQ_REL);
+		if (suppressedCount > 0)
+		{
+			dispatchSummary(pCallSite, suppressedCount, now - windowStart);
+		}
+	}
+
+	if (MD_ATOMIC_FETCH_ADD(&pCallSite->emittedCount, 1u, MD_MEMORY_ORDER_RELAXED) >= pCallSite->maxPerSecond)
+	{
+		MD_ATOMIC_FETCH_ADD(&pCallSite->suppressedCount, 1u, MD_MEMORY_ORDER_RELAXED);
+		return MD_FALSE;
+	}
+	return MD_TRUE;
+}
+
+void mdLogPrint(struct MdLogCallSite* pCallSite,
+				enum MdLogCategory	  category,
+				enum MdLogLevel		  level,
+				const char*			  file,
+				u32					  line,
+				const char*			  format,
+				...)
 {
+	if (s_pLogData == MD_NULL || !MD_LOG_IS_ENABLED(category, level))
+	{
+		return;
+	}
+
 	struct MdLogRecord record;
-	mdMemorySet(&record, 0, sizeof(struct MdLogRecord));
+	record.category	  = category;
+	record.level	  = level;
+	record.file		  = file;
+	record.line		  = line;
+	record.message[0] = '\0';
 
-	record.file = file;
-	record.line = line;
+	// The dropped records return before touching the format string.
+	if (pCallSite != MD_NULL && !throttleCallSite(pCallSite, &record))
+	{
+		return;
+	}
 
-	record.level = level;
 	va_list args;
 	va_start(args, format);
-	mdFormatString(record.message, MD_LOG_MESSAGE_MAX_LENGTH, format, args);
+	dispatchRecord(&record, format, &args);
 	va_end(args);
+}
 
-	struct MdLinkedListNode* pCurrent = s_pLogData->pHandlers->pHead;
+void mdLogFlush()
+{
+	if (s_pLogData == MD_NULL)
+	{
+		return;
+	}
 
+	mdTicks				  now		= mdGetTicks();
+	struct MdLogCallSite* pCallSite = MD_ATOMIC_LOAD(&s_pThrottledCallSites, MD_MEMORY_ORDER_ACQUIRE);
+	while (pCallSite != MD_NULL)
+	{
+		u32 suppressedCount = MD_ATOMIC_EXCHANGE(&pCallSite->suppressedCount, 0u, MD_MEMORY_ORDER_ACQ_REL);
+		if (suppressedCount > 0 && MD_LOG_IS_ENABLED(pCallSite->category, pCallSite->level))
+		{
+			mdTicks windowStart = MD_ATOMIC_LOAD(&pCallSite->windowStart, MD_MEMORY_ORDER_ACQUIRE);
+			dispatchSummary(pCallSite, suppressedCount, now - windowStart);
+		}
+		pCallSite = pCallSite->pNext;
+	}
+
+	struct MdLinkedListNode* pCurrent = s_pLogData->pHandlers->pHead;
 	while (pCurrent != MD_NULL)
 	{
 		struct MdLogHandler* pHandler = (struct MdLogHandler*)pCurrent->pData;
-		if (pHandler->level >= s_pLogData->level)
+		if (pHandler->flush)
 		{
-			pHandler->recordHandle(&record);
+			pHandler->flush();
 		}
 		pCurrent = pCurrent->pNext;
 	}
@@ -70,6 +267,19 @@ void mdLogShutdown()
 {
 	MD_ASSERT(s_pLogData != MD_NULL);
 
+	mdLogFlush();
+
+	// The registry is emptied, so a call site only has to outlive the logging system and is registered again by its
+	// next record.
+	struct MdLogCallSite* pCallSite = MD_ATOMIC_EXCHANGE(&s_pThrottledCallSites, MD_NULL, MD_MEMORY_ORDER_ACQ_REL);
+	while (pCallSite != MD_NULL)
+	{
+		struct MdLogCallSite* pNext = pCallSite->pNext;
+		pCallSite->pNext			= MD_NULL;
+		MD_ATOMIC_STORE(&pCallSite->isRegistered, 0u, MD_MEMORY_ORDER_RELEASE);
+		pCallSite = pNext;
+	}
+
 	struct MdLinkedListNode* pCurrent = s_pLogData->pHandlers->pHead;
 
 	while (pCurrent != MD_NULL)
@@ -87,6 +297,8 @@ void mdLogShutdown()
 	mdLinkedListDestroy(s_pLogData->pHandlers);
 	s_pLogData->pHandlers = MD_NULL;
 
+	mdLogSetAllCategoriesLevel(MD_LOG_LEVEL_VERBOSE);
+
 	MD_FREE(s_pLogData, struct MdLogData);
 	s_pLogData = MD_NULL;
-}
\ No newline at end of file
+}
@@ -0,0 +1,227 @@
+#include "MEEDEngine/modules/render/frame_stats.h"
+#include <string.h>
+
+struct FrameStats
+{
+	struct MdFrameTimer* pTimers[MD_FRAME_PHASE_COUNT]; ///< The rolling window of each phase.
+	u32		histograms[MD_FRAME_PHASE_COUNT][MD_FRAME_STATS_HISTOGRAM_BUCKETS]; ///< Follows the windows.
+	mdTicks pendingTicks[MD_FRAME_PHASE_COUNT]; ///< The durations recorded during the current frame.
+	u32		pendingMask;						///< The phases recorded during the current frame.
+	mdTicks lastFrameEndTicks;					///< 0 before the first frame.
+};
+
+static struct FrameStats* s_pFrameStats = MD_NULL;
+
+static u32 getBucket(mdTicks durationTicks)
+{
+	u64 bound  = MD_FRAME_STATS_HISTOGRAM_FIRST_BOUND_MICROSECONDS * (u64)MD_TICKS_PER_MICROSECOND;
+	u32 bucket = 0;
+	while (durationTicks >= bound && bucket < MD_FRAME_STATS_HISTOGRAM_BUCKETS - 1)
+	{
+		bound <<= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+static void addSample(enum MdFramePhase phase, mdTicks durationTicks)
+{
+	struct MdFrameTimer* pTimer = s_pFrameStats->pTimers[phase];
+
+	// The sample about to leave the window also leaves the histogram.
+	if (pTimer->samplesCount == pTimer->windowSize)
+	{
+		s_pFrameStats->histograms[phase][getBucket(pTimer->pSamples[pTimer->nextSample])]--;
+	}
+	s_pFrameStats->histograms[phase][getBucket(durationTicks)]++;
+
+	mdFrameTimerAddSample(pTimer, durationTicks);
+}
+
+void mdFrameStatsInitialize(u32 windowSize)
+{
+	MD_ASSERT(s_pFrameStats == MD_NULL);
+
+	s_pFrameStats = MD_MALLOC(struct FrameStats);
+	MD_ASSERT(s_pFrameStats != MD_NULL);
+	mdMemorySet(s_pFrameStats, 0, sizeof(struct FrameStats));
+
+	for (u32 i = 0; i < MD_FRAME_PHASE_COUNT; ++i)
+	{
+		s_pFrameStats->pTimers[i] = mdFrameTimerCreate(windowSize != 0 ? windowSize : MD_FRAME_STATS_DEFAULT_WINDOW);
+	}
+}
+
+void mdFrameStatsRecordPhase(enum MdFramePhase phase, mdTicks durationTicks)
+{
+	MD_ASSERT(phase < MD_FRAME_PHASE_FRAME);
+	if (s_pFrameStats == MD_NULL)
+	{
+		return;
+	}
+
+	s_pFrameStats->pendingTicks[phase] += durationTicks;
+	s_pFrameStats->pendingMask |= 1u << phase;
+}
+
+void mdFrameStatsEndFrame()
+{
+	if (s_pFrameStats == MD_NULL)
+	{
+		return;
+	}
+
+	for (u32 i = 0; i < MD_FRAME_PHASE_FRAME; ++i)
+	{
+		if ((s_pFrameStats->pendingMask & (1u << i)) != 0)
+		{
+			addSample((enum MdFramePhase)i, s_pFrameStats->pendingTicks[i]);
+		}
+	}
+	mdMemorySet(s_pFrameStats->pendingTicks, 0, sizeof(s_pFrameStats->pendingTicks));
+	s_pFrameStats->pendingMask = 0;
+
+	// The first frame has no start, only the phases it recorded are kept.
+	mdTicks now = mdGetTicks();
+	if (s_pFrameStats->lastFrameEndTicks != 0)
+	{
+		addSample(MD_FRAME_PHASE_FRAME, now - s_pFrameStats->lastFrameEndTicks);
+	}
+	s_pFrameStats->lastFrameEndTicks = now;
+}
+
+void mdFrameStatsGetPhase(enum MdFramePhase phase, struct MdFramePhaseStats* pStats)
+{
+	MD_ASSERT(s_pFrameStats != MD_NULL);
+	MD_ASSERT(phase < MD_FRAME_PHASE_COUNT);
+	MD_ASSERT(pStats != MD_NULL);
+
+	mdFrameTimerGetStats(s_pFrameStats->pTimers[phase], &pStats->timing);
+	mdMemoryCopy(pStats->histogram, s_pFrameStats->histograms[phase], sizeof(pStats->histogram));
+}
+
+static f64 getAverageMilliseconds(enum MdFramePhase phase)
+{
+	const struct MdFrameTimer* pTimer = s_pFrameStats->pTimers[phase];
+	return pTimer->samplesCount != 0 ? mdTicksToMilliseconds(pTimer->windowTicks) / (f64)pTimer->samplesCount : 0.0;
+}
+
+enum MdFrameBound mdFrameStatsGetBound()
+{
+	MD_ASSERT(s_pFrameStats != MD_NULL);
+
+	f64 frame = getAverageMilliseconds(MD_FRAME_PHASE_FRAME);
+	if (frame <= 0.0)
+	{
+		return MD_FRAME_BOUND_UNKNOWN;
+	}
+
+	f64 gpuWait	  = getAverageMilliseconds(MD_FRAME_PHASE_WAIT_FENCE);
+	f64 vsyncWait = getAverageMilliseconds(MD_FRAME_PHASE_ACQUIRE) + getAverageMilliseconds(MD_FRAME_PHASE_PRESENT);
+	if (gpuWait + vsyncWait < frame * 0.25)
+	{
+		return MD_FRAME_BOUND_CPU;
+	}
+	return gpuWait > vsyncWait ? MD_FRAME_BOUND_GPU : MD_FRAME_BOUND_VSYNC;
+}
+
+f64 mdFrameStatsGetBucketLowerBound(u32 bucket)
+{
+	MD_ASSERT(bucket < MD_FRAME_STATS_HISTOGRAM_BUCKETS);
+	if (bucket == 0)
+	{
+		return 0.0;
+	}
+	return (f64)(MD_FRAME_STATS_HISTOGRAM_FIRST_BOUND_MICROSECONDS << (bucket - 1)) * 1e-3;
+}
+
+const char* mdFrameStatsGetPhaseName(enum MdFramePhase phase)
+{
+	switch (phase)
+	{
+	case MD_FRAME_PHASE_WAIT_FENCE:
+		return "wait_fence";
+	case MD_FRAME_PHASE_ACQUIRE:
+		return "acquire";
+	case MD_FRAME_PHASE_RECORD:
+		return "record";
+	case MD_FRAME_PHASE_SUBMIT:
+		return "submit";
+	case MD_FRAME_PHASE_PRESENT:
+		return "present";
+	case MD_FRAME_PHASE_GPU:
+		return "gpu";
+	case MD_FRAME_PHASE_FRAME:
+		return "frame";
+	default:
+		MD_UNTOUCHABLE();
+		return "invalid";
+	}
+}
+
+b8 mdFrameStatsExportCSV(const char* filePath)
+{
+	MD_ASSERT(s_pFrameStats != MD_NULL);
+	MD_ASSERT(filePath != MD_NULL);
+
+	struct MdFileData* pFile = mdFileOpen(filePath, MD_FILE_MODE_WRITE_ATOMIC);
+	if (!mdFileIsOpen(pFile))
+	{
+		mdFileClose(pFile);
+		return MD_FALSE;
+	}
+
+	struct MdFileBufferedWriter* pWriter = mdFileBufferedWriterCreate(pFile, 0);
+	char						 line[128];
+
+	// The histogram columns are named after the lower bound of their bucket in milliseconds.
+	const char header[] = "phase,samples,last_ms,average_ms,min_ms,max_ms,p95_ms,p99_ms";
+	mdFileBufferedWriterWrite(pWriter, header, sizeof(header) - 1);
+	for (u32 i = 0; i < MD_FRAME_STATS_HISTOGRAM_BUCKETS; ++i)
+	{
+		mdFormatString(line, sizeof(line), ",ge_%.3f_ms", mdFrameStatsGetBucketLowerBound(i));
+		mdFileBufferedWriterWrite(pWriter, line, strlen(line));
+	}
+	mdFileBufferedWriterWrite(pWriter, "\n", 1);
+
+	for (u32 phase = 0; phase < MD_FRAME_PHASE_COUNT; ++phase)
+	{
+		struct MdFramePhaseStats stats;
+		mdFrameStatsGetPhase((enum MdFramePhase)phase, &stats);
+
+		mdFormatString(line,
+					   sizeof(line),
+					   "%s,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f",
+					   mdFrameStatsGetPhaseName((enum MdFramePhase)phase),
+					   stats.timing.samplesCount,
+					   stats.timing.deltaMilliseconds,
+					   stats.timing.averageMilliseconds,
+					   stats.timing.minMilliseconds,
+					   stats.timing.maxMilliseconds,
+					   stats.timing.p95Milliseconds,
+					   stats.timing.p99Milliseconds);
+		mdFileBufferedWriterWrite(pWriter, line, strlen(line));
+		for (u32 i = 0; i < MD_FRAME_STATS_HISTOGRAM_BUCKETS; ++i)
+		{
+			mdFormatString(line, sizeof(line), ",%u", stats.histogram[i]);
+			mdFileBufferedWriterWrite(pWriter, line, strlen(line));
+		}
+		mdFileBufferedWriterWrite(pWriter, "\n", 1);
+	}
+
+	mdFileBufferedWriterDestroy(pWriter);
+	mdFileClose(pFile);
+	return MD_TRUE;
+}
+
+void mdFrameStatsShutdown()
+{
+	MD_ASSERT(s_pFrameStats != MD_NULL);
+
+	for (u32 i = 0; i < MD_FRAME_PHASE_COUNT; ++i)
+	{
+		mdFrameTimerDestroy(s_pFrameStats->pTimers[i]);
+	}
+	MD_FREE(s_pFrameStats, struct FrameStats);
+	s_pFrameStats = MD_NULL;
+}
@@ -10,6 +10,9 @@
 #include <GLFW/glfw3.h>
 // clang-format on
 
+#include "MEEDEngine/modules/render/shader.h"
+#include "MEEDEngine/platforms/profile.h"
+
 struct OpenGLPipeline
 {
 	u32 shaderProgram; ///< OpenGL shader program ID.
@@ -18,6 +21,7 @@ struct OpenGLPipeline
 struct OpenGLRenderData
 {
 	struct MdWindowData* pWindowData;
+	mdTicks				 recordStartTicks; ///< When the recording of the current frame started.
 };
 
 struct OpenGLShader
@@ -42,4 +46,13 @@ extern struct OpenGLRenderData* s_pRenderData;
 		MD_ASSERT_MSG(err == GL_NO_ERROR, "OpenGL error occurred with code %u", err);                                  \
 	} while (MD_FALSE)
 
+/**
+ * @brief Compiles a shader from its file, logging the errors instead of asserting so a hot reload can fail safely.
+ * @param type The type of the shader.
+ * @param shaderSource The file path to the shader source code.
+ * @param pShaderID Receives the OpenGL shader ID on success.
+ * @return MD_TRUE if the shader was compiled, MD_FALSE otherwise.
+ */
+b8 mdOpenGLCompileShader(enum MdShaderType type, const char* shaderSource, u32* pShaderID);
+
 #endif // MD_USE_OPENGL
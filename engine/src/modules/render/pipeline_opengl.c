@@ -22,9 +22,50 @@ static void deleteProgram(void* pData)
 	GL_ASSERT(glDeleteProgram(pOpenGLPipeline->shaderProgram));
 }
 
+static b8 linkProgram(const char* vertexShaderPath, const char* fragmentShaderPath, u32* pShaderProgram)
+{
+	u32 vertexShaderID;
+	if (!mdOpenGLCompileShader(MD_SHADER_TYPE_VERTEX, vertexShaderPath, &vertexShaderID))
+	{
+		return MD_FALSE;
+	}
+	u32 fragmentShaderID;
+	if (!mdOpenGLCompileShader(MD_SHADER_TYPE_FRAGMENT, fragmentShaderPath, &fragmentShaderID))
+	{
+		GL_ASSERT(glDeleteShader(vertexShaderID));
+		return MD_FALSE;
+	}
+
+	u32 shaderProgram;
+	GL_ASSERT(shaderProgram = glCreateProgram());
+	GL_ASSERT(glAttachShader(shaderProgram, vertexShaderID));
+	GL_ASSERT(glAttachShader(shaderProgram, fragmentShaderID));
+	GL_ASSERT(glLinkProgram(shaderProgram));
+
+	// The program keeps the compiled code, the shaders are not needed anymore
+	GL_ASSERT(glDeleteShader(fragmentShaderID));
+	GL_ASSERT(glDeleteShader(vertexShaderID));
+
+	GLint linkStatus;
+	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &linkStatus);
+	if (linkStatus != GL_TRUE)
+	{
+		char infoLog[512];
+		glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
+		MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Shader program linking failed: %s", infoLog);
+		GL_ASSERT(glDeleteProgram(shaderProgram));
+		return MD_FALSE;
+	}
+
+	*pShaderProgram = shaderProgram;
+	return MD_TRUE;
+}
+
 struct MdPipeline*
 mdPipelineCreate(const char* vertexShaderPath, const char* fragmentShaderPath, struct MdVertexBuffer* pDesc)
 {
+	MD_PROFILE_SCOPE("mdPipelineCreate");
+
 	struct MdPipeline* pPipeline = MD_MALLOC(struct MdPipeline);
 	MD_ASSERT(pPipeline != MD_NULL);
 	mdMemorySet(pPipeline, 0, sizeof(struct MdPipeline));
@@ -40,29 +81,9 @@ mdPipelineCreate(const char* vertexShaderPath, const char* fragmentShaderPath, s
 
 	struct OpenGLPipeline* pOpenGLPipeline = (struct OpenGLPipeline*)pPipeline->pInternal;
 
-	GL_ASSERT(pOpenGLPipeline->shaderProgram = glCreateProgram());
-
-	struct MdShader* pVertexShader	 = mdShaderCreate(MD_SHADER_TYPE_VERTEX, vertexShaderPath);
-	struct MdShader* pFragmentShader = mdShaderCreate(MD_SHADER_TYPE_FRAGMENT, fragmentShaderPath);
-
-	struct OpenGLShader* pOpenGLVertexShader   = (struct OpenGLShader*)pVertexShader->pInternal;
-	struct OpenGLShader* pOpenGLFragmentShader = (struct OpenGLShader*)pFragmentShader->pInternal;
-
-	GL_ASSERT(glAttachShader(pOpenGLPipeline->shaderProgram, pOpenGLVertexShader->shaderID));
-	GL_ASSERT(glAttachShader(pOpenGLPipeline->shaderProgram, pOpenGLFragmentShader->shaderID));
-	GL_ASSERT(glLinkProgram(pOpenGLPipeline->shaderProgram));
-
-	u32 linkStatus;
-	glGetProgramiv(pOpenGLPipeline->shaderProgram, GL_LINK_STATUS, (GLint*)&linkStatus);
-	if (linkStatus != GL_TRUE)
-	{
-		char infoLog[512];
-		glGetProgramInfoLog(pOpenGLPipeline->shaderProgram, 512, NULL, infoLog);
-		MD_ASSERT_MSG(MD_FALSE, "Shader program linking failed: %s", infoLog);
-	}
-
-	mdShaderDestroy(pFragmentShader);
-	mdShaderDestroy(pVertexShader);
+	b8 isLinked = linkProgram(vertexShaderPath, fragmentShaderPath, &pOpenGLPipeline->shaderProgram);
+	MD_ASSERT_MSG(isLinked, "Failed to create shader program.");
+	MD_UNUSED(isLinked);
 
 	mdReleaseStackPush(pPipeline->pReleaseStack, pPipeline, deleteProgram);
 
@@ -76,6 +97,25 @@ void mdPipelineUse(struct MdPipeline* pPipeline)
 	GL_ASSERT(glUseProgram(pOpenGLPipeline->shaderProgram));
 }
 
+b8 mdPipelineReload(struct MdPipeline* pPipeline)
+{
+	MD_ASSERT(pPipeline != MD_NULL);
+
+	u32 shaderProgram;
+	if (!linkProgram(pPipeline->vertexShaderPath, pPipeline->fragmentShaderPath, &shaderProgram))
+	{
+		MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Pipeline not reloaded, keeping the previous one.");
+		return MD_FALSE;
+	}
+
+	// The driver defers the deletion of the previous program until the draws in flight are done
+	struct OpenGLPipeline* pOpenGLPipeline = (struct OpenGLPipeline*)pPipeline->pInternal;
+	GL_ASSERT(glDeleteProgram(pOpenGLPipeline->shaderProgram));
+	pOpenGLPipeline->shaderProgram = shaderProgram;
+
+	return MD_TRUE;
+}
+
 void mdPipelineDestroy(struct MdPipeline* pPipeline)
 {
 	MD_ASSERT(pPipeline != MD_NULL);
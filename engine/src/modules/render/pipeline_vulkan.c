@@ -4,8 +4,9 @@
 #include "MEEDEngine/modules/render/shader.h"
 #include "vulkan_common.h"
 
-static void createLayout(struct MdPipeline* pPipeline);
-static void createPipeline(struct MdPipeline* pPipeline);
+static void	   createLayout(struct MdPipeline* pPipeline);
+static void	   createPipeline(struct MdPipeline* pPipeline);
+static VkResult buildPipeline(struct MdPipeline* pPipeline, VkPipeline* pPipelineHandle);
 
 static void freeInternalPipeline(void*);
 static void deleteShaderResources(void*);
@@ -13,6 +14,8 @@ static void deleteShaderResources(void*);
 struct MdPipeline*
 mdPipelineCreate(const char* vertexShaderPath, const char* fragmentShaderPath, struct MdVertexBuffer* pBuffer)
 {
+	MD_PROFILE_SCOPE("mdPipelineCreate");
+
 	// Implementation of pipeline creation using Vulkan
 	struct MdPipeline* pPipeline = MD_MALLOC(struct MdPipeline);
 	MD_ASSERT(pPipeline != MD_NULL);
@@ -95,6 +98,17 @@ static void destroyPipeline(void* pData);
 static void createPipeline(struct MdPipeline* pPipeline)
 {
 	MD_ASSERT(pPipeline != MD_NULL);
+
+	struct VulkanPipeline* pVulkanPipeline = (struct VulkanPipeline*)pPipeline->pInternal;
+	VK_ASSERT(buildPipeline(pPipeline, &pVulkanPipeline->pipeline));
+
+	mdReleaseStackPush(pPipeline->pReleaseStack, pPipeline, destroyPipeline);
+}
+
+static VkResult buildPipeline(struct MdPipeline* pPipeline, VkPipeline* pPipelineHandle)
+{
+	MD_ASSERT(pPipeline != MD_NULL);
+	MD_ASSERT(pPipelineHandle != MD_NULL);
 	MD_ASSERT(g_vulkan != MD_NULL);
 	MD_ASSERT(g_vulkan->device != MD_NULL);
 	// MD_ASSERT(g_vulkan->renderPass != MD_NULL);
@@ -252,10 +266,8 @@ static void createPipeline(struct MdPipeline* pPipeline)
 #endif
 	pipelineCreateInfo.subpass = 0;
 
-	VK_ASSERT(vkCreateGraphicsPipelines(
-		g_vulkan->device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, MD_NULL, &pVulkanPipeline->pipeline));
-
-	mdReleaseStackPush(pPipeline->pReleaseStack, pPipeline, destroyPipeline);
+	return vkCreateGraphicsPipelines(
+		g_vulkan->device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, MD_NULL, pPipelineHandle);
 }
 
 static void destroyPipeline(void* pData)
@@ -282,6 +294,34 @@ void mdPipelineUse(struct MdPipeline* pPipeline)
 					  pVulkanPipeline->pipeline);
 }
 
+b8 mdPipelineReload(struct MdPipeline* pPipeline)
+{
+	MD_ASSERT(pPipeline != MD_NULL);
+
+	struct VulkanPipeline* pVulkanPipeline = (struct VulkanPipeline*)pPipeline->pInternal;
+	if (!mdShaderReload(pVulkanPipeline->pVertexShader, pPipeline->vertexShaderPath) ||
+		!mdShaderReload(pVulkanPipeline->pFragmentShader, pPipeline->fragmentShaderPath))
+	{
+		MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Pipeline not reloaded, keeping the previous one.");
+		return MD_FALSE;
+	}
+
+	VkPipeline pipeline;
+	VkResult   result = buildPipeline(pPipeline, &pipeline);
+	if (result != VK_SUCCESS)
+	{
+		MD_LOG_WARNING_CAT(
+			MD_LOG_CATEGORY_RENDER, "Failed to rebuild pipeline (%d), keeping the previous one.", result);
+		return MD_FALSE;
+	}
+
+	// The command buffers in flight may still reference the previous pipeline
+	mdVulkanRetirePipeline(pVulkanPipeline->pipeline);
+	pVulkanPipeline->pipeline = pipeline;
+
+	return MD_TRUE;
+}
+
 void mdPipelineDestroy(struct MdPipeline* pPipeline)
 {
 	MD_ASSERT(pPipeline != MD_NULL);
@@ -15,6 +15,9 @@ void mdRenderInitialize(struct MdWindowData* pWindowData)
 	s_pRenderData			   = MD_MALLOC(struct OpenGLRenderData);
 	s_pRenderData->pWindowData = pWindowData;
 
+	// OpenGL exposes no fence nor acquisition, the driver waits inside `glfwSwapBuffers` which is the present phase.
+	mdFrameStatsInitialize(0);
+
 	// clang-format off
 	float vertices[] = {
 		// positions        // colors
@@ -46,13 +49,21 @@ void mdRenderClearScreen(struct MdColor color)
 
 void mdRenderStartFrame()
 {
+	MD_PROFILE_SCOPE("mdRenderStartFrame");
+
 	MD_ASSERT(s_pRenderData != MD_NULL);
 
+	s_pRenderData->recordStartTicks = mdGetTicks();
 	GL_ASSERT(glBindVertexArray(vao));
 }
 
 void mdRenderEndFrame()
 {
+	MD_PROFILE_SCOPE("mdRenderEndFrame");
+
+	MD_ASSERT(s_pRenderData != MD_NULL);
+
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_RECORD, mdGetTicks() - s_pRenderData->recordStartTicks);
 }
 
 void mdRenderDraw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance)
@@ -65,12 +76,33 @@ void mdRenderDraw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 first
 	GL_ASSERT(glDrawArrays(GL_TRIANGLES, firstVertex, vertexCount));
 }
 
+// WebGL 2 and OpenGL ES 3 have no timestamp queries, the GPU zones are accepted and not measured.
+void mdRenderBeginGpuZone(const char* name)
+{
+	MD_ASSERT(name != MD_NULL);
+}
+
+void mdRenderEndGpuZone()
+{
+}
+
+u32 mdRenderGetGpuZones(struct MdGpuZoneTiming* pZones, u32 maxZones)
+{
+	MD_ASSERT(pZones != MD_NULL || maxZones == 0);
+	return 0;
+}
+
 void mdRenderPresent()
 {
+	MD_PROFILE_SCOPE("mdRenderPresent");
+
 	MD_ASSERT(s_pRenderData != MD_NULL);
 	MD_ASSERT(s_pWindow != MD_NULL);
 
+	mdTicks presentTicks = mdGetTicks();
 	GL_ASSERT(glfwSwapBuffers(s_pWindow));
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_PRESENT, mdGetTicks() - presentTicks);
+	mdFrameStatsEndFrame();
 }
 
 void mdRenderWaitIdle()
@@ -81,6 +113,7 @@ void mdRenderShutdown()
 {
 	MD_ASSERT(s_pRenderData != MD_NULL);
 
+	mdFrameStatsShutdown();
 	MD_FREE(s_pRenderData, struct OpenGLRenderData);
 	s_pRenderData = MD_NULL;
 	s_pRenderData = MD_NULL;
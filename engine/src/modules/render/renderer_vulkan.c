@@ -47,8 +47,13 @@ static void createRenderPass();
 static void createCommandPools();
 static void allocateCommandBuffers();
 static void createSyncObjects();
+static void createTimestampQueries();
+static void readTimestamps(u32 frameIndex);
 
 static void deleteGlobalVulkanInstance(void*);
+static void destroyRetiredPipelines(void*);
+static void shutdownFrameStats(void*);
+static void releaseRetiredPipelines(b8 force);
 
 void mdRenderInitialize(struct MdWindowData* pWindowData)
 {
@@ -88,6 +93,10 @@ void mdRenderInitialize(struct MdWindowData* pWindowData)
 	createCommandPools();
 	allocateCommandBuffers();
 	createSyncObjects();
+	createTimestampQueries();
+	mdReleaseStackPush(s_releaseStack, MD_NULL, destroyRetiredPipelines);
+	mdFrameStatsInitialize(0);
+	mdReleaseStackPush(s_releaseStack, MD_NULL, shutdownFrameStats);
 
 	s_isInitialized = MD_TRUE;
 }
@@ -1031,6 +1040,97 @@ static void deleteSyncObjects(void* pData)
 	}
 }
 
+static void deleteTimestampQueries(void*);
+
+static void createTimestampQueries()
+{
+	MD_ASSERT(g_vulkan != MD_NULL);
+	MD_ASSERT(g_vulkan->device != MD_NULL);
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(g_vulkan->physicalDevice, &properties);
+
+	u32 queueFamiliesCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(g_vulkan->physicalDevice, &queueFamiliesCount, MD_NULL);
+	VkQueueFamilyProperties* pQueueFamilies = MD_MALLOC_ARRAY(VkQueueFamilyProperties, queueFamiliesCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(g_vulkan->physicalDevice, &queueFamiliesCount, pQueueFamilies);
+	u32 validBits = pQueueFamilies[g_vulkan->queueFamilies.graphicsFamily].timestampValidBits;
+	MD_FREE_ARRAY(pQueueFamilies, VkQueueFamilyProperties, queueFamiliesCount);
+
+	// Without timestamps the GPU zones are simply not measured, the frames are rendered the same.
+	if (validBits == 0 || properties.limits.timestampPeriod <= 0.0f)
+	{
+		MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "The graphics queue has no timestamps, GPU zones are disabled.");
+		return;
+	}
+
+	g_vulkan->timestampPeriod = (f64)properties.limits.timestampPeriod;
+	g_vulkan->timestampMask	  = validBits >= 64 ? ~(u64)0 : ((u64)1 << validBits) - 1;
+
+	VkQueryPoolCreateInfo queryPoolCreateInfo = {};
+	queryPoolCreateInfo.sType				  = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	queryPoolCreateInfo.queryType			  = VK_QUERY_TYPE_TIMESTAMP;
+	queryPoolCreateInfo.queryCount			  = GPU_TIMESTAMPS_PER_FRAME * FRAME_IN_FLIGHT_COUNT;
+
+	VK_ASSERT(vkCreateQueryPool(g_vulkan->device, &queryPoolCreateInfo, MD_NULL, &g_vulkan->timestampQueryPool));
+
+	mdReleaseStackPush(s_releaseStack, MD_NULL, deleteTimestampQueries);
+}
+
+static void deleteTimestampQueries(void* pData)
+{
+	MD_UNUSED(pData);
+	MD_ASSERT(g_vulkan != MD_NULL);
+	MD_ASSERT(g_vulkan->timestampQueryPool != VK_NULL_HANDLE);
+
+	vkDestroyQueryPool(g_vulkan->device, g_vulkan->timestampQueryPool, MD_NULL);
+	g_vulkan->timestampQueryPool = VK_NULL_HANDLE;
+}
+
+/**
+ * Reads the timestamps of a frame whose fence signaled. The results are requested without waiting: if they are not
+ * available the frame is skipped rather than stalling the CPU.
+ */
+static void readTimestamps(u32 frameIndex)
+{
+	if (!g_vulkan->hasPendingTimestamps[frameIndex])
+	{
+		return;
+	}
+	g_vulkan->hasPendingTimestamps[frameIndex] = MD_FALSE;
+
+	u64		 timestamps[GPU_TIMESTAMPS_PER_FRAME];
+	u32		 zonesCount	 = g_vulkan->gpuZonesCount[frameIndex];
+	u32		 queriesCount = 2 + 2 * zonesCount;
+	VkResult result		 = vkGetQueryPoolResults(g_vulkan->device,
+											 g_vulkan->timestampQueryPool,
+											 frameIndex * GPU_TIMESTAMPS_PER_FRAME,
+											 queriesCount,
+											 sizeof(u64) * queriesCount,
+											 timestamps,
+											 sizeof(u64),
+											 VK_QUERY_RESULT_64_BIT);
+	if (result != VK_SUCCESS)
+	{
+		return;
+	}
+
+	// The timestamp period is in nanoseconds, the unit of the ticks.
+	u64 frameDelta = (timestamps[1] - timestamps[0]) & g_vulkan->timestampMask;
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_GPU, (mdTicks)((f64)frameDelta * g_vulkan->timestampPeriod));
+
+	for (u32 i = 0; i < zonesCount; ++i)
+	{
+		u64 zoneDelta = (timestamps[3 + 2 * i] - timestamps[2 + 2 * i]) & g_vulkan->timestampMask;
+
+		struct MdGpuZoneTiming* pTiming = &g_vulkan->resolvedGpuZones[i];
+		pTiming->name					= g_vulkan->gpuZones[frameIndex][i].name;
+		pTiming->depth					= g_vulkan->gpuZones[frameIndex][i].depth;
+		pTiming->milliseconds			= (f64)zoneDelta * g_vulkan->timestampPeriod * 1e-6;
+	}
+	g_vulkan->resolvedGpuZonesCount = zonesCount;
+}
+
 static void transitionImageLayout(VkImage			   image,
 								  VkImageLayout		   oldLayout,
 								  VkImageLayout		   newLayout,
@@ -1041,24 +1141,51 @@ static void transitionImageLayout(VkImage			   image,
 
 void mdRenderStartFrame()
 {
+	MD_PROFILE_SCOPE("mdRenderStartFrame");
+
 	MD_ASSERT(g_vulkan != MD_NULL);
 	MD_ASSERT(g_vulkan->graphicsCommandBuffers != MD_NULL);
 
+	mdTicks waitTicks = mdGetTicks();
 	vkWaitForFences(g_vulkan->device, 1, &g_vulkan->inFlightFences[g_vulkan->currentFrame], VK_TRUE, UINT64_MAX);
+	mdTicks acquireTicks = mdGetTicks();
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_WAIT_FENCE, acquireTicks - waitTicks);
+	readTimestamps(g_vulkan->currentFrame);
+
 	VK_ASSERT(vkResetFences(g_vulkan->device, 1, &g_vulkan->inFlightFences[g_vulkan->currentFrame]));
+	releaseRetiredPipelines(MD_FALSE);
 
+	acquireTicks = mdGetTicks();
 	vkAcquireNextImageKHR(g_vulkan->device,
 						  g_vulkan->swapchain,
 						  UINT64_MAX,
 						  g_vulkan->imageAvailableSemaphores[g_vulkan->currentFrame],
 						  VK_NULL_HANDLE,
 						  &g_vulkan->imageIndex);
+	g_vulkan->recordStartTicks = mdGetTicks();
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_ACQUIRE, g_vulkan->recordStartTicks - acquireTicks);
 
 	VkCommandBufferBeginInfo commandBufferBeginInfo = {};
 	commandBufferBeginInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
 	VK_ASSERT(vkBeginCommandBuffer(g_vulkan->graphicsCommandBuffers[g_vulkan->currentFrame], &commandBufferBeginInfo));
 
+	g_vulkan->gpuZonesCount[g_vulkan->currentFrame] = 0;
+	g_vulkan->openGpuZonesCount						= 0;
+	if (g_vulkan->timestampQueryPool != VK_NULL_HANDLE)
+	{
+		// The queries are reset by the command buffer, outside of the rendering, before being written again.
+		u32 firstQuery = g_vulkan->currentFrame * GPU_TIMESTAMPS_PER_FRAME;
+		vkCmdResetQueryPool(g_vulkan->graphicsCommandBuffers[g_vulkan->currentFrame],
+							g_vulkan->timestampQueryPool,
+							firstQuery,
+							GPU_TIMESTAMPS_PER_FRAME);
+		vkCmdWriteTimestamp(g_vulkan->graphicsCommandBuffers[g_vulkan->currentFrame],
+							VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+							g_vulkan->timestampQueryPool,
+							firstQuery);
+	}
+
 	transitionImageLayout(g_vulkan->pSwapchainImages[g_vulkan->imageIndex],
 						  VK_IMAGE_LAYOUT_UNDEFINED,
 						  VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
@@ -1128,9 +1255,12 @@ void mdRenderDraw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 first
 
 void mdRenderEndFrame()
 {
+	MD_PROFILE_SCOPE("mdRenderEndFrame");
+
 	MD_ASSERT(g_vulkan != MD_NULL);
 	MD_ASSERT(g_vulkan->graphicsCommandBuffers != MD_NULL);
 	MD_ASSERT(g_vulkan->graphicsQueue != MD_NULL);
+	MD_ASSERT_MSG(g_vulkan->openGpuZonesCount == 0, "Every GPU zone must be closed before the end of the frame.");
 
 	vkCmdEndRendering(g_vulkan->graphicsCommandBuffers[g_vulkan->currentFrame]);
 
@@ -1142,6 +1272,15 @@ void mdRenderEndFrame()
 						  VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
 						  VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
 
+	if (g_vulkan->timestampQueryPool != VK_NULL_HANDLE)
+	{
+		vkCmdWriteTimestamp(g_vulkan->graphicsCommandBuffers[g_vulkan->currentFrame],
+							VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+							g_vulkan->timestampQueryPool,
+							g_vulkan->currentFrame * GPU_TIMESTAMPS_PER_FRAME + 1);
+		g_vulkan->hasPendingTimestamps[g_vulkan->currentFrame] = MD_TRUE;
+	}
+
 	VK_ASSERT(vkEndCommandBuffer(g_vulkan->graphicsCommandBuffers[g_vulkan->currentFrame]));
 
 	// Submit command buffer
@@ -1167,11 +1306,69 @@ void mdRenderEndFrame()
 	submitInfo.signalSemaphoreCount = MD_ARRAY_SIZE(signalSemaphores);
 	submitInfo.pSignalSemaphores	= signalSemaphores;
 
+	mdTicks submitTicks = mdGetTicks();
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_RECORD, submitTicks - g_vulkan->recordStartTicks);
+
 	VK_ASSERT(vkQueueSubmit(g_vulkan->graphicsQueue, 1, &submitInfo, g_vulkan->inFlightFences[g_vulkan->currentFrame]));
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_SUBMIT, mdGetTicks() - submitTicks);
+}
+
+void mdRenderBeginGpuZone(const char* name)
+{
+	MD_ASSERT(g_vulkan != MD_NULL);
+	MD_ASSERT(name != MD_NULL);
+	MD_ASSERT_MSG(g_vulkan->openGpuZonesCount < MD_RENDER_GPU_ZONES_CAPACITY, "Too many nested GPU zones.");
+
+	u32* pZonesCount = &g_vulkan->gpuZonesCount[g_vulkan->currentFrame];
+	if (g_vulkan->timestampQueryPool == VK_NULL_HANDLE || *pZonesCount == MD_RENDER_GPU_ZONES_CAPACITY)
+	{
+		g_vulkan->openGpuZones[g_vulkan->openGpuZonesCount++] = GPU_ZONE_IGNORED;
+		return;
+	}
+
+	u32					  zoneIndex = (*pZonesCount)++;
+	struct VulkanGpuZone* pZone		= &g_vulkan->gpuZones[g_vulkan->currentFrame][zoneIndex];
+	pZone->name						= name;
+	pZone->depth					= g_vulkan->openGpuZonesCount;
+	g_vulkan->openGpuZones[g_vulkan->openGpuZonesCount++] = zoneIndex;
+
+	vkCmdWriteTimestamp(g_vulkan->graphicsCommandBuffers[g_vulkan->currentFrame],
+						VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+						g_vulkan->timestampQueryPool,
+						g_vulkan->currentFrame * GPU_TIMESTAMPS_PER_FRAME + 2 + 2 * zoneIndex);
+}
+
+void mdRenderEndGpuZone()
+{
+	MD_ASSERT(g_vulkan != MD_NULL);
+	MD_ASSERT_MSG(g_vulkan->openGpuZonesCount > 0, "No GPU zone to close.");
+
+	u32 zoneIndex = g_vulkan->openGpuZones[--g_vulkan->openGpuZonesCount];
+	if (zoneIndex == GPU_ZONE_IGNORED)
+	{
+		return;
+	}
+
+	vkCmdWriteTimestamp(g_vulkan->graphicsCommandBuffers[g_vulkan->currentFrame],
+						VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+						g_vulkan->timestampQueryPool,
+						g_vulkan->currentFrame * GPU_TIMESTAMPS_PER_FRAME + 3 + 2 * zoneIndex);
+}
+
+u32 mdRenderGetGpuZones(struct MdGpuZoneTiming* pZones, u32 maxZones)
+{
+	MD_ASSERT(g_vulkan != MD_NULL);
+	MD_ASSERT(pZones != MD_NULL || maxZones == 0);
+
+	u32 count = g_vulkan->resolvedGpuZonesCount < maxZones ? g_vulkan->resolvedGpuZonesCount : maxZones;
+	mdMemoryCopy(pZones, g_vulkan->resolvedGpuZones, sizeof(struct MdGpuZoneTiming) * count);
+	return count;
 }
 
 void mdRenderPresent()
 {
+	MD_PROFILE_SCOPE("mdRenderPresent");
+
 	MD_ASSERT(g_vulkan != MD_NULL);
 	MD_ASSERT(g_vulkan->presentQueue != MD_NULL);
 
@@ -1187,9 +1384,13 @@ void mdRenderPresent()
 	presentInfo.pSwapchains		   = &g_vulkan->swapchain;
 	presentInfo.pImageIndices	   = &g_vulkan->imageIndex;
 
+	mdTicks presentTicks = mdGetTicks();
 	VK_ASSERT(vkQueuePresentKHR(g_vulkan->presentQueue, &presentInfo));
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_PRESENT, mdGetTicks() - presentTicks);
+	mdFrameStatsEndFrame();
 
 	g_vulkan->currentFrame = (g_vulkan->currentFrame + 1) % FRAME_IN_FLIGHT_COUNT;
+	++g_vulkan->frameNumber;
 }
 
 static void transitionImageLayout(VkImage			   image,
@@ -1229,6 +1430,58 @@ void mdRenderWaitIdle()
 	MD_ASSERT(g_vulkan->device != MD_NULL);
 
 	vkDeviceWaitIdle(g_vulkan->device);
+	releaseRetiredPipelines(MD_TRUE);
+}
+
+void mdVulkanRetirePipeline(VkPipeline pipeline)
+{
+	MD_ASSERT(g_vulkan != MD_NULL);
+	MD_ASSERT(g_vulkan->device != MD_NULL);
+
+	if (g_vulkan->retiredPipelinesCount == RETIRED_PIPELINES_CAPACITY)
+	{
+		// Only reached when reloading many pipelines at once, stalling once is simpler than growing the array
+		vkDeviceWaitIdle(g_vulkan->device);
+		releaseRetiredPipelines(MD_TRUE);
+	}
+
+	// The frame being recorded is the last one which can reference the pipeline, it is done once its slot is reused
+	struct VulkanRetiredPipeline* pRetired = &g_vulkan->retiredPipelines[g_vulkan->retiredPipelinesCount++];
+	pRetired->pipeline					   = pipeline;
+	pRetired->releaseFrame				   = g_vulkan->frameNumber + FRAME_IN_FLIGHT_COUNT;
+}
+
+static void releaseRetiredPipelines(b8 force)
+{
+	u32 keptCount = 0;
+	for (u32 i = 0; i < g_vulkan->retiredPipelinesCount; ++i)
+	{
+		struct VulkanRetiredPipeline* pRetired = &g_vulkan->retiredPipelines[i];
+		if (force || pRetired->releaseFrame <= g_vulkan->frameNumber)
+		{
+			vkDestroyPipeline(g_vulkan->device, pRetired->pipeline, MD_NULL);
+		}
+		else
+		{
+			g_vulkan->retiredPipelines[keptCount++] = *pRetired;
+		}
+	}
+	g_vulkan->retiredPipelinesCount = keptCount;
+}
+
+static void destroyRetiredPipelines(void* pData)
+{
+	MD_UNUSED(pData);
+	MD_ASSERT(g_vulkan != MD_NULL);
+
+	vkDeviceWaitIdle(g_vulkan->device);
+	releaseRetiredPipelines(MD_TRUE);
+}
+
+static void shutdownFrameStats(void* pData)
+{
+	MD_UNUSED(pData);
+	mdFrameStatsShutdown();
 }
 
 #endif // MD_USE_VULKAN
@@ -1,24 +1,17 @@
 #if MD_USE_OPENGL
 
+#include "MEEDEngine/core/core.h"
 #include "MEEDEngine/modules/render/shader.h"
 #include "opengl_common.h"
 
-struct MdShader* mdShaderCreate(enum MdShaderType type, const char* shaderSource)
+b8 mdOpenGLCompileShader(enum MdShaderType type, const char* shaderSource, u32* pShaderID)
 {
-	struct MdShader* pShader = MD_MALLOC(struct MdShader);
-	MD_ASSERT(pShader != MD_NULL);
-	mdMemorySet(pShader, 0, sizeof(struct MdShader));
-
-	pShader->type = type;
-
-	pShader->pInternal = MD_MALLOC(struct OpenGLShader);
-	MD_ASSERT(pShader->pInternal != MD_NULL);
-	mdMemorySet(pShader->pInternal, 0, sizeof(struct OpenGLShader));
-
-	struct OpenGLShader* pOpenGLShader = (struct OpenGLShader*)pShader->pInternal;
-
 	struct MdFileData* pFile = mdFileOpen(shaderSource, MD_FILE_MODE_READ);
-	MD_ASSERT_MSG(pFile != MD_NULL && pFile->isOpen, "Failed to open shader file \"%s\".", shaderSource);
+	if (pFile == MD_NULL || !pFile->isOpen)
+	{
+		MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Failed to open shader file \"%s\".", shaderSource);
+		return MD_FALSE;
+	}
 
 	GLenum shaderType;
 
@@ -43,23 +36,67 @@ struct MdShader* mdShaderCreate(enum MdShaderType type, const char* shaderSource
 		MD_UNTOUCHABLE();
 	}
 
-	GL_ASSERT(pOpenGLShader->shaderID = glCreateShader(shaderType));
-	GL_ASSERT(glShaderSource(pOpenGLShader->shaderID, 1, (const char**)&pFile->content, (const GLint*)&pFile->size));
-	GL_ASSERT(glCompileShader(pOpenGLShader->shaderID));
+	u32 shaderID;
+	GL_ASSERT(shaderID = glCreateShader(shaderType));
+	GLint sourceLength = (GLint)pFile->size;
+	GL_ASSERT(glShaderSource(shaderID, 1, (const char**)&pFile->content, &sourceLength));
+	GL_ASSERT(glCompileShader(shaderID));
 
-	glGetShaderiv(pOpenGLShader->shaderID, GL_COMPILE_STATUS, (GLint*)&shaderType);
-	if (shaderType != GL_TRUE)
+	mdFileClose(pFile);
+
+	GLint compileStatus;
+	glGetShaderiv(shaderID, GL_COMPILE_STATUS, &compileStatus);
+	if (compileStatus != GL_TRUE)
 	{
 		char infoLog[512];
-		glGetShaderInfoLog(pOpenGLShader->shaderID, 512, NULL, infoLog);
-		MD_ASSERT_MSG(MD_FALSE, "Shader \"%s\" compilation failed: %s", shaderSource, infoLog);
+		glGetShaderInfoLog(shaderID, 512, NULL, infoLog);
+		MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Shader \"%s\" compilation failed: %s", shaderSource, infoLog);
+		GL_ASSERT(glDeleteShader(shaderID));
+		return MD_FALSE;
 	}
 
-	mdFileClose(pFile);
+	*pShaderID = shaderID;
+	return MD_TRUE;
+}
+
+struct MdShader* mdShaderCreate(enum MdShaderType type, const char* shaderSource)
+{
+	struct MdShader* pShader = MD_MALLOC(struct MdShader);
+	MD_ASSERT(pShader != MD_NULL);
+	mdMemorySet(pShader, 0, sizeof(struct MdShader));
+
+	pShader->type = type;
+
+	pShader->pInternal = MD_MALLOC(struct OpenGLShader);
+	MD_ASSERT(pShader->pInternal != MD_NULL);
+	mdMemorySet(pShader->pInternal, 0, sizeof(struct OpenGLShader));
+
+	struct OpenGLShader* pOpenGLShader = (struct OpenGLShader*)pShader->pInternal;
+
+	b8 isCompiled = mdOpenGLCompileShader(type, shaderSource, &pOpenGLShader->shaderID);
+	MD_ASSERT_MSG(isCompiled, "Failed to create shader \"%s\".", shaderSource);
+	MD_UNUSED(isCompiled);
 
 	return pShader;
 }
 
+b8 mdShaderReload(struct MdShader* pShader, const char* shaderSource)
+{
+	MD_ASSERT(pShader != MD_NULL);
+
+	u32 shaderID;
+	if (!mdOpenGLCompileShader(pShader->type, shaderSource, &shaderID))
+	{
+		return MD_FALSE;
+	}
+
+	struct OpenGLShader* pOpenGLShader = (struct OpenGLShader*)pShader->pInternal;
+	GL_ASSERT(glDeleteShader(pOpenGLShader->shaderID));
+	pOpenGLShader->shaderID = shaderID;
+
+	return MD_TRUE;
+}
+
 void mdShaderDestroy(struct MdShader* pShader)
 {
 	MD_ASSERT(pShader != MD_NULL);
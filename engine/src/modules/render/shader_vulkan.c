@@ -3,6 +3,35 @@
 #include "MEEDEngine/modules/render/shader.h"
 #include "vulkan_common.h"
 
+static b8 createModule(const char* filePath, VkShaderModule* pModule)
+{
+	MD_ASSERT(g_vulkan != MD_NULL);
+	MD_ASSERT(g_vulkan->device != MD_NULL);
+
+	// Load SPIR-V binary from file, the mapping is page aligned so it can be passed as `pCode` directly
+	struct MdFileData* pFile = mdFileOpen(filePath, MD_FILE_MODE_READ_MAPPED);
+	if (pFile == MD_NULL || !pFile->isOpen)
+	{
+		MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Failed to open shader file \"%s\".", filePath);
+		return MD_FALSE;
+	}
+
+	VkShaderModuleCreateInfo createInfo = {};
+	createInfo.sType					= VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	createInfo.codeSize					= pFile->size;
+	createInfo.pCode					= (const u32*)pFile->content;
+	VkResult result						= vkCreateShaderModule(g_vulkan->device, &createInfo, MD_NULL, pModule);
+
+	mdFileClose(pFile);
+
+	if (result != VK_SUCCESS)
+	{
+		MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Failed to create shader module \"%s\" (%d).", filePath, result);
+		return MD_FALSE;
+	}
+	return MD_TRUE;
+}
+
 struct MdShader* mdShaderCreate(enum MdShaderType type, const char* filePath)
 {
 	struct MdShader* pShader = MD_MALLOC(struct MdShader);
@@ -15,22 +44,29 @@ struct MdShader* mdShaderCreate(enum MdShaderType type, const char* filePath)
 	struct VulkanShader* pVulkanShader = (struct VulkanShader*)pShader->pInternal;
 	mdMemorySet(pVulkanShader, 0, sizeof(struct VulkanShader));
 
-	// Load SPIR-V binary from file
-	struct MdFileData* pFile = mdFileOpen(filePath, MD_FILE_MODE_READ);
-	MD_ASSERT_MSG(pFile != MD_NULL && pFile->isOpen, "Failed to open shader file \"%s\".", filePath);
+	b8 isCreated = createModule(filePath, &pVulkanShader->module);
+	MD_ASSERT_MSG(isCreated, "Failed to create shader \"%s\".", filePath);
+	MD_UNUSED(isCreated);
 
-	MD_ASSERT(g_vulkan != MD_NULL);
-	MD_ASSERT(g_vulkan->device != MD_NULL);
+	return pShader;
+}
 
-	VkShaderModuleCreateInfo createInfo = {};
-	createInfo.sType					= VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-	createInfo.codeSize					= pFile->size;
-	createInfo.pCode					= (const u32*)pFile->content;
-	VK_ASSERT(vkCreateShaderModule(g_vulkan->device, &createInfo, MD_NULL, &pVulkanShader->module));
+b8 mdShaderReload(struct MdShader* pShader, const char* filePath)
+{
+	MD_ASSERT(pShader != MD_NULL);
 
-	mdFileClose(pFile);
+	VkShaderModule module;
+	if (!createModule(filePath, &module))
+	{
+		return MD_FALSE;
+	}
 
-	return pShader;
+	// A module is only read while a pipeline is created, the pipelines built from the previous one stay valid
+	struct VulkanShader* pVulkanShader = (struct VulkanShader*)pShader->pInternal;
+	vkDestroyShaderModule(g_vulkan->device, pVulkanShader->module, MD_NULL);
+	pVulkanShader->module = module;
+
+	return MD_TRUE;
 }
 
 void mdShaderDestroy(struct MdShader* pShader)
@@ -92,6 +92,8 @@ void mdVertexBufferBind(struct MdVertexBuffer* pVertexBuffer)
 
 u32 mdVertexBufferWrite(struct MdVertexBuffer* pVertexBuffer, const void* pData)
 {
+	MD_PROFILE_SCOPE("mdVertexBufferWrite");
+
 	MD_ASSERT(pVertexBuffer != MD_NULL);
 	MD_ASSERT(pData != MD_NULL);
 
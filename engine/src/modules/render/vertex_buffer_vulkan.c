@@ -106,6 +106,8 @@ static void writeDataDynamic(struct MdVertexBuffer* pVertexBuffer, const void* p
 
 u32 mdVertexBufferWrite(struct MdVertexBuffer* pVertexBuffer, const void* pData)
 {
+	MD_PROFILE_SCOPE("mdVertexBufferWrite");
+
 	MD_ASSERT(g_vulkan != MD_NULL);
 	MD_ASSERT(g_vulkan->device != MD_NULL);
 	MD_ASSERT(pVertexBuffer != MD_NULL);
@@ -18,6 +18,12 @@ struct VulkanShader
 
 #define FRAME_IN_FLIGHT_COUNT 3
 
+#define RETIRED_PIPELINES_CAPACITY 16
+
+/// The timestamps of a frame in the query pool: the frame begin and end, then the begin and end of each GPU zone.
+#define GPU_TIMESTAMPS_PER_FRAME (2u + 2u * MD_RENDER_GPU_ZONES_CAPACITY)
+#define GPU_ZONE_IGNORED		 ((u32)(-1)) ///< A zone opened beyond the capacity, not timed.
+
 /**
  * @brief The queue family indices for the selected physical device.
  */
@@ -38,6 +44,24 @@ struct VulkanPipeline
 	VkPipeline		 pipeline;
 };
 
+/**
+ * @brief A pipeline replaced while frames in flight may still use it, see `mdVulkanRetirePipeline`.
+ */
+struct VulkanRetiredPipeline
+{
+	VkPipeline pipeline;
+	u64		   releaseFrame; ///< The first frame number at which no frame in flight can use the pipeline.
+};
+
+/**
+ * @brief A GPU zone recorded in a frame, its timestamps follow the frame timestamps in the query pool.
+ */
+struct VulkanGpuZone
+{
+	const char* name;
+	u32			depth;
+};
+
 /**
  * @brief The Vulkan-specific implementation of the vertex buffer.
  */
@@ -100,10 +124,32 @@ struct MEEDVulkan
 
 	VkRenderingAttachmentInfo colorAttachmentInfos[FRAME_IN_FLIGHT_COUNT];
 	VkRenderingInfoKHR		  renderingInfos[FRAME_IN_FLIGHT_COUNT];
+
+	u64							 frameNumber; ///< The number of frames presented since the initialization.
+	mdTicks						 recordStartTicks; ///< When the recording of the current frame started.
+	struct VulkanRetiredPipeline retiredPipelines[RETIRED_PIPELINES_CAPACITY];
+	u32							 retiredPipelinesCount;
+
+	VkQueryPool timestampQueryPool; ///< `GPU_TIMESTAMPS_PER_FRAME` queries per frame in flight, or VK_NULL_HANDLE.
+	f64			timestampPeriod;	///< The nanoseconds of a timestamp increment.
+	u64			timestampMask;		///< The valid bits of the timestamps.
+	b8			hasPendingTimestamps[FRAME_IN_FLIGHT_COUNT]; ///< The frame wrote timestamps which were not read yet.
+	struct VulkanGpuZone   gpuZones[FRAME_IN_FLIGHT_COUNT][MD_RENDER_GPU_ZONES_CAPACITY];
+	u32					   gpuZonesCount[FRAME_IN_FLIGHT_COUNT];
+	u32					   openGpuZones[MD_RENDER_GPU_ZONES_CAPACITY]; ///< The zone indices, innermost last.
+	u32					   openGpuZonesCount;
+	struct MdGpuZoneTiming resolvedGpuZones[MD_RENDER_GPU_ZONES_CAPACITY]; ///< The last frame read back.
+	u32					   resolvedGpuZonesCount;
 };
 
 extern struct MEEDVulkan* g_vulkan; // Global Vulkan instance
 
+/**
+ * @brief Destroys a pipeline once the frames in flight which may reference it are done, without stalling the GPU.
+ * @param pipeline The pipeline to destroy, it must not be used by the next frames.
+ */
+void mdVulkanRetirePipeline(VkPipeline pipeline);
+
 #if MD_DEBUG
 #define VK_ASSERT(call)                                                                                                \
 	do                                                                                                                 \
@@ -0,0 +1,498 @@
+#include "MEEDEngine/modules/voxel/chunk.h"
+#include "MEEDEngine/platforms/memory.h"
+
+#define DIRECT_INDEX 0xFFFFFFFFu ///< Returned by `acquireEntry` once the chunk has no palette anymore.
+
+static u32 getWordsCount(u32 bitsPerIndex)
+{
+	return bitsPerIndex * (MD_CHUNK_VOLUME / 64);
+}
+
+static u32 getPaletteCapacity(u32 bitsPerIndex)
+{
+	return bitsPerIndex == MD_CHUNK_MAX_BITS ? 0 : 1u << bitsPerIndex;
+}
+
+static u32 getBitsForPaletteCount(u32 paletteCount)
+{
+	u32 bitsPerIndex = 0;
+	while ((1u << bitsPerIndex) < paletteCount)
+	{
+		bitsPerIndex = bitsPerIndex == 0 ? 1 : bitsPerIndex * 2;
+	}
+	return bitsPerIndex;
+}
+
+/**
+ * The widths divide 64: an index never spans two words.
+ */
+static u32 readIndex(const u64* pIndices, u32 bitsPerIndex, u32 blockIndex)
+{
+	if (bitsPerIndex == 0)
+	{
+		return 0;
+	}
+	u32 bitOffset = blockIndex * bitsPerIndex;
+	return (u32)(pIndices[bitOffset >> 6] >> (bitOffset & 63)) & ((1u << bitsPerIndex) - 1);
+}
+
+static void writeIndex(u64* pIndices, u32 bitsPerIndex, u32 blockIndex, u32 index)
+{
+	u32	 bitOffset = blockIndex * bitsPerIndex;
+	u64	 mask	   = ((1ull << bitsPerIndex) - 1) << (bitOffset & 63);
+	u64* pWord	   = &pIndices[bitOffset >> 6];
+	*pWord		   = (*pWord & ~mask) | ((u64)index << (bitOffset & 63));
+}
+
+static u64* allocateIndices(u32 bitsPerIndex)
+{
+	if (bitsPerIndex == 0)
+	{
+		return MD_NULL;
+	}
+	u64* pIndices = MD_MALLOC_ARRAY(u64, getWordsCount(bitsPerIndex));
+	mdMemorySet(pIndices, 0, sizeof(u64) * getWordsCount(bitsPerIndex));
+	return pIndices;
+}
+
+/**
+ * The unused entries are zeroed: the decoding tables read every entry the indices can hold.
+ */
+static struct MdChunkPaletteEntry* allocatePalette(u32 bitsPerIndex)
+{
+	u32 capacity = getPaletteCapacity(bitsPerIndex);
+	if (capacity == 0)
+	{
+		return MD_NULL;
+	}
+	struct MdChunkPaletteEntry* pPalette = MD_MALLOC_ARRAY(struct MdChunkPaletteEntry, capacity);
+	mdMemorySet(pPalette, 0, sizeof(struct MdChunkPaletteEntry) * capacity);
+	return pPalette;
+}
+
+static void freeStorage(struct MdChunk* pChunk)
+{
+	if (pChunk->pIndices != MD_NULL)
+	{
+		MD_FREE_ARRAY(pChunk->pIndices, u64, getWordsCount(pChunk->bitsPerIndex));
+		pChunk->pIndices = MD_NULL;
+	}
+	if (pChunk->pPalette != MD_NULL)
+	{
+		MD_FREE_ARRAY(pChunk->pPalette, struct MdChunkPaletteEntry, getPaletteCapacity(pChunk->bitsPerIndex));
+		pChunk->pPalette = MD_NULL;
+	}
+}
+
+static void setUniform(struct MdChunk* pChunk, mdBlockId blockId)
+{
+	freeStorage(pChunk);
+	pChunk->bitsPerIndex			= 0;
+	pChunk->paletteCount			= 1;
+	pChunk->pPalette				= allocatePalette(0);
+	pChunk->pPalette[0].blockId		= blockId;
+	pChunk->pPalette[0].blocksCount = (u16)MD_CHUNK_VOLUME;
+}
+
+/**
+ * Drops the palette: the indices become the block IDs themselves.
+ */
+static void setDirect(struct MdChunk* pChunk)
+{
+	u64* pIndices = allocateIndices(MD_CHUNK_MAX_BITS);
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+	{
+		u32 index = readIndex(pChunk->pIndices, pChunk->bitsPerIndex, i);
+		writeIndex(pIndices, MD_CHUNK_MAX_BITS, i, pChunk->pPalette[index].blockId);
+	}
+
+	freeStorage(pChunk);
+	pChunk->pIndices	 = pIndices;
+	pChunk->bitsPerIndex = MD_CHUNK_MAX_BITS;
+	pChunk->paletteCount = 0;
+}
+
+/**
+ * Moves the indices and the palette to a wider index, the indices keep their values.
+ */
+static void widen(struct MdChunk* pChunk, u32 bitsPerIndex)
+{
+	u64*						pIndices = allocateIndices(bitsPerIndex);
+	struct MdChunkPaletteEntry* pPalette = allocatePalette(bitsPerIndex);
+	if (pChunk->bitsPerIndex > 0)
+	{
+		for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+		{
+			writeIndex(pIndices, bitsPerIndex, i, readIndex(pChunk->pIndices, pChunk->bitsPerIndex, i));
+		}
+	}
+	mdMemoryCopy(pPalette, pChunk->pPalette, sizeof(struct MdChunkPaletteEntry) * pChunk->paletteCount);
+
+	u32 paletteCount = pChunk->paletteCount;
+	freeStorage(pChunk);
+	pChunk->pIndices	 = pIndices;
+	pChunk->pPalette	 = pPalette;
+	pChunk->paletteCount = paletteCount;
+	pChunk->bitsPerIndex = bitsPerIndex;
+}
+
+/**
+ * Finds the palette entry of a block type, or makes one: a free entry, a new one, or a new one after widening the
+ * indices. The entry of a new block type counts no block yet.
+ * @return The index of the entry, or `DIRECT_INDEX` if the chunk had to drop its palette.
+ */
+static u32 acquireEntry(struct MdChunk* pChunk, mdBlockId blockId)
+{
+	u32 freeIndex = pChunk->paletteCount;
+	for (u32 i = 0; i < pChunk->paletteCount; ++i)
+	{
+		if (pChunk->pPalette[i].blockId == blockId)
+		{
+			return i;
+		}
+		if (pChunk->pPalette[i].blocksCount == 0 && freeIndex == pChunk->paletteCount)
+		{
+			freeIndex = i;
+		}
+	}
+
+	if (freeIndex == pChunk->paletteCount)
+	{
+		if (pChunk->paletteCount == MD_CHUNK_MAX_PALETTE_SIZE)
+		{
+			setDirect(pChunk);
+			return DIRECT_INDEX;
+		}
+		if (pChunk->paletteCount == getPaletteCapacity(pChunk->bitsPerIndex))
+		{
+			widen(pChunk, pChunk->bitsPerIndex == 0 ? 1 : pChunk->bitsPerIndex * 2);
+		}
+		++pChunk->paletteCount;
+	}
+
+	pChunk->pPalette[freeIndex].blockId		= blockId;
+	pChunk->pPalette[freeIndex].blocksCount = 0;
+	return freeIndex;
+}
+
+struct MdChunk* mdChunkCreate(mdBlockId blockId)
+{
+	struct MdChunk* pChunk = MD_MALLOC(struct MdChunk);
+	pChunk->pIndices	   = MD_NULL;
+	pChunk->pPalette	   = MD_NULL;
+	pChunk->bitsPerIndex   = 0;
+	setUniform(pChunk, blockId);
+	return pChunk;
+}
+
+mdBlockId mdChunkGetBlock(const struct MdChunk* pChunk, u32 x, u32 y, u32 z)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+	MD_ASSERT(x < MD_CHUNK_SIZE && y < MD_CHUNK_SIZE && z < MD_CHUNK_SIZE);
+
+	u32 index = readIndex(pChunk->pIndices, pChunk->bitsPerIndex, MD_CHUNK_BLOCK_INDEX(x, y, z));
+	return pChunk->bitsPerIndex == MD_CHUNK_MAX_BITS ? (mdBlockId)index : pChunk->pPalette[index].blockId;
+}
+
+void mdChunkSetBlock(struct MdChunk* pChunk, u32 x, u32 y, u32 z, mdBlockId blockId)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+	MD_ASSERT(x < MD_CHUNK_SIZE && y < MD_CHUNK_SIZE && z < MD_CHUNK_SIZE);
+
+	u32 blockIndex = MD_CHUNK_BLOCK_INDEX(x, y, z);
+	if (pChunk->bitsPerIndex == MD_CHUNK_MAX_BITS)
+	{
+		writeIndex(pChunk->pIndices, MD_CHUNK_MAX_BITS, blockIndex, blockId);
+		return;
+	}
+
+	u32 oldIndex = readIndex(pChunk->pIndices, pChunk->bitsPerIndex, blockIndex);
+	if (pChunk->pPalette[oldIndex].blockId == blockId)
+	{
+		return;
+	}
+
+	// Widening keeps the values of the indices: the old index stays valid.
+	u32 newIndex = acquireEntry(pChunk, blockId);
+	if (newIndex == DIRECT_INDEX)
+	{
+		writeIndex(pChunk->pIndices, MD_CHUNK_MAX_BITS, blockIndex, blockId);
+		return;
+	}
+
+	--pChunk->pPalette[oldIndex].blocksCount;
+	++pChunk->pPalette[newIndex].blocksCount;
+	writeIndex(pChunk->pIndices, pChunk->bitsPerIndex, blockIndex, newIndex);
+	if (pChunk->pPalette[newIndex].blocksCount == MD_CHUNK_VOLUME)
+	{
+		setUniform(pChunk, blockId);
+	}
+}
+
+void mdChunkFill(struct MdChunk* pChunk, mdBlockId blockId)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+	setUniform(pChunk, blockId);
+}
+
+void mdChunkFillBox(
+	struct MdChunk* pChunk, u32 minX, u32 minY, u32 minZ, u32 maxX, u32 maxY, u32 maxZ, mdBlockId blockId)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+	MD_ASSERT(minX <= maxX && minY <= maxY && minZ <= maxZ);
+	MD_ASSERT(maxX <= MD_CHUNK_SIZE && maxY <= MD_CHUNK_SIZE && maxZ <= MD_CHUNK_SIZE);
+
+	if (minX == maxX || minY == maxY || minZ == maxZ)
+	{
+		return;
+	}
+	if ((maxX - minX) * (maxY - minY) * (maxZ - minZ) == MD_CHUNK_VOLUME)
+	{
+		setUniform(pChunk, blockId);
+		return;
+	}
+
+	u32 newIndex = pChunk->bitsPerIndex == MD_CHUNK_MAX_BITS ? DIRECT_INDEX : acquireEntry(pChunk, blockId);
+	if (newIndex == DIRECT_INDEX)
+	{
+		for (u32 y = minY; y < maxY; ++y)
+		{
+			for (u32 z = minZ; z < maxZ; ++z)
+			{
+				for (u32 x = minX; x < maxX; ++x)
+				{
+					writeIndex(pChunk->pIndices, MD_CHUNK_MAX_BITS, MD_CHUNK_BLOCK_INDEX(x, y, z), blockId);
+				}
+			}
+		}
+		return;
+	}
+
+	// The entry of a new block type was just acquired: the chunk has indices if the box holds another block type.
+	u32 changedCount = 0;
+	for (u32 y = minY; y < maxY; ++y)
+	{
+		for (u32 z = minZ; z < maxZ; ++z)
+		{
+			for (u32 x = minX; x < maxX; ++x)
+			{
+				u32 blockIndex = MD_CHUNK_BLOCK_INDEX(x, y, z);
+				u32 oldIndex   = readIndex(pChunk->pIndices, pChunk->bitsPerIndex, blockIndex);
+				if (oldIndex != newIndex)
+				{
+					--pChunk->pPalette[oldIndex].blocksCount;
+					writeIndex(pChunk->pIndices, pChunk->bitsPerIndex, blockIndex, newIndex);
+					++changedCount;
+				}
+			}
+		}
+	}
+
+	pChunk->pPalette[newIndex].blocksCount += (u16)changedCount;
+	if (pChunk->pPalette[newIndex].blocksCount == MD_CHUNK_VOLUME)
+	{
+		setUniform(pChunk, blockId);
+	}
+}
+
+void mdChunkCompact(struct MdChunk* pChunk)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+
+	if (pChunk->bitsPerIndex == MD_CHUNK_MAX_BITS)
+	{
+		// The block types are not counted without palette: the encoding counts them.
+		mdBlockId* pBlocks = MD_MALLOC_ARRAY(mdBlockId, MD_CHUNK_VOLUME);
+		mdChunkDecode(pChunk, pBlocks);
+		mdChunkEncode(pChunk, pBlocks);
+		MD_FREE_ARRAY(pBlocks, mdBlockId, MD_CHUNK_VOLUME);
+		return;
+	}
+
+	u32 remap[MD_CHUNK_MAX_PALETTE_SIZE];
+	u32 usedCount = 0;
+	for (u32 i = 0; i < pChunk->paletteCount; ++i)
+	{
+		remap[i] = pChunk->pPalette[i].blocksCount > 0 ? usedCount++ : DIRECT_INDEX;
+	}
+
+	u32 bitsPerIndex = getBitsForPaletteCount(usedCount);
+	if (usedCount == pChunk->paletteCount && bitsPerIndex == pChunk->bitsPerIndex)
+	{
+		return;
+	}
+
+	u64*						pIndices = allocateIndices(bitsPerIndex);
+	struct MdChunkPaletteEntry* pPalette = allocatePalette(bitsPerIndex);
+	for (u32 i = 0; i < pChunk->paletteCount; ++i)
+	{
+		if (remap[i] != DIRECT_INDEX)
+		{
+			pPalette[remap[i]] = pChunk->pPalette[i];
+		}
+	}
+	if (bitsPerIndex > 0)
+	{
+		for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+		{
+			writeIndex(pIndices, bitsPerIndex, i, remap[readIndex(pChunk->pIndices, pChunk->bitsPerIndex, i)]);
+		}
+	}
+
+	freeStorage(pChunk);
+	pChunk->pIndices	 = pIndices;
+	pChunk->pPalette	 = pPalette;
+	pChunk->paletteCount = usedCount;
+	pChunk->bitsPerIndex = bitsPerIndex;
+}
+
+/**
+ * Decodes the narrow indices a byte at a time: a table built from the palette gives the blocks of every byte value,
+ * so each byte read writes 2, 4 or 8 blocks.
+ */
+static void decodeWithByteTable(const struct MdChunk* pChunk, mdBlockId* pBlocks, u32 blocksPerByte)
+{
+	u32		  bitsPerIndex = pChunk->bitsPerIndex;
+	u32		  mask		   = (1u << bitsPerIndex) - 1;
+	mdBlockId table[256 * 8];
+	for (u32 byte = 0; byte < 256; ++byte)
+	{
+		for (u32 i = 0; i < blocksPerByte; ++i)
+		{
+			table[byte * blocksPerByte + i] = pChunk->pPalette[(byte >> (i * bitsPerIndex)) & mask].blockId;
+		}
+	}
+
+	u32 wordsCount = getWordsCount(bitsPerIndex);
+	for (u32 i = 0; i < wordsCount; ++i)
+	{
+		u64 word = pChunk->pIndices[i];
+		for (u32 j = 0; j < 8; ++j)
+		{
+			const mdBlockId* pEntry = &table[((word >> (j * 8)) & 0xFF) * blocksPerByte];
+			for (u32 k = 0; k < blocksPerByte; ++k)
+			{
+				pBlocks[k] = pEntry[k];
+			}
+			pBlocks += blocksPerByte;
+		}
+	}
+}
+
+void mdChunkDecode(const struct MdChunk* pChunk, mdBlockId* pBlocks)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+	MD_ASSERT(pBlocks != MD_NULL);
+
+	switch (pChunk->bitsPerIndex)
+	{
+	case 0:
+	{
+		mdBlockId blockId = pChunk->pPalette[0].blockId;
+		for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+		{
+			pBlocks[i] = blockId;
+		}
+		break;
+	}
+	case 1:
+		decodeWithByteTable(pChunk, pBlocks, 8);
+		break;
+	case 2:
+		decodeWithByteTable(pChunk, pBlocks, 4);
+		break;
+	case 4:
+		decodeWithByteTable(pChunk, pBlocks, 2);
+		break;
+	case 8:
+		for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+		{
+			pBlocks[i] = pChunk->pPalette[(pChunk->pIndices[i >> 3] >> ((i & 7) * 8)) & 0xFF].blockId;
+		}
+		break;
+	default:
+		// The block IDs themselves, in the order of the blocks on a little-endian machine.
+		mdMemoryCopy(pBlocks, pChunk->pIndices, sizeof(mdBlockId) * MD_CHUNK_VOLUME);
+		break;
+	}
+}
+
+void mdChunkEncode(struct MdChunk* pChunk, const mdBlockId* pBlocks)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+	MD_ASSERT(pBlocks != MD_NULL);
+
+	// Gathers the palette and the index of every block, the neighbor blocks are often of the same type.
+	struct MdChunkPaletteEntry palette[MD_CHUNK_MAX_PALETTE_SIZE];
+	u8*						   pPaletteIndices = MD_MALLOC_ARRAY(u8, MD_CHUNK_VOLUME);
+	u32						   paletteCount	   = 0;
+	u32						   lastIndex	   = 0;
+	b8						   isDirect		   = MD_FALSE;
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+	{
+		if (paletteCount == 0 || palette[lastIndex].blockId != pBlocks[i])
+		{
+			lastIndex = 0;
+			while (lastIndex < paletteCount && palette[lastIndex].blockId != pBlocks[i])
+			{
+				++lastIndex;
+			}
+			if (lastIndex == MD_CHUNK_MAX_PALETTE_SIZE)
+			{
+				isDirect = MD_TRUE;
+				break;
+			}
+			if (lastIndex == paletteCount)
+			{
+				palette[paletteCount].blockId	  = pBlocks[i];
+				palette[paletteCount].blocksCount = 0;
+				++paletteCount;
+			}
+		}
+		++palette[lastIndex].blocksCount;
+		pPaletteIndices[i] = (u8)lastIndex;
+	}
+
+	freeStorage(pChunk);
+	if (isDirect)
+	{
+		pChunk->pIndices = allocateIndices(MD_CHUNK_MAX_BITS);
+		for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+		{
+			writeIndex(pChunk->pIndices, MD_CHUNK_MAX_BITS, i, pBlocks[i]);
+		}
+		pChunk->bitsPerIndex = MD_CHUNK_MAX_BITS;
+		pChunk->paletteCount = 0;
+	}
+	else
+	{
+		u32 bitsPerIndex = getBitsForPaletteCount(paletteCount);
+		pChunk->pIndices = allocateIndices(bitsPerIndex);
+		pChunk->pPalette = allocatePalette(bitsPerIndex);
+		mdMemoryCopy(pChunk->pPalette, palette, sizeof(struct MdChunkPaletteEntry) * paletteCount);
+		if (bitsPerIndex > 0)
+		{
+			for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+			{
+				writeIndex(pChunk->pIndices, bitsPerIndex, i, pPaletteIndices[i]);
+			}
+		}
+		pChunk->bitsPerIndex = bitsPerIndex;
+		pChunk->paletteCount = paletteCount;
+	}
+	MD_FREE_ARRAY(pPaletteIndices, u8, MD_CHUNK_VOLUME);
+}
+
+mdSize mdChunkGetMemorySize(const struct MdChunk* pChunk)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+	return sizeof(struct MdChunk) + sizeof(struct MdChunkPaletteEntry) * getPaletteCapacity(pChunk->bitsPerIndex) +
+		   sizeof(u64) * getWordsCount(pChunk->bitsPerIndex);
+}
+
+void mdChunkDestroy(struct MdChunk* pChunk)
+{
+	MD_ASSERT(pChunk != MD_NULL);
+	freeStorage(pChunk);
+	MD_FREE(pChunk, struct MdChunk);
+}
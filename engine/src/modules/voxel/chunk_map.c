@@ -0,0 +1,375 @@
+#include "MEEDEngine/modules/voxel/chunk_map.h"
+#include "MEEDEngine/platforms/memory.h"
+
+#define EMPTY_KEY		 (~0ull)			   ///< The packed coordinates never set the top bit.
+#define COORDINATE_MASK	 ((1ull << MD_CHUNK_MAP_COORDINATE_BITS) - 1)
+#define HASH_MULTIPLIER	 0x9E3779B97F4A7C15ull ///< 2^64 divided by the golden ratio, spreads the close coordinates.
+#define MIN_ENTRIES_LOG2 4u
+
+/**
+ * Offset by the smallest coordinate, a coordinate in the range fits in the packed bits.
+ */
+static b8 isInRange(i32 x, i32 y, i32 z)
+{
+	u32 minimum = (u32)MD_CHUNK_MAP_MIN_COORDINATE;
+	return (((u32)x - minimum) | ((u32)y - minimum) | ((u32)z - minimum)) < (1u << MD_CHUNK_MAP_COORDINATE_BITS);
+}
+
+static u64 packCoordinates(i32 x, i32 y, i32 z)
+{
+	return (((u64)(u32)x & COORDINATE_MASK) << (2 * MD_CHUNK_MAP_COORDINATE_BITS)) |
+		   (((u64)(u32)y & COORDINATE_MASK) << MD_CHUNK_MAP_COORDINATE_BITS) | ((u64)(u32)z & COORDINATE_MASK);
+}
+
+static u32 getHomeIndex(const struct MdChunkMap* pMap, u64 key)
+{
+	return (u32)((key * HASH_MULTIPLIER) >> pMap->hashShift);
+}
+
+/**
+ * @return The entry of the key, or `MD_CHUNK_MAP_NOT_FOUND_INDEX`.
+ */
+static u32 findEntry(const struct MdChunkMap* pMap, u64 key)
+{
+	u32 mask = pMap->entriesCapacity - 1;
+	for (u32 i = getHomeIndex(pMap, key);; i = (i + 1) & mask)
+	{
+		if (pMap->pEntries[i].key == key)
+		{
+			return i;
+		}
+		if (pMap->pEntries[i].key == EMPTY_KEY)
+		{
+			return MD_CHUNK_MAP_NOT_FOUND_INDEX;
+		}
+	}
+}
+
+/**
+ * Adds the entry of a key which is not in the table.
+ */
+static void addEntry(struct MdChunkMap* pMap, u64 key, u32 slotIndex)
+{
+	u32 mask = pMap->entriesCapacity - 1;
+	u32 i	 = getHomeIndex(pMap, key);
+	while (pMap->pEntries[i].key != EMPTY_KEY)
+	{
+		i = (i + 1) & mask;
+	}
+	pMap->pEntries[i].key		= key;
+	pMap->pEntries[i].slotIndex = slotIndex;
+}
+
+/**
+ * Removes an entry without tombstone: the entries after it in the probe sequence move back into the hole, unless
+ * their home is after the hole.
+ */
+static void removeEntry(struct MdChunkMap* pMap, u32 entryIndex)
+{
+	u32 mask = pMap->entriesCapacity - 1;
+	u32 hole = entryIndex;
+	for (u32 i = (entryIndex + 1) & mask; pMap->pEntries[i].key != EMPTY_KEY; i = (i + 1) & mask)
+	{
+		u32 homeIndex = getHomeIndex(pMap, pMap->pEntries[i].key);
+		if (((i - homeIndex) & mask) >= ((i - hole) & mask))
+		{
+			pMap->pEntries[hole] = pMap->pEntries[i];
+			hole				 = i;
+		}
+	}
+	pMap->pEntries[hole].key = EMPTY_KEY;
+}
+
+/**
+ * Allocates an empty table of at least twice the given number of chunks, then adds the loaded chunks.
+ */
+static void resizeEntries(struct MdChunkMap* pMap, u32 chunksCount)
+{
+	if (pMap->pEntries != MD_NULL)
+	{
+		MD_FREE_ARRAY(pMap->pEntries, struct MdChunkMapEntry, pMap->entriesCapacity);
+	}
+
+	u32 log2 = MIN_ENTRIES_LOG2;
+	while ((1u << log2) < chunksCount * 2)
+	{
+		++log2;
+	}
+	pMap->entriesCapacity = 1u << log2;
+	pMap->hashShift		  = 64 - log2;
+	pMap->pEntries		  = MD_MALLOC_ARRAY(struct MdChunkMapEntry, pMap->entriesCapacity);
+	mdMemorySet(pMap->pEntries, 0xFF, sizeof(struct MdChunkMapEntry) * pMap->entriesCapacity);
+
+	for (u32 i = 0; i < pMap->count; ++i)
+	{
+		const struct MdChunkMapSlot* pSlot = &pMap->pSlots[i];
+		addEntry(pMap, packCoordinates(pSlot->x, pSlot->y, pSlot->z), i);
+	}
+}
+
+static void resizeSlots(struct MdChunkMap* pMap, u32 capacity)
+{
+	struct MdChunkMapSlot* pSlots = MD_MALLOC_ARRAY(struct MdChunkMapSlot, capacity);
+	if (pMap->pSlots != MD_NULL)
+	{
+		mdMemoryCopy(pSlots, pMap->pSlots, sizeof(struct MdChunkMapSlot) * pMap->count);
+		MD_FREE_ARRAY(pMap->pSlots, struct MdChunkMapSlot, pMap->capacity);
+	}
+	pMap->pSlots   = pSlots;
+	pMap->capacity = capacity;
+}
+
+struct MdChunkMap* mdChunkMapCreate(u32 initialCapacity, MdNodeDataDeleteCallback pDeleteCallback)
+{
+	struct MdChunkMap* pMap = MD_MALLOC(struct MdChunkMap);
+	MD_ASSERT(pMap != MD_NULL);
+
+	if (initialCapacity == 0)
+	{
+		initialCapacity = MD_DEFAULT_CHUNK_MAP_CAPACITY;
+	}
+
+	pMap->count			  = 0;
+	pMap->capacity		  = 0;
+	pMap->pSlots		  = MD_NULL;
+	pMap->pEntries		  = MD_NULL;
+	pMap->pDeleteCallback = pDeleteCallback;
+	resizeSlots(pMap, initialCapacity);
+	resizeEntries(pMap, initialCapacity);
+
+	return pMap;
+}
+
+u32 mdChunkMapCount(struct MdChunkMap* pMap)
+{
+	MD_ASSERT(pMap != MD_NULL);
+	return pMap->count;
+}
+
+u32 mdChunkMapInsert(struct MdChunkMap* pMap, i32 x, i32 y, i32 z, void* pData)
+{
+	MD_ASSERT(pMap != MD_NULL);
+	MD_ASSERT(isInRange(x, y, z));
+
+	u64 key		   = packCoordinates(x, y, z);
+	u32 entryIndex = findEntry(pMap, key);
+	if (entryIndex != MD_CHUNK_MAP_NOT_FOUND_INDEX)
+	{
+		struct MdChunkMapSlot* pSlot = &pMap->pSlots[pMap->pEntries[entryIndex].slotIndex];
+		if (pMap->pDeleteCallback != MD_NULL && pSlot->pData != pData)
+		{
+			pMap->pDeleteCallback(pSlot->pData);
+		}
+		pSlot->pData = pData;
+		return pMap->pEntries[entryIndex].slotIndex;
+	}
+
+	if (pMap->count == pMap->capacity)
+	{
+		resizeSlots(pMap, pMap->capacity * 2);
+	}
+	if (pMap->count * 2 >= pMap->entriesCapacity)
+	{
+		resizeEntries(pMap, pMap->count + 1);
+	}
+
+	u32					   slotIndex = pMap->count++;
+	struct MdChunkMapSlot* pSlot	 = &pMap->pSlots[slotIndex];
+	pSlot->x						 = x;
+	pSlot->y						 = y;
+	pSlot->z						 = z;
+	pSlot->pData					 = pData;
+	addEntry(pMap, key, slotIndex);
+
+	u32 neighborIndex = 0;
+	for (i32 dx = -1; dx <= 1; ++dx)
+	{
+		for (i32 dy = -1; dy <= 1; ++dy)
+		{
+			for (i32 dz = -1; dz <= 1; ++dz)
+			{
+				if (dx == 0 && dy == 0 && dz == 0)
+				{
+					continue;
+				}
+
+				u32 neighborSlot = mdChunkMapFind(pMap, x + dx, y + dy, z + dz);
+				if (neighborSlot != MD_CHUNK_MAP_NOT_FOUND_INDEX)
+				{
+					pMap->pSlots[neighborSlot].neighborSlots[MD_CHUNK_MAP_NEIGHBORS_COUNT - 1 - neighborIndex] =
+						slotIndex;
+				}
+				pSlot->neighborSlots[neighborIndex++] = neighborSlot;
+			}
+		}
+	}
+
+	return slotIndex;
+}
+
+b8 mdChunkMapRemove(struct MdChunkMap* pMap, i32 x, i32 y, i32 z)
+{
+	MD_ASSERT(pMap != MD_NULL);
+
+	u32 entryIndex = isInRange(x, y, z) ? findEntry(pMap, packCoordinates(x, y, z)) : MD_CHUNK_MAP_NOT_FOUND_INDEX;
+	if (entryIndex == MD_CHUNK_MAP_NOT_FOUND_INDEX)
+	{
+		return MD_FALSE;
+	}
+
+	u32					   slotIndex = pMap->pEntries[entryIndex].slotIndex;
+	struct MdChunkMapSlot* pSlot	 = &pMap->pSlots[slotIndex];
+	if (pMap->pDeleteCallback != MD_NULL)
+	{
+		pMap->pDeleteCallback(pSlot->pData);
+	}
+	for (u32 i = 0; i < MD_CHUNK_MAP_NEIGHBORS_COUNT; ++i)
+	{
+		if (pSlot->neighborSlots[i] != MD_CHUNK_MAP_NOT_FOUND_INDEX)
+		{
+			pMap->pSlots[pSlot->neighborSlots[i]].neighborSlots[MD_CHUNK_MAP_NEIGHBORS_COUNT - 1 - i] =
+				MD_CHUNK_MAP_NOT_FOUND_INDEX;
+		}
+	}
+	removeEntry(pMap, entryIndex);
+
+	// The last slot fills the hole: its entry and its neighbors follow it.
+	u32 lastIndex = --pMap->count;
+	if (slotIndex != lastIndex)
+	{
+		*pSlot = pMap->pSlots[lastIndex];
+		pMap->pEntries[findEntry(pMap, packCoordinates(pSlot->x, pSlot->y, pSlot->z))].slotIndex = slotIndex;
+		for (u32 i = 0; i < MD_CHUNK_MAP_NEIGHBORS_COUNT; ++i)
+		{
+			if (pSlot->neighborSlots[i] != MD_CHUNK_MAP_NOT_FOUND_INDEX)
+			{
+				pMap->pSlots[pSlot->neighborSlots[i]].neighborSlots[MD_CHUNK_MAP_NEIGHBORS_COUNT - 1 - i] = slotIndex;
+			}
+		}
+	}
+
+	return MD_TRUE;
+}
+
+u32 mdChunkMapFind(const struct MdChunkMap* pMap, i32 x, i32 y, i32 z)
+{
+	MD_ASSERT(pMap != MD_NULL);
+
+	// The neighbors past the range of the coordinates are never loaded.
+	if (!isInRange(x, y, z))
+	{
+		return MD_CHUNK_MAP_NOT_FOUND_INDEX;
+	}
+
+	u32 entryIndex = findEntry(pMap, packCoordinates(x, y, z));
+	return entryIndex == MD_CHUNK_MAP_NOT_FOUND_INDEX ? MD_CHUNK_MAP_NOT_FOUND_INDEX
+													  : pMap->pEntries[entryIndex].slotIndex;
+}
+
+void* mdChunkMapGet(const struct MdChunkMap* pMap, i32 x, i32 y, i32 z)
+{
+	u32 slotIndex = mdChunkMapFind(pMap, x, y, z);
+	return slotIndex == MD_CHUNK_MAP_NOT_FOUND_INDEX ? MD_NULL : pMap->pSlots[slotIndex].pData;
+}
+
+struct MdChunkMapSlot* mdChunkMapAt(struct MdChunkMap* pMap, u32 slotIndex)
+{
+	MD_ASSERT(pMap != MD_NULL);
+
+	if (slotIndex >= pMap->count)
+	{
+		MD_THROW(MD_EXCEPTION_TYPE_OUT_OF_INDEX,
+				 "Index out of bounds: Attempted to access slot %u in a chunk map of %u chunks.",
+				 slotIndex,
+				 pMap->count);
+	}
+
+	return &pMap->pSlots[slotIndex];
+}
+
+void* mdChunkMapGetNeighbor(const struct MdChunkMap* pMap, u32 slotIndex, i32 dx, i32 dy, i32 dz)
+{
+	MD_ASSERT(pMap != MD_NULL);
+	MD_ASSERT(slotIndex < pMap->count);
+	MD_ASSERT(dx >= -1 && dx <= 1 && dy >= -1 && dy <= 1 && dz >= -1 && dz <= 1);
+	MD_ASSERT(dx != 0 || dy != 0 || dz != 0);
+
+	u32 neighborSlot = pMap->pSlots[slotIndex].neighborSlots[MD_CHUNK_MAP_NEIGHBOR_INDEX(dx, dy, dz)];
+	return neighborSlot == MD_CHUNK_MAP_NOT_FOUND_INDEX ? MD_NULL : pMap->pSlots[neighborSlot].pData;
+}
+
+u32 mdChunkMapQueryBox(const struct MdChunkMap* pMap,
+					   i32						minX,
+					   i32						minY,
+					   i32						minZ,
+					   i32						maxX,
+					   i32						maxY,
+					   i32						maxZ,
+					   u32*						pSlotIndices,
+					   u32						maxCount)
+{
+	MD_ASSERT(pMap != MD_NULL);
+	MD_ASSERT(pSlotIndices != MD_NULL || maxCount == 0);
+
+	if (minX > maxX || minY > maxY || minZ > maxZ)
+	{
+		return 0;
+	}
+
+	u32 foundCount = 0;
+	u64 boxVolume  = (u64)((i64)maxX - minX + 1) * (u64)((i64)maxY - minY + 1) * (u64)((i64)maxZ - minZ + 1);
+	if (boxVolume < pMap->count)
+	{
+		for (i32 x = minX; x <= maxX; ++x)
+		{
+			for (i32 y = minY; y <= maxY; ++y)
+			{
+				for (i32 z = minZ; z <= maxZ; ++z)
+				{
+					u32 slotIndex = mdChunkMapFind(pMap, x, y, z);
+					if (slotIndex != MD_CHUNK_MAP_NOT_FOUND_INDEX)
+					{
+						if (foundCount < maxCount)
+						{
+							pSlotIndices[foundCount] = slotIndex;
+						}
+						++foundCount;
+					}
+				}
+			}
+		}
+		return foundCount;
+	}
+
+	for (u32 i = 0; i < pMap->count; ++i)
+	{
+		const struct MdChunkMapSlot* pSlot = &pMap->pSlots[i];
+		if (pSlot->x >= minX && pSlot->x <= maxX && pSlot->y >= minY && pSlot->y <= maxY && pSlot->z >= minZ &&
+			pSlot->z <= maxZ)
+		{
+			if (foundCount < maxCount)
+			{
+				pSlotIndices[foundCount] = i;
+			}
+			++foundCount;
+		}
+	}
+	return foundCount;
+}
+
+void mdChunkMapDestroy(struct MdChunkMap* pMap)
+{
+	MD_ASSERT(pMap != MD_NULL);
+
+	if (pMap->pDeleteCallback != MD_NULL)
+	{
+		for (u32 i = 0; i < pMap->count; ++i)
+		{
+			pMap->pDeleteCallback(pMap->pSlots[i].pData);
+		}
+	}
+
+	MD_FREE_ARRAY(pMap->pEntries, struct MdChunkMapEntry, pMap->entriesCapacity);
+	MD_FREE_ARRAY(pMap->pSlots, struct MdChunkMapSlot, pMap->capacity);
+	MD_FREE(pMap, struct MdChunkMap);
+}
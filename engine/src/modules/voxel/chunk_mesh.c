@@ -0,0 +1,271 @@
+#include "MEEDEngine/modules/voxel/chunk_mesh.h"
+#include "MEEDEngine/platforms/memory.h"
+
+#define INITIAL_VERTICES_CAPACITY (1024u * MD_CHUNK_MESH_VERTICES_PER_QUAD)
+
+/**
+ * The visible faces of a slice of the chunk: the block type of each face, empty without face, and a bit per face by
+ * row so the merging skips the runs without face.
+ */
+struct SliceMask
+{
+	mdBlockId blockIds[MD_CHUNK_SIZE * MD_CHUNK_SIZE]; ///< By `MD_CHUNK_FACE_BLOCK_INDEX(u, v)`.
+	u32		  rows[MD_CHUNK_SIZE];					   ///< The bit u of the row v is set for a visible face.
+};
+
+/**
+ * The axes of the faces of a side: the normal axis d, then u and v the next axes in cyclic order, so that u cross v
+ * points along +d.
+ */
+struct SliceAxes
+{
+	u32 normal;
+	u32 u;
+	u32 v;
+};
+
+static const u32 s_axisStrides[3] = {1, MD_CHUNK_SIZE * MD_CHUNK_SIZE, MD_CHUNK_SIZE}; ///< x, y, z.
+
+static struct SliceAxes getSliceAxes(enum MdChunkFace face)
+{
+	struct SliceAxes axes;
+	axes.normal = (u32)face / 2;
+	axes.u		= (axes.normal + 1) % 3;
+	axes.v		= (axes.normal + 2) % 3;
+	return axes;
+}
+
+static b8 isPositive(enum MdChunkFace face)
+{
+	return ((u32)face & 1) != 0;
+}
+
+/**
+ * The layers of the sides index their blocks by the two other axes in the order x, y, z, which is the cyclic order
+ * but along y.
+ */
+static u32 getFaceBlockIndex(const struct SliceAxes* pAxes, u32 u, u32 v)
+{
+	return pAxes->u < pAxes->v ? MD_CHUNK_FACE_BLOCK_INDEX(u, v) : MD_CHUNK_FACE_BLOCK_INDEX(v, u);
+}
+
+static void buildSliceMask(const mdBlockId*  pBlocks,
+						   const mdBlockId*  pNeighborFace,
+						   enum MdChunkFace  face,
+						   u32				 slice,
+						   struct SliceMask* pMask)
+{
+	struct SliceAxes axes			 = getSliceAxes(face);
+	b8				 isLastSlice	 = isPositive(face) ? slice == MD_CHUNK_SIZE - 1 : slice == 0;
+	i32				 normalStride	 = (i32)s_axisStrides[axes.normal];
+	i32				 neighborOffset	 = isPositive(face) ? normalStride : -normalStride;
+	u32				 sliceBlockIndex = slice * s_axisStrides[axes.normal];
+
+	for (u32 v = 0; v < MD_CHUNK_SIZE; ++v)
+	{
+		u32 row = 0;
+		for (u32 u = 0; u < MD_CHUNK_SIZE; ++u)
+		{
+			u32		  blockIndex = sliceBlockIndex + u * s_axisStrides[axes.u] + v * s_axisStrides[axes.v];
+			mdBlockId blockId	 = pBlocks[blockIndex];
+			mdBlockId neighborId = MD_BLOCK_ID_EMPTY;
+			if (!isLastSlice)
+			{
+				neighborId = pBlocks[(i32)blockIndex + neighborOffset];
+			}
+			else if (pNeighborFace != MD_NULL)
+			{
+				neighborId = pNeighborFace[getFaceBlockIndex(&axes, u, v)];
+			}
+
+			b8 isVisible = blockId != MD_BLOCK_ID_EMPTY && neighborId == MD_BLOCK_ID_EMPTY;
+			pMask->blockIds[MD_CHUNK_FACE_BLOCK_INDEX(u, v)] = isVisible ? blockId : (mdBlockId)MD_BLOCK_ID_EMPTY;
+			row |= (u32)isVisible << u;
+		}
+		pMask->rows[v] = row;
+	}
+}
+
+static void reserveVertices(struct MdChunkMesh* pMesh, u32 verticesCount)
+{
+	if (verticesCount <= pMesh->verticesCapacity)
+	{
+		return;
+	}
+
+	u32 capacity = pMesh->verticesCapacity == 0 ? INITIAL_VERTICES_CAPACITY : pMesh->verticesCapacity;
+	while (capacity < verticesCount)
+	{
+		capacity *= 2;
+	}
+
+	struct MdChunkMeshVertex* pVertices = MD_MALLOC_ARRAY(struct MdChunkMeshVertex, capacity);
+	if (pMesh->pVertices != MD_NULL)
+	{
+		mdMemoryCopy(pVertices, pMesh->pVertices, sizeof(struct MdChunkMeshVertex) * pMesh->verticesCount);
+		MD_FREE_ARRAY(pMesh->pVertices, struct MdChunkMeshVertex, pMesh->verticesCapacity);
+	}
+	pMesh->pVertices		= pVertices;
+	pMesh->verticesCapacity = capacity;
+}
+
+/**
+ * Adds the two triangles of the rectangle of faces [u, u + width) x [v, v + height) of a slice.
+ */
+static void addQuad(struct MdChunkMesh* pMesh,
+					enum MdChunkFace	face,
+					u32					slice,
+					u32					u,
+					u32					v,
+					u32					width,
+					u32					height,
+					mdBlockId			blockId,
+					u32					textureId)
+{
+	struct SliceAxes axes  = getSliceAxes(face);
+	f32				 plane = (f32)(slice + (isPositive(face) ? 1 : 0));
+
+	// The corners counter-clockwise around +normal, the triangles are reversed for a face along -normal.
+	const u32  cornerU[4]  = {u, u + width, u + width, u};
+	const u32  cornerV[4]  = {v, v, v + height, v + height};
+	const u32  positive[6] = {0, 1, 2, 0, 2, 3};
+	const u32  negative[6] = {0, 2, 1, 0, 3, 2};
+	const u32* pCorners	   = isPositive(face) ? positive : negative;
+
+	reserveVertices(pMesh, pMesh->verticesCount + MD_CHUNK_MESH_VERTICES_PER_QUAD);
+	struct MdChunkMeshVertex* pVertex = &pMesh->pVertices[pMesh->verticesCount];
+	for (u32 i = 0; i < MD_CHUNK_MESH_VERTICES_PER_QUAD; ++i, ++pVertex)
+	{
+		u32 corner					   = pCorners[i];
+		pVertex->position[axes.normal] = plane;
+		pVertex->position[axes.u]	   = (f32)cornerU[corner];
+		pVertex->position[axes.v]	   = (f32)cornerV[corner];
+		pVertex->uv[0]				   = (f32)(cornerU[corner] - u);
+		pVertex->uv[1]				   = (f32)(cornerV[corner] - v);
+		pVertex->blockId			   = blockId;
+		pVertex->textureId			   = textureId;
+		pVertex->face				   = (u32)face;
+	}
+
+	pMesh->verticesCount += MD_CHUNK_MESH_VERTICES_PER_QUAD;
+	++pMesh->quadsCount;
+}
+
+/**
+ * Merges the faces of a slice into rectangles: a run of faces of the same block type along u, extended along v while
+ * the next row holds the same run.
+ */
+static void mergeSlice(struct MdChunkMesh*		  pMesh,
+					   struct SliceMask*		  pMask,
+					   enum MdChunkFace			  face,
+					   u32						  slice,
+					   MdChunkMeshTextureFunction textureFunction,
+					   void*					  pUserData)
+{
+	for (u32 v = 0; v < MD_CHUNK_SIZE; ++v)
+	{
+		while (pMask->rows[v] != 0)
+		{
+			u32		  u		  = (u32)__builtin_ctz(pMask->rows[v]);
+			mdBlockId blockId = pMask->blockIds[MD_CHUNK_FACE_BLOCK_INDEX(u, v)];
+
+			u32 width = 1;
+			while (u + width < MD_CHUNK_SIZE && (pMask->rows[v] >> (u + width) & 1) != 0 &&
+				   pMask->blockIds[MD_CHUNK_FACE_BLOCK_INDEX(u + width, v)] == blockId)
+			{
+				++width;
+			}
+			u32 runBits = (width == 32 ? ~0u : (1u << width) - 1) << u;
+
+			u32 height = 1;
+			while (v + height < MD_CHUNK_SIZE && (pMask->rows[v + height] & runBits) == runBits)
+			{
+				u32 i = 0;
+				while (i < width && pMask->blockIds[MD_CHUNK_FACE_BLOCK_INDEX(u + i, v + height)] == blockId)
+				{
+					++i;
+				}
+				if (i < width)
+				{
+					break;
+				}
+				++height;
+			}
+
+			for (u32 row = v; row < v + height; ++row)
+			{
+				pMask->rows[row] &= ~runBits;
+			}
+
+			u32 textureId = textureFunction != MD_NULL ? textureFunction(blockId, face, pUserData) : blockId;
+			addQuad(pMesh, face, slice, u, v, width, height, blockId, textureId);
+		}
+	}
+}
+
+struct MdChunkMesh* mdChunkMeshCreate()
+{
+	struct MdChunkMesh* pMesh = MD_MALLOC(struct MdChunkMesh);
+	MD_ASSERT(pMesh != MD_NULL);
+	mdMemorySet(pMesh, 0, sizeof(struct MdChunkMesh));
+	return pMesh;
+}
+
+void mdChunkMeshBuild(struct MdChunkMesh*		 pMesh,
+					  const mdBlockId*			 pBlocks,
+					  const mdBlockId* const	 pNeighborFaces[MD_CHUNK_FACE_COUNT],
+					  MdChunkMeshTextureFunction textureFunction,
+					  void*						 pUserData)
+{
+	MD_ASSERT(pMesh != MD_NULL);
+	MD_ASSERT(pBlocks != MD_NULL && pNeighborFaces != MD_NULL);
+
+	mdTicks startTicks	 = mdGetTicks();
+	pMesh->verticesCount = 0;
+	pMesh->quadsCount	 = 0;
+
+	struct SliceMask mask;
+	for (u32 face = 0; face < MD_CHUNK_FACE_COUNT; ++face)
+	{
+		for (u32 slice = 0; slice < MD_CHUNK_SIZE; ++slice)
+		{
+			buildSliceMask(pBlocks, pNeighborFaces[face], (enum MdChunkFace)face, slice, &mask);
+			mergeSlice(pMesh, &mask, (enum MdChunkFace)face, slice, textureFunction, pUserData);
+		}
+	}
+
+	pMesh->buildTicks = mdGetTicks() - startTicks;
+}
+
+void mdChunkMeshExtractFace(const mdBlockId* pBlocks, enum MdChunkFace face, mdBlockId* pFace)
+{
+	MD_ASSERT(pBlocks != MD_NULL && pFace != MD_NULL);
+	MD_ASSERT(face < MD_CHUNK_FACE_COUNT);
+
+	struct SliceAxes axes			 = getSliceAxes(face);
+	u32				 sliceBlockIndex = (isPositive(face) ? MD_CHUNK_SIZE - 1 : 0) * s_axisStrides[axes.normal];
+	for (u32 v = 0; v < MD_CHUNK_SIZE; ++v)
+	{
+		for (u32 u = 0; u < MD_CHUNK_SIZE; ++u)
+		{
+			pFace[getFaceBlockIndex(&axes, u, v)] =
+				pBlocks[sliceBlockIndex + u * s_axisStrides[axes.u] + v * s_axisStrides[axes.v]];
+		}
+	}
+}
+
+void mdChunkMeshWriteVertex(u8* pDest, const void* pSrc)
+{
+	mdMemoryCopy(pDest, pSrc, sizeof(struct MdChunkMeshVertex));
+}
+
+void mdChunkMeshDestroy(struct MdChunkMesh* pMesh)
+{
+	MD_ASSERT(pMesh != MD_NULL);
+
+	if (pMesh->pVertices != MD_NULL)
+	{
+		MD_FREE_ARRAY(pMesh->pVertices, struct MdChunkMeshVertex, pMesh->verticesCapacity);
+	}
+	MD_FREE(pMesh, struct MdChunkMesh);
+}
@@ -9,6 +9,7 @@
 #endif
 
 #include "MEEDEngine/platforms/console.h"
+#include "MEEDEngine/platforms/thread.h"
 
 static const char* ansi[] = {
 	[MD_CONSOLE_COLOR_RESET]   = "\033[0m",
@@ -35,6 +36,11 @@ void mdFormatString(char* buffer, mdSize length, const char* format, ...)
 	va_end(args);
 }
 
+i32 mdFormatStringArgs(char* buffer, mdSize length, const char* format, va_list args)
+{
+	return vsnprintf(buffer, length, format, args);
+}
+
 void mdFormatPrint(const char* format, ...)
 {
 	va_list args;
@@ -59,7 +65,7 @@ void mdPrintTrace(struct MdTraceInfo* pTraceInfo)
 		mdMemorySet(pPrintTraceInfo, 0, sizeof(struct MdTraceInfo));
 
 		pPrintTraceInfo->framesCount = backtrace(pPrintTraceInfo->frames, MD_MAX_TRACE_FRAMES);
-		pPrintTraceInfo->threadId	 = getpid();
+		pPrintTraceInfo->threadId	 = mdThreadGetCurrentId();
 	}
 
 	MD_ASSERT(pPrintTraceInfo->framesCount > 0);
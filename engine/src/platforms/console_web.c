@@ -26,6 +26,11 @@ void mdFormatString(char* buffer, mdSize length, const char* format, ...)
 	va_end(args);
 }
 
+i32 mdFormatStringArgs(char* buffer, mdSize length, const char* format, va_list args)
+{
+	return vsnprintf(buffer, length, format, args);
+}
+
 void mdPrintTrace(struct MdTraceInfo* pTraceInfo)
 {
 #if MD_DEBUG
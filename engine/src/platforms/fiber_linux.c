@@ -0,0 +1,241 @@
+#if PLATFORM_IS_LINUX
+#include "MEEDEngine/platforms/fiber.h"
+#include "MEEDEngine/platforms/memory.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__aarch64__)
+#define FIBER_USE_ASSEMBLY 1
+#else
+#define FIBER_USE_ASSEMBLY 0
+#include <ucontext.h>
+#endif
+
+#if MD_DEBUG
+#define FIBER_GUARD_PAGES 1u
+#else
+#define FIBER_GUARD_PAGES 0u
+#endif
+
+struct MdFiber
+{
+#if FIBER_USE_ASSEMBLY
+	void* pStackPointer; ///< The top of the suspended context, the registers are saved on its stack.
+#else
+	ucontext_t context;
+#endif
+	void*			pMapping; ///< The stack with its guard page, MD_NULL for the fiber of a thread.
+	mdSize			mappingSize;
+	MdFiberFunction function;
+	void*			pArgument;
+};
+
+#if FIBER_USE_ASSEMBLY
+/**
+ * Saves the callee-saved registers on the current stack, stores the stack pointer in `*ppFromStackPointer`, then
+ * loads `pToStackPointer` and restores the registers saved there. Returns into the resumed context.
+ */
+void mdFiberSwitchContext(void** ppFromStackPointer, void* pToStackPointer);
+
+/**
+ * The first return address of a new fiber: calls its function with its argument, both placed in callee-saved
+ * registers by `mdFiberCreate`. The unwinders stop there, the return address register is marked undefined.
+ */
+void mdFiberEntry();
+
+#if defined(__x86_64__)
+// The System V callee-saved registers, and the SSE and x87 control words which the ABI also preserves.
+__asm__(".text\n"
+		".globl mdFiberSwitchContext\n"
+		".type mdFiberSwitchContext, @function\n"
+		"mdFiberSwitchContext:\n"
+		"	pushq %rbp\n"
+		"	pushq %rbx\n"
+		"	pushq %r12\n"
+		"	pushq %r13\n"
+		"	pushq %r14\n"
+		"	pushq %r15\n"
+		"	subq $8, %rsp\n"
+		"	stmxcsr (%rsp)\n"
+		"	fnstcw 4(%rsp)\n"
+		"	movq %rsp, (%rdi)\n"
+		"	movq %rsi, %rsp\n"
+		"	ldmxcsr (%rsp)\n"
+		"	fldcw 4(%rsp)\n"
+		"	addq $8, %rsp\n"
+		"	popq %r15\n"
+		"	popq %r14\n"
+		"	popq %r13\n"
+		"	popq %r12\n"
+		"	popq %rbx\n"
+		"	popq %rbp\n"
+		"	ret\n"
+		".size mdFiberSwitchContext, .-mdFiberSwitchContext\n"
+		".globl mdFiberEntry\n"
+		".type mdFiberEntry, @function\n"
+		"mdFiberEntry:\n"
+		"	.cfi_startproc\n"
+		"	.cfi_undefined rip\n"
+		"	movq %r13, %rdi\n"
+		"	callq *%r12\n"
+		"	ud2\n"
+		"	.cfi_endproc\n"
+		".size mdFiberEntry, .-mdFiberEntry\n");
+
+#define FIBER_SAVED_WORDS	7u						 ///< The control words, r15, r14, r13, r12, rbx and rbp.
+#define FIBER_FUNCTION_WORD	4u						 ///< r12.
+#define FIBER_ARGUMENT_WORD	3u						 ///< r13.
+#define FIBER_CONTROL_WORDS	0x0000037F00001F80ull	 ///< The default MXCSR, then the default x87 control word.
+#define FIBER_RETURN_WORD	FIBER_SAVED_WORDS
+#define FIBER_INITIAL_WORDS	(FIBER_SAVED_WORDS + 3u) ///< With the return address and the alignment padding.
+#elif defined(__aarch64__)
+// The AAPCS64 callee-saved registers: x19-x28, the frame pointer, the link register and the low halves of v8-v15.
+__asm__(".text\n"
+		".globl mdFiberSwitchContext\n"
+		".type mdFiberSwitchContext, %function\n"
+		"mdFiberSwitchContext:\n"
+		"	sub sp, sp, #160\n"
+		"	stp x19, x20, [sp, #0]\n"
+		"	stp x21, x22, [sp, #16]\n"
+		"	stp x23, x24, [sp, #32]\n"
+		"	stp x25, x26, [sp, #48]\n"
+		"	stp x27, x28, [sp, #64]\n"
+		"	stp x29, x30, [sp, #80]\n"
+		"	stp d8, d9, [sp, #96]\n"
+		"	stp d10, d11, [sp, #112]\n"
+		"	stp d12, d13, [sp, #128]\n"
+		"	stp d14, d15, [sp, #144]\n"
+		"	mov x2, sp\n"
+		"	str x2, [x0]\n"
+		"	mov sp, x1\n"
+		"	ldp x19, x20, [sp, #0]\n"
+		"	ldp x21, x22, [sp, #16]\n"
+		"	ldp x23, x24, [sp, #32]\n"
+		"	ldp x25, x26, [sp, #48]\n"
+		"	ldp x27, x28, [sp, #64]\n"
+		"	ldp x29, x30, [sp, #80]\n"
+		"	ldp d8, d9, [sp, #96]\n"
+		"	ldp d10, d11, [sp, #112]\n"
+		"	ldp d12, d13, [sp, #128]\n"
+		"	ldp d14, d15, [sp, #144]\n"
+		"	add sp, sp, #160\n"
+		"	ret\n"
+		".size mdFiberSwitchContext, .-mdFiberSwitchContext\n"
+		".globl mdFiberEntry\n"
+		".type mdFiberEntry, %function\n"
+		"mdFiberEntry:\n"
+		"	.cfi_startproc\n"
+		"	.cfi_undefined x30\n"
+		"	mov x0, x20\n"
+		"	blr x19\n"
+		"	brk #0\n"
+		"	.cfi_endproc\n"
+		".size mdFiberEntry, .-mdFiberEntry\n");
+
+#define FIBER_SAVED_WORDS	20u
+#define FIBER_FUNCTION_WORD	0u	///< x19.
+#define FIBER_ARGUMENT_WORD	1u	///< x20.
+#define FIBER_RETURN_WORD	11u	///< x30.
+#define FIBER_INITIAL_WORDS	FIBER_SAVED_WORDS
+#endif
+#else
+/**
+ * The `makecontext` functions only take `int` arguments: the fiber pointer is given in two halves.
+ */
+static void fiberEntry(u32 fiberHigh, u32 fiberLow)
+{
+	struct MdFiber* pFiber = (struct MdFiber*)(((mdSize)fiberHigh << 32) | (mdSize)fiberLow);
+	pFiber->function(pFiber->pArgument);
+	MD_UNTOUCHABLE(); // A fiber function never returns.
+}
+#endif
+
+struct MdFiber* mdFiberCreate(mdSize stackSize, MdFiberFunction function, void* pArgument)
+{
+	MD_ASSERT(function != MD_NULL);
+
+	mdSize pageSize = (mdSize)sysconf(_SC_PAGESIZE);
+	if (stackSize < MD_FIBER_MIN_STACK_SIZE)
+	{
+		stackSize = MD_FIBER_MIN_STACK_SIZE;
+	}
+	stackSize = (stackSize + pageSize - 1) / pageSize * pageSize;
+
+	// The stack grows down, the guard page is the lowest one.
+	mdSize mappingSize = stackSize + FIBER_GUARD_PAGES * pageSize;
+	void*  pMapping	   = mmap(MD_NULL, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (pMapping == MAP_FAILED)
+	{
+		return MD_NULL;
+	}
+	if (FIBER_GUARD_PAGES > 0 && mprotect(pMapping, FIBER_GUARD_PAGES * pageSize, PROT_NONE) != 0)
+	{
+		munmap(pMapping, mappingSize);
+		return MD_NULL;
+	}
+
+	struct MdFiber* pFiber = MD_MALLOC(struct MdFiber);
+	MD_ASSERT(pFiber != MD_NULL);
+	mdMemorySet(pFiber, 0, sizeof(struct MdFiber));
+	pFiber->pMapping	= pMapping;
+	pFiber->mappingSize = mappingSize;
+	pFiber->function	= function;
+	pFiber->pArgument	= pArgument != MD_NULL ? pArgument : pFiber;
+
+#if FIBER_USE_ASSEMBLY
+	// The initial frame is the one `mdFiberSwitchContext` restores: the registers hold the function and its
+	// argument, and it returns into `mdFiberEntry` with the stack aligned as at a function call.
+	u64* pStackTop = (u64*)((u8*)pMapping + mappingSize);
+	u64* pFrame	   = pStackTop - FIBER_INITIAL_WORDS;
+	mdMemorySet(pFrame, 0, FIBER_INITIAL_WORDS * sizeof(u64));
+	pFrame[FIBER_FUNCTION_WORD] = (u64)(mdSize)pFiber->function;
+	pFrame[FIBER_ARGUMENT_WORD] = (u64)(mdSize)pFiber->pArgument;
+	pFrame[FIBER_RETURN_WORD]	= (u64)(mdSize)mdFiberEntry;
+#if defined(__x86_64__)
+	pFrame[0] = FIBER_CONTROL_WORDS;
+#endif
+	pFiber->pStackPointer = pFrame;
+#else
+	getcontext(&pFiber->context);
+	pFiber->context.uc_stack.ss_sp	 = (u8*)pMapping + FIBER_GUARD_PAGES * pageSize;
+	pFiber->context.uc_stack.ss_size = stackSize;
+	pFiber->context.uc_link			 = MD_NULL;
+	makecontext(&pFiber->context, (void (*)())fiberEntry, 2, (u32)((mdSize)pFiber >> 32), (u32)(mdSize)pFiber);
+#endif
+
+	return pFiber;
+}
+
+struct MdFiber* mdFiberCreateFromThread()
+{
+	struct MdFiber* pFiber = MD_MALLOC(struct MdFiber);
+	MD_ASSERT(pFiber != MD_NULL);
+	mdMemorySet(pFiber, 0, sizeof(struct MdFiber));
+	return pFiber;
+}
+
+void mdFiberDestroy(struct MdFiber* pFiber)
+{
+	MD_ASSERT(pFiber != MD_NULL);
+
+	if (pFiber->pMapping != MD_NULL)
+	{
+		munmap(pFiber->pMapping, pFiber->mappingSize);
+	}
+	MD_FREE(pFiber, struct MdFiber);
+}
+
+void mdFiberSwitch(struct MdFiber* pFrom, struct MdFiber* pTo)
+{
+	MD_ASSERT(pFrom != MD_NULL);
+	MD_ASSERT(pTo != MD_NULL);
+	MD_ASSERT(pFrom != pTo);
+
+#if FIBER_USE_ASSEMBLY
+	mdFiberSwitchContext(&pFrom->pStackPointer, pTo->pStackPointer);
+#else
+	swapcontext(&pFrom->context, &pTo->context);
+#endif
+}
+
+#endif // PLATFORM_IS_LINUX
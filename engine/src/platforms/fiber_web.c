@@ -0,0 +1,35 @@
+#if PLATFORM_IS_WEB
+#include "MEEDEngine/platforms/fiber.h"
+
+/**
+ * No backend: the Emscripten fibers need the Asyncify transform of the whole module, which the build does not
+ * enable. The callers fall back to running on the thread stack.
+ */
+
+struct MdFiber* mdFiberCreate(mdSize stackSize, MdFiberFunction function, void* pArgument)
+{
+	MD_ASSERT(function != MD_NULL);
+	MD_UNUSED(stackSize);
+	MD_UNUSED(pArgument);
+	return MD_NULL;
+}
+
+struct MdFiber* mdFiberCreateFromThread()
+{
+	return MD_NULL;
+}
+
+void mdFiberDestroy(struct MdFiber* pFiber)
+{
+	MD_UNUSED(pFiber);
+	MD_UNTOUCHABLE(); // No fiber can be created.
+}
+
+void mdFiberSwitch(struct MdFiber* pFrom, struct MdFiber* pTo)
+{
+	MD_UNUSED(pFrom);
+	MD_UNUSED(pTo);
+	MD_UNTOUCHABLE(); // No fiber can be created.
+}
+
+#endif // PLATFORM_IS_WEB
@@ -0,0 +1,863 @@
+#if PLATFORM_IS_LINUX
+#include "MEEDEngine/platforms/file_async.h"
+#include "MEEDEngine/platforms/thread.h"
+#include "file_internal.h"
+#include <errno.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define MD_FILE_ASYNC_HAS_IO_URING 1
+#else
+#define MD_FILE_ASYNC_HAS_IO_URING 0
+#endif
+
+#define MD_FILE_ASYNC_IO_URING_PROBE_OPS 256
+
+enum AsyncRequestState
+{
+	ASYNC_REQUEST_STATE_WAITING,
+	ASYNC_REQUEST_STATE_EXECUTING,
+	ASYNC_REQUEST_STATE_FINISHED,
+};
+
+struct AsyncFileRequest
+{
+	struct MdFileRequestDesc desc;
+	struct MdFileCompletion	 completion;
+	enum AsyncRequestState	 state;
+	b8						 cancelRequested;
+
+	struct AsyncFileRequest* pPrev;
+	struct AsyncFileRequest* pNext;
+};
+
+/**
+ * Intrusive doubly linked list of requests, a request is inside exactly one list at any time.
+ */
+struct AsyncRequestList
+{
+	struct AsyncFileRequest* pHead;
+	struct AsyncFileRequest* pTail;
+	u32						 count;
+};
+
+#if MD_FILE_ASYNC_HAS_IO_URING
+/**
+ * The rings shared with the kernel, set up with the raw system calls.
+ */
+struct IoUring
+{
+	i32 fd;
+	u32 entries;
+
+	u32* pSqHead;
+	u32* pSqTail;
+	u32* pSqMask;
+	u32* pSqArray;
+	u32* pCqHead;
+	u32* pCqTail;
+	u32* pCqMask;
+
+	struct io_uring_sqe* pSqes;
+	struct io_uring_cqe* pCqes;
+
+	void*  pSqRing;
+	void*  pCqRing;
+	mdSize sqRingSize;
+	mdSize cqRingSize;
+	mdSize sqesSize;
+	u32	   pendingSubmissions; ///< The entries written to the submission ring but not yet passed to the kernel.
+};
+#endif
+
+struct AsyncFileData
+{
+	struct MdFileAsyncConfig config;
+	mdFileRequestId			 nextId;
+
+	struct MdMutex			   mutex;
+	struct MdConditionVariable workAvailable; ///< Wakes the workers when a request waits or when the queue stops.
+	struct MdConditionVariable requestFinished;
+
+	struct AsyncRequestList waiting[MD_FILE_REQUEST_PRIORITY_COUNT];
+	struct AsyncRequestList executing;
+	struct AsyncRequestList finished;
+
+	b8 useIoUring;
+#if MD_FILE_ASYNC_HAS_IO_URING
+	struct IoUring ring;
+#endif
+
+	struct MdThread** ppWorkers;
+	b8				  isStopping;
+};
+
+static struct AsyncFileData* s_pAsyncFileData = MD_NULL;
+
+static void listPushBack(struct AsyncRequestList* pList, struct AsyncFileRequest* pRequest)
+{
+	pRequest->pPrev = pList->pTail;
+	pRequest->pNext = MD_NULL;
+	if (pList->pTail != MD_NULL)
+	{
+		pList->pTail->pNext = pRequest;
+	}
+	else
+	{
+		pList->pHead = pRequest;
+	}
+	pList->pTail = pRequest;
+	pList->count++;
+}
+
+static void listPushFront(struct AsyncRequestList* pList, struct AsyncFileRequest* pRequest)
+{
+	pRequest->pPrev = MD_NULL;
+	pRequest->pNext = pList->pHead;
+	if (pList->pHead != MD_NULL)
+	{
+		pList->pHead->pPrev = pRequest;
+	}
+	else
+	{
+		pList->pTail = pRequest;
+	}
+	pList->pHead = pRequest;
+	pList->count++;
+}
+
+static void listRemove(struct AsyncRequestList* pList, struct AsyncFileRequest* pRequest)
+{
+	if (pRequest->pPrev != MD_NULL)
+	{
+		pRequest->pPrev->pNext = pRequest->pNext;
+	}
+	else
+	{
+		pList->pHead = pRequest->pNext;
+	}
+
+	if (pRequest->pNext != MD_NULL)
+	{
+		pRequest->pNext->pPrev = pRequest->pPrev;
+	}
+	else
+	{
+		pList->pTail = pRequest->pPrev;
+	}
+
+	pRequest->pPrev = MD_NULL;
+	pRequest->pNext = MD_NULL;
+	pList->count--;
+}
+
+static struct AsyncFileRequest* findRequest(struct AsyncRequestList* pList, mdFileRequestId id)
+{
+	for (struct AsyncFileRequest* pRequest = pList->pHead; pRequest != MD_NULL; pRequest = pRequest->pNext)
+	{
+		if (pRequest->completion.id == id)
+		{
+			return pRequest;
+		}
+	}
+	return MD_NULL;
+}
+
+/**
+ * Must be called with the mutex locked.
+ */
+static struct AsyncFileRequest* popWaitingRequest()
+{
+	for (u32 priority = 0; priority < MD_FILE_REQUEST_PRIORITY_COUNT; ++priority)
+	{
+		struct AsyncRequestList* pList = &s_pAsyncFileData->waiting[priority];
+		if (pList->pHead != MD_NULL)
+		{
+			struct AsyncFileRequest* pRequest = pList->pHead;
+			listRemove(pList, pRequest);
+			return pRequest;
+		}
+	}
+	return MD_NULL;
+}
+
+static u32 getWaitingCount()
+{
+	u32 count = 0;
+	for (u32 priority = 0; priority < MD_FILE_REQUEST_PRIORITY_COUNT; ++priority)
+	{
+		count += s_pAsyncFileData->waiting[priority].count;
+	}
+	return count;
+}
+
+/**
+ * Moves an executing request to the finished list. Must be called with the mutex locked.
+ */
+static void finishRequest(struct AsyncFileRequest* pRequest, enum MdFileRequestStatus status, i32 error)
+{
+	if (pRequest->state == ASYNC_REQUEST_STATE_EXECUTING)
+	{
+		listRemove(&s_pAsyncFileData->executing, pRequest);
+	}
+
+	pRequest->completion.status = pRequest->cancelRequested ? MD_FILE_REQUEST_STATUS_CANCELLED : status;
+	pRequest->completion.error	= error;
+	pRequest->state				= ASYNC_REQUEST_STATE_FINISHED;
+	listPushBack(&s_pAsyncFileData->finished, pRequest);
+
+	mdConditionVariableBroadcast(&s_pAsyncFileData->requestFinished);
+}
+
+static i32 getNativeFile(const struct AsyncFileRequest* pRequest)
+{
+	return ((struct LinuxFileData*)pRequest->desc.pFile->pInternal)->fd;
+}
+
+// ============================================== Worker pool ==============================================
+
+/**
+ * Executes the whole request on the calling worker, the short transfers are continued until the end of the file.
+ */
+static void executeBlocking(struct AsyncFileRequest* pRequest, i32* pError)
+{
+	i32	 fd		 = getNativeFile(pRequest);
+	u8*	 pBuffer = (u8*)pRequest->desc.pBuffer;
+	u64* pDone	 = &pRequest->completion.bytesTransferred;
+
+	*pError = 0;
+	while (*pDone < pRequest->desc.size && !MD_ATOMIC_LOAD(&pRequest->cancelRequested, MD_MEMORY_ORDER_RELAXED))
+	{
+		size_t	remaining = (size_t)(pRequest->desc.size - *pDone);
+		off_t	position  = (off_t)(pRequest->desc.offset + *pDone);
+		ssize_t result	  = pRequest->desc.type == MD_FILE_REQUEST_TYPE_READ
+								? pread(fd, pBuffer + *pDone, remaining, position)
+								: pwrite(fd, pBuffer + *pDone, remaining, position);
+
+		if (result < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (result < 0)
+		{
+			*pError = errno;
+			return;
+		}
+		if (result == 0)
+		{
+			return; // End of the file.
+		}
+		*pDone += (u64)result;
+	}
+}
+
+static void workerMain(void* pArgument)
+{
+	MD_UNUSED(pArgument);
+
+	mdMutexLock(&s_pAsyncFileData->mutex);
+	while (MD_TRUE)
+	{
+		struct AsyncFileRequest* pRequest = popWaitingRequest();
+		if (pRequest == MD_NULL)
+		{
+			if (s_pAsyncFileData->isStopping)
+			{
+				break;
+			}
+			mdConditionVariableWait(&s_pAsyncFileData->workAvailable, &s_pAsyncFileData->mutex);
+			continue;
+		}
+
+		pRequest->state = ASYNC_REQUEST_STATE_EXECUTING;
+		listPushBack(&s_pAsyncFileData->executing, pRequest);
+		mdMutexUnlock(&s_pAsyncFileData->mutex);
+
+		i32 error = 0;
+		executeBlocking(pRequest, &error);
+
+		mdMutexLock(&s_pAsyncFileData->mutex);
+		finishRequest(pRequest, error == 0 ? MD_FILE_REQUEST_STATUS_COMPLETED : MD_FILE_REQUEST_STATUS_FAILED, error);
+	}
+	mdMutexUnlock(&s_pAsyncFileData->mutex);
+}
+
+static void startWorkers()
+{
+	if (s_pAsyncFileData->config.workerThreadsCount == 0)
+	{
+		s_pAsyncFileData->config.workerThreadsCount = 1;
+	}
+
+	u32 workersCount		   = s_pAsyncFileData->config.workerThreadsCount;
+	s_pAsyncFileData->ppWorkers = MD_MALLOC_ARRAY(struct MdThread*, workersCount);
+
+	for (u32 i = 0; i < workersCount; ++i)
+	{
+		char name[MD_THREAD_NAME_MAX_LENGTH + 1];
+		mdFormatString(name, sizeof(name), "MEEDFileIO%u", i);
+		s_pAsyncFileData->ppWorkers[i] = mdThreadCreate(workerMain, MD_NULL, name);
+		MD_ASSERT_MSG(s_pAsyncFileData->ppWorkers[i] != MD_NULL, "Failed to create the file worker thread %u.", i);
+	}
+}
+
+static void stopWorkers()
+{
+	mdMutexLock(&s_pAsyncFileData->mutex);
+	s_pAsyncFileData->isStopping = MD_TRUE;
+	mdConditionVariableBroadcast(&s_pAsyncFileData->workAvailable);
+	mdMutexUnlock(&s_pAsyncFileData->mutex);
+
+	for (u32 i = 0; i < s_pAsyncFileData->config.workerThreadsCount; ++i)
+	{
+		mdThreadJoin(s_pAsyncFileData->ppWorkers[i]);
+	}
+
+	MD_FREE_ARRAY(s_pAsyncFileData->ppWorkers, struct MdThread*, s_pAsyncFileData->config.workerThreadsCount);
+	s_pAsyncFileData->ppWorkers = MD_NULL;
+}
+
+// ================================================ io_uring ================================================
+
+#if MD_FILE_ASYNC_HAS_IO_URING
+static b8 isIoUringOperationSupported(const struct io_uring_probe* pProbe, u32 operation)
+{
+	return operation < pProbe->ops_len && (pProbe->ops[operation].flags & IO_URING_OP_SUPPORTED) != 0;
+}
+
+/**
+ * Creates the rings, fails when the kernel is too old, when io_uring is disabled (`kernel.io_uring_disabled`,
+ * seccomp filters of containers) or when an operation used by the queue is missing.
+ */
+static b8 setupIoUring(struct IoUring* pRing, u32 entries)
+{
+	mdMemorySet(pRing, 0, sizeof(struct IoUring));
+
+	struct io_uring_params params;
+	mdMemorySet(&params, 0, sizeof(struct io_uring_params));
+
+	pRing->fd = (i32)syscall(__NR_io_uring_setup, entries, &params);
+	if (pRing->fd < 0)
+	{
+		return MD_FALSE;
+	}
+
+	u32	   opsCount	 = MD_FILE_ASYNC_IO_URING_PROBE_OPS;
+	mdSize probeSize = sizeof(struct io_uring_probe) + opsCount * sizeof(struct io_uring_probe_op);
+
+	struct io_uring_probe* pProbe = (struct io_uring_probe*)MD_MALLOC_ARRAY(u8, probeSize);
+	mdMemorySet(pProbe, 0, probeSize);
+
+	b8 isSupported = syscall(__NR_io_uring_register, pRing->fd, IORING_REGISTER_PROBE, pProbe, opsCount) == 0 &&
+					 isIoUringOperationSupported(pProbe, IORING_OP_READ) &&
+					 isIoUringOperationSupported(pProbe, IORING_OP_WRITE) &&
+					 isIoUringOperationSupported(pProbe, IORING_OP_ASYNC_CANCEL);
+	MD_FREE_ARRAY(pProbe, u8, probeSize);
+
+	if (!isSupported)
+	{
+		close(pRing->fd);
+		return MD_FALSE;
+	}
+
+	pRing->entries	  = params.sq_entries;
+	pRing->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(u32);
+	pRing->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	pRing->sqesSize	  = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	b8 isSingleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (isSingleMapping)
+	{
+		pRing->sqRingSize = pRing->cqRingSize > pRing->sqRingSize ? pRing->cqRingSize : pRing->sqRingSize;
+		pRing->cqRingSize = pRing->sqRingSize;
+	}
+
+	pRing->pSqRing = mmap(MD_NULL,
+						  pRing->sqRingSize,
+						  PROT_READ | PROT_WRITE,
+						  MAP_SHARED | MAP_POPULATE,
+						  pRing->fd,
+						  IORING_OFF_SQ_RING);
+	pRing->pCqRing = isSingleMapping ? pRing->pSqRing
+									 : mmap(MD_NULL,
+											pRing->cqRingSize,
+											PROT_READ | PROT_WRITE,
+											MAP_SHARED | MAP_POPULATE,
+											pRing->fd,
+											IORING_OFF_CQ_RING);
+	pRing->pSqes   = (struct io_uring_sqe*)mmap(
+		  MD_NULL, pRing->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pRing->fd, IORING_OFF_SQES);
+
+	if (pRing->pSqRing == MAP_FAILED || pRing->pCqRing == MAP_FAILED || (void*)pRing->pSqes == MAP_FAILED)
+	{
+		MD_ASSERT_MSG(MD_FALSE, "Failed to map the io_uring rings.");
+		close(pRing->fd);
+		return MD_FALSE;
+	}
+
+	u8* pSq			= (u8*)pRing->pSqRing;
+	u8* pCq			= (u8*)pRing->pCqRing;
+	pRing->pSqHead	= (u32*)(pSq + params.sq_off.head);
+	pRing->pSqTail	= (u32*)(pSq + params.sq_off.tail);
+	pRing->pSqMask	= (u32*)(pSq + params.sq_off.ring_mask);
+	pRing->pSqArray = (u32*)(pSq + params.sq_off.array);
+	pRing->pCqHead	= (u32*)(pCq + params.cq_off.head);
+	pRing->pCqTail	= (u32*)(pCq + params.cq_off.tail);
+	pRing->pCqMask	= (u32*)(pCq + params.cq_off.ring_mask);
+	pRing->pCqes	= (struct io_uring_cqe*)(pCq + params.cq_off.cqes);
+
+	return MD_TRUE;
+}
+
+static void destroyIoUring(struct IoUring* pRing)
+{
+	munmap(pRing->pSqes, pRing->sqesSize);
+	if (pRing->pCqRing != pRing->pSqRing)
+	{
+		munmap(pRing->pCqRing, pRing->cqRingSize);
+	}
+	munmap(pRing->pSqRing, pRing->sqRingSize);
+	close(pRing->fd);
+}
+
+/**
+ * Reserves the next submission entry, returns MD_NULL when the ring is full.
+ */
+static struct io_uring_sqe* getSubmissionEntry(struct IoUring* pRing)
+{
+	u32 head = __atomic_load_n(pRing->pSqHead, __ATOMIC_ACQUIRE);
+	u32 tail = *pRing->pSqTail + pRing->pendingSubmissions;
+	if (tail - head >= pRing->entries)
+	{
+		return MD_NULL;
+	}
+
+	u32					 index = tail & *pRing->pSqMask;
+	struct io_uring_sqe* pSqe  = &pRing->pSqes[index];
+	mdMemorySet(pSqe, 0, sizeof(struct io_uring_sqe));
+	pRing->pSqArray[index] = index;
+	pRing->pendingSubmissions++;
+
+	return pSqe;
+}
+
+/**
+ * Publishes the reserved entries to the kernel, optionally waiting for at least one completion.
+ */
+static void enterIoUring(struct IoUring* pRing, b8 waitCompletion)
+{
+	u32 submitted = pRing->pendingSubmissions;
+	if (submitted > 0)
+	{
+		__atomic_store_n(pRing->pSqTail, *pRing->pSqTail + submitted, __ATOMIC_RELEASE);
+		pRing->pendingSubmissions = 0;
+	}
+
+	if (submitted == 0 && !waitCompletion)
+	{
+		return;
+	}
+
+	u32 flags = waitCompletion ? IORING_ENTER_GETEVENTS : 0;
+	while (syscall(__NR_io_uring_enter, pRing->fd, submitted, waitCompletion ? 1 : 0, flags, MD_NULL, 0) < 0 &&
+		   errno == EINTR)
+	{
+	}
+}
+
+static void submitIoUringRequest(struct AsyncFileRequest* pRequest, struct io_uring_sqe* pSqe)
+{
+	u64 done = pRequest->completion.bytesTransferred;
+	u64 left = pRequest->desc.size - done;
+
+	pSqe->opcode	= pRequest->desc.type == MD_FILE_REQUEST_TYPE_READ ? IORING_OP_READ : IORING_OP_WRITE;
+	pSqe->fd		= getNativeFile(pRequest);
+	pSqe->off		= pRequest->desc.offset + done;
+	pSqe->addr		= (u64)(uintptr_t)((u8*)pRequest->desc.pBuffer + done);
+	pSqe->len		= left > 0x7FFFF000ull ? 0x7FFFF000u : (u32)left;
+	pSqe->user_data = (u64)(uintptr_t)pRequest;
+}
+
+/**
+ * Moves the waiting requests into the ring while the queue depth allows it. Must be called with the mutex locked.
+ */
+static void startIoUringRequests()
+{
+	struct IoUring* pRing = &s_pAsyncFileData->ring;
+
+	while (s_pAsyncFileData->executing.count < s_pAsyncFileData->config.queueDepth)
+	{
+		struct AsyncFileRequest* pRequest = popWaitingRequest();
+		if (pRequest == MD_NULL)
+		{
+			break;
+		}
+
+		struct io_uring_sqe* pSqe = getSubmissionEntry(pRing);
+		if (pSqe == MD_NULL)
+		{
+			listPushFront(&s_pAsyncFileData->waiting[pRequest->desc.priority], pRequest);
+			break;
+		}
+
+		submitIoUringRequest(pRequest, pSqe);
+		pRequest->state = ASYNC_REQUEST_STATE_EXECUTING;
+		listPushBack(&s_pAsyncFileData->executing, pRequest);
+	}
+
+	enterIoUring(pRing, MD_FALSE);
+}
+
+/**
+ * Handles every available completion, the short transfers are submitted again for the remaining bytes. Must be
+ * called with the mutex locked.
+ */
+static void reapIoUringCompletions()
+{
+	struct IoUring* pRing = &s_pAsyncFileData->ring;
+
+	u32 head = *pRing->pCqHead;
+	u32 tail = __atomic_load_n(pRing->pCqTail, __ATOMIC_ACQUIRE);
+
+	for (; head != tail; ++head)
+	{
+		struct io_uring_cqe*	 pCqe	  = &pRing->pCqes[head & *pRing->pCqMask];
+		struct AsyncFileRequest* pRequest = (struct AsyncFileRequest*)(uintptr_t)pCqe->user_data;
+		i32						 result	  = pCqe->res;
+
+		// The cancel operations are submitted without a request.
+		if (pRequest == MD_NULL)
+		{
+			continue;
+		}
+
+		if (result == -ECANCELED)
+		{
+			pRequest->cancelRequested = MD_TRUE;
+			finishRequest(pRequest, MD_FILE_REQUEST_STATUS_CANCELLED, 0);
+		}
+		else if (result < 0 && result != -EINTR && result != -EAGAIN)
+		{
+			finishRequest(pRequest, MD_FILE_REQUEST_STATUS_FAILED, -result);
+		}
+		else
+		{
+			pRequest->completion.bytesTransferred += result > 0 ? (u64)result : 0;
+
+			b8 isShort = (result > 0 || result == -EINTR || result == -EAGAIN) &&
+						 pRequest->completion.bytesTransferred < pRequest->desc.size;
+			if (isShort && !pRequest->cancelRequested)
+			{
+				listRemove(&s_pAsyncFileData->executing, pRequest);
+				pRequest->state = ASYNC_REQUEST_STATE_WAITING;
+				listPushFront(&s_pAsyncFileData->waiting[pRequest->desc.priority], pRequest);
+			}
+			else
+			{
+				finishRequest(pRequest, MD_FILE_REQUEST_STATUS_COMPLETED, 0);
+			}
+		}
+	}
+
+	__atomic_store_n(pRing->pCqHead, head, __ATOMIC_RELEASE);
+}
+
+static void cancelIoUringRequest(struct AsyncFileRequest* pRequest)
+{
+	struct io_uring_sqe* pSqe = getSubmissionEntry(&s_pAsyncFileData->ring);
+	if (pSqe == MD_NULL)
+	{
+		return; // The request is still reported as cancelled when it finishes.
+	}
+
+	pSqe->opcode	= IORING_OP_ASYNC_CANCEL;
+	pSqe->addr		= (u64)(uintptr_t)pRequest;
+	pSqe->user_data = 0;
+	enterIoUring(&s_pAsyncFileData->ring, MD_FALSE);
+}
+#endif
+
+// ================================================= Queue =================================================
+
+struct MdFileAsyncConfig mdFileAsyncGetDefaultConfig()
+{
+	struct MdFileAsyncConfig config;
+	config.queueDepth		  = 64;
+	config.workerThreadsCount = 4;
+	config.disableIoUring	  = MD_FALSE;
+	return config;
+}
+
+void mdFileAsyncInitialize(const struct MdFileAsyncConfig* pConfig)
+{
+	MD_ASSERT(s_pAsyncFileData == MD_NULL);
+
+	s_pAsyncFileData = MD_MALLOC(struct AsyncFileData);
+	mdMemorySet(s_pAsyncFileData, 0, sizeof(struct AsyncFileData));
+
+	s_pAsyncFileData->config = pConfig != MD_NULL ? *pConfig : mdFileAsyncGetDefaultConfig();
+	s_pAsyncFileData->nextId = MD_FILE_REQUEST_INVALID_ID + 1;
+	if (s_pAsyncFileData->config.queueDepth == 0)
+	{
+		s_pAsyncFileData->config.queueDepth = 1;
+	}
+
+	mdMutexInitialize(&s_pAsyncFileData->mutex);
+	mdConditionVariableInitialize(&s_pAsyncFileData->workAvailable);
+	mdConditionVariableInitialize(&s_pAsyncFileData->requestFinished);
+
+#if MD_FILE_ASYNC_HAS_IO_URING
+	// The ring is twice the queue depth so the cancel operations always find a free entry.
+	if (!s_pAsyncFileData->config.disableIoUring)
+	{
+		s_pAsyncFileData->useIoUring = setupIoUring(&s_pAsyncFileData->ring, s_pAsyncFileData->config.queueDepth * 2);
+	}
+#endif
+
+	if (!s_pAsyncFileData->useIoUring)
+	{
+		startWorkers();
+	}
+}
+
+b8 mdFileAsyncIsUsingIoUring()
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+	return s_pAsyncFileData->useIoUring;
+}
+
+mdFileRequestId mdFileAsyncSubmit(const struct MdFileRequestDesc* pDesc)
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+	MD_ASSERT(pDesc != MD_NULL);
+	MD_ASSERT(pDesc->pFile != MD_NULL && pDesc->pFile->isOpen);
+	MD_ASSERT(pDesc->pBuffer != MD_NULL || pDesc->size == 0);
+	MD_ASSERT(pDesc->priority < MD_FILE_REQUEST_PRIORITY_COUNT);
+
+	struct AsyncFileRequest* pRequest = MD_MALLOC(struct AsyncFileRequest);
+	mdMemorySet(pRequest, 0, sizeof(struct AsyncFileRequest));
+
+	pRequest->desc				   = *pDesc;
+	pRequest->state				   = ASYNC_REQUEST_STATE_WAITING;
+	pRequest->completion.id		   = s_pAsyncFileData->nextId++;
+	pRequest->completion.pBuffer   = pDesc->pBuffer;
+	pRequest->completion.pUserData = pDesc->pUserData;
+
+	mdMutexLock(&s_pAsyncFileData->mutex);
+
+	// The packed files are already in memory, there is no native handle to queue the request on.
+	if (pDesc->pFile->isPacked)
+	{
+		MD_ASSERT(pDesc->type == MD_FILE_REQUEST_TYPE_READ);
+		pRequest->completion.bytesTransferred = mdFileReadAt(pDesc->pFile, pDesc->offset, pDesc->pBuffer, pDesc->size);
+		finishRequest(pRequest, MD_FILE_REQUEST_STATUS_COMPLETED, 0);
+		mdMutexUnlock(&s_pAsyncFileData->mutex);
+		return pRequest->completion.id;
+	}
+
+	listPushBack(&s_pAsyncFileData->waiting[pDesc->priority], pRequest);
+
+	if (s_pAsyncFileData->useIoUring)
+	{
+#if MD_FILE_ASYNC_HAS_IO_URING
+		startIoUringRequests();
+#endif
+	}
+	else
+	{
+		mdConditionVariableSignal(&s_pAsyncFileData->workAvailable);
+	}
+	mdMutexUnlock(&s_pAsyncFileData->mutex);
+
+	return pRequest->completion.id;
+}
+
+b8 mdFileAsyncCancel(mdFileRequestId id)
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+
+	b8 isFound = MD_FALSE;
+	mdMutexLock(&s_pAsyncFileData->mutex);
+
+	for (u32 priority = 0; priority < MD_FILE_REQUEST_PRIORITY_COUNT && !isFound; ++priority)
+	{
+		struct AsyncFileRequest* pRequest = findRequest(&s_pAsyncFileData->waiting[priority], id);
+		if (pRequest != MD_NULL)
+		{
+			listRemove(&s_pAsyncFileData->waiting[priority], pRequest);
+			pRequest->cancelRequested = MD_TRUE;
+			finishRequest(pRequest, MD_FILE_REQUEST_STATUS_CANCELLED, 0);
+			isFound = MD_TRUE;
+		}
+	}
+
+	if (!isFound)
+	{
+		struct AsyncFileRequest* pRequest = findRequest(&s_pAsyncFileData->executing, id);
+		if (pRequest != MD_NULL && !pRequest->cancelRequested)
+		{
+			// The workers check the flag between two transfers, io_uring interrupts the operation.
+			MD_ATOMIC_STORE(&pRequest->cancelRequested, MD_TRUE, MD_MEMORY_ORDER_RELAXED);
+#if MD_FILE_ASYNC_HAS_IO_URING
+			if (s_pAsyncFileData->useIoUring)
+			{
+				cancelIoUringRequest(pRequest);
+			}
+#endif
+			isFound = MD_TRUE;
+		}
+	}
+
+	mdMutexUnlock(&s_pAsyncFileData->mutex);
+	return isFound;
+}
+
+u32 mdFileAsyncPoll(struct MdFileCompletion* pCompletions, u32 maxCompletions)
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+	MD_ASSERT(pCompletions != MD_NULL || maxCompletions == 0);
+
+	mdMutexLock(&s_pAsyncFileData->mutex);
+
+#if MD_FILE_ASYNC_HAS_IO_URING
+	if (s_pAsyncFileData->useIoUring)
+	{
+		reapIoUringCompletions();
+		startIoUringRequests();
+	}
+#endif
+
+	// The callbacks run without the lock, they are allowed to submit new requests.
+	struct AsyncRequestList finished = s_pAsyncFileData->finished;
+	mdMemorySet(&s_pAsyncFileData->finished, 0, sizeof(struct AsyncRequestList));
+	mdMutexUnlock(&s_pAsyncFileData->mutex);
+
+	u32						 completionsCount = 0;
+	struct AsyncRequestList	 kept			  = {0};
+	struct AsyncFileRequest* pRequest		  = finished.pHead;
+
+	while (pRequest != MD_NULL)
+	{
+		struct AsyncFileRequest* pNext = pRequest->pNext;
+
+		if (pRequest->desc.callback != MD_NULL)
+		{
+			pRequest->desc.callback(&pRequest->completion);
+			MD_FREE(pRequest, struct AsyncFileRequest);
+		}
+		else if (completionsCount < maxCompletions)
+		{
+			pCompletions[completionsCount++] = pRequest->completion;
+			MD_FREE(pRequest, struct AsyncFileRequest);
+		}
+		else
+		{
+			listPushBack(&kept, pRequest);
+		}
+
+		pRequest = pNext;
+	}
+
+	// The completions which did not fit are reported first by the next poll.
+	if (kept.pHead != MD_NULL)
+	{
+		mdMutexLock(&s_pAsyncFileData->mutex);
+		while (kept.pTail != MD_NULL)
+		{
+			struct AsyncFileRequest* pLast = kept.pTail;
+			listRemove(&kept, pLast);
+			listPushFront(&s_pAsyncFileData->finished, pLast);
+		}
+		mdMutexUnlock(&s_pAsyncFileData->mutex);
+	}
+
+	return completionsCount;
+}
+
+void mdFileAsyncWaitIdle()
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+
+	mdMutexLock(&s_pAsyncFileData->mutex);
+	while (getWaitingCount() > 0 || s_pAsyncFileData->executing.count > 0)
+	{
+		if (s_pAsyncFileData->useIoUring)
+		{
+#if MD_FILE_ASYNC_HAS_IO_URING
+			startIoUringRequests();
+			enterIoUring(&s_pAsyncFileData->ring, MD_TRUE);
+			reapIoUringCompletions();
+#endif
+		}
+		else
+		{
+			mdConditionVariableWait(&s_pAsyncFileData->requestFinished, &s_pAsyncFileData->mutex);
+		}
+	}
+	mdMutexUnlock(&s_pAsyncFileData->mutex);
+}
+
+void mdFileAsyncShutdown()
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+
+	mdMutexLock(&s_pAsyncFileData->mutex);
+	for (u32 priority = 0; priority < MD_FILE_REQUEST_PRIORITY_COUNT; ++priority)
+	{
+		struct AsyncRequestList* pList = &s_pAsyncFileData->waiting[priority];
+		while (pList->pHead != MD_NULL)
+		{
+			struct AsyncFileRequest* pRequest = pList->pHead;
+			listRemove(pList, pRequest);
+			pRequest->cancelRequested = MD_TRUE;
+			finishRequest(pRequest, MD_FILE_REQUEST_STATUS_CANCELLED, 0);
+		}
+	}
+
+	struct AsyncFileRequest* pExecuting = s_pAsyncFileData->executing.pHead;
+	while (pExecuting != MD_NULL)
+	{
+		MD_ATOMIC_STORE(&pExecuting->cancelRequested, MD_TRUE, MD_MEMORY_ORDER_RELAXED);
+#if MD_FILE_ASYNC_HAS_IO_URING
+		if (s_pAsyncFileData->useIoUring)
+		{
+			cancelIoUringRequest(pExecuting);
+		}
+#endif
+		pExecuting = pExecuting->pNext;
+	}
+	mdMutexUnlock(&s_pAsyncFileData->mutex);
+
+	mdFileAsyncWaitIdle();
+
+	if (s_pAsyncFileData->useIoUring)
+	{
+#if MD_FILE_ASYNC_HAS_IO_URING
+		destroyIoUring(&s_pAsyncFileData->ring);
+#endif
+	}
+	else
+	{
+		stopWorkers();
+	}
+
+	while (s_pAsyncFileData->finished.pHead != MD_NULL)
+	{
+		struct AsyncFileRequest* pRequest = s_pAsyncFileData->finished.pHead;
+		listRemove(&s_pAsyncFileData->finished, pRequest);
+		MD_FREE(pRequest, struct AsyncFileRequest);
+	}
+
+	mdConditionVariableDestroy(&s_pAsyncFileData->requestFinished);
+	mdConditionVariableDestroy(&s_pAsyncFileData->workAvailable);
+	mdMutexDestroy(&s_pAsyncFileData->mutex);
+
+	MD_FREE(s_pAsyncFileData, struct AsyncFileData);
+	s_pAsyncFileData = MD_NULL;
+}
+
+#endif // PLATFORM_IS_LINUX
@@ -0,0 +1,264 @@
+#if PLATFORM_IS_WEB || PLATFORM_IS_WINDOWS
+#include "MEEDEngine/platforms/file_async.h"
+
+/**
+ * Without a native asynchronous backend the requests are executed synchronously by `mdFileAsyncPoll`, at most
+ * `queueDepth` of them per poll in priority order. The API behaves the same, only the I/O blocks the polling thread.
+ */
+
+struct AsyncFileRequest
+{
+	struct MdFileRequestDesc desc;
+	struct MdFileCompletion	 completion;
+	struct AsyncFileRequest* pNext;
+};
+
+struct AsyncRequestQueue
+{
+	struct AsyncFileRequest* pHead;
+	struct AsyncFileRequest* pTail;
+};
+
+struct AsyncFileData
+{
+	struct MdFileAsyncConfig config;
+	mdFileRequestId			 nextId;
+
+	struct AsyncRequestQueue waiting[MD_FILE_REQUEST_PRIORITY_COUNT];
+	struct AsyncRequestQueue finished;
+};
+
+static struct AsyncFileData* s_pAsyncFileData = MD_NULL;
+
+static void queuePush(struct AsyncRequestQueue* pQueue, struct AsyncFileRequest* pRequest)
+{
+	pRequest->pNext = MD_NULL;
+	if (pQueue->pTail != MD_NULL)
+	{
+		pQueue->pTail->pNext = pRequest;
+	}
+	else
+	{
+		pQueue->pHead = pRequest;
+	}
+	pQueue->pTail = pRequest;
+}
+
+static struct AsyncFileRequest* queuePop(struct AsyncRequestQueue* pQueue)
+{
+	struct AsyncFileRequest* pRequest = pQueue->pHead;
+	if (pRequest != MD_NULL)
+	{
+		pQueue->pHead = pRequest->pNext;
+		if (pQueue->pHead == MD_NULL)
+		{
+			pQueue->pTail = MD_NULL;
+		}
+	}
+	return pRequest;
+}
+
+static struct AsyncFileRequest* popWaitingRequest()
+{
+	for (u32 priority = 0; priority < MD_FILE_REQUEST_PRIORITY_COUNT; ++priority)
+	{
+		struct AsyncFileRequest* pRequest = queuePop(&s_pAsyncFileData->waiting[priority]);
+		if (pRequest != MD_NULL)
+		{
+			return pRequest;
+		}
+	}
+	return MD_NULL;
+}
+
+static void executeRequest(struct AsyncFileRequest* pRequest)
+{
+	const struct MdFileRequestDesc* pDesc = &pRequest->desc;
+
+	if (pDesc->type == MD_FILE_REQUEST_TYPE_READ)
+	{
+		pRequest->completion.bytesTransferred = mdFileReadAt(pDesc->pFile, pDesc->offset, pDesc->pBuffer, pDesc->size);
+	}
+	else
+	{
+		mdFileWriteAt(pDesc->pFile, pDesc->offset, pDesc->pBuffer, pDesc->size);
+		pRequest->completion.bytesTransferred = pDesc->size;
+	}
+
+	pRequest->completion.status = MD_FILE_REQUEST_STATUS_COMPLETED;
+	queuePush(&s_pAsyncFileData->finished, pRequest);
+}
+
+struct MdFileAsyncConfig mdFileAsyncGetDefaultConfig()
+{
+	struct MdFileAsyncConfig config;
+	config.queueDepth		  = 64;
+	config.workerThreadsCount = 4;
+	config.disableIoUring	  = MD_FALSE;
+	return config;
+}
+
+void mdFileAsyncInitialize(const struct MdFileAsyncConfig* pConfig)
+{
+	MD_ASSERT(s_pAsyncFileData == MD_NULL);
+
+	s_pAsyncFileData = MD_MALLOC(struct AsyncFileData);
+	mdMemorySet(s_pAsyncFileData, 0, sizeof(struct AsyncFileData));
+
+	s_pAsyncFileData->config = pConfig != MD_NULL ? *pConfig : mdFileAsyncGetDefaultConfig();
+	s_pAsyncFileData->nextId = MD_FILE_REQUEST_INVALID_ID + 1;
+	if (s_pAsyncFileData->config.queueDepth == 0)
+	{
+		s_pAsyncFileData->config.queueDepth = 1;
+	}
+}
+
+b8 mdFileAsyncIsUsingIoUring()
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+	return MD_FALSE;
+}
+
+mdFileRequestId mdFileAsyncSubmit(const struct MdFileRequestDesc* pDesc)
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+	MD_ASSERT(pDesc != MD_NULL);
+	MD_ASSERT(pDesc->pFile != MD_NULL && pDesc->pFile->isOpen);
+	MD_ASSERT(pDesc->pBuffer != MD_NULL || pDesc->size == 0);
+	MD_ASSERT(pDesc->priority < MD_FILE_REQUEST_PRIORITY_COUNT);
+
+	struct AsyncFileRequest* pRequest = MD_MALLOC(struct AsyncFileRequest);
+	mdMemorySet(pRequest, 0, sizeof(struct AsyncFileRequest));
+
+	pRequest->desc				   = *pDesc;
+	pRequest->completion.id		   = s_pAsyncFileData->nextId++;
+	pRequest->completion.pBuffer   = pDesc->pBuffer;
+	pRequest->completion.pUserData = pDesc->pUserData;
+
+	queuePush(&s_pAsyncFileData->waiting[pDesc->priority], pRequest);
+
+	return pRequest->completion.id;
+}
+
+b8 mdFileAsyncCancel(mdFileRequestId id)
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+
+	for (u32 priority = 0; priority < MD_FILE_REQUEST_PRIORITY_COUNT; ++priority)
+	{
+		struct AsyncRequestQueue* pQueue	= &s_pAsyncFileData->waiting[priority];
+		struct AsyncFileRequest*  pPrevious = MD_NULL;
+
+		for (struct AsyncFileRequest* pRequest = pQueue->pHead; pRequest != MD_NULL; pRequest = pRequest->pNext)
+		{
+			if (pRequest->completion.id != id)
+			{
+				pPrevious = pRequest;
+				continue;
+			}
+
+			if (pPrevious != MD_NULL)
+			{
+				pPrevious->pNext = pRequest->pNext;
+			}
+			else
+			{
+				pQueue->pHead = pRequest->pNext;
+			}
+			if (pQueue->pTail == pRequest)
+			{
+				pQueue->pTail = pPrevious;
+			}
+
+			pRequest->completion.status = MD_FILE_REQUEST_STATUS_CANCELLED;
+			queuePush(&s_pAsyncFileData->finished, pRequest);
+			return MD_TRUE;
+		}
+	}
+
+	return MD_FALSE;
+}
+
+u32 mdFileAsyncPoll(struct MdFileCompletion* pCompletions, u32 maxCompletions)
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+	MD_ASSERT(pCompletions != MD_NULL || maxCompletions == 0);
+
+	for (u32 executed = 0; executed < s_pAsyncFileData->config.queueDepth; ++executed)
+	{
+		struct AsyncFileRequest* pRequest = popWaitingRequest();
+		if (pRequest == MD_NULL)
+		{
+			break;
+		}
+		executeRequest(pRequest);
+	}
+
+	u32						 completionsCount = 0;
+	struct AsyncRequestQueue finished		  = s_pAsyncFileData->finished;
+	mdMemorySet(&s_pAsyncFileData->finished, 0, sizeof(struct AsyncRequestQueue));
+
+	struct AsyncRequestQueue kept = {};
+	struct AsyncFileRequest* pRequest;
+	while ((pRequest = queuePop(&finished)) != MD_NULL)
+	{
+		if (pRequest->desc.callback != MD_NULL)
+		{
+			pRequest->desc.callback(&pRequest->completion);
+			MD_FREE(pRequest, struct AsyncFileRequest);
+		}
+		else if (completionsCount < maxCompletions)
+		{
+			pCompletions[completionsCount++] = pRequest->completion;
+			MD_FREE(pRequest, struct AsyncFileRequest);
+		}
+		else
+		{
+			queuePush(&kept, pRequest);
+		}
+	}
+
+	// The completions which did not fit are reported first by the next poll.
+	if (kept.pHead != MD_NULL)
+	{
+		kept.pTail->pNext = s_pAsyncFileData->finished.pHead;
+		if (s_pAsyncFileData->finished.pTail != MD_NULL)
+		{
+			kept.pTail = s_pAsyncFileData->finished.pTail;
+		}
+		s_pAsyncFileData->finished = kept;
+	}
+
+	return completionsCount;
+}
+
+void mdFileAsyncWaitIdle()
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+
+	struct AsyncFileRequest* pRequest;
+	while ((pRequest = popWaitingRequest()) != MD_NULL)
+	{
+		executeRequest(pRequest);
+	}
+}
+
+void mdFileAsyncShutdown()
+{
+	MD_ASSERT(s_pAsyncFileData != MD_NULL);
+
+	struct AsyncFileRequest* pRequest;
+	while ((pRequest = popWaitingRequest()) != MD_NULL)
+	{
+		MD_FREE(pRequest, struct AsyncFileRequest);
+	}
+	while ((pRequest = queuePop(&s_pAsyncFileData->finished)) != MD_NULL)
+	{
+		MD_FREE(pRequest, struct AsyncFileRequest);
+	}
+
+	MD_FREE(s_pAsyncFileData, struct AsyncFileData);
+	s_pAsyncFileData = MD_NULL;
+}
+
+#endif // PLATFORM_IS_WEB || PLATFORM_IS_WINDOWS
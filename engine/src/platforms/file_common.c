@@ -0,0 +1,168 @@
+#include "MEEDEngine/platforms/file.h"
+#include "file_internal.h"
+#include <string.h>
+
+char* mdFileCreateTempPath(const char* filePath)
+{
+	MD_ASSERT(filePath != MD_NULL);
+
+	mdSize length	= strlen(filePath);
+	char*  tempPath = MD_MALLOC_ARRAY(char, length + sizeof(MD_FILE_ATOMIC_SUFFIX));
+	mdMemoryCopy(tempPath, filePath, length);
+	mdMemoryCopy(tempPath + length, MD_FILE_ATOMIC_SUFFIX, sizeof(MD_FILE_ATOMIC_SUFFIX));
+	return tempPath;
+}
+
+char* mdFileCopyPath(const char* filePath)
+{
+	MD_ASSERT(filePath != MD_NULL);
+
+	mdSize length = strlen(filePath);
+	char*  path	  = MD_MALLOC_ARRAY(char, length + 1);
+	mdMemoryCopy(path, filePath, length + 1);
+	return path;
+}
+
+void mdFileFreePath(char* path)
+{
+	MD_ASSERT(path != MD_NULL);
+	MD_FREE_ARRAY(path, char, strlen(path) + 1);
+}
+
+struct MdFileStreamReader* mdFileStreamReaderCreate(struct MdFileData* pFileData, u64 offset, u32 blockSize)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+	MD_ASSERT(blockSize > 0);
+
+	struct MdFileStreamReader* pReader = MD_MALLOC(struct MdFileStreamReader);
+	MD_ASSERT(pReader != MD_NULL);
+
+	pReader->pFile		   = pFileData;
+	pReader->offset		   = offset;
+	pReader->blockSize	   = blockSize;
+	pReader->currentBuffer = 1;
+	pReader->pBuffers[0]   = MD_MALLOC_ARRAY(u8, blockSize);
+	pReader->pBuffers[1]   = MD_MALLOC_ARRAY(u8, blockSize);
+
+	mdFilePrefetch(pFileData, offset, blockSize);
+
+	return pReader;
+}
+
+const void* mdFileStreamReaderNext(struct MdFileStreamReader* pReader, u64* pSize)
+{
+	MD_ASSERT(pReader != MD_NULL);
+	MD_ASSERT(pSize != MD_NULL);
+
+	*pSize = 0;
+	if (pReader->offset >= pReader->pFile->size)
+	{
+		return MD_NULL;
+	}
+
+	// The other buffer holds the previous block, which stays valid until the next call.
+	pReader->currentBuffer = 1 - pReader->currentBuffer;
+	u8* pBuffer			   = pReader->pBuffers[pReader->currentBuffer];
+
+	u64 bytesRead = mdFileReadAt(pReader->pFile, pReader->offset, pBuffer, pReader->blockSize);
+	if (bytesRead == 0)
+	{
+		return MD_NULL;
+	}
+
+	pReader->offset += bytesRead;
+
+	// Let the OS load the following block while the caller processes this one.
+	if (pReader->offset < pReader->pFile->size)
+	{
+		mdFilePrefetch(pReader->pFile, pReader->offset, pReader->blockSize);
+	}
+
+	*pSize = bytesRead;
+	return pBuffer;
+}
+
+void mdFileStreamReaderSeek(struct MdFileStreamReader* pReader, u64 offset)
+{
+	MD_ASSERT(pReader != MD_NULL);
+
+	pReader->offset = offset;
+	if (offset < pReader->pFile->size)
+	{
+		mdFilePrefetch(pReader->pFile, offset, pReader->blockSize);
+	}
+}
+
+void mdFileStreamReaderDestroy(struct MdFileStreamReader* pReader)
+{
+	MD_ASSERT(pReader != MD_NULL);
+
+	MD_FREE_ARRAY(pReader->pBuffers[0], u8, pReader->blockSize);
+	MD_FREE_ARRAY(pReader->pBuffers[1], u8, pReader->blockSize);
+	MD_FREE(pReader, struct MdFileStreamReader);
+}
+
+struct MdFileBufferedWriter* mdFileBufferedWriterCreate(struct MdFileData* pFileData, u32 bufferSize)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+
+	struct MdFileBufferedWriter* pWriter = MD_MALLOC(struct MdFileBufferedWriter);
+	MD_ASSERT(pWriter != MD_NULL);
+
+	pWriter->pFile		= pFileData;
+	pWriter->bufferSize = bufferSize != 0 ? bufferSize : MD_FILE_BUFFERED_WRITER_DEFAULT_SIZE;
+	pWriter->usedSize	= 0;
+	pWriter->pBuffer	= MD_MALLOC_ARRAY(u8, pWriter->bufferSize);
+
+	return pWriter;
+}
+
+void mdFileBufferedWriterWrite(struct MdFileBufferedWriter* pWriter, const void* pData, mdSize size)
+{
+	MD_ASSERT(pWriter != MD_NULL);
+	MD_ASSERT(pData != MD_NULL || size == 0);
+
+	if (size <= (mdSize)(pWriter->bufferSize - pWriter->usedSize))
+	{
+		mdMemoryCopy(pWriter->pBuffer + pWriter->usedSize, pData, size);
+		pWriter->usedSize += (u32)size;
+		return;
+	}
+
+	// Copying would only fill the buffer for it to be written right away, send both regions at once instead.
+	struct MdFileBuffer buffers[2];
+	buffers[0].pData = pWriter->pBuffer;
+	buffers[0].size	 = pWriter->usedSize;
+	buffers[1].pData = pData;
+	buffers[1].size	 = size;
+	mdFileWriteVector(pWriter->pFile, buffers, 2);
+
+	pWriter->usedSize = 0;
+}
+
+void mdFileBufferedWriterFlush(struct MdFileBufferedWriter* pWriter)
+{
+	MD_ASSERT(pWriter != MD_NULL);
+
+	if (pWriter->usedSize > 0)
+	{
+		// `mdFileWrite` gives up on a short write, the vector write retries until the whole buffer is written.
+		struct MdFileBuffer buffer;
+		buffer.pData = pWriter->pBuffer;
+		buffer.size	 = pWriter->usedSize;
+		mdFileWriteVector(pWriter->pFile, &buffer, 1);
+		pWriter->usedSize = 0;
+	}
+}
+
+void mdFileBufferedWriterDestroy(struct MdFileBufferedWriter* pWriter)
+{
+	MD_ASSERT(pWriter != MD_NULL);
+
+	mdFileBufferedWriterFlush(pWriter);
+
+	MD_FREE_ARRAY(pWriter->pBuffer, u8, pWriter->bufferSize);
+	MD_FREE(pWriter, struct MdFileBufferedWriter);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "MEEDEngine/platforms/file.h"
+
+/**
+ * @file file_internal.h
+ * The platform data stored inside `MdFileData::pInternal`, shared between the file implementation and the other
+ * platform files which need the native handle (e.g. the asynchronous file queue), and the hooks through which every
+ * file implementation serves the files of the mounted packs.
+ * @note this file is internal to the platform layer and should not be included directly by other modules.
+ */
+
+#if PLATFORM_IS_LINUX || PLATFORM_IS_WEB
+struct LinuxFileData
+{
+	i32	  fd;
+	b8	  isMapped; ///< Whether `content` is a memory mapping which must be unmapped instead of freed.
+	char* tempPath;	  ///< The file written in `MD_FILE_MODE_WRITE_ATOMIC`, renamed over `targetPath` on close.
+	char* targetPath; ///< The copy of the path given to `mdFileOpen` in `MD_FILE_MODE_WRITE_ATOMIC`.
+};
+#endif
+
+#define MD_FILE_ATOMIC_SUFFIX ".tmp"
+
+/**
+ * Builds the path of the temporary file written in `MD_FILE_MODE_WRITE_ATOMIC`.
+ * @param filePath The path given to `mdFileOpen`.
+ * @return The path with `MD_FILE_ATOMIC_SUFFIX` appended, released with `mdFileFreePath`.
+ */
+char* mdFileCreateTempPath(const char* filePath);
+
+/**
+ * Copies the path of a file opened in `MD_FILE_MODE_WRITE_ATOMIC`, the string given to `mdFileOpen` may be gone when
+ * `mdFileClose` renames the temporary file over it.
+ * @param filePath The path given to `mdFileOpen`.
+ * @return The copy of the path, released with `mdFileFreePath`.
+ */
+char* mdFileCopyPath(const char* filePath);
+
+/**
+ * Releases a path built by `mdFileCreateTempPath` or `mdFileCopyPath`.
+ */
+void mdFileFreePath(char* path);
+
+/**
+ * Opens a file from the mounted packs, called first by `mdFileOpen`.
+ * @param filePath The path given to `mdFileOpen`.
+ * @param mode The mode given to `mdFileOpen`.
+ * @return The packed file, or `MD_NULL` if the path is not inside a mounted pack or the mode writes.
+ */
+struct MdFileData* mdPackFileOpen(const char* filePath, enum MdFileMode mode);
+
+/**
+ * Implements `mdFileReadAt` for a file whose `isPacked` is set.
+ */
+u64 mdPackFileReadAt(struct MdFileData* pFileData, u64 offset, void* pDestination, u64 size);
+
+/**
+ * Implements `mdFileClose` for a file whose `isPacked` is set.
+ */
+void mdPackFileClose(struct MdFileData* pFileData);
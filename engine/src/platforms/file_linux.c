@@ -1,15 +1,83 @@
 #if PLATFORM_IS_LINUX
-#include "MEEDEngine/platforms/file.h"
+#include "MEEDEngine/platforms/profile.h"
+#include "file_internal.h"
+#include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
-struct LinuxFileData
+#define MD_FILE_WRITE_VECTOR_BATCH 64
+
+/**
+ * Flushes the directory holding a file to the storage device, so that a file renamed into it survives a power loss.
+ */
+static void syncParentDirectory(const char* filePath)
+{
+	char		directoryPath[PATH_MAX];
+	const char* pSeparator = strrchr(filePath, '/');
+	if (pSeparator == MD_NULL)
+	{
+		mdFormatString(directoryPath, sizeof(directoryPath), ".");
+	}
+	else
+	{
+		// The root keeps its separator, "/file" lives in "/".
+		i32 directoryLength = pSeparator == filePath ? 1 : (i32)(pSeparator - filePath);
+		mdFormatString(directoryPath, sizeof(directoryPath), "%.*s", directoryLength, filePath);
+	}
+
+	i32 fd = open(directoryPath, O_RDONLY | O_DIRECTORY);
+	if (fd == -1)
+	{
+		return;
+	}
+	fsync(fd);
+	close(fd);
+}
+
+/**
+ * Maps the whole content of a file opened in `MD_FILE_MODE_READ_MAPPED`.
+ * @return MD_FALSE when the mapping failed, the content stays MD_NULL.
+ */
+static b8 mapFileContent(struct MdFileData* pFileData, struct LinuxFileData* pLinuxData)
 {
-	i32 fd;
-};
+	if (pFileData->size == 0)
+	{
+		// `mmap` rejects empty files, the content stays MD_NULL.
+		return MD_TRUE;
+	}
+
+	void* pMapping = mmap(MD_NULL, (size_t)pFileData->size, PROT_READ, MAP_PRIVATE, pLinuxData->fd, 0);
+	MD_ASSERT_MSG(pMapping != MAP_FAILED, "Failed to map file \"%s\".", pFileData->filePath);
+	if (pMapping == MAP_FAILED)
+	{
+		return MD_FALSE;
+	}
+
+	// The callers usually walk the content from start to end, let the kernel read ahead aggressively.
+	madvise(pMapping, (size_t)pFileData->size, MADV_SEQUENTIAL);
+	madvise(pMapping, (size_t)pFileData->size, MADV_WILLNEED);
+
+	pFileData->content	 = (char*)pMapping;
+	pLinuxData->isMapped = MD_TRUE;
+	return MD_TRUE;
+}
 
 struct MdFileData* mdFileOpen(const char* filePath, enum MdFileMode mode)
 {
+	MD_PROFILE_SCOPE("mdFileOpen");
+
+	struct MdFileData* pPackedFile = mdPackFileOpen(filePath, mode);
+	if (pPackedFile != MD_NULL)
+	{
+		return pPackedFile;
+	}
+
 	struct MdFileData* pFileData = MD_MALLOC(struct MdFileData);
 	mdMemorySet(pFileData, 0, sizeof(struct MdFileData));
 
@@ -21,17 +89,36 @@ struct MdFileData* mdFileOpen(const char* filePath, enum MdFileMode mode)
 	MD_ASSERT(pFileData->pInternal != MD_NULL);
 
 	struct LinuxFileData* pLinuxData = (struct LinuxFileData*)pFileData->pInternal;
+	pLinuxData->isMapped			 = MD_FALSE;
+	pLinuxData->tempPath			 = MD_NULL;
+	pLinuxData->targetPath			 = MD_NULL;
 
 	switch (mode)
 	{
 	case MD_FILE_MODE_READ:
+	case MD_FILE_MODE_READ_MAPPED:
+	case MD_FILE_MODE_READ_NO_PRELOAD:
 		pLinuxData->fd = open(filePath, O_RDONLY);
 		break;
 	case MD_FILE_MODE_WRITE:
 		pLinuxData->fd = open(filePath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
 		break;
 	case MD_FILE_MODE_APPEND:
-		pLinuxData->fd = open(filePath, O_WRONLY | O_CREAT | O_APPEND, 066);
+		pLinuxData->fd = open(filePath, O_WRONLY | O_CREAT | O_APPEND, 0644);
+		break;
+	case MD_FILE_MODE_WRITE_ATOMIC:
+		pLinuxData->tempPath = mdFileCreateTempPath(filePath);
+		pLinuxData->fd		 = open(pLinuxData->tempPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (pLinuxData->fd == -1)
+		{
+			mdFileFreePath(pLinuxData->tempPath);
+			pLinuxData->tempPath = MD_NULL;
+		}
+		else
+		{
+			pLinuxData->targetPath = mdFileCopyPath(filePath);
+			pFileData->filePath	   = pLinuxData->targetPath;
+		}
 		break;
 
 	default:
@@ -42,24 +129,38 @@ struct MdFileData* mdFileOpen(const char* filePath, enum MdFileMode mode)
 	{
 		pFileData->isOpen = MD_TRUE;
 
-		if (mode == MD_FILE_MODE_READ)
+		if (mode != MD_FILE_MODE_WRITE && mode != MD_FILE_MODE_APPEND && mode != MD_FILE_MODE_WRITE_ATOMIC)
 		{
-			// Get file size
-			off_t currentPos = lseek(pLinuxData->fd, 0, SEEK_CUR);
-			off_t fileSize	 = lseek(pLinuxData->fd, 0, SEEK_END);
-			lseek(pLinuxData->fd, currentPos, SEEK_SET);
-
-			pFileData->size = (u32)fileSize;
+			struct stat fileStat;
+			pFileData->size = fstat(pLinuxData->fd, &fileStat) == 0 ? (u64)fileStat.st_size : 0;
+		}
 
+		if (mode == MD_FILE_MODE_READ)
+		{
 			// Read file content into memory
 			pFileData->content = MD_MALLOC_ARRAY(char, pFileData->size + 1);
 			MD_ASSERT(pFileData->content != MD_NULL);
-			ssize_t bytesRead = read(pLinuxData->fd, pFileData->content, pFileData->size);
-			MD_ASSERT_MSG(bytesRead == (ssize_t)pFileData->size,
-						  "Failed to read entire file: Expected %u bytes, but read %zd bytes.",
-						  pFileData->size,
-						  bytesRead);
-			pFileData->content[pFileData->size] = '\0'; // Null-terminate the content
+			u64 bytesRead = mdFileReadAt(pFileData, 0, pFileData->content, pFileData->size);
+			if (bytesRead != pFileData->size)
+			{
+				// The file shrank or a read failed: the file is reported as not opened rather than truncated.
+				MD_FREE_ARRAY(pFileData->content, char, pFileData->size + 1);
+				pFileData->content = MD_NULL;
+				close(pLinuxData->fd);
+				pLinuxData->fd	  = -1;
+				pFileData->isOpen = MD_FALSE;
+			}
+			else
+			{
+				pFileData->content[pFileData->size] = '\0'; // Null-terminate the content
+			}
+		}
+		else if (mode == MD_FILE_MODE_READ_MAPPED && !mapFileContent(pFileData, pLinuxData))
+		{
+			// Same as a failed read: a file without its content is reported as not opened.
+			close(pLinuxData->fd);
+			pLinuxData->fd	  = -1;
+			pFileData->isOpen = MD_FALSE;
 		}
 	}
 
@@ -72,6 +173,62 @@ b8 mdFileIsOpen(struct MdFileData* pFileData)
 	return pFileData->isOpen;
 }
 
+u64 mdFileReadAt(struct MdFileData* pFileData, u64 offset, void* pDestination, u64 size)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+	MD_ASSERT(pFileData->mode != MD_FILE_MODE_WRITE && pFileData->mode != MD_FILE_MODE_APPEND &&
+			  pFileData->mode != MD_FILE_MODE_WRITE_ATOMIC);
+	MD_ASSERT(pDestination != MD_NULL || size == 0);
+
+	if (pFileData->isPacked)
+	{
+		return mdPackFileReadAt(pFileData, offset, pDestination, size);
+	}
+
+	struct LinuxFileData* pLinuxData = (struct LinuxFileData*)pFileData->pInternal;
+	MD_ASSERT(pLinuxData != MD_NULL);
+
+	// `pread` may return less than requested (signals, reads above 2 GB), loop until the end of the file.
+	u64 totalRead = 0;
+	while (totalRead < size)
+	{
+		ssize_t bytesRead = pread(pLinuxData->fd,
+								  (u8*)pDestination + totalRead,
+								  (size_t)(size - totalRead),
+								  (off_t)(offset + totalRead));
+		if (bytesRead < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		MD_ASSERT_MSG(bytesRead >= 0, "Failed to read from file \"%s\".", pFileData->filePath);
+		if (bytesRead <= 0)
+		{
+			break;
+		}
+		totalRead += (u64)bytesRead;
+	}
+
+	return totalRead;
+}
+
+void mdFilePrefetch(struct MdFileData* pFileData, u64 offset, u64 size)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+
+	// The packs are mapped, their pages were already hinted when mounting.
+	if (pFileData->isPacked)
+	{
+		return;
+	}
+
+	struct LinuxFileData* pLinuxData = (struct LinuxFileData*)pFileData->pInternal;
+	MD_ASSERT(pLinuxData != MD_NULL);
+
+	posix_fadvise(pLinuxData->fd, (off_t)offset, (off_t)size, POSIX_FADV_WILLNEED);
+}
+
 void mdFileWrite(struct MdFileData* pFileData, const char* data, mdSize size)
 {
 	MD_ASSERT(pFileData != MD_NULL);
@@ -87,10 +244,131 @@ void mdFileWrite(struct MdFileData* pFileData, const char* data, mdSize size)
 				  bytesWritten);
 }
 
+void mdFileWriteAt(struct MdFileData* pFileData, u64 offset, const void* pSource, u64 size)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+	MD_ASSERT(pFileData->mode == MD_FILE_MODE_WRITE || pFileData->mode == MD_FILE_MODE_APPEND ||
+			  pFileData->mode == MD_FILE_MODE_WRITE_ATOMIC);
+	MD_ASSERT(pSource != MD_NULL || size == 0);
+
+	struct LinuxFileData* pLinuxData = (struct LinuxFileData*)pFileData->pInternal;
+	MD_ASSERT(pLinuxData != MD_NULL);
+
+	u64 totalWritten = 0;
+	while (totalWritten < size)
+	{
+		ssize_t bytesWritten = pwrite(pLinuxData->fd,
+									  (const u8*)pSource + totalWritten,
+									  (size_t)(size - totalWritten),
+									  (off_t)(offset + totalWritten));
+		if (bytesWritten < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		MD_ASSERT_MSG(bytesWritten > 0, "Failed to write to file \"%s\".", pFileData->filePath);
+		if (bytesWritten <= 0)
+		{
+			return;
+		}
+		totalWritten += (u64)bytesWritten;
+	}
+}
+
+void mdFileWriteVector(struct MdFileData* pFileData, const struct MdFileBuffer* pBuffers, u32 buffersCount)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+	MD_ASSERT(pBuffers != MD_NULL || buffersCount == 0);
+
+	struct LinuxFileData* pLinuxData = (struct LinuxFileData*)pFileData->pInternal;
+	MD_ASSERT(pLinuxData != MD_NULL);
+
+	struct iovec vectors[MD_FILE_WRITE_VECTOR_BATCH];
+	u32			 bufferIndex = 0u;
+
+	while (bufferIndex < buffersCount)
+	{
+		u32 vectorsCount = 0u;
+		while (vectorsCount < MD_FILE_WRITE_VECTOR_BATCH && bufferIndex + vectorsCount < buffersCount)
+		{
+			vectors[vectorsCount].iov_base = (void*)pBuffers[bufferIndex + vectorsCount].pData;
+			vectors[vectorsCount].iov_len  = pBuffers[bufferIndex + vectorsCount].size;
+			vectorsCount++;
+		}
+		bufferIndex += vectorsCount;
+
+		// `writev` may write less than requested, skip the fully written vectors and retry with the rest.
+		struct iovec* pVectors = vectors;
+		while (vectorsCount > 0u)
+		{
+			ssize_t bytesWritten = writev(pLinuxData->fd, pVectors, (int)vectorsCount);
+			if (bytesWritten < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			MD_ASSERT_MSG(bytesWritten >= 0, "Failed to write vectors to file \"%s\".", pFileData->filePath);
+			if (bytesWritten < 0)
+			{
+				return;
+			}
+
+			while (vectorsCount > 0u && (mdSize)bytesWritten >= pVectors->iov_len)
+			{
+				bytesWritten -= (ssize_t)pVectors->iov_len;
+				pVectors++;
+				vectorsCount--;
+			}
+
+			if (vectorsCount > 0u)
+			{
+				pVectors->iov_base = (u8*)pVectors->iov_base + bytesWritten;
+				pVectors->iov_len -= (mdSize)bytesWritten;
+			}
+		}
+	}
+}
+
+void mdFileSync(struct MdFileData* pFileData)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+
+	struct LinuxFileData* pLinuxData = (struct LinuxFileData*)pFileData->pInternal;
+	MD_ASSERT(pLinuxData != MD_NULL);
+
+	fdatasync(pLinuxData->fd);
+}
+
+b8 mdFileExists(const char* filePath)
+{
+	MD_ASSERT(filePath != MD_NULL);
+	return access(filePath, F_OK) == 0 ? MD_TRUE : MD_FALSE;
+}
+
+b8 mdFileRename(const char* oldPath, const char* newPath)
+{
+	MD_ASSERT(oldPath != MD_NULL);
+	MD_ASSERT(newPath != MD_NULL);
+	return rename(oldPath, newPath) == 0 ? MD_TRUE : MD_FALSE;
+}
+
+b8 mdFileRemove(const char* filePath)
+{
+	MD_ASSERT(filePath != MD_NULL);
+	return unlink(filePath) == 0 ? MD_TRUE : MD_FALSE;
+}
+
 void mdFileClose(struct MdFileData* pFileData)
 {
 	MD_ASSERT(pFileData != MD_NULL);
 
+	if (pFileData->isPacked)
+	{
+		mdPackFileClose(pFileData);
+		return;
+	}
+
 	struct LinuxFileData* pLinuxData = (struct LinuxFileData*)pFileData->pInternal;
 	MD_ASSERT(pLinuxData != MD_NULL);
 
@@ -98,7 +376,25 @@ void mdFileClose(struct MdFileData* pFileData)
 	{
 		close(pLinuxData->fd);
 
-		if (pFileData->mode == MD_FILE_MODE_READ && pFileData->content != MD_NULL)
+		if (pLinuxData->tempPath != MD_NULL)
+		{
+			// `rename` replaces the target atomically, a reader opens either the previous file or the new one. The
+			// rename only reaches the storage device once the directory itself is flushed.
+			b8 isReplaced = mdFileRename(pLinuxData->tempPath, pLinuxData->targetPath);
+			MD_ASSERT_MSG(isReplaced, "Failed to replace file \"%s\".", pLinuxData->targetPath);
+			if (isReplaced)
+			{
+				syncParentDirectory(pLinuxData->targetPath);
+			}
+			mdFileFreePath(pLinuxData->tempPath);
+			mdFileFreePath(pLinuxData->targetPath);
+		}
+
+		if (pLinuxData->isMapped)
+		{
+			munmap(pFileData->content, (size_t)pFileData->size);
+		}
+		else if (pFileData->mode == MD_FILE_MODE_READ && pFileData->content != MD_NULL)
 		{
 			MD_FREE_ARRAY(pFileData->content, char, pFileData->size + 1);
 		}
@@ -108,4 +404,24 @@ void mdFileClose(struct MdFileData* pFileData)
 	MD_FREE(pFileData, struct MdFileData);
 }
 
+void mdFileDiscard(struct MdFileData* pFileData)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->mode == MD_FILE_MODE_WRITE_ATOMIC);
+
+	struct LinuxFileData* pLinuxData = (struct LinuxFileData*)pFileData->pInternal;
+	MD_ASSERT(pLinuxData != MD_NULL);
+
+	if (pFileData->isOpen)
+	{
+		close(pLinuxData->fd);
+		unlink(pLinuxData->tempPath);
+		mdFileFreePath(pLinuxData->tempPath);
+		mdFileFreePath(pLinuxData->targetPath);
+	}
+
+	MD_FREE(pLinuxData, struct LinuxFileData);
+	MD_FREE(pFileData, struct MdFileData);
+}
+
 #endif // PLATFORM_IS_LINUX
\ No newline at end of file
@@ -0,0 +1,502 @@
+#if PLATFORM_IS_LINUX
+#include "MEEDEngine/platforms/console.h"
+#include "MEEDEngine/platforms/file_watcher.h"
+#include "MEEDEngine/platforms/time.h"
+#include <dirent.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define WATCHER_EVENT_MASK                                                                                             \
+	(IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF)
+
+#define WATCHER_READ_BUFFER_SIZE 4096
+
+/**
+ * A watch requested by the user.
+ */
+struct UserWatch
+{
+	mdFileWatchId id;
+	b8			  recursive;
+	char		  path[MD_FILE_WATCHER_MAX_PATH_LENGTH];
+};
+
+/**
+ * One inotify watch. A file is watched through its directory, so it survives being replaced by a rename.
+ */
+struct DirectoryWatch
+{
+	i32			  wd;
+	mdFileWatchId watchId;
+	char		  path[MD_FILE_WATCHER_MAX_PATH_LENGTH];
+	char		  fileName[MD_FILE_WATCHER_MAX_PATH_LENGTH]; ///< The only file reported, empty for directory watches.
+};
+
+/**
+ * An event waiting for its path to stay quiet.
+ */
+struct PendingEvent
+{
+	struct MdFileWatchEvent event;
+	u64						lastChangeTime; ///< In milliseconds.
+};
+
+struct MdFileWatcher
+{
+	i32			  fd;
+	u32			  debounceMilliseconds;
+	mdFileWatchId nextId;
+
+	struct UserWatch* pWatches;
+	u32				  watchesCount;
+	u32				  watchesCapacity;
+
+	struct DirectoryWatch* pDirectories;
+	u32					   directoriesCount;
+	u32					   directoriesCapacity;
+
+	struct PendingEvent* pPending;
+	u32					 pendingCount;
+	u32					 pendingCapacity;
+};
+
+/**
+ * Makes room for one more element at the end of an array.
+ */
+static void reserveOne(void** ppArray, u32 count, u32* pCapacity, mdSize elementSize)
+{
+	if (count < *pCapacity)
+	{
+		return;
+	}
+
+	u32 capacity = *pCapacity != 0 ? *pCapacity * 2 : 16u;
+	u8* pArray	 = MD_MALLOC_ARRAY(u8, elementSize * capacity);
+	if (*ppArray != MD_NULL)
+	{
+		mdMemoryCopy(pArray, *ppArray, elementSize * count);
+		MD_FREE_ARRAY(*ppArray, u8, elementSize * *pCapacity);
+	}
+	*ppArray   = pArray;
+	*pCapacity = capacity;
+}
+
+static struct UserWatch* findUserWatch(struct MdFileWatcher* pWatcher, mdFileWatchId id)
+{
+	for (u32 i = 0; i < pWatcher->watchesCount; ++i)
+	{
+		if (pWatcher->pWatches[i].id == id)
+		{
+			return &pWatcher->pWatches[i];
+		}
+	}
+	return MD_NULL;
+}
+
+static void pushEvent(struct MdFileWatcher*		pWatcher,
+					  mdFileWatchId				watchId,
+					  const char*				path,
+					  enum MdFileWatchEventType type)
+{
+	u64 now = mdGetTicks() / MD_TICKS_PER_MILLISECOND;
+
+	for (u32 i = 0; i < pWatcher->pendingCount; ++i)
+	{
+		struct PendingEvent* pPending = &pWatcher->pPending[i];
+		if (pPending->event.watchId != watchId || strcmp(pPending->event.path, path) != 0)
+		{
+			continue;
+		}
+
+		enum MdFileWatchEventType previous = pPending->event.type;
+		if (previous == MD_FILE_WATCH_EVENT_TYPE_CREATED && type == MD_FILE_WATCH_EVENT_TYPE_DELETED)
+		{
+			// Created and removed before anyone looked, e.g. a swap file.
+			pWatcher->pPending[i] = pWatcher->pPending[--pWatcher->pendingCount];
+			return;
+		}
+
+		if (previous == MD_FILE_WATCH_EVENT_TYPE_DELETED && type != MD_FILE_WATCH_EVENT_TYPE_DELETED)
+		{
+			pPending->event.type = MD_FILE_WATCH_EVENT_TYPE_MODIFIED;
+		}
+		else if (previous != MD_FILE_WATCH_EVENT_TYPE_CREATED && previous != MD_FILE_WATCH_EVENT_TYPE_OVERFLOW)
+		{
+			pPending->event.type = type;
+		}
+		pPending->lastChangeTime = now;
+		return;
+	}
+
+	reserveOne((void**)&pWatcher->pPending,
+			   pWatcher->pendingCount,
+			   &pWatcher->pendingCapacity,
+			   sizeof(struct PendingEvent));
+
+	struct PendingEvent* pPending = &pWatcher->pPending[pWatcher->pendingCount++];
+	pPending->event.watchId		  = watchId;
+	pPending->event.type		  = type;
+	pPending->lastChangeTime	  = now;
+	mdFormatString(pPending->event.path, MD_FILE_WATCHER_MAX_PATH_LENGTH, "%s", path);
+}
+
+static b8 addDirectoryWatch(struct MdFileWatcher* pWatcher,
+							mdFileWatchId		  watchId,
+							const char*			  path,
+							const char*			  fileName)
+{
+	i32 wd = inotify_add_watch(pWatcher->fd, path, WATCHER_EVENT_MASK);
+	if (wd < 0)
+	{
+		return MD_FALSE;
+	}
+
+	reserveOne((void**)&pWatcher->pDirectories,
+			   pWatcher->directoriesCount,
+			   &pWatcher->directoriesCapacity,
+			   sizeof(struct DirectoryWatch));
+
+	struct DirectoryWatch* pDirectory = &pWatcher->pDirectories[pWatcher->directoriesCount++];
+	pDirectory->wd					  = wd;
+	pDirectory->watchId				  = watchId;
+	mdFormatString(pDirectory->path, MD_FILE_WATCHER_MAX_PATH_LENGTH, "%s", path);
+	mdFormatString(pDirectory->fileName, MD_FILE_WATCHER_MAX_PATH_LENGTH, "%s", fileName);
+	return MD_TRUE;
+}
+
+/**
+ * Watches a directory and its subdirectories. With `reportFiles`, the files already inside are reported as created,
+ * they may have been written before the watch existed (e.g. a directory copied into a watched one).
+ */
+static void addDirectoryTree(struct MdFileWatcher* pWatcher, mdFileWatchId watchId, const char* path, b8 reportFiles)
+{
+	if (!addDirectoryWatch(pWatcher, watchId, path, ""))
+	{
+		return;
+	}
+
+	DIR* pDirectory = opendir(path);
+	if (pDirectory == MD_NULL)
+	{
+		return;
+	}
+
+	struct dirent* pEntry;
+	while ((pEntry = readdir(pDirectory)) != MD_NULL)
+	{
+		if (strcmp(pEntry->d_name, ".") == 0 || strcmp(pEntry->d_name, "..") == 0)
+		{
+			continue;
+		}
+
+		char childPath[MD_FILE_WATCHER_MAX_PATH_LENGTH];
+		mdFormatString(childPath, sizeof(childPath), "%s/%s", path, pEntry->d_name);
+
+		struct stat childStat;
+		if (stat(childPath, &childStat) != 0)
+		{
+			continue;
+		}
+
+		if (S_ISDIR(childStat.st_mode))
+		{
+			addDirectoryTree(pWatcher, watchId, childPath, reportFiles);
+		}
+		else if (reportFiles)
+		{
+			pushEvent(pWatcher, watchId, childPath, MD_FILE_WATCH_EVENT_TYPE_CREATED);
+		}
+	}
+
+	closedir(pDirectory);
+}
+
+static void removeDirectoryWatch(struct MdFileWatcher* pWatcher, u32 index, b8 removeKernelWatch)
+{
+	i32 wd = pWatcher->pDirectories[index].wd;
+	pWatcher->pDirectories[index] = pWatcher->pDirectories[--pWatcher->directoriesCount];
+
+	if (!removeKernelWatch)
+	{
+		return;
+	}
+
+	// The kernel returns the same descriptor for every watch of a directory, keep it while another watch uses it.
+	for (u32 i = 0; i < pWatcher->directoriesCount; ++i)
+	{
+		if (pWatcher->pDirectories[i].wd == wd)
+		{
+			return;
+		}
+	}
+	inotify_rm_watch(pWatcher->fd, wd);
+}
+
+static void handleNotification(struct MdFileWatcher* pWatcher, const struct inotify_event* pNotification)
+{
+	if (pNotification->mask & IN_Q_OVERFLOW)
+	{
+		for (u32 i = 0; i < pWatcher->watchesCount; ++i)
+		{
+			struct UserWatch* pWatch = &pWatcher->pWatches[i];
+			pushEvent(pWatcher, pWatch->id, pWatch->path, MD_FILE_WATCH_EVENT_TYPE_OVERFLOW);
+		}
+		return;
+	}
+
+	if (pNotification->mask & IN_IGNORED)
+	{
+		// The directory was removed, the kernel dropped its watch already.
+		for (u32 i = pWatcher->directoriesCount; i > 0; --i)
+		{
+			if (pWatcher->pDirectories[i - 1].wd == pNotification->wd)
+			{
+				removeDirectoryWatch(pWatcher, i - 1, MD_FALSE);
+			}
+		}
+		return;
+	}
+
+	if (pNotification->len == 0 || (pNotification->mask & IN_DELETE_SELF))
+	{
+		return;
+	}
+
+	enum MdFileWatchEventType type = MD_FILE_WATCH_EVENT_TYPE_MODIFIED;
+	if (pNotification->mask & IN_CREATE)
+	{
+		type = MD_FILE_WATCH_EVENT_TYPE_CREATED;
+	}
+	else if (pNotification->mask & (IN_DELETE | IN_MOVED_FROM))
+	{
+		type = MD_FILE_WATCH_EVENT_TYPE_DELETED;
+	}
+
+	// Adding a watch may grow the directories array, iterate over the count known before.
+	u32 directoriesCount = pWatcher->directoriesCount;
+	for (u32 i = 0; i < directoriesCount; ++i)
+	{
+		const struct DirectoryWatch* pDirectory = &pWatcher->pDirectories[i];
+		if (pDirectory->wd != pNotification->wd)
+		{
+			continue;
+		}
+
+		struct UserWatch* pUserWatch = findUserWatch(pWatcher, pDirectory->watchId);
+		MD_ASSERT(pUserWatch != MD_NULL);
+
+		if (pDirectory->fileName[0] != '\0')
+		{
+			if (strcmp(pDirectory->fileName, pNotification->name) == 0)
+			{
+				pushEvent(pWatcher, pUserWatch->id, pUserWatch->path, type);
+			}
+			continue;
+		}
+
+		char path[MD_FILE_WATCHER_MAX_PATH_LENGTH];
+		mdFormatString(path, sizeof(path), "%s/%s", pDirectory->path, pNotification->name);
+
+		if (pNotification->mask & IN_ISDIR)
+		{
+			if (pUserWatch->recursive && (pNotification->mask & (IN_CREATE | IN_MOVED_TO)))
+			{
+				addDirectoryTree(pWatcher, pUserWatch->id, path, MD_TRUE);
+			}
+			continue;
+		}
+
+		pushEvent(pWatcher, pUserWatch->id, path, type);
+	}
+}
+
+struct MdFileWatcher* mdFileWatcherCreate(u32 debounceMilliseconds)
+{
+	struct MdFileWatcher* pWatcher = MD_MALLOC(struct MdFileWatcher);
+	mdMemorySet(pWatcher, 0, sizeof(struct MdFileWatcher));
+
+	pWatcher->fd				   = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	pWatcher->debounceMilliseconds = debounceMilliseconds;
+	pWatcher->nextId			   = MD_FILE_WATCH_INVALID_ID + 1;
+	MD_ASSERT_MSG(pWatcher->fd >= 0, "Failed to initialize inotify (errno %d).", errno);
+
+	return pWatcher;
+}
+
+mdFileWatchId mdFileWatcherAdd(struct MdFileWatcher* pWatcher, const char* path, b8 recursive)
+{
+	MD_ASSERT(pWatcher != MD_NULL);
+	MD_ASSERT(path != MD_NULL);
+
+	struct stat pathStat;
+	if (pWatcher->fd < 0 || stat(path, &pathStat) != 0 || strlen(path) >= MD_FILE_WATCHER_MAX_PATH_LENGTH)
+	{
+		return MD_FILE_WATCH_INVALID_ID;
+	}
+
+	mdFileWatchId id = pWatcher->nextId;
+
+	if (S_ISDIR(pathStat.st_mode))
+	{
+		u32 directoriesCount = pWatcher->directoriesCount;
+		if (recursive)
+		{
+			addDirectoryTree(pWatcher, id, path, MD_FALSE);
+		}
+		else
+		{
+			addDirectoryWatch(pWatcher, id, path, "");
+		}
+
+		if (pWatcher->directoriesCount == directoriesCount)
+		{
+			return MD_FILE_WATCH_INVALID_ID;
+		}
+	}
+	else
+	{
+		char		directory[MD_FILE_WATCHER_MAX_PATH_LENGTH];
+		const char* separator = strrchr(path, '/');
+		if (separator == MD_NULL)
+		{
+			mdFormatString(directory, sizeof(directory), ".");
+		}
+		else if (separator == path)
+		{
+			mdFormatString(directory, sizeof(directory), "/");
+		}
+		else
+		{
+			mdFormatString(directory, sizeof(directory), "%.*s", (int)(separator - path), path);
+		}
+
+		if (!addDirectoryWatch(pWatcher, id, directory, separator != MD_NULL ? separator + 1 : path))
+		{
+			return MD_FILE_WATCH_INVALID_ID;
+		}
+	}
+
+	reserveOne((void**)&pWatcher->pWatches,
+			   pWatcher->watchesCount,
+			   &pWatcher->watchesCapacity,
+			   sizeof(struct UserWatch));
+
+	struct UserWatch* pUserWatch = &pWatcher->pWatches[pWatcher->watchesCount++];
+	pUserWatch->id				 = id;
+	pUserWatch->recursive		 = recursive;
+	mdFormatString(pUserWatch->path, MD_FILE_WATCHER_MAX_PATH_LENGTH, "%s", path);
+
+	pWatcher->nextId++;
+	return id;
+}
+
+void mdFileWatcherRemove(struct MdFileWatcher* pWatcher, mdFileWatchId id)
+{
+	MD_ASSERT(pWatcher != MD_NULL);
+
+	for (u32 i = pWatcher->directoriesCount; i > 0; --i)
+	{
+		if (pWatcher->pDirectories[i - 1].watchId == id)
+		{
+			removeDirectoryWatch(pWatcher, i - 1, MD_TRUE);
+		}
+	}
+
+	for (u32 i = pWatcher->pendingCount; i > 0; --i)
+	{
+		if (pWatcher->pPending[i - 1].event.watchId == id)
+		{
+			pWatcher->pPending[i - 1] = pWatcher->pPending[--pWatcher->pendingCount];
+		}
+	}
+
+	for (u32 i = 0; i < pWatcher->watchesCount; ++i)
+	{
+		if (pWatcher->pWatches[i].id == id)
+		{
+			pWatcher->pWatches[i] = pWatcher->pWatches[--pWatcher->watchesCount];
+			break;
+		}
+	}
+}
+
+u32 mdFileWatcherPoll(struct MdFileWatcher* pWatcher, struct MdFileWatchEvent* pEvents, u32 maxEvents)
+{
+	MD_ASSERT(pWatcher != MD_NULL);
+	MD_ASSERT(pEvents != MD_NULL || maxEvents == 0);
+
+	if (pWatcher->fd < 0)
+	{
+		return 0;
+	}
+
+	char buffer[WATCHER_READ_BUFFER_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+	for (;;)
+	{
+		ssize_t bytesRead = read(pWatcher->fd, buffer, sizeof(buffer));
+		if (bytesRead < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (bytesRead <= 0)
+		{
+			break; // EAGAIN, nothing more to read.
+		}
+
+		for (char* pPosition = buffer; pPosition < buffer + bytesRead;)
+		{
+			const struct inotify_event* pNotification = (const struct inotify_event*)pPosition;
+			handleNotification(pWatcher, pNotification);
+			pPosition += sizeof(struct inotify_event) + pNotification->len;
+		}
+	}
+
+	// Report the quiet events in the order they were first seen.
+	u64 now			= mdGetTicks() / MD_TICKS_PER_MILLISECOND;
+	u32 eventsCount = 0;
+	u32 keptCount	= 0;
+	for (u32 i = 0; i < pWatcher->pendingCount; ++i)
+	{
+		struct PendingEvent* pPending = &pWatcher->pPending[i];
+		if (eventsCount < maxEvents && now - pPending->lastChangeTime >= pWatcher->debounceMilliseconds)
+		{
+			pEvents[eventsCount++] = pPending->event;
+		}
+		else
+		{
+			pWatcher->pPending[keptCount++] = *pPending;
+		}
+	}
+	pWatcher->pendingCount = keptCount;
+
+	return eventsCount;
+}
+
+void mdFileWatcherDestroy(struct MdFileWatcher* pWatcher)
+{
+	MD_ASSERT(pWatcher != MD_NULL);
+
+	if (pWatcher->fd >= 0)
+	{
+		close(pWatcher->fd); // Drops every inotify watch.
+	}
+
+	if (pWatcher->pWatches != MD_NULL)
+	{
+		MD_FREE_ARRAY(pWatcher->pWatches, struct UserWatch, pWatcher->watchesCapacity);
+	}
+	if (pWatcher->pDirectories != MD_NULL)
+	{
+		MD_FREE_ARRAY(pWatcher->pDirectories, struct DirectoryWatch, pWatcher->directoriesCapacity);
+	}
+	if (pWatcher->pPending != MD_NULL)
+	{
+		MD_FREE_ARRAY(pWatcher->pPending, struct PendingEvent, pWatcher->pendingCapacity);
+	}
+	MD_FREE(pWatcher, struct MdFileWatcher);
+}
+
+#endif // PLATFORM_IS_LINUX
@@ -0,0 +1,52 @@
+#if PLATFORM_IS_WEB || PLATFORM_IS_WINDOWS
+#include "MEEDEngine/platforms/file_watcher.h"
+
+/**
+ * No native backend yet: the browser file system never changes and Windows would need `ReadDirectoryChangesW`.
+ * The watches are accepted so the callers do not need platform checks, they simply never report any event.
+ */
+
+struct MdFileWatcher
+{
+	mdFileWatchId nextId;
+};
+
+struct MdFileWatcher* mdFileWatcherCreate(u32 debounceMilliseconds)
+{
+	MD_UNUSED(debounceMilliseconds);
+
+	struct MdFileWatcher* pWatcher = MD_MALLOC(struct MdFileWatcher);
+	pWatcher->nextId			   = MD_FILE_WATCH_INVALID_ID + 1;
+	return pWatcher;
+}
+
+mdFileWatchId mdFileWatcherAdd(struct MdFileWatcher* pWatcher, const char* path, b8 recursive)
+{
+	MD_ASSERT(pWatcher != MD_NULL);
+	MD_ASSERT(path != MD_NULL);
+	MD_UNUSED(recursive);
+
+	return pWatcher->nextId++;
+}
+
+void mdFileWatcherRemove(struct MdFileWatcher* pWatcher, mdFileWatchId id)
+{
+	MD_ASSERT(pWatcher != MD_NULL);
+	MD_UNUSED(id);
+}
+
+u32 mdFileWatcherPoll(struct MdFileWatcher* pWatcher, struct MdFileWatchEvent* pEvents, u32 maxEvents)
+{
+	MD_ASSERT(pWatcher != MD_NULL);
+	MD_ASSERT(pEvents != MD_NULL || maxEvents == 0);
+
+	return 0;
+}
+
+void mdFileWatcherDestroy(struct MdFileWatcher* pWatcher)
+{
+	MD_ASSERT(pWatcher != MD_NULL);
+	MD_FREE(pWatcher, struct MdFileWatcher);
+}
+
+#endif // PLATFORM_IS_WEB || PLATFORM_IS_WINDOWS
@@ -1,15 +1,28 @@
 #if PLATFORM_IS_WINDOWS
 #include "MEEDEngine/platforms/common.h"
 #include "MEEDEngine/platforms/file.h"
+#include "MEEDEngine/platforms/profile.h"
+#include "file_internal.h"
 #include <windows.h>
 
 struct WindowsFileData
 {
 	HANDLE file;
+	HANDLE mapping;	 ///< The file mapping object of `MD_FILE_MODE_READ_MAPPED`, NULL otherwise.
+	char*  tempPath;   ///< The file written in `MD_FILE_MODE_WRITE_ATOMIC`, moved over `targetPath` on close.
+	char*  targetPath; ///< The copy of the path given to `mdFileOpen` in `MD_FILE_MODE_WRITE_ATOMIC`.
 };
 
 struct MdFileData* mdFileOpen(const char* filePath, enum MdFileMode mode)
 {
+	MD_PROFILE_SCOPE("mdFileOpen");
+
+	struct MdFileData* pPackedFile = mdPackFileOpen(filePath, mode);
+	if (pPackedFile != MD_NULL)
+	{
+		return pPackedFile;
+	}
+
 	struct MdFileData* pFileData = MD_MALLOC(struct MdFileData);
 	MD_ASSERT(pFileData != MD_NULL);
 	mdMemorySet(pFileData, 0, sizeof(struct MdFileData));
@@ -21,43 +34,166 @@ struct MdFileData* mdFileOpen(const char* filePath, enum MdFileMode mode)
 	pFileData->pInternal = MD_MALLOC(struct WindowsFileData);
 	MD_ASSERT(pFileData->pInternal != MD_NULL);
 	struct WindowsFileData* pWindowsData = (struct WindowsFileData*)pFileData->pInternal;
+	pWindowsData->mapping				 = NULL;
 
-	pWindowsData->file = CreateFileA(filePath,
-									 (mode == MD_FILE_MODE_READ) ? GENERIC_READ : GENERIC_WRITE,
-									 0,
+	b8	  isAtomic	  = mode == MD_FILE_MODE_WRITE_ATOMIC;
+	b8	  isRead	  = mode != MD_FILE_MODE_WRITE && mode != MD_FILE_MODE_APPEND && !isAtomic;
+	DWORD flags		  = (mode == MD_FILE_MODE_READ_MAPPED) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL;
+	DWORD disposition = isRead ? OPEN_EXISTING : (isAtomic ? CREATE_ALWAYS : OPEN_ALWAYS);
+
+	pWindowsData->tempPath	 = isAtomic ? mdFileCreateTempPath(filePath) : MD_NULL;
+	pWindowsData->targetPath = MD_NULL;
+
+	pWindowsData->file = CreateFileA(isAtomic ? pWindowsData->tempPath : filePath,
+									 isRead ? GENERIC_READ : GENERIC_WRITE,
+									 isRead ? FILE_SHARE_READ : 0,
 									 NULL,
-									 (mode == MD_FILE_MODE_READ) ? OPEN_EXISTING : OPEN_ALWAYS,
-									 FILE_ATTRIBUTE_NORMAL,
+									 disposition,
+									 flags,
 									 NULL);
 
 	if (pWindowsData->file == INVALID_HANDLE_VALUE)
 	{
+		if (isAtomic)
+		{
+			mdFileFreePath(pWindowsData->tempPath);
+			pWindowsData->tempPath = MD_NULL;
+		}
 		return pFileData;
 	}
 
-	DWORD size		= GetFileSize(pWindowsData->file, NULL);
-	pFileData->size = (u32)size;
+	if (isAtomic)
+	{
+		pWindowsData->targetPath = mdFileCopyPath(filePath);
+		pFileData->filePath		 = pWindowsData->targetPath;
+	}
+
+	pFileData->isOpen = MD_TRUE;
 
-	pFileData->content = MD_MALLOC_ARRAY(i8, pFileData->size + 1);
-	MD_ASSERT(pFileData->content != MD_NULL);
-	DWORD bytesRead = 0;
-	ReadFile(pWindowsData->file, pFileData->content, size, &bytesRead, NULL);
-	MD_ASSERT_MSG(bytesRead == size,
-				  "Failed to read entire file: Expected %u "
-				  "bytes, but read %u bytes.",
-				  size,
-				  bytesRead);
-	pFileData->isOpen		 = MD_TRUE;
-	pFileData->content[size] = '\0'; // Null-terminate the content buffer
+	if (!isRead)
+	{
+		return pFileData;
+	}
+
+	LARGE_INTEGER fileSize;
+	pFileData->size = GetFileSizeEx(pWindowsData->file, &fileSize) ? (u64)fileSize.QuadPart : 0;
+
+	if (mode == MD_FILE_MODE_READ_MAPPED)
+	{
+		// Empty files cannot be mapped, the content stays MD_NULL.
+		if (pFileData->size > 0)
+		{
+			pWindowsData->mapping = CreateFileMappingA(pWindowsData->file, NULL, PAGE_READONLY, 0, 0, NULL);
+			MD_ASSERT_MSG(pWindowsData->mapping != NULL, "Failed to map file \"%s\".", filePath);
+			if (pWindowsData->mapping != NULL)
+			{
+				pFileData->content = (char*)MapViewOfFile(pWindowsData->mapping, FILE_MAP_READ, 0, 0, 0);
+			}
+			if (pFileData->content == MD_NULL)
+			{
+				// Same as a failed read: a file without its content is reported as not opened.
+				if (pWindowsData->mapping != NULL)
+				{
+					CloseHandle(pWindowsData->mapping);
+					pWindowsData->mapping = NULL;
+				}
+				CloseHandle(pWindowsData->file);
+				pWindowsData->file = INVALID_HANDLE_VALUE;
+				pFileData->isOpen  = MD_FALSE;
+			}
+		}
+	}
+	else if (mode == MD_FILE_MODE_READ)
+	{
+		pFileData->content = MD_MALLOC_ARRAY(i8, pFileData->size + 1);
+		MD_ASSERT(pFileData->content != MD_NULL);
+		u64 bytesRead = mdFileReadAt(pFileData, 0, pFileData->content, pFileData->size);
+		if (bytesRead != pFileData->size)
+		{
+			// The file shrank or a read failed: the file is reported as not opened rather than truncated.
+			MD_FREE_ARRAY(pFileData->content, i8, pFileData->size + 1);
+			pFileData->content = MD_NULL;
+			CloseHandle(pWindowsData->file);
+			pWindowsData->file = INVALID_HANDLE_VALUE;
+			pFileData->isOpen  = MD_FALSE;
+		}
+		else
+		{
+			pFileData->content[pFileData->size] = '\0'; // Null-terminate the content buffer
+		}
+	}
 
 	return pFileData;
 }
 
+b8 mdFileIsOpen(struct MdFileData* pFileData)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	return pFileData->isOpen;
+}
+
+u64 mdFileReadAt(struct MdFileData* pFileData, u64 offset, void* pDestination, u64 size)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+	MD_ASSERT(pFileData->mode != MD_FILE_MODE_WRITE && pFileData->mode != MD_FILE_MODE_APPEND &&
+			  pFileData->mode != MD_FILE_MODE_WRITE_ATOMIC);
+	MD_ASSERT(pDestination != MD_NULL || size == 0);
+
+	if (pFileData->isPacked)
+	{
+		return mdPackFileReadAt(pFileData, offset, pDestination, size);
+	}
+
+	struct WindowsFileData* pWindowsData = (struct WindowsFileData*)pFileData->pInternal;
+
+	// `ReadFile` takes a 32-bit size, the position is passed through the OVERLAPPED structure.
+	u64 totalRead = 0;
+	while (totalRead < size)
+	{
+		u64	  remaining = size - totalRead;
+		DWORD toRead	= remaining > 0x40000000ull ? 0x40000000u : (DWORD)remaining;
+		u64	  position	= offset + totalRead;
+
+		OVERLAPPED overlapped;
+		mdMemorySet(&overlapped, 0, sizeof(OVERLAPPED));
+		overlapped.Offset	  = (DWORD)(position & 0xFFFFFFFFull);
+		overlapped.OffsetHigh = (DWORD)(position >> 32);
+
+		DWORD bytesRead = 0;
+		if (!ReadFile(pWindowsData->file, (u8*)pDestination + totalRead, toRead, &bytesRead, &overlapped) ||
+			bytesRead == 0)
+		{
+			break;
+		}
+		totalRead += bytesRead;
+	}
+
+	return totalRead;
+}
+
+void mdFilePrefetch(struct MdFileData* pFileData, u64 offset, u64 size)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+
+	// The packs are mapped, their pages were already hinted when mounting.
+	if (pFileData->isPacked)
+	{
+		return;
+	}
+
+	// No readahead hint for plain handles, the cache manager already reads ahead sequential accesses.
+	MD_UNUSED(offset);
+	MD_UNUSED(size);
+}
+
 void mdFileWrite(struct MdFileData* pFileData, const char* data, mdSize size)
 {
 	MD_ASSERT(pFileData != MD_NULL);
 	MD_ASSERT(pFileData->isOpen == MD_TRUE);
-	MD_ASSERT(pFileData->mode == MD_FILE_MODE_WRITE || pFileData->mode == MD_FILE_MODE_APPEND);
+	MD_ASSERT(pFileData->mode == MD_FILE_MODE_WRITE || pFileData->mode == MD_FILE_MODE_APPEND ||
+			  pFileData->mode == MD_FILE_MODE_WRITE_ATOMIC);
 
 	struct WindowsFileData* pWindowsData = (struct WindowsFileData*)pFileData->pInternal;
 	DWORD					bytesWritten = 0;
@@ -69,17 +205,141 @@ void mdFileWrite(struct MdFileData* pFileData, const char* data, mdSize size)
 				  bytesWritten);
 }
 
-void mdFileClose(struct MdFileData* pFileData)
+void mdFileWriteAt(struct MdFileData* pFileData, u64 offset, const void* pSource, u64 size)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->isOpen == MD_TRUE);
+	MD_ASSERT(pFileData->mode == MD_FILE_MODE_WRITE || pFileData->mode == MD_FILE_MODE_APPEND ||
+			  pFileData->mode == MD_FILE_MODE_WRITE_ATOMIC);
+	MD_ASSERT(pSource != MD_NULL || size == 0);
+
+	struct WindowsFileData* pWindowsData = (struct WindowsFileData*)pFileData->pInternal;
+
+	u64 totalWritten = 0;
+	while (totalWritten < size)
+	{
+		u64	  remaining = size - totalWritten;
+		DWORD toWrite	= remaining > 0x40000000ull ? 0x40000000u : (DWORD)remaining;
+		u64	  position	= offset + totalWritten;
+
+		OVERLAPPED overlapped;
+		mdMemorySet(&overlapped, 0, sizeof(OVERLAPPED));
+		overlapped.Offset	  = (DWORD)(position & 0xFFFFFFFFull);
+		overlapped.OffsetHigh = (DWORD)(position >> 32);
+
+		DWORD bytesWritten = 0;
+		if (!WriteFile(pWindowsData->file, (const u8*)pSource + totalWritten, toWrite, &bytesWritten, &overlapped) ||
+			bytesWritten == 0)
+		{
+			MD_ASSERT_MSG(MD_FALSE, "Failed to write to file \"%s\".", pFileData->filePath);
+			return;
+		}
+		totalWritten += bytesWritten;
+	}
+}
+
+void mdFileWriteVector(struct MdFileData* pFileData, const struct MdFileBuffer* pBuffers, u32 buffersCount)
+{
+	MD_ASSERT(pBuffers != MD_NULL || buffersCount == 0);
+
+	for (u32 bufferIndex = 0u; bufferIndex < buffersCount; ++bufferIndex)
+	{
+		mdFileWrite(pFileData, (const char*)pBuffers[bufferIndex].pData, pBuffers[bufferIndex].size);
+	}
+}
+
+void mdFileSync(struct MdFileData* pFileData)
 {
 	MD_ASSERT(pFileData != MD_NULL);
 	MD_ASSERT(pFileData->isOpen == MD_TRUE);
 
 	struct WindowsFileData* pWindowsData = (struct WindowsFileData*)pFileData->pInternal;
-	CloseHandle(pWindowsData->file);
+	FlushFileBuffers(pWindowsData->file);
+}
+
+b8 mdFileExists(const char* filePath)
+{
+	MD_ASSERT(filePath != MD_NULL);
+	return GetFileAttributesA(filePath) != INVALID_FILE_ATTRIBUTES ? MD_TRUE : MD_FALSE;
+}
+
+b8 mdFileRename(const char* oldPath, const char* newPath)
+{
+	MD_ASSERT(oldPath != MD_NULL);
+	MD_ASSERT(newPath != MD_NULL);
+	return MoveFileExA(oldPath, newPath, MOVEFILE_REPLACE_EXISTING) ? MD_TRUE : MD_FALSE;
+}
+
+b8 mdFileRemove(const char* filePath)
+{
+	MD_ASSERT(filePath != MD_NULL);
+	return DeleteFileA(filePath) ? MD_TRUE : MD_FALSE;
+}
+
+void mdFileClose(struct MdFileData* pFileData)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+
+	if (pFileData->isPacked)
+	{
+		mdPackFileClose(pFileData);
+		return;
+	}
+
+	struct WindowsFileData* pWindowsData = (struct WindowsFileData*)pFileData->pInternal;
+	if (pFileData->isOpen)
+	{
+		CloseHandle(pWindowsData->file);
+	}
 
 	pFileData->isOpen = MD_FALSE;
 
-	MD_FREE_ARRAY(pFileData->content, i8, pFileData->size + 1);
+	if (pWindowsData->tempPath != MD_NULL)
+	{
+		// Replaces the target in one step, a reader opens either the previous file or the new one. The write-through
+		// flag returns once the move is flushed to the storage device.
+		b8 isReplaced = MoveFileExA(pWindowsData->tempPath,
+									pWindowsData->targetPath,
+									MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) ? MD_TRUE : MD_FALSE;
+		MD_ASSERT_MSG(isReplaced, "Failed to replace file \"%s\".", pWindowsData->targetPath);
+		MD_UNUSED(isReplaced);
+		mdFileFreePath(pWindowsData->tempPath);
+		mdFileFreePath(pWindowsData->targetPath);
+	}
+
+	if (pFileData->mode == MD_FILE_MODE_READ_MAPPED)
+	{
+		if (pFileData->content != MD_NULL)
+		{
+			UnmapViewOfFile(pFileData->content);
+		}
+		if (pWindowsData->mapping != NULL)
+		{
+			CloseHandle(pWindowsData->mapping);
+		}
+	}
+	else if (pFileData->mode == MD_FILE_MODE_READ && pFileData->content != MD_NULL)
+	{
+		MD_FREE_ARRAY(pFileData->content, i8, pFileData->size + 1);
+	}
+
+	MD_FREE(pWindowsData, struct WindowsFileData);
+	MD_FREE(pFileData, struct MdFileData);
+}
+
+void mdFileDiscard(struct MdFileData* pFileData)
+{
+	MD_ASSERT(pFileData != MD_NULL);
+	MD_ASSERT(pFileData->mode == MD_FILE_MODE_WRITE_ATOMIC);
+
+	struct WindowsFileData* pWindowsData = (struct WindowsFileData*)pFileData->pInternal;
+	if (pFileData->isOpen)
+	{
+		CloseHandle(pWindowsData->file);
+		DeleteFileA(pWindowsData->tempPath);
+		mdFileFreePath(pWindowsData->tempPath);
+		mdFileFreePath(pWindowsData->targetPath);
+	}
 
 	MD_FREE(pWindowsData, struct WindowsFileData);
 	MD_FREE(pFileData, struct MdFileData);
@@ -0,0 +1,178 @@
+#include "MEEDEngine/platforms/frame_loop.h"
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/profile.h"
+
+#define FRAME_LOOP_DEFAULT_FIXED_TIMESTEP		(1.0 / 60.0)
+#define FRAME_LOOP_DEFAULT_MAX_STEPS_PER_FRAME	8u
+#define FRAME_LOOP_MIN_SPIN_TICKS				(MD_FRAME_LOOP_MIN_SPIN_MICROSECONDS * MD_TICKS_PER_MICROSECOND)
+#define FRAME_LOOP_MAX_SPIN_TICKS				(MD_FRAME_LOOP_MAX_SPIN_MICROSECONDS * MD_TICKS_PER_MICROSECOND)
+#define FRAME_LOOP_INITIAL_SPIN_TICKS			(1000ull * MD_TICKS_PER_MICROSECOND)
+
+struct MdFrameLoopConfig mdFrameLoopGetDefaultConfig()
+{
+	struct MdFrameLoopConfig config;
+	config.fixedTimestep	= FRAME_LOOP_DEFAULT_FIXED_TIMESTEP;
+	config.targetFrameRate	= 0.0;
+	config.maxStepsPerFrame = FRAME_LOOP_DEFAULT_MAX_STEPS_PER_FRAME;
+	config.isLateLatched	= MD_FALSE;
+	return config;
+}
+
+struct MdFrameLoop* mdFrameLoopCreate(const struct MdFrameLoopConfig* pConfig,
+									  const struct MdFrameLoopCallbacks* pCallbacks)
+{
+	MD_ASSERT(pConfig != MD_NULL);
+	MD_ASSERT(pCallbacks != MD_NULL);
+	MD_ASSERT(pConfig->fixedTimestep >= 0.0);
+	MD_ASSERT(pConfig->fixedTimestep == 0.0 || pConfig->maxStepsPerFrame > 0);
+
+	struct MdFrameLoop* pLoop = MD_MALLOC(struct MdFrameLoop);
+	MD_ASSERT(pLoop != MD_NULL);
+	mdMemorySet(pLoop, 0, sizeof(struct MdFrameLoop));
+
+	pLoop->config		  = *pConfig;
+	pLoop->callbacks	  = *pCallbacks;
+	pLoop->fixedStepTicks = mdSecondsToTicks(pConfig->fixedTimestep);
+	pLoop->spinTicks	  = FRAME_LOOP_INITIAL_SPIN_TICKS;
+	mdFrameLoopSetTargetFrameRate(pLoop, pConfig->targetFrameRate);
+
+	return pLoop;
+}
+
+static void waitForDeadline(struct MdFrameLoop* pLoop)
+{
+	MD_PROFILE_SCOPE("Frame Pacing");
+
+	mdTicks oversleepTicks = mdSleepUntil(pLoop->nextDeadlineTicks, pLoop->spinTicks);
+
+	// The margin grows at once after a late wake-up, so the next deadlines are not missed, and shrinks slowly back
+	// when the scheduler is punctual, to not burn the CPU spinning.
+	if (oversleepTicks > pLoop->spinTicks)
+	{
+		pLoop->spinTicks = oversleepTicks + oversleepTicks / 2;
+	}
+	else
+	{
+		pLoop->spinTicks -= pLoop->spinTicks / 16;
+	}
+	if (pLoop->spinTicks < FRAME_LOOP_MIN_SPIN_TICKS)
+	{
+		pLoop->spinTicks = FRAME_LOOP_MIN_SPIN_TICKS;
+	}
+	if (pLoop->spinTicks > FRAME_LOOP_MAX_SPIN_TICKS)
+	{
+		pLoop->spinTicks = FRAME_LOOP_MAX_SPIN_TICKS;
+	}
+}
+
+void mdFrameLoopRunFrame(struct MdFrameLoop* pLoop)
+{
+	MD_ASSERT(pLoop != MD_NULL);
+
+	if (pLoop->targetFrameTicks != 0 && pLoop->nextDeadlineTicks != 0)
+	{
+		waitForDeadline(pLoop);
+	}
+
+	mdTicks now			 = mdGetTicks();
+	mdTicks elapsedTicks = pLoop->lastFrameTicks != 0 ? now - pLoop->lastFrameTicks : 0;
+	pLoop->lastFrameTicks = now;
+
+	if (pLoop->targetFrameTicks != 0)
+	{
+		// The deadlines follow a fixed schedule, a late frame does not delay the next ones. A frame late by more than a
+		// whole frame restarts the schedule instead of running the next frames back to back to catch up.
+		if (pLoop->nextDeadlineTicks == 0 || now >= pLoop->nextDeadlineTicks + pLoop->targetFrameTicks)
+		{
+			pLoop->lastLatenessTicks = 0;
+			pLoop->nextDeadlineTicks = now + pLoop->targetFrameTicks;
+		}
+		else
+		{
+			pLoop->lastLatenessTicks = now > pLoop->nextDeadlineTicks ? now - pLoop->nextDeadlineTicks : 0;
+			pLoop->nextDeadlineTicks += pLoop->targetFrameTicks;
+		}
+	}
+
+	mdFrameLoopAdvance(pLoop, elapsedTicks);
+}
+
+u32 mdFrameLoopAdvance(struct MdFrameLoop* pLoop, mdTicks elapsedTicks)
+{
+	MD_ASSERT(pLoop != MD_NULL);
+
+	struct MdFrameLoopCallbacks* pCallbacks	  = &pLoop->callbacks;
+	mdTicks						 maxDeltaTicks = mdSecondsToTicks(MD_FRAME_LOOP_MAX_DELTA_SECONDS);
+	if (elapsedTicks > maxDeltaTicks)
+	{
+		elapsedTicks = maxDeltaTicks;
+	}
+
+	if (pCallbacks->pollInput != MD_NULL)
+	{
+		pCallbacks->pollInput(pCallbacks->pUserData);
+	}
+
+	u32 stepsCount = 0;
+	if (pLoop->fixedStepTicks == 0)
+	{
+		if (pCallbacks->update != MD_NULL)
+		{
+			pCallbacks->update(mdTicksToSeconds(elapsedTicks), pCallbacks->pUserData);
+		}
+		stepsCount	 = 1;
+		pLoop->alpha = 1.0;
+	}
+	else
+	{
+		pLoop->accumulatorTicks += elapsedTicks;
+		while (pLoop->accumulatorTicks >= pLoop->fixedStepTicks && stepsCount < pLoop->config.maxStepsPerFrame)
+		{
+			if (pCallbacks->update != MD_NULL)
+			{
+				pCallbacks->update(pLoop->config.fixedTimestep, pCallbacks->pUserData);
+			}
+			pLoop->accumulatorTicks -= pLoop->fixedStepTicks;
+			++stepsCount;
+		}
+
+		// The simulation is slower than the real time: the late steps are dropped rather than accumulated, which
+		// would make every next frame slower still.
+		if (pLoop->accumulatorTicks >= pLoop->fixedStepTicks)
+		{
+			pLoop->droppedStepsCount += pLoop->accumulatorTicks / pLoop->fixedStepTicks;
+			pLoop->accumulatorTicks %= pLoop->fixedStepTicks;
+		}
+		pLoop->alpha = (f64)pLoop->accumulatorTicks / (f64)pLoop->fixedStepTicks;
+	}
+	pLoop->stepsCount += stepsCount;
+
+	if (pLoop->config.isLateLatched && pCallbacks->pollInput != MD_NULL)
+	{
+		pCallbacks->pollInput(pCallbacks->pUserData);
+	}
+
+	if (pCallbacks->render != MD_NULL)
+	{
+		pCallbacks->render(pLoop->alpha, pCallbacks->pUserData);
+	}
+	++pLoop->framesCount;
+
+	return stepsCount;
+}
+
+void mdFrameLoopSetTargetFrameRate(struct MdFrameLoop* pLoop, f64 targetFrameRate)
+{
+	MD_ASSERT(pLoop != MD_NULL);
+	MD_ASSERT(targetFrameRate >= 0.0);
+
+	pLoop->config.targetFrameRate = targetFrameRate;
+	pLoop->targetFrameTicks		  = targetFrameRate > 0.0 ? mdSecondsToTicks(1.0 / targetFrameRate) : 0;
+	pLoop->nextDeadlineTicks	  = 0;
+}
+
+void mdFrameLoopDestroy(struct MdFrameLoop* pLoop)
+{
+	MD_ASSERT(pLoop != MD_NULL);
+	MD_FREE(pLoop, struct MdFrameLoop);
+}
@@ -1,4 +1,5 @@
 #include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/thread.h"
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -27,6 +28,7 @@ struct MemoryNode
 
 	struct MemoryNode* pNext;
 	struct MemoryNode* pPrev;
+	struct MemoryNode* pBucketNext; ///< The next node of the same bucket of `s_pMemoryBuckets`.
 };
 /**
  * Must be tracked to avoid multiple initializations and non-initializations.
@@ -39,12 +41,24 @@ static b8 s_isInitialized = MD_FALSE;
 static struct MemoryNode* s_pMemoryHead = MD_NULL;
 static struct MemoryNode* s_pMemoryTail = MD_NULL;
 
+/**
+ * The nodes chained by the hash of their pointer, `mdFree` finds its node without walking every allocation.
+ */
+#define MEMORY_BUCKETS_BITS 12
+static struct MemoryNode* s_pMemoryBuckets[1u << MEMORY_BUCKETS_BITS] = {MD_NULL};
+
 /**
  * Be modified by the `_malloc` and `_free` functions, just be used for
  * debugging purposes to track the total allocated memory size.
  */
 static mdSize s_totalAllocatedMemory = 0;
 
+/**
+ * Guards the linked list and the total, the allocations may come from any thread. A spinlock needs no initialization
+ * and the critical sections are short: the backtraces are captured outside of them.
+ */
+static struct MdSpinlock s_memoryLock = {0};
+
 /**
  * Internal function for allocating memory without tracking but adding the allocation size to the total allocated
  * memory.
@@ -61,6 +75,20 @@ static void* _malloc(mdSize size);
  */
 static void _free(void* ptr, mdSize size);
 
+/**
+ * Internal function for choosing the bucket of an allocation, a Fibonacci hash of its address.
+ * @param ptr A pointer to the memory block.
+ * @return The index of the bucket in `s_pMemoryBuckets`.
+ */
+static u32 _hashPtr(void* ptr);
+
+/**
+ * Internal function for finding the node of an allocation in its bucket.
+ * @param ptr A pointer to the memory block.
+ * @return The link pointing to the node, which points to `MD_NULL` if the memory block is not tracked.
+ */
+static struct MemoryNode** _findNodeLinkByPtr(void* ptr);
+
 void mdMemoryInitialize()
 {
 	MD_ASSERT(s_isInitialized == MD_FALSE);
@@ -79,18 +107,22 @@ void* mdMalloc(mdSize size)
 {
 	MD_ASSERT(s_isInitialized == MD_TRUE);
 
+	mdSpinlockLock(&s_memoryLock);
 	struct MemoryNode* pNode = (struct MemoryNode*)_malloc(sizeof(struct MemoryNode));
-	mdMemorySet(pNode, 0, sizeof(struct MemoryNode));
+	void*			   ptr	 = _malloc(size);
+	mdSpinlockUnlock(&s_memoryLock);
 
-	pNode->ptr	= _malloc(size);
+	mdMemorySet(pNode, 0, sizeof(struct MemoryNode));
+	pNode->ptr	= ptr;
 	pNode->size = size;
 
 #if PLATFORM_IS_LINUX
 	mdMemorySet(pNode->traceInfo.frames, 0, sizeof(void*) * MD_MAX_TRACE_FRAMES);
 	pNode->traceInfo.framesCount = backtrace(pNode->traceInfo.frames, MD_MAX_TRACE_FRAMES);
-	pNode->traceInfo.threadId	 = getpid();
+	pNode->traceInfo.threadId	 = mdThreadGetCurrentId();
 #endif
 
+	mdSpinlockLock(&s_memoryLock);
 	if (s_pMemoryHead == MD_NULL)
 	{
 		s_pMemoryHead = pNode;
@@ -104,17 +136,22 @@ void* mdMalloc(mdSize size)
 	pNode->pPrev  = s_pMemoryTail;
 	s_pMemoryTail = pNode;
 
+	struct MemoryNode** ppBucket = &s_pMemoryBuckets[_hashPtr(ptr)];
+	pNode->pBucketNext			 = *ppBucket;
+	*ppBucket					 = pNode;
+	mdSpinlockUnlock(&s_memoryLock);
+
 	MD_ASSERT(pNode->ptr != MD_NULL);
 	return pNode->ptr;
 }
 
-static struct MemoryNode* _findNodeByPtr(void* ptr);
-
 void mdFree(void* ptr, mdSize size)
 {
 	MD_ASSERT(s_isInitialized == MD_TRUE);
 
-	struct MemoryNode* pNode = _findNodeByPtr(ptr);
+	mdSpinlockLock(&s_memoryLock);
+	struct MemoryNode** ppNode = _findNodeLinkByPtr(ptr);
+	struct MemoryNode*	pNode  = *ppNode;
 	MD_ASSERT_MSG(pNode != MD_NULL, "Attempting to free untracked or already freed memory at address %p.", ptr);
 
 	MD_ASSERT_MSG(pNode->size == size,
@@ -125,7 +162,9 @@ void mdFree(void* ptr, mdSize size)
 
 	_free(ptr, pNode->size); // Note: size should be tracked and passed here for accurate memory tracking.
 
-	// Remove the node from the linked list.
+	// Remove the node from its bucket and from the linked list.
+	*ppNode = pNode->pBucketNext;
+
 	if (pNode->pPrev != MD_NULL)
 	{
 		pNode->pPrev->pNext = pNode->pNext;
@@ -145,6 +184,7 @@ void mdFree(void* ptr, mdSize size)
 	}
 
 	_free(pNode, sizeof(struct MemoryNode));
+	mdSpinlockUnlock(&s_memoryLock);
 }
 
 void* mdMemoryCopy(void* pDest, const void* pSrc, mdSize size)
@@ -195,19 +235,20 @@ static void _free(void* ptr, mdSize size)
 	free(ptr);
 }
 
-static struct MemoryNode* _findNodeByPtr(void* ptr)
+static u32 _hashPtr(void* ptr)
+{
+	return (u32)(((u64)(uintptr_t)ptr * 0x9E3779B97F4A7C15ull) >> (64 - MEMORY_BUCKETS_BITS));
+}
+
+static struct MemoryNode** _findNodeLinkByPtr(void* ptr)
 {
-	struct MemoryNode* pCurrent = s_pMemoryHead;
-	while (pCurrent != MD_NULL)
+	struct MemoryNode** ppCurrent = &s_pMemoryBuckets[_hashPtr(ptr)];
+	while (*ppCurrent != MD_NULL && (*ppCurrent)->ptr != ptr)
 	{
-		if (pCurrent->ptr == (void*)ptr)
-		{
-			return pCurrent;
-		}
-		pCurrent = pCurrent->pNext;
+		ppCurrent = &(*ppCurrent)->pBucketNext;
 	}
 
-	return MD_NULL;
+	return ppCurrent;
 }
 
 #else // MD_RELEASE
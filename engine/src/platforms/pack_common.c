@@ -0,0 +1,821 @@
+#include "MEEDEngine/platforms/pack.h"
+#include "MEEDEngine/platforms/thread.h"
+#include "file_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MD_PACK_FNV_OFFSET_BASIS 0xCBF29CE484222325ull
+#define MD_PACK_FNV_PRIME		 0x00000100000001B3ull
+
+#define LZ_HASH_BITS	  12
+#define LZ_MIN_MATCH	  4
+#define LZ_MAX_OFFSET	  0xFFFFu
+#define LZ_LENGTH_EXTENDS 15u
+
+/**
+ * The compression is a byte oriented LZ77 in the spirit of LZ4: fast to decode straight into the destination, no
+ * dependency. Each sequence is a token (high nibble: literals count, low nibble: match length - 4, 15 meaning that
+ * extra length bytes follow), the literals, then a 16-bit little-endian match offset. The last sequence only holds
+ * literals.
+ */
+
+struct MdPackWriter
+{
+	struct MdFileData*	pFile;
+	u32					alignment;
+	u64					offset; ///< The position of the next byte written.
+	struct MdPackEntry* pEntries;
+	u32					entriesCount;
+	u32					entriesCapacity;
+	char*				pNames;
+	u32					namesSize;
+	u32					namesCapacity;
+};
+
+struct PackMount
+{
+	struct MdFileData*		  pPackFile; ///< The pack, opened with `MD_FILE_MODE_READ_MAPPED`.
+	const struct MdPackEntry* pEntries;	 ///< The table of contents inside the mapping.
+	u32						  entriesCount;
+	const char*				  pNames;	///< The names inside the mapping.
+	char*					  packPath; ///< Copy of the pack path, referenced by `pPackFile`.
+	char*					  mountPoint;
+	u32						  mountPointLength;
+	u32						  openFilesCount; ///< The files opened from this pack, to be closed before unmounting.
+	struct PackMount*		  pNext;
+};
+
+/**
+ * Stored inside `MdFileData::pInternal` for the files opened from a pack.
+ */
+struct PackFileData
+{
+	struct PackMount*		  pMount;
+	const struct MdPackEntry* pEntry;
+	u8*						  pBuffer; ///< The null-terminated copy of the data, MD_NULL when read from the mapping.
+};
+
+/**
+ * The packed files are opened from any thread (the async file workers among others): the list is only changed under
+ * `s_packMountsLock`, and `PackMount::openFilesCount` is only updated atomically.
+ */
+static struct PackMount* s_pPackMounts	  = MD_NULL;
+static struct MdSpinlock s_packMountsLock = {0};
+
+static u32 lzRead32(const u8* pData)
+{
+	u32 value;
+	memcpy(&value, pData, sizeof(u32));
+	return value;
+}
+
+static b8 lzWriteLength(u8* pDst, u64 capacity, u64* pOut, u64 length)
+{
+	while (length >= 255u)
+	{
+		if (*pOut >= capacity)
+		{
+			return MD_FALSE;
+		}
+		pDst[(*pOut)++] = 255u;
+		length -= 255u;
+	}
+	if (*pOut >= capacity)
+	{
+		return MD_FALSE;
+	}
+	pDst[(*pOut)++] = (u8)length;
+	return MD_TRUE;
+}
+
+static b8 lzWriteSequence(u8*		pDst,
+						  u64		capacity,
+						  u64*		pOut,
+						  const u8* pLiterals,
+						  u64		literalsCount,
+						  u32		matchOffset,
+						  u64		matchLength)
+{
+	u64 literalsToken = literalsCount < LZ_LENGTH_EXTENDS ? literalsCount : LZ_LENGTH_EXTENDS;
+	u64 matchToken	  = 0;
+	if (matchLength > 0)
+	{
+		matchToken = matchLength - LZ_MIN_MATCH < LZ_LENGTH_EXTENDS ? matchLength - LZ_MIN_MATCH : LZ_LENGTH_EXTENDS;
+	}
+
+	if (*pOut >= capacity)
+	{
+		return MD_FALSE;
+	}
+	pDst[(*pOut)++] = (u8)((literalsToken << 4) | matchToken);
+
+	if (literalsToken == LZ_LENGTH_EXTENDS && !lzWriteLength(pDst, capacity, pOut, literalsCount - LZ_LENGTH_EXTENDS))
+	{
+		return MD_FALSE;
+	}
+
+	if (capacity - *pOut < literalsCount)
+	{
+		return MD_FALSE;
+	}
+	memcpy(pDst + *pOut, pLiterals, (size_t)literalsCount);
+	*pOut += literalsCount;
+
+	if (matchLength == 0)
+	{
+		return MD_TRUE;
+	}
+
+	if (capacity - *pOut < 2u)
+	{
+		return MD_FALSE;
+	}
+	pDst[(*pOut)++] = (u8)(matchOffset & 0xFFu);
+	pDst[(*pOut)++] = (u8)(matchOffset >> 8);
+
+	if (matchToken == LZ_LENGTH_EXTENDS)
+	{
+		return lzWriteLength(pDst, capacity, pOut, matchLength - LZ_MIN_MATCH - LZ_LENGTH_EXTENDS);
+	}
+	return MD_TRUE;
+}
+
+/**
+ * Compresses a buffer.
+ * @return The compressed size, or 0 if the result does not fit inside `capacity`.
+ */
+static u64 lzCompress(const u8* pSrc, u64 size, u8* pDst, u64 capacity)
+{
+	// Positions + 1, 0 marks an empty slot.
+	u32 table[1u << LZ_HASH_BITS];
+	memset(table, 0, sizeof(table));
+
+	u64 out	   = 0;
+	u64 anchor = 0;
+	u64 i	   = 0;
+	while (i + LZ_MIN_MATCH <= size)
+	{
+		u32 sequence  = lzRead32(pSrc + i);
+		u32 hash	  = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+		u64 candidate = table[hash];
+		table[hash]	  = (u32)(i + 1);
+
+		if (candidate == 0 || i - (candidate - 1) > LZ_MAX_OFFSET || lzRead32(pSrc + candidate - 1) != sequence)
+		{
+			i++;
+			continue;
+		}
+
+		u64 matchPosition = candidate - 1;
+		u64 matchLength	  = LZ_MIN_MATCH;
+		while (i + matchLength < size && pSrc[matchPosition + matchLength] == pSrc[i + matchLength])
+		{
+			matchLength++;
+		}
+
+		if (!lzWriteSequence(
+				pDst, capacity, &out, pSrc + anchor, i - anchor, (u32)(i - matchPosition), matchLength))
+		{
+			return 0;
+		}
+
+		i += matchLength;
+		anchor = i;
+	}
+
+	if (!lzWriteSequence(pDst, capacity, &out, pSrc + anchor, size - anchor, 0, 0))
+	{
+		return 0;
+	}
+	return out;
+}
+
+static b8 lzReadLength(const u8* pSrc, u64 srcSize, u64* pIn, u64* pLength)
+{
+	u8 byte;
+	do
+	{
+		if (*pIn >= srcSize)
+		{
+			return MD_FALSE;
+		}
+		byte = pSrc[(*pIn)++];
+		*pLength += byte;
+	} while (byte == 255u);
+	return MD_TRUE;
+}
+
+/**
+ * Decompresses a buffer, every offset and length is checked so a corrupted pack cannot write out of bounds.
+ * @return MD_TRUE if exactly `dstSize` bytes were decompressed.
+ */
+static b8 lzDecompress(const u8* pSrc, u64 srcSize, u8* pDst, u64 dstSize)
+{
+	u64 in	= 0;
+	u64 out = 0;
+	while (in < srcSize)
+	{
+		u8	token		  = pSrc[in++];
+		u64 literalsCount = token >> 4;
+		if (literalsCount == LZ_LENGTH_EXTENDS && !lzReadLength(pSrc, srcSize, &in, &literalsCount))
+		{
+			return MD_FALSE;
+		}
+		if (srcSize - in < literalsCount || dstSize - out < literalsCount)
+		{
+			return MD_FALSE;
+		}
+		memcpy(pDst + out, pSrc + in, (size_t)literalsCount);
+		in += literalsCount;
+		out += literalsCount;
+
+		if (in == srcSize)
+		{
+			break;
+		}
+
+		if (srcSize - in < 2u)
+		{
+			return MD_FALSE;
+		}
+		u64 matchOffset = (u64)pSrc[in] | ((u64)pSrc[in + 1] << 8);
+		in += 2;
+
+		u64 matchLength = (token & 0x0Fu);
+		if (matchLength == LZ_LENGTH_EXTENDS && !lzReadLength(pSrc, srcSize, &in, &matchLength))
+		{
+			return MD_FALSE;
+		}
+		matchLength += LZ_MIN_MATCH;
+
+		if (matchOffset == 0 || matchOffset > out || dstSize - out < matchLength)
+		{
+			return MD_FALSE;
+		}
+
+		// The match may overlap the bytes it produces (e.g. runs), copy byte by byte.
+		const u8* pMatch = pDst + out - matchOffset;
+		for (u64 j = 0; j < matchLength; ++j)
+		{
+			pDst[out + j] = pMatch[j];
+		}
+		out += matchLength;
+	}
+
+	return out == dstSize;
+}
+
+u64 mdPackHashPath(const char* path)
+{
+	MD_ASSERT(path != MD_NULL);
+
+	u64 hash = MD_PACK_FNV_OFFSET_BASIS;
+	for (const u8* pChar = (const u8*)path; *pChar != '\0'; ++pChar)
+	{
+		hash ^= *pChar;
+		hash *= MD_PACK_FNV_PRIME;
+	}
+	return hash;
+}
+
+static u64 alignUp(u64 value, u32 alignment)
+{
+	return (value + alignment - 1) & ~((u64)alignment - 1);
+}
+
+static void writerPad(struct MdPackWriter* pWriter, u64 alignment)
+{
+	static const u8 zeros[64] = {0};
+
+	u64 paddingSize = alignUp(pWriter->offset, (u32)alignment) - pWriter->offset;
+	while (paddingSize > 0)
+	{
+		u64 chunkSize = paddingSize < sizeof(zeros) ? paddingSize : sizeof(zeros);
+		mdFileWrite(pWriter->pFile, (const char*)zeros, (mdSize)chunkSize);
+		pWriter->offset += chunkSize;
+		paddingSize -= chunkSize;
+	}
+}
+
+struct MdPackWriter* mdPackWriterCreate(const char* packPath, u32 alignment)
+{
+	MD_ASSERT(packPath != MD_NULL);
+	MD_ASSERT_MSG((alignment & (alignment - 1)) == 0, "The pack alignment %u is not a power of two.", alignment);
+
+	// The pack replaces the previous one only once complete, so the processes which have the previous pack mapped
+	// keep reading valid data and a file watcher sees a single change.
+	struct MdFileData* pFile = mdFileOpen(packPath, MD_FILE_MODE_WRITE_ATOMIC);
+	if (!pFile->isOpen)
+	{
+		mdFileClose(pFile);
+		return MD_NULL;
+	}
+
+	struct MdPackWriter* pWriter = MD_MALLOC(struct MdPackWriter);
+	mdMemorySet(pWriter, 0, sizeof(struct MdPackWriter));
+	pWriter->pFile	   = pFile;
+	pWriter->alignment = alignment != 0 ? alignment : MD_PACK_DEFAULT_ALIGNMENT;
+
+	// The header is written last, once the table of contents is known, reserve its place.
+	struct MdPackHeader header;
+	mdMemorySet(&header, 0, sizeof(struct MdPackHeader));
+	mdFileWrite(pFile, (const char*)&header, sizeof(struct MdPackHeader));
+	pWriter->offset = sizeof(struct MdPackHeader);
+
+	return pWriter;
+}
+
+static void writerAddName(struct MdPackWriter* pWriter, struct MdPackEntry* pEntry, const char* path)
+{
+	u64 length = strlen(path);
+	MD_ASSERT_MSG(length <= 0xFFFFu, "The pack path \"%s\" is too long.", path);
+
+	if (pWriter->namesSize + length > pWriter->namesCapacity)
+	{
+		u32 capacity = pWriter->namesCapacity != 0 ? pWriter->namesCapacity : 1024u;
+		while (capacity < pWriter->namesSize + length)
+		{
+			capacity *= 2;
+		}
+
+		char* pNames = MD_MALLOC_ARRAY(char, capacity);
+		if (pWriter->pNames != MD_NULL)
+		{
+			mdMemoryCopy(pNames, pWriter->pNames, pWriter->namesSize);
+			MD_FREE_ARRAY(pWriter->pNames, char, pWriter->namesCapacity);
+		}
+		pWriter->pNames		   = pNames;
+		pWriter->namesCapacity = capacity;
+	}
+
+	mdMemoryCopy(pWriter->pNames + pWriter->namesSize, path, (mdSize)length);
+	pEntry->nameOffset = pWriter->namesSize;
+	pEntry->nameLength = (u16)length;
+	pWriter->namesSize += (u32)length;
+}
+
+void mdPackWriterAddData(struct MdPackWriter* pWriter, const char* path, const void* pData, u64 size, b8 compress)
+{
+	MD_ASSERT(pWriter != MD_NULL);
+	MD_ASSERT(path != MD_NULL);
+	MD_ASSERT(pData != MD_NULL || size == 0);
+
+	if (pWriter->entriesCount == pWriter->entriesCapacity)
+	{
+		u32					capacity = pWriter->entriesCapacity != 0 ? pWriter->entriesCapacity * 2 : 64u;
+		struct MdPackEntry* pEntries = MD_MALLOC_ARRAY(struct MdPackEntry, capacity);
+		if (pWriter->pEntries != MD_NULL)
+		{
+			mdMemoryCopy(pEntries, pWriter->pEntries, sizeof(struct MdPackEntry) * pWriter->entriesCount);
+			MD_FREE_ARRAY(pWriter->pEntries, struct MdPackEntry, pWriter->entriesCapacity);
+		}
+		pWriter->pEntries		 = pEntries;
+		pWriter->entriesCapacity = capacity;
+	}
+
+	writerPad(pWriter, pWriter->alignment);
+
+	struct MdPackEntry* pEntry = &pWriter->pEntries[pWriter->entriesCount++];
+	mdMemorySet(pEntry, 0, sizeof(struct MdPackEntry));
+	pEntry->pathHash   = mdPackHashPath(path);
+	pEntry->offset	   = pWriter->offset;
+	pEntry->size	   = size;
+	pEntry->storedSize = size;
+	writerAddName(pWriter, pEntry, path);
+
+	const void* pStored		= pData;
+	u8*			pCompressed = MD_NULL;
+	// Keep the compression only when it saves at least an eighth, decoding is not free.
+	u64 capacity = size - size / 8;
+	if (compress && size >= 64 && size <= 0xFFFFFFFFull)
+	{
+		pCompressed		   = MD_MALLOC_ARRAY(u8, capacity);
+		u64 compressedSize = lzCompress((const u8*)pData, size, pCompressed, capacity);
+		if (compressedSize != 0)
+		{
+			pStored			   = pCompressed;
+			pEntry->storedSize = compressedSize;
+			pEntry->flags |= MD_PACK_ENTRY_FLAG_COMPRESSED;
+		}
+	}
+
+	if (pEntry->storedSize > 0)
+	{
+		mdFileWrite(pWriter->pFile, (const char*)pStored, (mdSize)pEntry->storedSize);
+	}
+	pWriter->offset += pEntry->storedSize;
+
+	if (pCompressed != MD_NULL)
+	{
+		MD_FREE_ARRAY(pCompressed, u8, capacity);
+	}
+}
+
+b8 mdPackWriterAddFile(struct MdPackWriter* pWriter, const char* path, const char* sourcePath, b8 compress)
+{
+	MD_ASSERT(pWriter != MD_NULL);
+	MD_ASSERT(sourcePath != MD_NULL);
+
+	struct MdFileData* pSource = mdFileOpen(sourcePath, MD_FILE_MODE_READ_MAPPED);
+	if (!pSource->isOpen)
+	{
+		mdFileClose(pSource);
+		return MD_FALSE;
+	}
+
+	mdPackWriterAddData(pWriter, path, pSource->content, pSource->size, compress);
+	mdFileClose(pSource);
+	return MD_TRUE;
+}
+
+static int compareEntries(const void* pLeft, const void* pRight)
+{
+	u64 left  = ((const struct MdPackEntry*)pLeft)->pathHash;
+	u64 right = ((const struct MdPackEntry*)pRight)->pathHash;
+	return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+static void destroyWriter(struct MdPackWriter* pWriter)
+{
+	if (pWriter->pEntries != MD_NULL)
+	{
+		MD_FREE_ARRAY(pWriter->pEntries, struct MdPackEntry, pWriter->entriesCapacity);
+	}
+	if (pWriter->pNames != MD_NULL)
+	{
+		MD_FREE_ARRAY(pWriter->pNames, char, pWriter->namesCapacity);
+	}
+	MD_FREE(pWriter, struct MdPackWriter);
+}
+
+void mdPackWriterFinish(struct MdPackWriter* pWriter)
+{
+	MD_ASSERT(pWriter != MD_NULL);
+
+	if (pWriter->entriesCount > 0)
+	{
+		qsort(pWriter->pEntries, pWriter->entriesCount, sizeof(struct MdPackEntry), compareEntries);
+	}
+
+#if MD_DEBUG
+	for (u32 i = 1; i < pWriter->entriesCount; ++i)
+	{
+		const struct MdPackEntry* pPrevious = &pWriter->pEntries[i - 1];
+		const struct MdPackEntry* pEntry	= &pWriter->pEntries[i];
+		MD_ASSERT_MSG(pPrevious->pathHash != pEntry->pathHash || pPrevious->nameLength != pEntry->nameLength ||
+						  memcmp(pWriter->pNames + pPrevious->nameOffset,
+								 pWriter->pNames + pEntry->nameOffset,
+								 pEntry->nameLength) != 0,
+					  "The path \"%.*s\" was added twice to the pack.",
+					  (int)pEntry->nameLength,
+					  pWriter->pNames + pEntry->nameOffset);
+	}
+#endif
+
+	// The table of contents is read in place from the mapping, keep its 64-bit fields aligned.
+	writerPad(pWriter, sizeof(u64));
+
+	struct MdPackHeader header;
+	header.magic		= MD_PACK_MAGIC;
+	header.version		= MD_PACK_VERSION;
+	header.entriesCount = pWriter->entriesCount;
+	header.alignment	= pWriter->alignment;
+	header.tocOffset	= pWriter->offset;
+	header.namesOffset	= header.tocOffset + sizeof(struct MdPackEntry) * pWriter->entriesCount;
+	header.namesSize	= pWriter->namesSize;
+
+	struct MdFileBuffer buffers[2];
+	buffers[0].pData = pWriter->pEntries;
+	buffers[0].size	 = sizeof(struct MdPackEntry) * pWriter->entriesCount;
+	buffers[1].pData = pWriter->pNames;
+	buffers[1].size	 = pWriter->namesSize;
+	mdFileWriteVector(pWriter->pFile, buffers, 2);
+
+	mdFileWriteAt(pWriter->pFile, 0, &header, sizeof(struct MdPackHeader));
+	mdFileClose(pWriter->pFile);
+	destroyWriter(pWriter);
+}
+
+void mdPackWriterDiscard(struct MdPackWriter* pWriter)
+{
+	MD_ASSERT(pWriter != MD_NULL);
+
+	mdFileDiscard(pWriter->pFile);
+	destroyWriter(pWriter);
+}
+
+static char* copyString(const char* string, u32 length)
+{
+	char* copy = MD_MALLOC_ARRAY(char, length + 1);
+	mdMemoryCopy(copy, string, length);
+	copy[length] = '\0';
+	return copy;
+}
+
+static b8 isPackValid(const struct MdFileData* pPackFile)
+{
+	if (pPackFile->size < sizeof(struct MdPackHeader))
+	{
+		return MD_FALSE;
+	}
+
+	const struct MdPackHeader* pHeader = (const struct MdPackHeader*)pPackFile->content;
+	if (pHeader->magic != MD_PACK_MAGIC || pHeader->version != MD_PACK_VERSION)
+	{
+		return MD_FALSE;
+	}
+
+	u64 tocSize = sizeof(struct MdPackEntry) * (u64)pHeader->entriesCount;
+	if (pHeader->tocOffset % sizeof(u64) != 0 || pHeader->tocOffset > pPackFile->size ||
+		pPackFile->size - pHeader->tocOffset < tocSize || pHeader->namesOffset > pPackFile->size ||
+		pPackFile->size - pHeader->namesOffset < pHeader->namesSize)
+	{
+		return MD_FALSE;
+	}
+
+	const struct MdPackEntry* pEntries = (const struct MdPackEntry*)(pPackFile->content + pHeader->tocOffset);
+	for (u32 i = 0; i < pHeader->entriesCount; ++i)
+	{
+		if (pEntries[i].offset > pPackFile->size || pPackFile->size - pEntries[i].offset < pEntries[i].storedSize ||
+			(u64)pEntries[i].nameOffset + pEntries[i].nameLength > pHeader->namesSize)
+		{
+			return MD_FALSE;
+		}
+	}
+
+	return MD_TRUE;
+}
+
+b8 mdPackMount(const char* packPath, const char* mountPoint)
+{
+	MD_ASSERT(packPath != MD_NULL);
+	MD_ASSERT(mountPoint != MD_NULL);
+
+	struct PackMount* pMount = MD_MALLOC(struct PackMount);
+	mdMemorySet(pMount, 0, sizeof(struct PackMount));
+
+	pMount->packPath  = copyString(packPath, (u32)strlen(packPath));
+	pMount->pPackFile = mdFileOpen(pMount->packPath, MD_FILE_MODE_READ_MAPPED);
+
+	if (!pMount->pPackFile->isOpen || !isPackValid(pMount->pPackFile))
+	{
+		mdFileClose(pMount->pPackFile);
+		MD_FREE_ARRAY(pMount->packPath, char, strlen(pMount->packPath) + 1);
+		MD_FREE(pMount, struct PackMount);
+		return MD_FALSE;
+	}
+
+	const struct MdPackHeader* pHeader = (const struct MdPackHeader*)pMount->pPackFile->content;
+	pMount->pEntries	 = (const struct MdPackEntry*)(pMount->pPackFile->content + pHeader->tocOffset);
+	pMount->entriesCount = pHeader->entriesCount;
+	pMount->pNames		 = pMount->pPackFile->content + pHeader->namesOffset;
+
+	// "assets/" and "assets" are the same mount point.
+	u32 mountPointLength = (u32)strlen(mountPoint);
+	while (mountPointLength > 0 && mountPoint[mountPointLength - 1] == '/')
+	{
+		mountPointLength--;
+	}
+	pMount->mountPoint		 = copyString(mountPoint, mountPointLength);
+	pMount->mountPointLength = mountPointLength;
+
+	mdSpinlockLock(&s_packMountsLock);
+	pMount->pNext = s_pPackMounts;
+	MD_ATOMIC_STORE(&s_pPackMounts, pMount, MD_MEMORY_ORDER_RELEASE);
+	mdSpinlockUnlock(&s_packMountsLock);
+
+	return MD_TRUE;
+}
+
+void mdPackUnmount(const char* mountPoint)
+{
+	MD_ASSERT(mountPoint != MD_NULL);
+
+	u32 mountPointLength = (u32)strlen(mountPoint);
+	while (mountPointLength > 0 && mountPoint[mountPointLength - 1] == '/')
+	{
+		mountPointLength--;
+	}
+
+	mdSpinlockLock(&s_packMountsLock);
+
+	struct PackMount** ppMount = &s_pPackMounts;
+	while (*ppMount != MD_NULL && ((*ppMount)->mountPointLength != mountPointLength ||
+								   strncmp((*ppMount)->mountPoint, mountPoint, mountPointLength) != 0))
+	{
+		ppMount = &(*ppMount)->pNext;
+	}
+
+	struct PackMount* pMount = *ppMount;
+	MD_ASSERT_MSG(pMount != MD_NULL, "No pack is mounted at \"%s\".", mountPoint);
+	if (pMount == MD_NULL)
+	{
+		mdSpinlockUnlock(&s_packMountsLock);
+		return;
+	}
+	MD_ASSERT_MSG(MD_ATOMIC_LOAD(&pMount->openFilesCount, MD_MEMORY_ORDER_ACQUIRE) == 0,
+				  "%u files of the pack \"%s\" are still open.",
+				  MD_ATOMIC_LOAD(&pMount->openFilesCount, MD_MEMORY_ORDER_ACQUIRE),
+				  pMount->packPath);
+
+	MD_ATOMIC_STORE(ppMount, pMount->pNext, MD_MEMORY_ORDER_RELEASE);
+	mdSpinlockUnlock(&s_packMountsLock);
+
+	mdFileClose(pMount->pPackFile);
+	MD_FREE_ARRAY(pMount->packPath, char, strlen(pMount->packPath) + 1);
+	MD_FREE_ARRAY(pMount->mountPoint, char, pMount->mountPointLength + 1);
+	MD_FREE(pMount, struct PackMount);
+}
+
+static const struct MdPackEntry* findMountEntry(const struct PackMount* pMount, const char* path)
+{
+	const char* relativePath = path;
+	if (pMount->mountPointLength > 0)
+	{
+		if (strncmp(path, pMount->mountPoint, pMount->mountPointLength) != 0 ||
+			path[pMount->mountPointLength] != '/')
+		{
+			return MD_NULL;
+		}
+		relativePath = path + pMount->mountPointLength + 1;
+	}
+
+	u64 hash   = mdPackHashPath(relativePath);
+	u64 length = strlen(relativePath);
+
+	// Lower bound of the hash, then compare the names of the entries sharing it.
+	u32 first = 0;
+	u32 count = pMount->entriesCount;
+	while (count > 0)
+	{
+		u32 step = count / 2;
+		if (pMount->pEntries[first + step].pathHash < hash)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
+
+	for (u32 i = first; i < pMount->entriesCount && pMount->pEntries[i].pathHash == hash; ++i)
+	{
+		const struct MdPackEntry* pEntry = &pMount->pEntries[i];
+		if (pEntry->nameLength == length && memcmp(pMount->pNames + pEntry->nameOffset, relativePath, length) == 0)
+		{
+			return pEntry;
+		}
+	}
+
+	return MD_NULL;
+}
+
+static const struct MdPackEntry* findEntry(const char* path, struct PackMount** ppMount)
+{
+	for (struct PackMount* pMount = s_pPackMounts; pMount != MD_NULL; pMount = pMount->pNext)
+	{
+		const struct MdPackEntry* pEntry = findMountEntry(pMount, path);
+		if (pEntry != MD_NULL)
+		{
+			*ppMount = pMount;
+			return pEntry;
+		}
+	}
+	return MD_NULL;
+}
+
+const struct MdPackEntry* mdPackFindEntry(const char* path)
+{
+	MD_ASSERT(path != MD_NULL);
+
+	mdSpinlockLock(&s_packMountsLock);
+	struct PackMount*		  pMount = MD_NULL;
+	const struct MdPackEntry* pEntry = findEntry(path, &pMount);
+	mdSpinlockUnlock(&s_packMountsLock);
+	return pEntry;
+}
+
+struct MdFileData* mdPackFileOpen(const char* filePath, enum MdFileMode mode)
+{
+	if (MD_ATOMIC_LOAD(&s_pPackMounts, MD_MEMORY_ORDER_ACQUIRE) == MD_NULL || mode == MD_FILE_MODE_WRITE ||
+		mode == MD_FILE_MODE_APPEND || mode == MD_FILE_MODE_WRITE_ATOMIC)
+	{
+		return MD_NULL;
+	}
+
+	// The count is taken under the lock, the mount cannot be unmounted between the lookup and the open.
+	mdSpinlockLock(&s_packMountsLock);
+	struct PackMount*		  pMount = MD_NULL;
+	const struct MdPackEntry* pEntry = findEntry(filePath, &pMount);
+	if (pEntry != MD_NULL)
+	{
+		MD_ATOMIC_FETCH_ADD(&pMount->openFilesCount, 1u, MD_MEMORY_ORDER_RELAXED);
+	}
+	mdSpinlockUnlock(&s_packMountsLock);
+
+	if (pEntry == MD_NULL)
+	{
+		return MD_NULL;
+	}
+
+	struct PackFileData* pPackData = MD_MALLOC(struct PackFileData);
+	pPackData->pMount			   = pMount;
+	pPackData->pEntry			   = pEntry;
+	pPackData->pBuffer			   = MD_NULL;
+
+	const u8* pStored	   = (const u8*)pMount->pPackFile->content + pEntry->offset;
+	b8		  isCompressed = (pEntry->flags & MD_PACK_ENTRY_FLAG_COMPRESSED) != 0;
+
+	// Only the uncompressed entries can be used in place, the others always need their own buffer.
+	if (isCompressed || mode == MD_FILE_MODE_READ)
+	{
+		pPackData->pBuffer = MD_MALLOC_ARRAY(u8, pEntry->size + 1);
+		if (isCompressed && !lzDecompress(pStored, pEntry->storedSize, pPackData->pBuffer, pEntry->size))
+		{
+			// A corrupted entry is reported as a file which cannot be opened, not as garbage content.
+			MD_FREE_ARRAY(pPackData->pBuffer, u8, pEntry->size + 1);
+			MD_FREE(pPackData, struct PackFileData);
+			MD_ATOMIC_FETCH_SUB(&pMount->openFilesCount, 1u, MD_MEMORY_ORDER_RELEASE);
+
+			struct MdFileData* pFileData = MD_MALLOC(struct MdFileData);
+			mdMemorySet(pFileData, 0, sizeof(struct MdFileData));
+			pFileData->isPacked = MD_TRUE;
+			pFileData->isOpen	= MD_FALSE;
+			pFileData->filePath = filePath;
+			pFileData->mode		= mode;
+			return pFileData;
+		}
+		else if (!isCompressed)
+		{
+			mdMemoryCopy(pPackData->pBuffer, pStored, (mdSize)pEntry->size);
+		}
+		pPackData->pBuffer[pEntry->size] = '\0';
+	}
+
+	struct MdFileData* pFileData = MD_MALLOC(struct MdFileData);
+	mdMemorySet(pFileData, 0, sizeof(struct MdFileData));
+	pFileData->pInternal = pPackData;
+	pFileData->isPacked	 = MD_TRUE;
+	pFileData->isOpen	 = MD_TRUE;
+	pFileData->filePath	 = filePath;
+	pFileData->size		 = pEntry->size;
+	pFileData->mode		 = mode;
+
+	if (mode == MD_FILE_MODE_READ)
+	{
+		pFileData->content = (char*)pPackData->pBuffer;
+	}
+	else if (mode == MD_FILE_MODE_READ_MAPPED && pEntry->size > 0)
+	{
+		pFileData->content = pPackData->pBuffer != MD_NULL ? (char*)pPackData->pBuffer : (char*)pStored;
+	}
+
+	return pFileData;
+}
+
+u64 mdPackFileReadAt(struct MdFileData* pFileData, u64 offset, void* pDestination, u64 size)
+{
+	struct PackFileData* pPackData = (struct PackFileData*)pFileData->pInternal;
+	MD_ASSERT(pPackData != MD_NULL);
+
+	if (offset >= pFileData->size)
+	{
+		return 0;
+	}
+	if (size > pFileData->size - offset)
+	{
+		size = pFileData->size - offset;
+	}
+
+	const u8* pSource = pPackData->pBuffer != MD_NULL
+							? pPackData->pBuffer
+							: (const u8*)pPackData->pMount->pPackFile->content + pPackData->pEntry->offset;
+	mdMemoryCopy(pDestination, pSource + offset, (mdSize)size);
+	return size;
+}
+
+void mdPackFileClose(struct MdFileData* pFileData)
+{
+	struct PackFileData* pPackData = (struct PackFileData*)pFileData->pInternal;
+	if (pPackData == MD_NULL)
+	{
+		// The entry could not be opened, so nothing but the file data itself was allocated.
+		MD_FREE(pFileData, struct MdFileData);
+		return;
+	}
+
+	if (pPackData->pBuffer != MD_NULL)
+	{
+		MD_FREE_ARRAY(pPackData->pBuffer, u8, pPackData->pEntry->size + 1);
+	}
+
+	// Released last, the entry lives inside the mapping which the pack can be unmounted with right after.
+	u32 openFilesCount = MD_ATOMIC_FETCH_SUB(&pPackData->pMount->openFilesCount, 1u, MD_MEMORY_ORDER_RELEASE);
+	MD_ASSERT(openFilesCount > 0);
+	MD_UNUSED(openFilesCount);
+
+	MD_FREE(pPackData, struct PackFileData);
+	MD_FREE(pFileData, struct MdFileData);
+}
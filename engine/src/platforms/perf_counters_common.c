@@ -0,0 +1,34 @@
+#include "MEEDEngine/platforms/perf_counters.h"
+
+f64 mdPerfCountersGetIPC(const struct MdPerfCounterValues* pValues)
+{
+	MD_ASSERT(pValues != MD_NULL);
+
+	u32 required = MD_PERF_COUNTER_BIT(MD_PERF_COUNTER_CYCLES) | MD_PERF_COUNTER_BIT(MD_PERF_COUNTER_INSTRUCTIONS);
+	if ((pValues->availableMask & required) != required || pValues->values[MD_PERF_COUNTER_CYCLES] == 0)
+	{
+		return 0.0;
+	}
+
+	return (f64)pValues->values[MD_PERF_COUNTER_INSTRUCTIONS] / (f64)pValues->values[MD_PERF_COUNTER_CYCLES];
+}
+
+const char* mdPerfCounterGetName(enum MdPerfCounter counter)
+{
+	switch (counter)
+	{
+	case MD_PERF_COUNTER_CYCLES:
+		return "cycles";
+	case MD_PERF_COUNTER_INSTRUCTIONS:
+		return "instructions";
+	case MD_PERF_COUNTER_L1D_MISSES:
+		return "L1D misses";
+	case MD_PERF_COUNTER_LLC_MISSES:
+		return "LLC misses";
+	case MD_PERF_COUNTER_BRANCH_MISSES:
+		return "branch misses";
+	default:
+		MD_UNTOUCHABLE();
+		return "invalid";
+	}
+}
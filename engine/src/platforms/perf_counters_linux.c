@@ -0,0 +1,199 @@
+#if PLATFORM_IS_LINUX
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/perf_counters.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define PERF_COUNTER_CLOSED (-1)
+
+struct MdPerfCounters
+{
+	i32 leaderFd; ///< The first opened counter, the group is started, stopped and read through it.
+	i32 fds[MD_PERF_COUNTER_COUNT];
+	u64 ids[MD_PERF_COUNTER_COUNT]; ///< The kernel ids which identify the values in a group read.
+};
+
+/**
+ * The layout of a group read with `PERF_FORMAT_GROUP | PERF_FORMAT_ID` and both total times.
+ */
+struct PerfGroupRead
+{
+	u64 count;
+	u64 timeEnabled;
+	u64 timeRunning;
+	struct
+	{
+		u64 value;
+		u64 id;
+	} values[MD_PERF_COUNTER_COUNT];
+};
+
+static void getCounterConfig(enum MdPerfCounter counter, u32* pType, u64* pConfig)
+{
+	switch (counter)
+	{
+	case MD_PERF_COUNTER_CYCLES:
+		*pType	 = PERF_TYPE_HARDWARE;
+		*pConfig = PERF_COUNT_HW_CPU_CYCLES;
+		break;
+	case MD_PERF_COUNTER_INSTRUCTIONS:
+		*pType	 = PERF_TYPE_HARDWARE;
+		*pConfig = PERF_COUNT_HW_INSTRUCTIONS;
+		break;
+	case MD_PERF_COUNTER_L1D_MISSES:
+		*pType	 = PERF_TYPE_HW_CACHE;
+		*pConfig = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+				   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		break;
+	case MD_PERF_COUNTER_LLC_MISSES:
+		// The generic cache miss event maps to the last level cache on the common CPUs, unlike the LL cache event
+		// which several of them do not expose.
+		*pType	 = PERF_TYPE_HARDWARE;
+		*pConfig = PERF_COUNT_HW_CACHE_MISSES;
+		break;
+	case MD_PERF_COUNTER_BRANCH_MISSES:
+		*pType	 = PERF_TYPE_HARDWARE;
+		*pConfig = PERF_COUNT_HW_BRANCH_MISSES;
+		break;
+	default:
+		MD_UNTOUCHABLE();
+	}
+}
+
+static i32 openCounter(enum MdPerfCounter counter, i32 groupFd)
+{
+	struct perf_event_attr attributes;
+	mdMemorySet(&attributes, 0, sizeof(attributes));
+	attributes.size = sizeof(attributes);
+	getCounterConfig(counter, &attributes.type, (u64*)&attributes.config);
+
+	// Only the leader is disabled: the members follow it, so the whole group starts and stops at once.
+	attributes.disabled		  = groupFd == PERF_COUNTER_CLOSED;
+	attributes.exclude_kernel = 1;
+	attributes.exclude_hv	  = 1;
+	attributes.read_format =
+		PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	return (i32)syscall(SYS_perf_event_open, &attributes, 0, -1, groupFd, PERF_FLAG_FD_CLOEXEC);
+}
+
+struct MdPerfCounters* mdPerfCountersCreate()
+{
+	struct MdPerfCounters* pCounters = MD_MALLOC(struct MdPerfCounters);
+	MD_ASSERT(pCounters != MD_NULL);
+	mdMemorySet(pCounters, 0, sizeof(struct MdPerfCounters));
+	pCounters->leaderFd = PERF_COUNTER_CLOSED;
+
+	// A counter the CPU or the system refuses is skipped, the others are still measured.
+	for (u32 i = 0; i < MD_PERF_COUNTER_COUNT; ++i)
+	{
+		i32 fd			  = openCounter((enum MdPerfCounter)i, pCounters->leaderFd);
+		pCounters->fds[i] = fd >= 0 ? fd : PERF_COUNTER_CLOSED;
+		if (fd < 0)
+		{
+			continue;
+		}
+
+		if (ioctl(fd, PERF_EVENT_IOC_ID, &pCounters->ids[i]) != 0)
+		{
+			close(fd);
+			pCounters->fds[i] = PERF_COUNTER_CLOSED;
+			continue;
+		}
+
+		if (pCounters->leaderFd == PERF_COUNTER_CLOSED)
+		{
+			pCounters->leaderFd = fd;
+		}
+	}
+
+	return pCounters;
+}
+
+b8 mdPerfCountersIsAvailable(const struct MdPerfCounters* pCounters, enum MdPerfCounter counter)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+	MD_ASSERT(counter < MD_PERF_COUNTER_COUNT);
+
+	return pCounters->fds[counter] != PERF_COUNTER_CLOSED;
+}
+
+void mdPerfCountersStart(struct MdPerfCounters* pCounters)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+	if (pCounters->leaderFd == PERF_COUNTER_CLOSED)
+	{
+		return;
+	}
+
+	ioctl(pCounters->leaderFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(pCounters->leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void mdPerfCountersStop(struct MdPerfCounters* pCounters)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+	if (pCounters->leaderFd == PERF_COUNTER_CLOSED)
+	{
+		return;
+	}
+
+	ioctl(pCounters->leaderFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void mdPerfCountersRead(struct MdPerfCounters* pCounters, struct MdPerfCounterValues* pValues)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+	MD_ASSERT(pValues != MD_NULL);
+
+	mdMemorySet(pValues, 0, sizeof(struct MdPerfCounterValues));
+
+	struct PerfGroupRead groupRead;
+	if (pCounters->leaderFd == PERF_COUNTER_CLOSED ||
+		read(pCounters->leaderFd, &groupRead, sizeof(groupRead)) < (ssize_t)(3 * sizeof(u64)))
+	{
+		return;
+	}
+
+	// When more counters are opened than the CPU has registers, the kernel time-slices them: the counts are
+	// extrapolated to the whole region.
+	f64 scale = 1.0;
+	if (groupRead.timeRunning != 0 && groupRead.timeRunning < groupRead.timeEnabled)
+	{
+		scale			  = (f64)groupRead.timeEnabled / (f64)groupRead.timeRunning;
+		pValues->isScaled = MD_TRUE;
+	}
+
+	for (u64 i = 0; i < groupRead.count && i < MD_PERF_COUNTER_COUNT; ++i)
+	{
+		for (u32 counter = 0; counter < MD_PERF_COUNTER_COUNT; ++counter)
+		{
+			if (pCounters->fds[counter] != PERF_COUNTER_CLOSED && pCounters->ids[counter] == groupRead.values[i].id)
+			{
+				pValues->values[counter] = (u64)((f64)groupRead.values[i].value * scale);
+				pValues->availableMask |= MD_PERF_COUNTER_BIT(counter);
+				break;
+			}
+		}
+	}
+}
+
+void mdPerfCountersDestroy(struct MdPerfCounters* pCounters)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+
+	// The members are closed before the leader of their group.
+	for (i32 i = MD_PERF_COUNTER_COUNT - 1; i >= 0; --i)
+	{
+		if (pCounters->fds[i] != PERF_COUNTER_CLOSED)
+		{
+			close(pCounters->fds[i]);
+		}
+	}
+
+	MD_FREE(pCounters, struct MdPerfCounters);
+}
+
+#endif // PLATFORM_IS_LINUX
@@ -0,0 +1,53 @@
+#if PLATFORM_IS_WEB || PLATFORM_IS_WINDOWS
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/perf_counters.h"
+
+/**
+ * No backend: the browser exposes no hardware counter and Windows would need a kernel driver. Every counter is
+ * reported as unavailable.
+ */
+
+struct MdPerfCounters
+{
+	u32 unused;
+};
+
+struct MdPerfCounters* mdPerfCountersCreate()
+{
+	struct MdPerfCounters* pCounters = MD_MALLOC(struct MdPerfCounters);
+	MD_ASSERT(pCounters != MD_NULL);
+	return pCounters;
+}
+
+b8 mdPerfCountersIsAvailable(const struct MdPerfCounters* pCounters, enum MdPerfCounter counter)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+	MD_ASSERT(counter < MD_PERF_COUNTER_COUNT);
+	return MD_FALSE;
+}
+
+void mdPerfCountersStart(struct MdPerfCounters* pCounters)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+}
+
+void mdPerfCountersStop(struct MdPerfCounters* pCounters)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+}
+
+void mdPerfCountersRead(struct MdPerfCounters* pCounters, struct MdPerfCounterValues* pValues)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+	MD_ASSERT(pValues != MD_NULL);
+
+	mdMemorySet(pValues, 0, sizeof(struct MdPerfCounterValues));
+}
+
+void mdPerfCountersDestroy(struct MdPerfCounters* pCounters)
+{
+	MD_ASSERT(pCounters != MD_NULL);
+	MD_FREE(pCounters, struct MdPerfCounters);
+}
+
+#endif // PLATFORM_IS_WEB || PLATFORM_IS_WINDOWS
@@ -0,0 +1,326 @@
+#include "MEEDEngine/platforms/file.h"
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/profile.h"
+#include "MEEDEngine/platforms/thread.h"
+#include <string.h>
+
+#define PROFILE_PROCESS_ID 1
+
+enum ProfileEventType
+{
+	PROFILE_EVENT_TYPE_BEGIN,
+	PROFILE_EVENT_TYPE_END,
+	PROFILE_EVENT_TYPE_FRAME,
+};
+
+struct ProfileEvent
+{
+	const char* name; ///< The name of the zone, MD_NULL for the end events.
+	mdTicks		ticks;
+	u32			type; ///< A `ProfileEventType`.
+};
+
+/**
+ * The events of one thread. Only the owning thread writes `pEvents` and `count`, the exporter reads `count` with
+ * an acquire load so the events below it are complete.
+ */
+struct ProfileThreadBuffer
+{
+	struct ProfileThreadBuffer* pNext;
+	u32							threadId;	   ///< Sequential, the first thread which records an event is 1.
+	u32							generation;	   ///< The capture the events belong to.
+	u32							count;		   ///< The number of recorded events.
+	u32							droppedCount;  ///< The events which did not fit into the buffer.
+	struct ProfileEvent			pEvents[MD_PROFILE_THREAD_EVENTS_CAPACITY];
+};
+
+static struct ProfileThreadBuffer* s_pProfileBuffers = MD_NULL; ///< Every thread buffer, pushed lock-free.
+static u32						   s_profileThreadsCount = 0;
+
+static b8  s_isProfileCapturing	  = MD_FALSE;
+static b8  s_isProfileCaptureArmed = MD_FALSE;
+static u32 s_profileGeneration	   = 0; ///< Incremented by every capture, lets each thread reset its own buffer.
+static u32 s_profileFramesLeft	   = 0; ///< The frames left in the capture, 0 for an unlimited capture.
+static b8  s_isProfileFrameLimited = MD_FALSE;
+
+static MD_THREAD_LOCAL struct ProfileThreadBuffer* t_pProfileBuffer = MD_NULL;
+
+static struct ProfileThreadBuffer* getThreadBuffer()
+{
+	if (t_pProfileBuffer != MD_NULL)
+	{
+		return t_pProfileBuffer;
+	}
+
+	// The memory tracker can be used from any thread, the buffer is released by `mdProfileShutdown`.
+	struct ProfileThreadBuffer* pBuffer = MD_MALLOC(struct ProfileThreadBuffer);
+	MD_ASSERT(pBuffer != MD_NULL);
+	mdMemorySet(pBuffer, 0, sizeof(struct ProfileThreadBuffer));
+	pBuffer->threadId = MD_ATOMIC_FETCH_ADD(&s_profileThreadsCount, 1u, MD_MEMORY_ORDER_RELAXED) + 1;
+
+	pBuffer->pNext = MD_ATOMIC_LOAD(&s_pProfileBuffers, MD_MEMORY_ORDER_RELAXED);
+	while (!MD_ATOMIC_COMPARE_EXCHANGE_WEAK(
+		&s_pProfileBuffers, &pBuffer->pNext, pBuffer, MD_MEMORY_ORDER_RELEASE, MD_MEMORY_ORDER_RELAXED))
+	{
+	}
+
+	t_pProfileBuffer = pBuffer;
+	return pBuffer;
+}
+
+static void recordEvent(const char* name, enum ProfileEventType type)
+{
+	if (!MD_ATOMIC_LOAD(&s_isProfileCapturing, MD_MEMORY_ORDER_RELAXED))
+	{
+		return;
+	}
+
+	mdTicks						ticks	= mdGetTicks();
+	struct ProfileThreadBuffer* pBuffer = getThreadBuffer();
+
+	// The first event of a new capture discards the events of the previous one.
+	u32 generation = MD_ATOMIC_LOAD(&s_profileGeneration, MD_MEMORY_ORDER_ACQUIRE);
+	if (pBuffer->generation != generation)
+	{
+		pBuffer->generation	  = generation;
+		pBuffer->droppedCount = 0;
+		MD_ATOMIC_STORE(&pBuffer->count, 0u, MD_MEMORY_ORDER_RELEASE);
+	}
+
+	u32 count = pBuffer->count;
+	if (count == MD_PROFILE_THREAD_EVENTS_CAPACITY)
+	{
+		pBuffer->droppedCount++;
+		return;
+	}
+
+	struct ProfileEvent* pEvent = &pBuffer->pEvents[count];
+	pEvent->name				= name;
+	pEvent->ticks				= ticks;
+	pEvent->type				= type;
+	MD_ATOMIC_STORE(&pBuffer->count, count + 1, MD_MEMORY_ORDER_RELEASE);
+}
+
+void mdProfileBegin(const char* name)
+{
+	MD_ASSERT(name != MD_NULL);
+	recordEvent(name, PROFILE_EVENT_TYPE_BEGIN);
+}
+
+void mdProfileEnd()
+{
+	recordEvent(MD_NULL, PROFILE_EVENT_TYPE_END);
+}
+
+void mdProfileScopeEnd(const char** pName)
+{
+	MD_UNUSED(pName);
+	recordEvent(MD_NULL, PROFILE_EVENT_TYPE_END);
+}
+
+void mdProfileFrameMark()
+{
+	if (s_isProfileCaptureArmed)
+	{
+		s_isProfileCaptureArmed = MD_FALSE;
+		MD_ATOMIC_FETCH_ADD(&s_profileGeneration, 1u, MD_MEMORY_ORDER_RELEASE);
+		MD_ATOMIC_STORE(&s_isProfileCapturing, MD_TRUE, MD_MEMORY_ORDER_RELAXED);
+	}
+	else if (s_isProfileFrameLimited && mdProfileIsCapturing() && --s_profileFramesLeft == 0)
+	{
+		mdProfileCaptureStop();
+		return;
+	}
+
+	recordEvent("Frame", PROFILE_EVENT_TYPE_FRAME);
+}
+
+void mdProfileCaptureStart(u32 framesCount)
+{
+	mdProfileCaptureStop();
+
+	s_isProfileCaptureArmed = MD_TRUE;
+	s_isProfileFrameLimited = framesCount != 0;
+	s_profileFramesLeft		= framesCount;
+}
+
+void mdProfileCaptureStop()
+{
+	s_isProfileCaptureArmed = MD_FALSE;
+	MD_ATOMIC_STORE(&s_isProfileCapturing, MD_FALSE, MD_MEMORY_ORDER_RELAXED);
+}
+
+b8 mdProfileIsCapturing()
+{
+	return MD_ATOMIC_LOAD(&s_isProfileCapturing, MD_MEMORY_ORDER_RELAXED);
+}
+
+/**
+ * Writes a JSON string, the names are usually literals so escaping is rarely needed.
+ */
+static void writeJsonString(struct MdFileBufferedWriter* pWriter, const char* string)
+{
+	mdFileBufferedWriterWrite(pWriter, "\"", 1);
+	for (const char* pChar = string; *pChar != '\0'; ++pChar)
+	{
+		if (*pChar == '"' || *pChar == '\\')
+		{
+			mdFileBufferedWriterWrite(pWriter, "\\", 1);
+		}
+		if ((u8)*pChar >= 0x20)
+		{
+			mdFileBufferedWriterWrite(pWriter, pChar, 1);
+		}
+	}
+	mdFileBufferedWriterWrite(pWriter, "\"", 1);
+}
+
+static void writeEvent(struct MdFileBufferedWriter* pWriter,
+					   b8*							pIsFirst,
+					   const char*					name,
+					   const char*					phase,
+					   mdTicks						ticks,
+					   mdTicks						originTicks,
+					   u32							threadId)
+{
+	char line[160];
+	mdFileBufferedWriterWrite(pWriter, *pIsFirst ? "\n" : ",\n", *pIsFirst ? 1 : 2);
+	*pIsFirst = MD_FALSE;
+
+	mdFileBufferedWriterWrite(pWriter, "{\"name\":", 8);
+	writeJsonString(pWriter, name);
+
+	// The timestamps are in microseconds, the fraction keeps the nanoseconds.
+	u64 nanoseconds = ticks - originTicks;
+	mdFormatString(line,
+				   sizeof(line),
+				   ",\"ph\":\"%s\",\"ts\":%llu.%03llu,\"pid\":%d,\"tid\":%u%s}",
+				   phase,
+				   (unsigned long long)(nanoseconds / 1000u),
+				   (unsigned long long)(nanoseconds % 1000u),
+				   PROFILE_PROCESS_ID,
+				   threadId,
+				   phase[0] == 'i' ? ",\"s\":\"g\"" : "");
+	mdFileBufferedWriterWrite(pWriter, line, strlen(line));
+}
+
+b8 mdProfileExportChromeTrace(const char* filePath)
+{
+	MD_ASSERT(filePath != MD_NULL);
+	MD_ASSERT_MSG(!mdProfileIsCapturing(), "The capture must be stopped before exporting it.");
+
+	u32							generation = MD_ATOMIC_LOAD(&s_profileGeneration, MD_MEMORY_ORDER_ACQUIRE);
+	struct ProfileThreadBuffer* pBuffers   = MD_ATOMIC_LOAD(&s_pProfileBuffers, MD_MEMORY_ORDER_ACQUIRE);
+
+	// The timestamps start at the first event of the capture, Perfetto then shows the capture at 0.
+	mdTicks originTicks = (mdTicks)-1;
+	for (struct ProfileThreadBuffer* pBuffer = pBuffers; pBuffer != MD_NULL; pBuffer = pBuffer->pNext)
+	{
+		u32 count = MD_ATOMIC_LOAD(&pBuffer->count, MD_MEMORY_ORDER_ACQUIRE);
+		if (pBuffer->generation == generation && count > 0 && pBuffer->pEvents[0].ticks < originTicks)
+		{
+			originTicks = pBuffer->pEvents[0].ticks;
+		}
+	}
+
+	struct MdFileData* pFile = mdFileOpen(filePath, MD_FILE_MODE_WRITE_ATOMIC);
+	if (!mdFileIsOpen(pFile))
+	{
+		mdFileClose(pFile);
+		return MD_FALSE;
+	}
+
+	struct MdFileBufferedWriter* pWriter = mdFileBufferedWriterCreate(pFile, 0);
+	const char					 header[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	mdFileBufferedWriterWrite(pWriter, header, sizeof(header) - 1);
+
+	b8	isFirst		 = MD_TRUE;
+	u32 droppedCount = 0;
+	for (struct ProfileThreadBuffer* pBuffer = pBuffers; pBuffer != MD_NULL; pBuffer = pBuffer->pNext)
+	{
+		u32 count = MD_ATOMIC_LOAD(&pBuffer->count, MD_MEMORY_ORDER_ACQUIRE);
+		if (pBuffer->generation != generation || count == 0)
+		{
+			continue;
+		}
+		droppedCount += pBuffer->droppedCount;
+
+		// The zones opened before the capture have no begin event, their end is skipped. The names of the end
+		// events are the names of the zones they close, Perfetto shows them on hover.
+		const char* openNames[256];
+		u32			depth = 0;
+		for (u32 i = 0; i < count; ++i)
+		{
+			const struct ProfileEvent* pEvent = &pBuffer->pEvents[i];
+			switch (pEvent->type)
+			{
+			case PROFILE_EVENT_TYPE_BEGIN:
+				if (depth < MD_ARRAY_SIZE(openNames))
+				{
+					openNames[depth] = pEvent->name;
+				}
+				depth++;
+				writeEvent(pWriter, &isFirst, pEvent->name, "B", pEvent->ticks, originTicks, pBuffer->threadId);
+				break;
+			case PROFILE_EVENT_TYPE_END:
+				if (depth == 0)
+				{
+					break;
+				}
+				depth--;
+				writeEvent(pWriter,
+						   &isFirst,
+						   depth < MD_ARRAY_SIZE(openNames) ? openNames[depth] : "",
+						   "E",
+						   pEvent->ticks,
+						   originTicks,
+						   pBuffer->threadId);
+				break;
+			case PROFILE_EVENT_TYPE_FRAME:
+				writeEvent(pWriter, &isFirst, pEvent->name, "i", pEvent->ticks, originTicks, pBuffer->threadId);
+				break;
+			default:
+				MD_UNTOUCHABLE();
+			}
+		}
+
+		mdTicks lastTicks = pBuffer->pEvents[count - 1].ticks;
+		while (depth > 0)
+		{
+			depth--;
+			writeEvent(pWriter,
+					   &isFirst,
+					   depth < MD_ARRAY_SIZE(openNames) ? openNames[depth] : "",
+					   "E",
+					   lastTicks,
+					   originTicks,
+					   pBuffer->threadId);
+		}
+	}
+
+	// The dropped events are reported next to the trace, a full buffer shortens the capture of its thread.
+	char footer[64];
+	mdFormatString(footer, sizeof(footer), "\n],\"otherData\":{\"droppedEvents\":%u}}\n", droppedCount);
+	mdFileBufferedWriterWrite(pWriter, footer, strlen(footer));
+	mdFileBufferedWriterDestroy(pWriter);
+	mdFileClose(pFile);
+
+	return MD_TRUE;
+}
+
+void mdProfileShutdown()
+{
+	mdProfileCaptureStop();
+
+	struct ProfileThreadBuffer* pBuffer = MD_ATOMIC_EXCHANGE(&s_pProfileBuffers, MD_NULL, MD_MEMORY_ORDER_ACQ_REL);
+	while (pBuffer != MD_NULL)
+	{
+		struct ProfileThreadBuffer* pNext = pBuffer->pNext;
+		MD_FREE(pBuffer, struct ProfileThreadBuffer);
+		pBuffer = pNext;
+	}
+
+	// Only the calling thread can forget its buffer, the others must not record events anymore.
+	t_pProfileBuffer = MD_NULL;
+	MD_ATOMIC_STORE(&s_profileThreadsCount, 0u, MD_MEMORY_ORDER_RELAXED);
+}
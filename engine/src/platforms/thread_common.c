@@ -0,0 +1,45 @@
+#include "MEEDEngine/platforms/thread.h"
+
+#define SPINLOCK_MAX_PAUSES 16u
+
+void mdSpinlockLock(struct MdSpinlock* pSpinlock)
+{
+	MD_ASSERT(pSpinlock != MD_NULL);
+
+	u32 pausesCount = 1;
+	u32 spinsCount	= 0;
+	while (!mdSpinlockTryLock(pSpinlock))
+	{
+		// The waiting threads only read the lock until it looks free: a failed exchange would take the cache line
+		// away from the owner every time.
+		while (MD_ATOMIC_LOAD(&pSpinlock->isLocked, MD_MEMORY_ORDER_RELAXED) != 0)
+		{
+			if (spinsCount < MD_SPINLOCK_SPINS_BEFORE_YIELD)
+			{
+				for (u32 i = 0; i < pausesCount; ++i)
+				{
+					MD_CPU_RELAX();
+				}
+				pausesCount = pausesCount < SPINLOCK_MAX_PAUSES ? pausesCount * 2 : SPINLOCK_MAX_PAUSES;
+				++spinsCount;
+			}
+			else
+			{
+				mdThreadYield();
+			}
+		}
+	}
+}
+
+b8 mdSpinlockTryLock(struct MdSpinlock* pSpinlock)
+{
+	MD_ASSERT(pSpinlock != MD_NULL);
+	return MD_ATOMIC_EXCHANGE(&pSpinlock->isLocked, 1u, MD_MEMORY_ORDER_ACQUIRE) == 0;
+}
+
+void mdSpinlockUnlock(struct MdSpinlock* pSpinlock)
+{
+	MD_ASSERT(pSpinlock != MD_NULL);
+	MD_ASSERT(pSpinlock->isLocked != 0);
+	MD_ATOMIC_STORE(&pSpinlock->isLocked, 0u, MD_MEMORY_ORDER_RELEASE);
+}
@@ -0,0 +1,556 @@
+#if PLATFORM_IS_LINUX
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/thread.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+_Static_assert(sizeof(pthread_mutex_t) <= sizeof(((struct MdMutex*)0)->storage), "MdMutex storage is too small");
+_Static_assert(sizeof(pthread_cond_t) <= sizeof(((struct MdConditionVariable*)0)->storage),
+			   "MdConditionVariable storage is too small");
+_Static_assert(sizeof(sem_t) <= sizeof(((struct MdSemaphore*)0)->storage), "MdSemaphore storage is too small");
+_Static_assert(sizeof(pthread_key_t) <= sizeof(mdThreadLocalKey), "mdThreadLocalKey is too small");
+
+#define MUTEX_HANDLE(pMutex)		 ((pthread_mutex_t*)(pMutex)->storage)
+#define CONDITION_HANDLE(pCondition) ((pthread_cond_t*)(pCondition)->storage)
+#define SEMAPHORE_HANDLE(pSemaphore) ((sem_t*)(pSemaphore)->storage)
+
+#define AFFINITY_MASK_WORDS 16 ///< Up to 1024 logical cores.
+#define SYSFS_CPU_PATH		"/sys/devices/system/cpu"
+#define SYSFS_VALUE_LENGTH	256u
+#define NO_GROUP_KEY		0xFFFFFFFFu
+
+struct MdThread
+{
+	pthread_t		 handle;
+	MdThreadFunction function;
+	void*			 pArgument;
+	char			 name[MD_THREAD_NAME_MAX_LENGTH + 1];
+};
+
+/**
+ * The affinity mask of the process, captured before the first thread is pinned: a pinned thread reads its single core
+ * in its own mask.
+ */
+static pthread_once_t s_processMaskOnce					 = PTHREAD_ONCE_INIT;
+static u64			  s_processMask[AFFINITY_MASK_WORDS] = {0};
+static u32			  s_processCoresCount				 = 0;
+static b8			  s_isAnyThreadPinned				 = MD_FALSE;
+
+static void captureProcessMask()
+{
+	// The raw system call returns the size of the mask it filled.
+	long size = syscall(SYS_sched_getaffinity, 0, sizeof(s_processMask), s_processMask);
+	for (long i = 0; i < size / (long)sizeof(u64); ++i)
+	{
+		s_processCoresCount += (u32)__builtin_popcountll(s_processMask[i]);
+	}
+}
+
+static void* threadMain(void* pArgument)
+{
+	struct MdThread* pThread = (struct MdThread*)pArgument;
+	if (pThread->name[0] != '\0')
+	{
+		mdThreadSetCurrentName(pThread->name);
+	}
+
+	// A thread started from a pinned one inherits its single core, it gets back the cores of the process.
+	if (MD_ATOMIC_LOAD(&s_isAnyThreadPinned, MD_MEMORY_ORDER_ACQUIRE) && s_processCoresCount > 0)
+	{
+		syscall(SYS_sched_setaffinity, 0, sizeof(s_processMask), s_processMask);
+	}
+
+	pThread->function(pThread->pArgument);
+	return MD_NULL;
+}
+
+struct MdThread* mdThreadCreate(MdThreadFunction function, void* pArgument, const char* name)
+{
+	MD_ASSERT(function != MD_NULL);
+
+	struct MdThread* pThread = MD_MALLOC(struct MdThread);
+	MD_ASSERT(pThread != MD_NULL);
+	mdMemorySet(pThread, 0, sizeof(struct MdThread));
+	pThread->function  = function;
+	pThread->pArgument = pArgument;
+	if (name != MD_NULL)
+	{
+		mdFormatString(pThread->name, sizeof(pThread->name), "%s", name);
+	}
+
+	if (pthread_create(&pThread->handle, MD_NULL, threadMain, pThread) != 0)
+	{
+		MD_FREE(pThread, struct MdThread);
+		return MD_NULL;
+	}
+
+	return pThread;
+}
+
+void mdThreadJoin(struct MdThread* pThread)
+{
+	MD_ASSERT(pThread != MD_NULL);
+
+	pthread_join(pThread->handle, MD_NULL);
+	MD_FREE(pThread, struct MdThread);
+}
+
+void mdThreadSetCurrentName(const char* name)
+{
+	MD_ASSERT(name != MD_NULL);
+
+	// `prctl` rather than `pthread_setname_np`, which needs `_GNU_SOURCE`: both name the calling thread.
+	char truncatedName[MD_THREAD_NAME_MAX_LENGTH + 1];
+	mdFormatString(truncatedName, sizeof(truncatedName), "%s", name);
+	prctl(PR_SET_NAME, truncatedName, 0, 0, 0);
+}
+
+mdPid mdThreadGetCurrentId()
+{
+	// Cached: the system call costs more than the callers expect from an id query.
+	static MD_THREAD_LOCAL mdPid s_threadId = 0;
+	if (s_threadId == 0)
+	{
+		s_threadId = (mdPid)syscall(SYS_gettid);
+	}
+	return s_threadId;
+}
+
+void mdThreadYield()
+{
+	sched_yield();
+}
+
+/**
+ * Reads the affinity mask of the process, which unlike the online processors count honors `taskset` and the container
+ * CPU sets.
+ * @return The number of logical cores in the mask, 0 when it cannot be read.
+ */
+static u32 getAffinityMask(u64 mask[AFFINITY_MASK_WORDS])
+{
+	pthread_once(&s_processMaskOnce, captureProcessMask);
+	mdMemoryCopy(mask, s_processMask, sizeof(s_processMask));
+	return s_processCoresCount;
+}
+
+u32 mdThreadGetHardwareConcurrency()
+{
+	u64 mask[AFFINITY_MASK_WORDS];
+	u32 count = getAffinityMask(mask);
+	if (count > 0)
+	{
+		return count;
+	}
+
+	long onlineCount = sysconf(_SC_NPROCESSORS_ONLN);
+	return onlineCount > 0 ? (u32)onlineCount : 1;
+}
+
+/**
+ * The sysfs keys of a logical core, the lowest logical core of each group it belongs to.
+ */
+struct CoreKeys
+{
+	u32 cpuId;
+	u32 packageId;
+	u32 l3Key;
+	u32 l2Key;
+	u32 coreKey;
+};
+
+/**
+ * Reads a small sysfs file of a logical core, e.g. `topology/core_id`.
+ * @return MD_FALSE when the file does not exist.
+ */
+static b8 readCpuValue(u32 cpuId, const char* name, char* pValue)
+{
+	char path[128];
+	mdFormatString(path, sizeof(path), SYSFS_CPU_PATH "/cpu%u/%s", cpuId, name);
+	i32 fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		return MD_FALSE;
+	}
+	ssize_t length = read(fd, pValue, SYSFS_VALUE_LENGTH - 1);
+	close(fd);
+	if (length <= 0)
+	{
+		return MD_FALSE;
+	}
+	pValue[length] = '\0';
+	return MD_TRUE;
+}
+
+static u64 parseNumber(const char** ppText)
+{
+	u64 value = 0;
+	while (**ppText >= '0' && **ppText <= '9')
+	{
+		value = value * 10 + (u64)(**ppText - '0');
+		++*ppText;
+	}
+	return value;
+}
+
+/**
+ * Parses a cache size such as `32K` or `16384K`.
+ */
+static u64 parseSize(const char* pText)
+{
+	u64 size = parseNumber(&pText);
+	if (*pText == 'K')
+	{
+		size *= 1024;
+	}
+	else if (*pText == 'M')
+	{
+		size *= 1024 * 1024;
+	}
+	return size;
+}
+
+/**
+ * Finds the lowest logical core of a list such as `0-3,8-11` which the process can run on, the key of the group.
+ */
+static u32 parseGroupKey(const char* pText, const u64 mask[AFFINITY_MASK_WORDS])
+{
+	while (*pText >= '0' && *pText <= '9')
+	{
+		u64 first = parseNumber(&pText);
+		u64 last  = first;
+		if (*pText == '-')
+		{
+			++pText;
+			last = parseNumber(&pText);
+		}
+		for (u64 cpuId = first; cpuId <= last && cpuId < AFFINITY_MASK_WORDS * 64; ++cpuId)
+		{
+			if ((mask[cpuId / 64] >> (cpuId % 64)) & 1)
+			{
+				return (u32)cpuId;
+			}
+		}
+		if (*pText == ',')
+		{
+			++pText;
+		}
+	}
+	return NO_GROUP_KEY;
+}
+
+static void readCoreKeys(u32 cpuId, const u64 mask[AFFINITY_MASK_WORDS], struct CoreKeys* pKeys, u64 cacheSizes[4])
+{
+	// Without sysfs, each logical core is its own physical core, in a single package and L3 group.
+	char value[SYSFS_VALUE_LENGTH];
+	pKeys->cpuId	 = cpuId;
+	pKeys->packageId = 0;
+	pKeys->l3Key	 = NO_GROUP_KEY;
+	pKeys->coreKey	 = cpuId;
+
+	if (readCpuValue(cpuId, "topology/physical_package_id", value))
+	{
+		const char* pText = value;
+		pKeys->packageId  = (u32)parseNumber(&pText);
+	}
+	if (readCpuValue(cpuId, "topology/thread_siblings_list", value))
+	{
+		u32 coreKey	   = parseGroupKey(value, mask);
+		pKeys->coreKey = coreKey != NO_GROUP_KEY ? coreKey : cpuId;
+	}
+	pKeys->l2Key = pKeys->coreKey;
+
+	// The caches are listed from L1 up, the instruction and data L1 caches separately.
+	for (u32 i = 0;; ++i)
+	{
+		char name[64];
+		mdFormatString(name, sizeof(name), "cache/index%u/level", i);
+		if (!readCpuValue(cpuId, name, value))
+		{
+			break;
+		}
+		u32 level = value[0] - '0';
+		if (level != 2 && level != 3)
+		{
+			continue;
+		}
+
+		mdFormatString(name, sizeof(name), "cache/index%u/shared_cpu_list", i);
+		u32 groupKey = readCpuValue(cpuId, name, value) ? parseGroupKey(value, mask) : NO_GROUP_KEY;
+		if (groupKey == NO_GROUP_KEY)
+		{
+			groupKey = pKeys->coreKey;
+		}
+		if (level == 2)
+		{
+			pKeys->l2Key = groupKey;
+		}
+		else
+		{
+			pKeys->l3Key = groupKey;
+		}
+
+		mdFormatString(name, sizeof(name), "cache/index%u/size", i);
+		if (cacheSizes[level] == 0 && readCpuValue(cpuId, name, value))
+		{
+			cacheSizes[level] = parseSize(value);
+		}
+	}
+}
+
+static b8 isCoreBefore(const struct CoreKeys* pFirst, const struct CoreKeys* pSecond)
+{
+	if (pFirst->packageId != pSecond->packageId)
+	{
+		return pFirst->packageId < pSecond->packageId;
+	}
+	if (pFirst->l3Key != pSecond->l3Key)
+	{
+		return pFirst->l3Key < pSecond->l3Key;
+	}
+	if (pFirst->l2Key != pSecond->l2Key)
+	{
+		return pFirst->l2Key < pSecond->l2Key;
+	}
+	if (pFirst->coreKey != pSecond->coreKey)
+	{
+		return pFirst->coreKey < pSecond->coreKey;
+	}
+	return pFirst->cpuId < pSecond->cpuId;
+}
+
+void mdThreadGetCpuTopology(struct MdCpuTopology* pTopology)
+{
+	MD_ASSERT(pTopology != MD_NULL);
+	mdMemorySet(pTopology, 0, sizeof(struct MdCpuTopology));
+
+	u64				mask[AFFINITY_MASK_WORDS];
+	struct CoreKeys keys[MD_CPU_TOPOLOGY_MAX_LOGICAL_CORES];
+	u64				cacheSizes[4] = {0};
+	u32				coresCount	  = 0;
+	if (getAffinityMask(mask) == 0)
+	{
+		mask[0] = 1;
+	}
+
+	// Sorted by insertion, the cores sharing hardware end up next to each other.
+	for (u32 cpuId = 0; cpuId < AFFINITY_MASK_WORDS * 64 && coresCount < MD_CPU_TOPOLOGY_MAX_LOGICAL_CORES; ++cpuId)
+	{
+		if (((mask[cpuId / 64] >> (cpuId % 64)) & 1) == 0)
+		{
+			continue;
+		}
+
+		struct CoreKeys coreKeys;
+		readCoreKeys(cpuId, mask, &coreKeys, cacheSizes);
+		u32 index = coresCount++;
+		while (index > 0 && isCoreBefore(&coreKeys, &keys[index - 1]))
+		{
+			keys[index] = keys[index - 1];
+			--index;
+		}
+		keys[index] = coreKeys;
+	}
+
+	pTopology->logicalCoresCount = coresCount;
+	pTopology->l2CacheSize		 = cacheSizes[2];
+	pTopology->l3CacheSize		 = cacheSizes[3];
+	for (u32 i = 0; i < coresCount; ++i)
+	{
+		const struct CoreKeys* pKeys	 = &keys[i];
+		const struct CoreKeys* pPrevious = i > 0 ? &keys[i - 1] : MD_NULL;
+		struct MdLogicalCore*  pCore	 = &pTopology->logicalCores[i];
+		pCore->cpuId					 = pKeys->cpuId;
+
+		// A new group starts where a key or an enclosing key changes.
+		b8 isNewPackage = pPrevious == MD_NULL || pKeys->packageId != pPrevious->packageId;
+		b8 isNewL3Group = isNewPackage || pKeys->l3Key != pPrevious->l3Key;
+		b8 isNewL2Group = isNewL3Group || pKeys->l2Key != pPrevious->l2Key;
+		b8 isNewCore	= isNewL2Group || pKeys->coreKey != pPrevious->coreKey;
+		pTopology->packagesCount += isNewPackage;
+		pTopology->l3GroupsCount += isNewL3Group;
+		pTopology->l2GroupsCount += isNewL2Group;
+		pTopology->physicalCoresCount += isNewCore;
+		pCore->packageIndex		 = pTopology->packagesCount - 1;
+		pCore->l3GroupIndex		 = pTopology->l3GroupsCount - 1;
+		pCore->l2GroupIndex		 = pTopology->l2GroupsCount - 1;
+		pCore->physicalCoreIndex = pTopology->physicalCoresCount - 1;
+		pCore->siblingIndex		 = isNewCore ? 0 : pTopology->logicalCores[i - 1].siblingIndex + 1;
+	}
+}
+
+b8 mdThreadSetCurrentAffinity(u32 cpuId)
+{
+	if (cpuId >= AFFINITY_MASK_WORDS * 64)
+	{
+		return MD_FALSE;
+	}
+
+	// The raw system call rather than `pthread_setaffinity_np`, which needs `_GNU_SOURCE`: both pin the calling thread.
+	pthread_once(&s_processMaskOnce, captureProcessMask);
+	u64 mask[AFFINITY_MASK_WORDS] = {0};
+	mask[cpuId / 64]			  = 1ull << (cpuId % 64);
+	if (syscall(SYS_sched_setaffinity, 0, sizeof(mask), mask) != 0)
+	{
+		return MD_FALSE;
+	}
+	MD_ATOMIC_STORE(&s_isAnyThreadPinned, MD_TRUE, MD_MEMORY_ORDER_RELEASE);
+	return MD_TRUE;
+}
+
+void mdMutexInitialize(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+	i32 result = pthread_mutex_init(MUTEX_HANDLE(pMutex), MD_NULL);
+	MD_ASSERT(result == 0);
+	MD_UNUSED(result);
+}
+
+void mdMutexDestroy(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+	pthread_mutex_destroy(MUTEX_HANDLE(pMutex));
+}
+
+void mdMutexLock(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+	pthread_mutex_lock(MUTEX_HANDLE(pMutex));
+}
+
+b8 mdMutexTryLock(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+	return pthread_mutex_trylock(MUTEX_HANDLE(pMutex)) == 0;
+}
+
+void mdMutexUnlock(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+	pthread_mutex_unlock(MUTEX_HANDLE(pMutex));
+}
+
+void mdConditionVariableInitialize(struct MdConditionVariable* pCondition)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+
+	// The timed waits use the same clock as `mdGetTicks`, a change of the system time does not affect them.
+	pthread_condattr_t attributes;
+	pthread_condattr_init(&attributes);
+	pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+	i32 result = pthread_cond_init(CONDITION_HANDLE(pCondition), &attributes);
+	pthread_condattr_destroy(&attributes);
+	MD_ASSERT(result == 0);
+	MD_UNUSED(result);
+}
+
+void mdConditionVariableDestroy(struct MdConditionVariable* pCondition)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+	pthread_cond_destroy(CONDITION_HANDLE(pCondition));
+}
+
+void mdConditionVariableWait(struct MdConditionVariable* pCondition, struct MdMutex* pMutex)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+	MD_ASSERT(pMutex != MD_NULL);
+	pthread_cond_wait(CONDITION_HANDLE(pCondition), MUTEX_HANDLE(pMutex));
+}
+
+b8 mdConditionVariableWaitFor(struct MdConditionVariable* pCondition, struct MdMutex* pMutex, mdTicks timeoutTicks)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+	MD_ASSERT(pMutex != MD_NULL);
+
+	mdTicks			deadlineTicks = mdGetTicks() + timeoutTicks;
+	struct timespec deadline;
+	deadline.tv_sec	 = (time_t)(deadlineTicks / MD_TICKS_PER_SECOND);
+	deadline.tv_nsec = (long)(deadlineTicks % MD_TICKS_PER_SECOND);
+	return pthread_cond_timedwait(CONDITION_HANDLE(pCondition), MUTEX_HANDLE(pMutex), &deadline) != ETIMEDOUT;
+}
+
+void mdConditionVariableSignal(struct MdConditionVariable* pCondition)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+	pthread_cond_signal(CONDITION_HANDLE(pCondition));
+}
+
+void mdConditionVariableBroadcast(struct MdConditionVariable* pCondition)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+	pthread_cond_broadcast(CONDITION_HANDLE(pCondition));
+}
+
+void mdSemaphoreInitialize(struct MdSemaphore* pSemaphore, u32 initialCount)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	i32 result = sem_init(SEMAPHORE_HANDLE(pSemaphore), 0, initialCount);
+	MD_ASSERT(result == 0);
+	MD_UNUSED(result);
+}
+
+void mdSemaphoreDestroy(struct MdSemaphore* pSemaphore)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	sem_destroy(SEMAPHORE_HANDLE(pSemaphore));
+}
+
+void mdSemaphoreWait(struct MdSemaphore* pSemaphore)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	while (sem_wait(SEMAPHORE_HANDLE(pSemaphore)) != 0 && errno == EINTR)
+	{
+	}
+}
+
+b8 mdSemaphoreTryWait(struct MdSemaphore* pSemaphore)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	return sem_trywait(SEMAPHORE_HANDLE(pSemaphore)) == 0;
+}
+
+void mdSemaphorePost(struct MdSemaphore* pSemaphore, u32 count)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	for (u32 i = 0; i < count; ++i)
+	{
+		sem_post(SEMAPHORE_HANDLE(pSemaphore));
+	}
+}
+
+b8 mdThreadLocalCreate(mdThreadLocalKey* pKey, void (*destructor)(void*))
+{
+	MD_ASSERT(pKey != MD_NULL);
+
+	pthread_key_t key;
+	if (pthread_key_create(&key, destructor) != 0)
+	{
+		return MD_FALSE;
+	}
+
+	*pKey = (mdThreadLocalKey)key;
+	return MD_TRUE;
+}
+
+void mdThreadLocalDestroy(mdThreadLocalKey key)
+{
+	pthread_key_delete((pthread_key_t)key);
+}
+
+void* mdThreadLocalGet(mdThreadLocalKey key)
+{
+	return pthread_getspecific((pthread_key_t)key);
+}
+
+void mdThreadLocalSet(mdThreadLocalKey key, void* pValue)
+{
+	pthread_setspecific((pthread_key_t)key, pValue);
+}
+
+#endif // PLATFORM_IS_LINUX
@@ -0,0 +1,202 @@
+#if PLATFORM_IS_WEB
+#include "MEEDEngine/platforms/memory.h"
+#include "MEEDEngine/platforms/thread.h"
+
+/**
+ * No backend: the build does not enable the WebAssembly threads, which need cross-origin isolated pages. The
+ * application runs on the browser main thread alone, so a lock is always free and a wait for another thread would
+ * never end.
+ */
+
+#define THREAD_LOCAL_KEYS_CAPACITY 64u
+#define SEMAPHORE_COUNT(pSemaphore) ((pSemaphore)->storage[0])
+
+static void* s_threadLocalValues[THREAD_LOCAL_KEYS_CAPACITY];
+static b8	 s_isThreadLocalKeyUsed[THREAD_LOCAL_KEYS_CAPACITY];
+
+struct MdThread* mdThreadCreate(MdThreadFunction function, void* pArgument, const char* name)
+{
+	MD_ASSERT(function != MD_NULL);
+	MD_UNUSED(pArgument);
+	MD_UNUSED(name);
+	return MD_NULL;
+}
+
+void mdThreadJoin(struct MdThread* pThread)
+{
+	MD_UNUSED(pThread);
+	MD_UNTOUCHABLE(); // No thread can be created.
+}
+
+void mdThreadSetCurrentName(const char* name)
+{
+	MD_ASSERT(name != MD_NULL);
+}
+
+mdPid mdThreadGetCurrentId()
+{
+	return 1;
+}
+
+void mdThreadYield()
+{
+}
+
+u32 mdThreadGetHardwareConcurrency()
+{
+	return 1;
+}
+
+void mdThreadGetCpuTopology(struct MdCpuTopology* pTopology)
+{
+	MD_ASSERT(pTopology != MD_NULL);
+
+	// The logical core 0 already has every index at 0.
+	mdMemorySet(pTopology, 0, sizeof(struct MdCpuTopology));
+	pTopology->logicalCoresCount  = 1;
+	pTopology->physicalCoresCount = 1;
+	pTopology->l2GroupsCount	  = 1;
+	pTopology->l3GroupsCount	  = 1;
+	pTopology->packagesCount	  = 1;
+}
+
+b8 mdThreadSetCurrentAffinity(u32 cpuId)
+{
+	MD_UNUSED(cpuId);
+	return MD_FALSE;
+}
+
+void mdMutexInitialize(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+}
+
+void mdMutexDestroy(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+}
+
+void mdMutexLock(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+}
+
+b8 mdMutexTryLock(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+	return MD_TRUE;
+}
+
+void mdMutexUnlock(struct MdMutex* pMutex)
+{
+	MD_ASSERT(pMutex != MD_NULL);
+}
+
+void mdConditionVariableInitialize(struct MdConditionVariable* pCondition)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+}
+
+void mdConditionVariableDestroy(struct MdConditionVariable* pCondition)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+}
+
+void mdConditionVariableWait(struct MdConditionVariable* pCondition, struct MdMutex* pMutex)
+{
+	MD_UNUSED(pCondition);
+	MD_UNUSED(pMutex);
+	MD_UNTOUCHABLE(); // No other thread can signal the condition.
+}
+
+b8 mdConditionVariableWaitFor(struct MdConditionVariable* pCondition, struct MdMutex* pMutex, mdTicks timeoutTicks)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+	MD_ASSERT(pMutex != MD_NULL);
+	MD_UNUSED(timeoutTicks);
+	return MD_FALSE;
+}
+
+void mdConditionVariableSignal(struct MdConditionVariable* pCondition)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+}
+
+void mdConditionVariableBroadcast(struct MdConditionVariable* pCondition)
+{
+	MD_ASSERT(pCondition != MD_NULL);
+}
+
+void mdSemaphoreInitialize(struct MdSemaphore* pSemaphore, u32 initialCount)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	SEMAPHORE_COUNT(pSemaphore) = initialCount;
+}
+
+void mdSemaphoreDestroy(struct MdSemaphore* pSemaphore)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+}
+
+void mdSemaphoreWait(struct MdSemaphore* pSemaphore)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	MD_ASSERT_MSG(SEMAPHORE_COUNT(pSemaphore) > 0, "No other thread can post the semaphore.");
+	--SEMAPHORE_COUNT(pSemaphore);
+}
+
+b8 mdSemaphoreTryWait(struct MdSemaphore* pSemaphore)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	if (SEMAPHORE_COUNT(pSemaphore) == 0)
+	{
+		return MD_FALSE;
+	}
+
+	--SEMAPHORE_COUNT(pSemaphore);
+	return MD_TRUE;
+}
+
+void mdSemaphorePost(struct MdSemaphore* pSemaphore, u32 count)
+{
+	MD_ASSERT(pSemaphore != MD_NULL);
+	SEMAPHORE_COUNT(pSemaphore) += count;
+}
+
+b8 mdThreadLocalCreate(mdThreadLocalKey* pKey, void (*destructor)(void*))
+{
+	MD_ASSERT(pKey != MD_NULL);
+	MD_UNUSED(destructor); // The main thread never exits.
+
+	for (u32 i = 0; i < THREAD_LOCAL_KEYS_CAPACITY; ++i)
+	{
+		if (!s_isThreadLocalKeyUsed[i])
+		{
+			s_isThreadLocalKeyUsed[i] = MD_TRUE;
+			s_threadLocalValues[i]	  = MD_NULL;
+			*pKey					  = i;
+			return MD_TRUE;
+		}
+	}
+	return MD_FALSE;
+}
+
+void mdThreadLocalDestroy(mdThreadLocalKey key)
+{
+	MD_ASSERT(key < THREAD_LOCAL_KEYS_CAPACITY && s_isThreadLocalKeyUsed[key]);
+	s_isThreadLocalKeyUsed[key] = MD_FALSE;
+}
+
+void* mdThreadLocalGet(mdThreadLocalKey key)
+{
+	MD_ASSERT(key < THREAD_LOCAL_KEYS_CAPACITY && s_isThreadLocalKeyUsed[key]);
+	return s_threadLocalValues[key];
+}
+
+void mdThreadLocalSet(mdThreadLocalKey key, void* pValue)
+{
+	MD_ASSERT(key < THREAD_LOCAL_KEYS_CAPACITY && s_isThreadLocalKeyUsed[key]);
+	s_threadLocalValues[key] = pValue;
+}
+
+#endif // PLATFORM_IS_WEB
@@ -1,5 +1,7 @@
 #include "MEEDEngine/platforms/console.h"
+#include "MEEDEngine/platforms/memory.h"
 #include "MEEDEngine/platforms/time.h"
+#include <stdlib.h>
 
 const char* mdGetMonthName(i32 month)
 {
@@ -59,4 +61,121 @@ f64 mdGetTimeDifferenceInMilliseconds(mdUNIXTime start, mdUNIXTime end)
 f64 mdGetTimeDifferenceInSeconds(mdUNIXTime start, mdUNIXTime end)
 {
 	return mdGetTimeDifferenceInMicroseconds(start, end) * 1e-6;
-}
\ No newline at end of file
+}
+
+f64 mdTicksToSeconds(mdTicks ticks)
+{
+	return (f64)ticks * 1e-9;
+}
+
+f64 mdTicksToMilliseconds(mdTicks ticks)
+{
+	return (f64)ticks * 1e-6;
+}
+
+mdTicks mdSecondsToTicks(f64 seconds)
+{
+	MD_ASSERT(seconds >= 0.0);
+	return (mdTicks)(seconds * 1e9 + 0.5);
+}
+
+struct MdFrameTimer* mdFrameTimerCreate(u32 windowSize)
+{
+	struct MdFrameTimer* pTimer = MD_MALLOC(struct MdFrameTimer);
+	MD_ASSERT(pTimer != MD_NULL);
+	mdMemorySet(pTimer, 0, sizeof(struct MdFrameTimer));
+
+	pTimer->windowSize = windowSize != 0 ? windowSize : MD_FRAME_TIMER_DEFAULT_WINDOW;
+	pTimer->pSamples   = MD_MALLOC_ARRAY(mdTicks, pTimer->windowSize);
+	pTimer->pSorted	   = MD_MALLOC_ARRAY(mdTicks, pTimer->windowSize);
+
+	return pTimer;
+}
+
+f64 mdFrameTimerTick(struct MdFrameTimer* pTimer)
+{
+	MD_ASSERT(pTimer != MD_NULL);
+
+	mdTicks now = mdGetTicks();
+	if (pTimer->lastTicks == 0)
+	{
+		pTimer->lastTicks = now;
+		return 0.0;
+	}
+
+	mdFrameTimerAddSample(pTimer, now - pTimer->lastTicks);
+	pTimer->lastTicks = now;
+
+	return mdTicksToSeconds(pTimer->deltaTicks);
+}
+
+void mdFrameTimerAddSample(struct MdFrameTimer* pTimer, mdTicks deltaTicks)
+{
+	MD_ASSERT(pTimer != MD_NULL);
+
+	// The running sum keeps the moving average O(1), the sample which leaves the window is subtracted.
+	if (pTimer->samplesCount == pTimer->windowSize)
+	{
+		pTimer->windowTicks -= pTimer->pSamples[pTimer->nextSample];
+	}
+	else
+	{
+		pTimer->samplesCount++;
+	}
+
+	pTimer->pSamples[pTimer->nextSample] = deltaTicks;
+	pTimer->nextSample					 = (pTimer->nextSample + 1) % pTimer->windowSize;
+	pTimer->windowTicks += deltaTicks;
+	pTimer->deltaTicks = deltaTicks;
+	pTimer->framesCount++;
+}
+
+static int compareTicks(const void* pLeft, const void* pRight)
+{
+	mdTicks left  = *(const mdTicks*)pLeft;
+	mdTicks right = *(const mdTicks*)pRight;
+	return (left > right) - (left < right);
+}
+
+/**
+ * Nearest-rank percentile of sorted samples: the smallest sample which at least `percent` of the samples do not
+ * exceed.
+ */
+static mdTicks getPercentile(const mdTicks* pSorted, u32 count, u32 percent)
+{
+	u32 rank = (count * percent + 99) / 100;
+	return pSorted[rank > 0 ? rank - 1 : 0];
+}
+
+void mdFrameTimerGetStats(const struct MdFrameTimer* pTimer, struct MdFrameTimerStats* pStats)
+{
+	MD_ASSERT(pTimer != MD_NULL);
+	MD_ASSERT(pStats != MD_NULL);
+
+	mdMemorySet(pStats, 0, sizeof(struct MdFrameTimerStats));
+	u32 count = pTimer->samplesCount;
+	if (count == 0)
+	{
+		return;
+	}
+
+	mdMemoryCopy(pTimer->pSorted, pTimer->pSamples, sizeof(mdTicks) * count);
+	qsort(pTimer->pSorted, count, sizeof(mdTicks), compareTicks);
+
+	pStats->samplesCount		= count;
+	pStats->deltaMilliseconds	= mdTicksToMilliseconds(pTimer->deltaTicks);
+	pStats->averageMilliseconds = mdTicksToMilliseconds(pTimer->windowTicks) / (f64)count;
+	pStats->minMilliseconds		= mdTicksToMilliseconds(pTimer->pSorted[0]);
+	pStats->maxMilliseconds		= mdTicksToMilliseconds(pTimer->pSorted[count - 1]);
+	pStats->p95Milliseconds		= mdTicksToMilliseconds(getPercentile(pTimer->pSorted, count, 95));
+	pStats->p99Milliseconds		= mdTicksToMilliseconds(getPercentile(pTimer->pSorted, count, 99));
+}
+
+void mdFrameTimerDestroy(struct MdFrameTimer* pTimer)
+{
+	MD_ASSERT(pTimer != MD_NULL);
+
+	MD_FREE_ARRAY(pTimer->pSamples, mdTicks, pTimer->windowSize);
+	MD_FREE_ARRAY(pTimer->pSorted, mdTicks, pTimer->windowSize);
+	MD_FREE(pTimer, struct MdFrameTimer);
+}
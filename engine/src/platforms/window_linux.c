@@ -101,14 +101,17 @@ struct MdWindowEvent mdWindowPollEvents(struct MdWindowData* pWindowData)
 
 	struct LinuxWindowData* pLinuxData = (struct LinuxWindowData*)pWindowData->pInternal;
 
-	XNextEvent(pLinuxData->pDisplay, &event);
 	struct MdWindowEvent windowEvent;
 	mdMemorySet(&windowEvent, 0, sizeof(struct MdWindowEvent));
 	windowEvent.type = MD_WINDOW_EVENT_TYPE_NONE;
 
-	if (event.type == ClientMessage)
+	// Only the queued events are read: `XNextEvent` alone blocks until the next event, and the frames would then be
+	// paced by the events instead of the frame loop.
+	while (XPending(pLinuxData->pDisplay) > 0)
 	{
-		if (event.xclient.data.l[0] == XInternAtom(pLinuxData->pDisplay, "WM_DELETE_WINDOW", False))
+		XNextEvent(pLinuxData->pDisplay, &event);
+		if (event.type == ClientMessage &&
+			event.xclient.data.l[0] == XInternAtom(pLinuxData->pDisplay, "WM_DELETE_WINDOW", False))
 		{
 			pWindowData->shouldClose = MD_TRUE;
 			windowEvent.type		 = MD_WINDOW_EVENT_TYPE_CLOSE;
@@ -0,0 +1,141 @@
+#include "common.hpp"
+
+namespace
+{
+const char* s_jsonPath		 = "meed_bench_test.json";
+u32			s_runsCount		 = 0;
+u32			s_setupsCount	 = 0;
+u32			s_teardownsCount = 0;
+
+void countRun()
+{
+	++s_runsCount;
+}
+
+void countSetup()
+{
+	++s_setupsCount;
+}
+
+void countTeardown()
+{
+	++s_teardownsCount;
+}
+
+struct MdBenchConfig getQuickConfig()
+{
+	struct MdBenchConfig config		 = mdBenchGetDefaultConfig();
+	config.repetitions				 = 5;
+	config.warmupMilliseconds		 = 1.0;
+	config.minRepetitionMilliseconds = 0.5;
+	return config;
+}
+} // namespace
+
+MD_BENCH(BenchTest, Registered)
+{
+	MD_BENCH_DO_NOT_OPTIMIZE(s_runsCount);
+}
+
+class BenchTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		s_runsCount		 = 0;
+		s_setupsCount	 = 0;
+		s_teardownsCount = 0;
+	}
+
+	void TearDown() override
+	{
+		mdFileRemove(s_jsonPath);
+	}
+};
+
+TEST_F(BenchTest, BenchmarksRegisterBeforeMain)
+{
+	b8 isFound = MD_FALSE;
+	for (const struct MdBench* pBench = mdBenchGetRegistered(); pBench != MD_NULL; pBench = pBench->pNext)
+	{
+		isFound |= strcmp(pBench->suite, "BenchTest") == 0 && strcmp(pBench->name, "Registered") == 0;
+	}
+	EXPECT_TRUE(isFound);
+}
+
+TEST_F(BenchTest, HooksRunAroundEveryIteration)
+{
+	struct MdBench bench = {"BenchTest", "Hooks", countRun, countSetup, countTeardown, nullptr, nullptr, nullptr};
+
+	struct MdBenchConfig config = getQuickConfig();
+
+	struct MdBenchResult result;
+	mdBenchMeasure(&bench, &config, &result);
+
+	EXPECT_GT(result.iterations, 0u);
+	EXPECT_EQ(result.repetitions, 5u);
+	EXPECT_EQ(s_setupsCount, s_runsCount);
+	EXPECT_EQ(s_teardownsCount, s_runsCount);
+	EXPECT_GE(s_runsCount, result.iterations * result.repetitions);
+
+	EXPECT_LE(result.minNanoseconds, result.p5Nanoseconds);
+	EXPECT_LE(result.p5Nanoseconds, result.medianNanoseconds);
+	EXPECT_LE(result.medianNanoseconds, result.p95Nanoseconds);
+	EXPECT_GE(result.madNanoseconds, 0.0);
+}
+
+TEST_F(BenchTest, FixtureRunsOnce)
+{
+	struct MdBench bench = {"BenchTest", "Fixture", countRun, nullptr, nullptr, countSetup, countTeardown, nullptr};
+
+	struct MdBenchConfig config = getQuickConfig();
+
+	struct MdBenchResult result;
+	mdBenchMeasure(&bench, &config, &result);
+
+	EXPECT_EQ(s_setupsCount, 1u);
+	EXPECT_EQ(s_teardownsCount, 1u);
+	EXPECT_GT(s_runsCount, 1u);
+}
+
+TEST_F(BenchTest, BaselineComparisonFailsOnRegression)
+{
+	struct MdBench		 bench = {"BenchTest", "Baseline", countRun, nullptr, nullptr, nullptr, nullptr, nullptr};
+	struct MdBenchResult result;
+	mdMemorySet(&result, 0, sizeof(result));
+	result.pBench			 = &bench;
+	result.iterations		 = 100;
+	result.repetitions		 = 5;
+	result.medianNanoseconds = 100.0;
+	result.madNanoseconds	 = 1.0;
+	ASSERT_TRUE(mdBenchWriteJSON(s_jsonPath, &result, 1));
+
+	EXPECT_EQ(mdBenchCompareBaseline(s_jsonPath, &result, 1, 0.1), 0u);
+
+	result.medianNanoseconds = 105.0; // Within the threshold.
+	EXPECT_EQ(mdBenchCompareBaseline(s_jsonPath, &result, 1, 0.1), 0u);
+
+	result.medianNanoseconds = 150.0;
+	EXPECT_EQ(mdBenchCompareBaseline(s_jsonPath, &result, 1, 0.1), 1u);
+
+	result.madNanoseconds = 30.0; // The slowdown is within the noise.
+	EXPECT_EQ(mdBenchCompareBaseline(s_jsonPath, &result, 1, 0.1), 0u);
+
+	EXPECT_EQ(mdBenchCompareBaseline("meed_bench_missing.json", &result, 1, 0.1), 1u);
+}
+
+TEST_F(BenchTest, ParseArguments)
+{
+	const char* argv[] = {"bench", "--filter=Containers", "--repetitions=7", "--json=out.json", "--threshold=0.2"};
+	struct MdBenchConfig config = mdBenchGetDefaultConfig();
+
+	EXPECT_TRUE(mdBenchParseArguments(&config, MD_ARRAY_SIZE(argv), (char**)argv));
+	EXPECT_STREQ(config.filter, "Containers");
+	EXPECT_EQ(config.repetitions, 7u);
+	EXPECT_STREQ(config.jsonPath, "out.json");
+	EXPECT_DOUBLE_EQ(config.threshold, 0.2);
+	EXPECT_EQ(config.baselinePath, nullptr);
+
+	const char* invalidArgv[] = {"bench", "--unknown"};
+	EXPECT_FALSE(mdBenchParseArguments(&config, MD_ARRAY_SIZE(invalidArgv), (char**)invalidArgv));
+}
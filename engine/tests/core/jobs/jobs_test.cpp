@@ -0,0 +1,203 @@
+#include "common.hpp"
+
+#include <vector>
+
+static void incrementCounter(void* pUserData)
+{
+	MD_ATOMIC_FETCH_ADD((u32*)pUserData, 1u, MD_MEMORY_ORDER_RELAXED);
+}
+
+static void submitIncrements(u32*				   pCounter,
+							 u32				   jobsCount,
+							 enum MdJobPriority   priority,
+							 struct MdJobCounter* pJobCounter)
+{
+	std::vector<struct MdJobDecl> jobs(jobsCount, MdJobDecl{incrementCounter, pCounter});
+	mdJobSubmit(jobs.data(), jobsCount, priority, pJobCounter);
+}
+
+class JobSystemTest : public TestWithParam<u32>
+{
+protected:
+	void SetUp() override
+	{
+		mdJobSystemInitialize(GetParam());
+	}
+
+	void TearDown() override
+	{
+		mdJobSystemShutdown();
+	}
+};
+
+TEST_P(JobSystemTest, WaitRunsEveryJobOfTheCounter)
+{
+	u32					counter	   = 0;
+	struct MdJobCounter jobCounter = {};
+	submitIncrements(&counter, 1000, MD_JOB_PRIORITY_NORMAL, &jobCounter);
+	mdJobWait(&jobCounter);
+
+	EXPECT_TRUE(mdJobIsDone(&jobCounter));
+	EXPECT_EQ(counter, 1000u);
+	EXPECT_EQ(mdJobSystemGetWorkersCount(), GetParam());
+}
+
+TEST_P(JobSystemTest, EveryLaneRuns)
+{
+	// A budget smaller than any job: the workers skip the background lane, the wait must not.
+	mdJobSystemSetBackgroundBudget(1);
+	mdJobSystemBeginFrame();
+
+	u32					counters[MD_JOB_PRIORITY_COUNT] = {};
+	struct MdJobCounter jobCounter					   = {};
+	for (u32 i = 0; i < MD_JOB_PRIORITY_COUNT; ++i)
+	{
+		submitIncrements(&counters[i], 100, (enum MdJobPriority)i, &jobCounter);
+	}
+	mdJobWait(&jobCounter);
+
+	EXPECT_THAT(counters, Each(100u));
+}
+
+TEST_P(JobSystemTest, DequeOverflowGoesToTheSharedQueue)
+{
+	u32					counter	   = 0;
+	struct MdJobCounter jobCounter = {};
+	submitIncrements(&counter, 3 * MD_JOB_DEQUE_CAPACITY, MD_JOB_PRIORITY_NORMAL, &jobCounter);
+	mdJobWait(&jobCounter);
+
+	EXPECT_EQ(counter, 3 * MD_JOB_DEQUE_CAPACITY);
+}
+
+struct SumRange
+{
+	u32 begin;
+	u32 end;
+	u64 sum;
+};
+
+static void sumRecursively(void* pUserData)
+{
+	SumRange* pRange = (SumRange*)pUserData;
+	if (pRange->end - pRange->begin <= 16)
+	{
+		for (u32 i = pRange->begin; i < pRange->end; ++i)
+		{
+			pRange->sum += i;
+		}
+		return;
+	}
+
+	// The jobs submit and wait on their own children.
+	u32					middle		= pRange->begin + (pRange->end - pRange->begin) / 2;
+	SumRange			halves[2]	= {{pRange->begin, middle, 0}, {middle, pRange->end, 0}};
+	struct MdJobDecl	jobs[2]		= {{sumRecursively, &halves[0]}, {sumRecursively, &halves[1]}};
+	struct MdJobCounter jobCounter = {};
+	mdJobSubmit(jobs, 2, MD_JOB_PRIORITY_NORMAL, &jobCounter);
+	mdJobWait(&jobCounter);
+	pRange->sum = halves[0].sum + halves[1].sum;
+}
+
+TEST_P(JobSystemTest, JobsWaitOnNestedJobs)
+{
+	SumRange			range	   = {0, 100000, 0};
+	struct MdJobDecl	job		   = {sumRecursively, &range};
+	struct MdJobCounter jobCounter = {};
+	mdJobSubmit(&job, 1, MD_JOB_PRIORITY_HIGH, &jobCounter);
+	mdJobWait(&jobCounter);
+
+	EXPECT_EQ(range.sum, 100000ull * 99999ull / 2);
+}
+
+struct ForeignSubmission
+{
+	u32					counter;
+	struct MdJobCounter jobCounter;
+};
+
+static void submitFromForeignThread(void* pArgument)
+{
+	ForeignSubmission* pSubmission = (ForeignSubmission*)pArgument;
+	submitIncrements(&pSubmission->counter, 500, MD_JOB_PRIORITY_NORMAL, &pSubmission->jobCounter);
+	mdJobWait(&pSubmission->jobCounter);
+}
+
+TEST_P(JobSystemTest, ThreadsOutsideTheSystemSubmit)
+{
+	ForeignSubmission submission = {};
+	mdThreadJoin(mdThreadCreate(submitFromForeignThread, &submission, "md-foreign"));
+
+	EXPECT_EQ(submission.counter, 500u);
+}
+
+INSTANTIATE_TEST_SUITE_P(WorkersCounts, JobSystemTest, Values(0u, 1u, 3u));
+
+struct StackProbe
+{
+	struct MdJobCounter* pSiblingCounter;
+	mdSize				 waiterAddress;
+	mdSize				 siblingAddress;
+};
+
+static void recordSiblingStack(void* pUserData)
+{
+	u32 local									 = 0;
+	((StackProbe*)pUserData)->siblingAddress = (mdSize)&local;
+	MD_BENCH_DO_NOT_OPTIMIZE(&local);
+}
+
+static void waitOnSibling(void* pUserData)
+{
+	StackProbe* pProbe	  = (StackProbe*)pUserData;
+	u32			local	  = 0;
+	pProbe->waiterAddress = (mdSize)&local;
+	MD_BENCH_DO_NOT_OPTIMIZE(&local);
+	mdJobWait(pProbe->pSiblingCounter);
+}
+
+TEST(JobFiberTest, WaitingJobsSuspendTheirFiber)
+{
+	mdJobSystemInitialize(0);
+
+	// The waiter is taken first, the deque is LIFO. Were it not suspended, the sibling would run nested on its stack.
+	StackProbe			probe		   = {};
+	struct MdJobCounter siblingCounter = {};
+	struct MdJobCounter waiterCounter  = {};
+	probe.pSiblingCounter			   = &siblingCounter;
+	struct MdJobDecl sibling		   = {recordSiblingStack, &probe};
+	struct MdJobDecl waiter			   = {waitOnSibling, &probe};
+	mdJobSubmit(&sibling, 1, MD_JOB_PRIORITY_NORMAL, &siblingCounter);
+	mdJobSubmit(&waiter, 1, MD_JOB_PRIORITY_NORMAL, &waiterCounter);
+	mdJobWait(&waiterCounter);
+
+	mdSize distance = probe.waiterAddress > probe.siblingAddress ? probe.waiterAddress - probe.siblingAddress
+																  : probe.siblingAddress - probe.waiterAddress;
+	EXPECT_GT(distance, (mdSize)MD_JOB_FIBER_STACK_SIZE);
+	EXPECT_TRUE(mdJobIsDone(&siblingCounter));
+
+	mdJobSystemShutdown();
+}
+
+static void waitOnChildren(void* pUserData)
+{
+	u32*				pCounter   = (u32*)pUserData;
+	struct MdJobCounter jobCounter = {};
+	submitIncrements(pCounter, 8, MD_JOB_PRIORITY_HIGH, &jobCounter);
+	mdJobWait(&jobCounter);
+}
+
+TEST(JobFiberTest, MoreWaitersThanFibers)
+{
+	mdJobSystemInitialize(2);
+
+	// The waiters beyond the pool run on the thread stacks.
+	u32							  counter = 0;
+	std::vector<struct MdJobDecl> jobs(2 * MD_JOB_FIBERS_COUNT, MdJobDecl{waitOnChildren, &counter});
+	struct MdJobCounter			  jobCounter = {};
+	mdJobSubmit(jobs.data(), (u32)jobs.size(), MD_JOB_PRIORITY_NORMAL, &jobCounter);
+	mdJobWait(&jobCounter);
+
+	EXPECT_EQ(counter, 8 * 2 * MD_JOB_FIBERS_COUNT);
+
+	mdJobSystemShutdown();
+}
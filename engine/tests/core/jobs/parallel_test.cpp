@@ -0,0 +1,158 @@
+#include "common.hpp"
+
+#include <numeric>
+#include <vector>
+
+static void markElements(u64 begin, u64 end, void* pUserData)
+{
+	u8* pMarks = (u8*)pUserData;
+	for (u64 i = begin; i < end; ++i)
+	{
+		++pMarks[i];
+	}
+}
+
+static void sumRange(u64 begin, u64 end, void* pPartial, void* pUserData)
+{
+	const u32* pValues = (const u32*)pUserData;
+	for (u64 i = begin; i < end; ++i)
+	{
+		*(u64*)pPartial += pValues[i];
+	}
+}
+
+static void addPartial(void* pAccumulator, const void* pPartial, void* pUserData)
+{
+	MD_UNUSED(pUserData);
+	*(u64*)pAccumulator += *(const u64*)pPartial;
+}
+
+// Appends the digits of the indices to a number, modulo 2^64: associative but not commutative.
+struct Digits
+{
+	u64 value;
+	u64 scale;
+};
+
+static void appendDigits(u64 begin, u64 end, void* pPartial, void* pUserData)
+{
+	MD_UNUSED(pUserData);
+	Digits* pDigits = (Digits*)pPartial;
+	for (u64 i = begin; i < end; ++i)
+	{
+		pDigits->value = pDigits->value * 10 + i % 10;
+		pDigits->scale *= 10;
+	}
+}
+
+static void concatenateDigits(void* pAccumulator, const void* pPartial, void* pUserData)
+{
+	MD_UNUSED(pUserData);
+	Digits*		  pDigits = (Digits*)pAccumulator;
+	const Digits* pNext	  = (const Digits*)pPartial;
+	pDigits->value		  = pDigits->value * pNext->scale + pNext->value;
+	pDigits->scale *= pNext->scale;
+}
+
+class ParallelTest : public TestWithParam<u32>
+{
+protected:
+	void SetUp() override
+	{
+		mdJobSystemInitialize(GetParam());
+	}
+
+	void TearDown() override
+	{
+		mdJobSystemShutdown();
+	}
+};
+
+TEST_P(ParallelTest, ForVisitsEveryElementOnce)
+{
+	for (u64 grainSize : {0ull, 1ull, 7ull, 1000ull, 100000ull})
+	{
+		std::vector<u8> marks(10000, 0);
+		mdParallelFor(0, marks.size(), grainSize, markElements, marks.data());
+		EXPECT_THAT(marks, Each(1)) << "grain size " << grainSize;
+	}
+
+	// A sub-range, and an empty one.
+	std::vector<u8> marks(100, 0);
+	mdParallelFor(10, 90, 3, markElements, marks.data());
+	mdParallelFor(50, 50, 3, markElements, marks.data());
+	EXPECT_EQ(std::accumulate(marks.begin(), marks.end(), 0), 80);
+	EXPECT_EQ(marks[9], 0);
+	EXPECT_EQ(marks[10], 1);
+}
+
+TEST_P(ParallelTest, ReduceCombinesThePartialsInOrder)
+{
+	std::vector<u32> values(100000);
+	std::iota(values.begin(), values.end(), 0u);
+	u64 identity = 0;
+	u64 sum		 = 1;
+	mdParallelReduce(0, values.size(), 100, sumRange, addPartial, &identity, sizeof(u64), &sum, values.data());
+	EXPECT_EQ(sum, 100000ull * 99999ull / 2);
+
+	Digits digitsIdentity = {0, 1};
+	Digits digits		  = {};
+	Digits expected		  = digitsIdentity;
+	appendDigits(0, 5000, &expected, nullptr);
+	mdParallelReduce(0, 5000, 10, appendDigits, concatenateDigits, &digitsIdentity, sizeof(Digits), &digits, nullptr);
+	EXPECT_EQ(digits.value, expected.value);
+
+	// An empty range gives the identity.
+	mdParallelReduce(7, 7, 0, sumRange, addPartial, &identity, sizeof(u64), &sum, values.data());
+	EXPECT_EQ(sum, 0u);
+}
+
+TEST_P(ParallelTest, ScanMatchesTheSerialPrefixSums)
+{
+	for (u64 count : {1ull, 1000ull, 100003ull})
+	{
+		std::vector<u32> values(count);
+		for (u64 i = 0; i < count; ++i)
+		{
+			values[i] = (u32)(i * 7 % 13);
+		}
+		std::vector<u32> expected(count);
+		std::exclusive_scan(values.begin(), values.end(), expected.begin(), 0u);
+		u32 expectedTotal = expected.back() + values.back();
+
+		std::vector<u32> sums(count);
+		EXPECT_EQ(mdParallelScan(values.data(), sums.data(), count, 0), expectedTotal);
+		EXPECT_EQ(sums, expected);
+
+		EXPECT_EQ(mdParallelScan(values.data(), values.data(), count, 64), expectedTotal);
+		EXPECT_EQ(values, expected);
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(WorkersCounts, ParallelTest, Values(0u, 3u));
+
+TEST(ParallelLazyStartTest, TheFirstLoopStartsTheJobSystem)
+{
+	ASSERT_FALSE(mdJobSystemIsInitialized());
+
+	std::vector<u8> marks(5000, 0);
+	mdParallelFor(0, marks.size(), 0, markElements, marks.data());
+	EXPECT_TRUE(mdJobSystemIsInitialized());
+	EXPECT_THAT(marks, Each(1));
+
+	mdParallelShutdown();
+	EXPECT_FALSE(mdJobSystemIsInitialized());
+}
+
+TEST(ParallelLazyStartTest, ShutdownLeavesAnOwnedJobSystemRunning)
+{
+	mdJobSystemInitialize(1);
+
+	std::vector<u8> marks(5000, 0);
+	mdParallelFor(0, marks.size(), 0, markElements, marks.data());
+	mdParallelShutdown();
+	EXPECT_TRUE(mdJobSystemIsInitialized());
+	EXPECT_THAT(marks, Each(1));
+
+	mdJobSystemShutdown();
+}
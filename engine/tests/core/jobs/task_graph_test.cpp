@@ -0,0 +1,200 @@
+#include "common.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define RESOURCE_VALUE MD_TASK_RESOURCE(0)
+#define RESOURCE_OTHER MD_TASK_RESOURCE(1)
+
+struct TaskLog
+{
+	std::mutex				 mutex;
+	std::vector<std::string> entries;
+	u32						 value		   = 0;
+	u32						 framesCount   = 0;
+	mdPid					 mainThreadId  = 0;
+	b8						 isOnMainThread = MD_TRUE;
+};
+
+static TaskLog* s_pLog = nullptr;
+
+static void logEntry(const std::string& entry)
+{
+	std::lock_guard<std::mutex> lock(s_pLog->mutex);
+	s_pLog->entries.push_back(entry);
+}
+
+static size_t findEntry(const std::string& entry)
+{
+	for (size_t i = 0; i < s_pLog->entries.size(); ++i)
+	{
+		if (s_pLog->entries[i] == entry)
+		{
+			return i;
+		}
+	}
+	return s_pLog->entries.size();
+}
+
+static void produce(void*)
+{
+	++s_pLog->value;
+	logEntry("produce " + std::to_string(s_pLog->value));
+}
+
+static void consume(void*)
+{
+	logEntry("consume " + std::to_string(s_pLog->value));
+}
+
+static void runIndependently(void*)
+{
+	logEntry("independent");
+}
+
+static void runOnMainThread(void*)
+{
+	s_pLog->isOnMainThread &= mdThreadGetCurrentId() == s_pLog->mainThreadId;
+	logEntry("main");
+}
+
+static void spin(void* pUserData)
+{
+	mdTicks endTicks = mdGetTicks() + (mdTicks)(mdSize)pUserData;
+	while (mdGetTicks() < endTicks)
+	{
+	}
+}
+
+class TaskGraphTest : public TestWithParam<u32>
+{
+protected:
+	void SetUp() override
+	{
+		mdJobSystemInitialize(GetParam());
+		s_pLog				 = new TaskLog();
+		s_pLog->mainThreadId = mdThreadGetCurrentId();
+	}
+
+	void TearDown() override
+	{
+		delete s_pLog;
+		s_pLog = nullptr;
+		mdJobSystemShutdown();
+	}
+};
+
+TEST_P(TaskGraphTest, ConflictingTasksRunInDeclarationOrder)
+{
+	struct MdTaskDecl tasks[] = {
+		{"Consume", consume, nullptr, RESOURCE_VALUE, 0, MD_FALSE, MD_FALSE},
+		{"Produce", produce, nullptr, 0, RESOURCE_VALUE, MD_FALSE, MD_FALSE},
+		{"Independent", runIndependently, nullptr, RESOURCE_OTHER, 0, MD_FALSE, MD_FALSE},
+		{"Main", runOnMainThread, nullptr, RESOURCE_VALUE, 0, MD_TRUE, MD_FALSE},
+	};
+	struct MdTaskGraph* pGraph = mdTaskGraphCreate(tasks, MD_ARRAY_SIZE(tasks));
+	for (u32 i = 0; i < 3; ++i)
+	{
+		mdTaskGraphExecute(pGraph);
+	}
+	mdTaskGraphWaitIdle(pGraph);
+	mdTaskGraphDestroy(pGraph);
+
+	// Reading before the write sees the previous frame, the main thread task after it sees the current one.
+	ASSERT_EQ(s_pLog->entries.size(), 12u);
+	for (u32 frame = 0; frame < 3; ++frame)
+	{
+		EXPECT_LT(findEntry("consume " + std::to_string(frame)), findEntry("produce " + std::to_string(frame + 1)));
+	}
+	EXPECT_EQ(s_pLog->value, 3u);
+	EXPECT_TRUE(s_pLog->isOnMainThread);
+}
+
+static void produceFrame(void*)
+{
+	++s_pLog->framesCount;
+	logEntry("produce " + std::to_string(s_pLog->framesCount));
+}
+
+static void submitFrame(void*)
+{
+	s_pLog->isOnMainThread &= mdThreadGetCurrentId() == s_pLog->mainThreadId;
+	logEntry("submit " + std::to_string(s_pLog->framesCount));
+}
+
+static void simulate(void*)
+{
+	logEntry("simulate");
+}
+
+TEST_P(TaskGraphTest, OverlappedTasksFinishDuringTheNextFrame)
+{
+	// The submission reads what the production writes, the simulation shares nothing with them.
+	struct MdTaskDecl tasks[] = {
+		{"Simulate", simulate, nullptr, 0, RESOURCE_OTHER, MD_FALSE, MD_FALSE},
+		{"Produce", produceFrame, nullptr, 0, RESOURCE_VALUE, MD_FALSE, MD_FALSE},
+		{"Submit", submitFrame, nullptr, RESOURCE_VALUE, 0, MD_TRUE, MD_TRUE},
+	};
+	struct MdTaskGraph* pGraph = mdTaskGraphCreate(tasks, MD_ARRAY_SIZE(tasks));
+	for (u32 i = 0; i < 4; ++i)
+	{
+		mdTaskGraphExecute(pGraph);
+
+		// The previous frame is done once an execution returns, its submission included.
+		std::lock_guard<std::mutex> lock(s_pLog->mutex);
+		if (i > 0)
+		{
+			EXPECT_LT(findEntry("submit " + std::to_string(i)), s_pLog->entries.size());
+		}
+	}
+	mdTaskGraphWaitIdle(pGraph);
+	mdTaskGraphDestroy(pGraph);
+
+	// Each submission sees its own frame, the next production waits for it.
+	for (u32 frame = 1; frame <= 4; ++frame)
+	{
+		EXPECT_LT(findEntry("produce " + std::to_string(frame)), findEntry("submit " + std::to_string(frame)));
+	}
+	for (u32 frame = 1; frame < 4; ++frame)
+	{
+		EXPECT_LT(findEntry("submit " + std::to_string(frame)), findEntry("produce " + std::to_string(frame + 1)));
+	}
+	EXPECT_EQ(s_pLog->entries.size(), 12u);
+	EXPECT_TRUE(s_pLog->isOnMainThread);
+}
+
+TEST_P(TaskGraphTest, StatsFollowTheCriticalPath)
+{
+	// A chain of two tasks, and a shorter independent task.
+	mdTicks			  spinTicks = 2 * MD_TICKS_PER_MILLISECOND;
+	struct MdTaskDecl tasks[]	= {
+		  {"First", spin, (void*)(mdSize)spinTicks, 0, RESOURCE_VALUE, MD_FALSE, MD_FALSE},
+		  {"Second", spin, (void*)(mdSize)spinTicks, RESOURCE_VALUE, 0, MD_FALSE, MD_FALSE},
+		  {"Short", spin, (void*)(mdSize)0, RESOURCE_OTHER, 0, MD_FALSE, MD_FALSE},
+	  };
+	struct MdTaskGraph* pGraph = mdTaskGraphCreate(tasks, MD_ARRAY_SIZE(tasks));
+	EXPECT_EQ(mdTaskGraphGetCriticalPathTicks(pGraph), 0u);
+	for (u32 i = 0; i < 5; ++i)
+	{
+		mdTaskGraphExecute(pGraph);
+	}
+	mdTaskGraphWaitIdle(pGraph);
+
+	struct MdTaskStats first  = mdTaskGraphGetTaskStats(pGraph, 0);
+	struct MdTaskStats second = mdTaskGraphGetTaskStats(pGraph, 1);
+	struct MdTaskStats other  = mdTaskGraphGetTaskStats(pGraph, 2);
+	EXPECT_GE(first.durationTicks, spinTicks);
+	EXPECT_GE(first.averageDurationTicks, spinTicks - spinTicks / 8);
+	EXPECT_EQ(second.pathTicks, first.durationTicks + second.durationTicks);
+	EXPECT_EQ(mdTaskGraphGetCriticalPathTicks(pGraph), second.pathTicks);
+	EXPECT_EQ(first.slackTicks, 0u);
+	EXPECT_EQ(second.slackTicks, 0u);
+	EXPECT_EQ(first.criticalFramesCount, 5u);
+	EXPECT_EQ(other.slackTicks, second.pathTicks - other.durationTicks);
+	EXPECT_EQ(other.criticalFramesCount, 0u);
+
+	mdTaskGraphDestroy(pGraph);
+}
+
+INSTANTIATE_TEST_SUITE_P(WorkersCounts, TaskGraphTest, Values(0u, 3u));
@@ -0,0 +1,179 @@
+#include "common.hpp"
+
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+
+namespace {
+const char* s_logPath = "meed_file_handler_test.log";
+
+std::string readLogFile(const char* filePath)
+{
+	struct MdFileData* pFile   = mdFileOpen(filePath, MD_FILE_MODE_READ);
+	std::string		   content = mdFileIsOpen(pFile) ? std::string(pFile->content, pFile->size) : std::string();
+	mdFileClose(pFile);
+	return content;
+}
+
+void removeLogFiles()
+{
+	char path[64];
+	mdFileRemove(s_logPath);
+	for (u32 index = 1; index <= 4; ++index)
+	{
+		snprintf(path, sizeof(path), "%s.%u", s_logPath, index);
+		mdFileRemove(path);
+	}
+}
+
+void logRecords(void* pArgument)
+{
+	MD_UNUSED(pArgument);
+	for (u32 i = 0; i < 1000; ++i)
+	{
+		MD_LOG_INFO("threaded record");
+	}
+}
+} // anonymous namespace
+
+class FileLogHandlerTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		removeLogFiles();
+
+		config						= mdFileLogHandlerGetDefaultConfig(s_logPath);
+		config.flushIntervalSeconds = 0;
+		config.syncPolicy			= MD_FILE_LOG_SYNC_POLICY_NONE;
+	}
+
+	void Start()
+	{
+		mdLogInitialize(MD_LOG_LEVEL_VERBOSE);
+		mdInitializeFileLogHandler(MD_LOG_LEVEL_VERBOSE, &config);
+		mdLogAddHandler(MD_LOG_FILE_HANDLER);
+	}
+
+	void Stop()
+	{
+		mdLogShutdown();
+		mdShutdownFileLogHandler();
+	}
+
+	void TearDown() override
+	{
+		removeLogFiles();
+	}
+
+protected:
+	struct MdFileLogHandlerConfig config;
+};
+
+TEST_F(FileLogHandlerTest, RecordsAreBufferedUntilFlush)
+{
+	Start();
+
+	MD_LOG_INFO_CAT(MD_LOG_CATEGORY_CORE, "buffered %d", 1);
+	EXPECT_TRUE(readLogFile(s_logPath).empty());
+
+	mdFileLogHandlerFlush();
+	std::string content = readLogFile(s_logPath);
+	EXPECT_NE(content.find("buffered 1"), std::string::npos);
+	EXPECT_NE(content.find("CORE"), std::string::npos);
+
+	Stop();
+}
+
+TEST_F(FileLogHandlerTest, FlushLevelWritesImmediately)
+{
+	Start();
+
+	MD_LOG_INFO("first");
+	MD_LOG_ERROR("second");
+
+	std::string content = readLogFile(s_logPath);
+	EXPECT_LT(content.find("first"), content.find("second"));
+	EXPECT_NE(content.find("second"), std::string::npos);
+
+	Stop();
+}
+
+TEST_F(FileLogHandlerTest, LogFlushWritesExpiredBuffer)
+{
+	config.flushIntervalSeconds = 1;
+	Start();
+
+	MD_LOG_INFO("idle");
+	mdLogFlush();
+	EXPECT_TRUE(readLogFile(s_logPath).empty());
+
+	// No other record arrives, only `mdLogFlush` sees that the buffer is older than the interval.
+	usleep(1100 * 1000);
+	mdLogFlush();
+	EXPECT_NE(readLogFile(s_logPath).find("idle"), std::string::npos);
+
+	Stop();
+}
+
+TEST_F(FileLogHandlerTest, RecordsFromSeveralThreadsAreKept)
+{
+	config.bufferSize = 64u * 1024u;
+	Start();
+
+	struct MdThread* threads[4];
+	for (u32 i = 0; i < 4; ++i)
+	{
+		threads[i] = mdThreadCreate(logRecords, nullptr, "md-test");
+		ASSERT_NE(threads[i], nullptr);
+	}
+	for (u32 i = 0; i < 4; ++i)
+	{
+		mdThreadJoin(threads[i]);
+	}
+
+	Stop();
+
+	std::string content = readLogFile(s_logPath);
+	u32	   count	= 0;
+	size_t position = content.find("threaded record\n");
+	while (position != std::string::npos)
+	{
+		count++;
+		position = content.find("threaded record\n", position + 1);
+	}
+	EXPECT_EQ(count, 4000u);
+}
+
+TEST_F(FileLogHandlerTest, ShutdownFlushesPendingRecords)
+{
+	Start();
+	MD_LOG_INFO("pending");
+	Stop();
+
+	EXPECT_NE(readLogFile(s_logPath).find("pending"), std::string::npos);
+}
+
+TEST_F(FileLogHandlerTest, RotatesBySizeAndBoundsRetainedFiles)
+{
+	config.maxFileSize		= 1;
+	config.maxRetainedFiles = 2;
+	config.flushLevel		= MD_LOG_LEVEL_VERBOSE;
+	Start();
+
+	MD_LOG_INFO("record 1");
+	MD_LOG_INFO("record 2");
+	MD_LOG_INFO("record 3");
+	MD_LOG_INFO("record 4");
+
+	Stop();
+
+	char path[64];
+	snprintf(path, sizeof(path), "%s.1", s_logPath);
+	EXPECT_NE(readLogFile(path).find("record 4"), std::string::npos);
+	snprintf(path, sizeof(path), "%s.2", s_logPath);
+	EXPECT_NE(readLogFile(path).find("record 3"), std::string::npos);
+	snprintf(path, sizeof(path), "%s.3", s_logPath);
+	EXPECT_FALSE(mdFileExists(path));
+	EXPECT_TRUE(readLogFile(s_logPath).empty());
+}
@@ -0,0 +1,206 @@
+#include "common.hpp"
+
+#include <string>
+
+namespace {
+static u32				  s_recordsCount = 0;
+static struct MdLogRecord s_lastRecord;
+static struct MdLogRecord s_firstRecord;
+static u32				  s_evaluationsCount = 0;
+
+void captureRecord(const struct MdLogRecord* pRecord)
+{
+	if (s_recordsCount == 0)
+	{
+		mdMemoryCopy(&s_firstRecord, pRecord, sizeof(struct MdLogRecord));
+	}
+	s_recordsCount++;
+	mdMemoryCopy(&s_lastRecord, pRecord, sizeof(struct MdLogRecord));
+}
+
+u32 countEvaluation()
+{
+	s_evaluationsCount++;
+	return s_evaluationsCount;
+}
+} // anonymous namespace
+
+class LoggerTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		s_recordsCount	   = 0;
+		s_evaluationsCount = 0;
+		mdMemorySet(&s_lastRecord, 0, sizeof(struct MdLogRecord));
+		mdMemorySet(&s_firstRecord, 0, sizeof(struct MdLogRecord));
+
+		handler.init		 = nullptr;
+		handler.recordHandle = captureRecord;
+		handler.shutdown	 = nullptr;
+		handler.flush		 = nullptr;
+		handler.level		 = MD_LOG_LEVEL_VERBOSE;
+
+		mdLogInitialize(MD_LOG_LEVEL_INFO);
+		mdLogAddHandler(&handler);
+	}
+
+	void TearDown() override
+	{
+		mdLogShutdown();
+	}
+
+protected:
+	struct MdLogHandler	 handler;
+	struct MdLogCallSite callSite; ///< Registered in the logger until the shutdown of `TearDown`.
+};
+
+TEST_F(LoggerTest, RecordCarriesCategoryAndMessage)
+{
+	MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Frame %d took %s", 7, "long");
+
+	EXPECT_EQ(s_recordsCount, 1u);
+	EXPECT_EQ(s_lastRecord.category, MD_LOG_CATEGORY_RENDER);
+	EXPECT_EQ(s_lastRecord.level, MD_LOG_LEVEL_WARNING);
+	EXPECT_STREQ(s_lastRecord.message, "Frame 7 took long");
+}
+
+TEST_F(LoggerTest, BelowThresholdSkipsArguments)
+{
+	MD_LOG_DEBUG_CAT(MD_LOG_CATEGORY_RENDER, "Value %u", countEvaluation());
+
+	EXPECT_EQ(s_recordsCount, 0u);
+	EXPECT_EQ(s_evaluationsCount, 0u);
+}
+
+TEST_F(LoggerTest, CategoryThresholdsAreIndependent)
+{
+	// Levels at or above the release floor (`MD_LOG_COMPILE_LEVEL`), so no statement is compiled out.
+	mdLogSetCategoryLevel(MD_LOG_CATEGORY_RENDER, MD_LOG_LEVEL_ERROR);
+	EXPECT_EQ(mdLogGetCategoryLevel(MD_LOG_CATEGORY_RENDER), MD_LOG_LEVEL_ERROR);
+	EXPECT_EQ(mdLogGetCategoryLevel(MD_LOG_CATEGORY_PLATFORM), MD_LOG_LEVEL_INFO);
+
+	MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_RENDER, "Value %u", countEvaluation());
+	MD_LOG_WARNING_CAT(MD_LOG_CATEGORY_PLATFORM, "Value %u", countEvaluation());
+
+	EXPECT_EQ(s_recordsCount, 1u);
+	EXPECT_EQ(s_evaluationsCount, 1u);
+	EXPECT_EQ(s_lastRecord.category, MD_LOG_CATEGORY_PLATFORM);
+
+#if MD_LOG_COMPILE_LEVEL <= 0
+	// Lowering a category threshold lets its verbose statements through.
+	mdLogSetCategoryLevel(MD_LOG_CATEGORY_RENDER, MD_LOG_LEVEL_VERBOSE);
+	MD_LOG_VERBOSE_CAT(MD_LOG_CATEGORY_RENDER, "Value %u", countEvaluation());
+	MD_LOG_VERBOSE_CAT(MD_LOG_CATEGORY_PLATFORM, "Value %u", countEvaluation());
+
+	EXPECT_EQ(s_recordsCount, 2u);
+	EXPECT_EQ(s_evaluationsCount, 2u);
+	EXPECT_EQ(s_lastRecord.category, MD_LOG_CATEGORY_RENDER);
+#endif
+}
+
+TEST_F(LoggerTest, DisableCategory)
+{
+	mdLogSetCategoryLevel(MD_LOG_CATEGORY_ENGINE, MD_LOG_LEVEL_NONE);
+
+	MD_LOG_FATAL("Should be dropped %u", countEvaluation());
+
+	EXPECT_EQ(s_recordsCount, 0u);
+	EXPECT_EQ(s_evaluationsCount, 0u);
+}
+
+TEST_F(LoggerTest, HandlerLevelFiltersRecords)
+{
+	handler.level = MD_LOG_LEVEL_ERROR;
+
+	MD_LOG_WARNING("Warning");
+	EXPECT_EQ(s_recordsCount, 0u);
+
+	MD_LOG_ERROR("Error");
+	EXPECT_EQ(s_recordsCount, 1u);
+}
+
+TEST_F(LoggerTest, CategoryNames)
+{
+	EXPECT_STREQ(mdLogGetCategoryName(MD_LOG_CATEGORY_ENGINE), "ENGINE");
+	EXPECT_STREQ(mdLogGetCategoryName(MD_LOG_CATEGORY_RENDER), "RENDER");
+}
+
+TEST_F(LoggerTest, ThrottledCallSiteDropsRecordsAboveLimit)
+{
+	callSite = {2, mdGetTicks(), 0, 0};
+
+	for (u32 i = 0; i < 10; ++i)
+	{
+		mdLogPrint(&callSite, MD_LOG_CATEGORY_RENDER, MD_LOG_LEVEL_WARNING, __FILE__, __LINE__, "Record %u", i);
+	}
+
+	EXPECT_EQ(s_recordsCount, 2u);
+	EXPECT_STREQ(s_lastRecord.message, "Record 1");
+	EXPECT_EQ(callSite.suppressedCount, 8u);
+}
+
+TEST_F(LoggerTest, ThrottledCallSiteReportsRepeatsInNextWindow)
+{
+	callSite = {1, mdGetTicks() - MD_TICKS_PER_SECOND, 1, 4312};
+
+	mdLogPrint(&callSite, MD_LOG_CATEGORY_RENDER, MD_LOG_LEVEL_WARNING, __FILE__, __LINE__, "Fresh");
+
+	EXPECT_EQ(s_recordsCount, 2u);
+	EXPECT_STREQ(s_firstRecord.message, "message repeated 4312 times in last 1s");
+	EXPECT_EQ(s_firstRecord.category, MD_LOG_CATEGORY_RENDER);
+	EXPECT_STREQ(s_lastRecord.message, "Fresh");
+	EXPECT_EQ(callSite.suppressedCount, 0u);
+}
+
+TEST_F(LoggerTest, FlushReportsRepeatsOfAStoppedCallSite)
+{
+	callSite = {1, mdGetTicks(), 0, 0};
+	for (u32 i = 0; i < 3; ++i)
+	{
+		mdLogPrint(&callSite, MD_LOG_CATEGORY_RENDER, MD_LOG_LEVEL_WARNING, "file.c", 12, "Record %u", i);
+	}
+	EXPECT_EQ(s_recordsCount, 1u);
+
+	// The statement stopped two minutes ago, the summary covers the whole window.
+	callSite.windowStart -= 120 * MD_TICKS_PER_SECOND;
+	mdLogFlush();
+
+	EXPECT_EQ(s_recordsCount, 2u);
+	EXPECT_EQ(std::string(s_lastRecord.message).rfind("message repeated 2 times in last 12", 0), 0u);
+	EXPECT_EQ(s_lastRecord.category, MD_LOG_CATEGORY_RENDER);
+	EXPECT_EQ(s_lastRecord.level, MD_LOG_LEVEL_WARNING);
+	EXPECT_STREQ(s_lastRecord.file, "file.c");
+	EXPECT_EQ(s_lastRecord.line, 12u);
+
+	mdLogFlush();
+	EXPECT_EQ(s_recordsCount, 2u);
+}
+
+TEST_F(LoggerTest, ShutdownReportsPendingRepeats)
+{
+	callSite = {1, mdGetTicks(), 0, 0};
+	for (u32 i = 0; i < 5; ++i)
+	{
+		mdLogPrint(&callSite, MD_LOG_CATEGORY_RENDER, MD_LOG_LEVEL_WARNING, __FILE__, __LINE__, "Record %u", i);
+	}
+
+	mdLogShutdown();
+	EXPECT_EQ(s_recordsCount, 2u);
+	EXPECT_STREQ(s_lastRecord.message, "message repeated 4 times in last 1s");
+	EXPECT_EQ(callSite.isRegistered, 0u);
+
+	mdLogInitialize(MD_LOG_LEVEL_INFO);
+}
+
+TEST_F(LoggerTest, ThrottledMacroLimitsEachCallSite)
+{
+	for (u32 i = 0; i < 100; ++i)
+	{
+		MD_LOG_WARNING_THROTTLED(1, "Flood %u", i);
+	}
+
+	// A window boundary inside the loop lets at most one more record and one summary through.
+	EXPECT_GE(s_recordsCount, 1u);
+	EXPECT_LE(s_recordsCount, 3u);
+}
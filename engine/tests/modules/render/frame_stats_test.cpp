@@ -0,0 +1,148 @@
+#include "common.hpp"
+
+#include <string>
+
+namespace {
+const char* s_csvPath = "meed_frame_stats_test.csv";
+
+mdTicks milliseconds(f64 value)
+{
+	return mdSecondsToTicks(value * 1e-3);
+}
+} // anonymous namespace
+
+class FrameStatsTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		mdFrameStatsInitialize(4);
+	}
+
+	void TearDown() override
+	{
+		mdFrameStatsShutdown();
+		mdFileRemove(s_csvPath);
+	}
+};
+
+TEST_F(FrameStatsTest, PhasesEnterWindowAtEndOfFrame)
+{
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_WAIT_FENCE, milliseconds(1.0));
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_WAIT_FENCE, milliseconds(2.0));
+
+	struct MdFramePhaseStats stats;
+	mdFrameStatsGetPhase(MD_FRAME_PHASE_WAIT_FENCE, &stats);
+	EXPECT_EQ(stats.timing.samplesCount, 0u);
+
+	// The durations of the same phase add up within a frame.
+	mdFrameStatsEndFrame();
+	mdFrameStatsGetPhase(MD_FRAME_PHASE_WAIT_FENCE, &stats);
+	EXPECT_EQ(stats.timing.samplesCount, 1u);
+	EXPECT_NEAR(stats.timing.averageMilliseconds, 3.0, 1e-6);
+
+	// The phases which were not recorded get no sample, the first frame has no duration.
+	mdFrameStatsGetPhase(MD_FRAME_PHASE_SUBMIT, &stats);
+	EXPECT_EQ(stats.timing.samplesCount, 0u);
+	mdFrameStatsGetPhase(MD_FRAME_PHASE_FRAME, &stats);
+	EXPECT_EQ(stats.timing.samplesCount, 0u);
+
+	mdFrameStatsEndFrame();
+	mdFrameStatsGetPhase(MD_FRAME_PHASE_FRAME, &stats);
+	EXPECT_EQ(stats.timing.samplesCount, 1u);
+}
+
+TEST_F(FrameStatsTest, HistogramBucketsDouble)
+{
+	EXPECT_DOUBLE_EQ(mdFrameStatsGetBucketLowerBound(0), 0.0);
+	EXPECT_DOUBLE_EQ(mdFrameStatsGetBucketLowerBound(1), 0.125);
+	EXPECT_DOUBLE_EQ(mdFrameStatsGetBucketLowerBound(4), 1.0);
+
+	f64 durations[] = {0.1, 0.2, 100.0, 1000.0};
+	for (f64 duration : durations)
+	{
+		mdFrameStatsRecordPhase(MD_FRAME_PHASE_PRESENT, milliseconds(duration));
+		mdFrameStatsEndFrame();
+	}
+
+	struct MdFramePhaseStats stats;
+	mdFrameStatsGetPhase(MD_FRAME_PHASE_PRESENT, &stats);
+	EXPECT_EQ(stats.histogram[0], 1u);
+	EXPECT_EQ(stats.histogram[1], 1u);
+	EXPECT_EQ(stats.histogram[10], 1u);
+	EXPECT_EQ(stats.histogram[MD_FRAME_STATS_HISTOGRAM_BUCKETS - 1], 1u);
+}
+
+TEST_F(FrameStatsTest, HistogramFollowsWindow)
+{
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_RECORD, milliseconds(10.0));
+	mdFrameStatsEndFrame();
+	for (u32 i = 0; i < 4; ++i)
+	{
+		mdFrameStatsRecordPhase(MD_FRAME_PHASE_RECORD, milliseconds(0.01));
+		mdFrameStatsEndFrame();
+	}
+
+	struct MdFramePhaseStats stats;
+	mdFrameStatsGetPhase(MD_FRAME_PHASE_RECORD, &stats);
+	EXPECT_EQ(stats.timing.samplesCount, 4u);
+	EXPECT_EQ(stats.histogram[0], 4u);
+	for (u32 i = 1; i < MD_FRAME_STATS_HISTOGRAM_BUCKETS; ++i)
+	{
+		EXPECT_EQ(stats.histogram[i], 0u);
+	}
+}
+
+TEST_F(FrameStatsTest, BoundFollowsLongestWait)
+{
+	EXPECT_EQ(mdFrameStatsGetBound(), MD_FRAME_BOUND_UNKNOWN);
+
+	// The recorded waits exceed the real duration of these frames, which are measured between the calls.
+	for (u32 i = 0; i < 4; ++i)
+	{
+		mdFrameStatsRecordPhase(MD_FRAME_PHASE_RECORD, milliseconds(0.01));
+		mdFrameStatsEndFrame();
+	}
+	EXPECT_EQ(mdFrameStatsGetBound(), MD_FRAME_BOUND_CPU);
+
+	for (u32 i = 0; i < 4; ++i)
+	{
+		mdFrameStatsRecordPhase(MD_FRAME_PHASE_WAIT_FENCE, milliseconds(50.0));
+		mdFrameStatsRecordPhase(MD_FRAME_PHASE_PRESENT, milliseconds(1.0));
+		mdFrameStatsEndFrame();
+	}
+	EXPECT_EQ(mdFrameStatsGetBound(), MD_FRAME_BOUND_GPU);
+
+	for (u32 i = 0; i < 4; ++i)
+	{
+		mdFrameStatsRecordPhase(MD_FRAME_PHASE_WAIT_FENCE, milliseconds(1.0));
+		mdFrameStatsRecordPhase(MD_FRAME_PHASE_ACQUIRE, milliseconds(20.0));
+		mdFrameStatsRecordPhase(MD_FRAME_PHASE_PRESENT, milliseconds(30.0));
+		mdFrameStatsEndFrame();
+	}
+	EXPECT_EQ(mdFrameStatsGetBound(), MD_FRAME_BOUND_VSYNC);
+}
+
+TEST_F(FrameStatsTest, ExportWritesOneRowPerPhase)
+{
+	mdFrameStatsRecordPhase(MD_FRAME_PHASE_SUBMIT, milliseconds(0.5));
+	mdFrameStatsEndFrame();
+	ASSERT_TRUE(mdFrameStatsExportCSV(s_csvPath));
+
+	struct MdFileData* pFile = mdFileOpen(s_csvPath, MD_FILE_MODE_READ);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	std::string csv(pFile->content, pFile->size);
+	mdFileClose(pFile);
+
+	EXPECT_EQ(csv.rfind("phase,samples,last_ms,average_ms,min_ms,max_ms,p95_ms,p99_ms,ge_0.000_ms,ge_0.125_ms", 0),
+			  0u);
+	EXPECT_NE(csv.find("\nsubmit,1,0.5000,0.5000,0.5000,0.5000,0.5000,0.5000,0,0,0,1,0,"), std::string::npos);
+	EXPECT_NE(csv.find("\nwait_fence,0,"), std::string::npos);
+
+	u32 linesCount = 0;
+	for (char character : csv)
+	{
+		linesCount += character == '\n';
+	}
+	EXPECT_EQ(linesCount, 1u + MD_FRAME_PHASE_COUNT);
+}
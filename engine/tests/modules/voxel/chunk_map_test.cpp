@@ -0,0 +1,229 @@
+#include "common.hpp"
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace {
+u32 s_deletedCount = 0;
+
+void countDeleted(void* pData)
+{
+	MD_UNUSED(pData);
+	++s_deletedCount;
+}
+
+void* payload(i32 x, i32 y, i32 z)
+{
+	return (void*)(mdSize)(((x & 0xFF) << 16) | ((y & 0xFF) << 8) | (z & 0xFF) | 0x1000000);
+}
+
+/**
+ * Checks every link of every slot against a lookup of the neighbor.
+ */
+void expectLinksMatchLookups(struct MdChunkMap* pMap)
+{
+	for (u32 i = 0; i < mdChunkMapCount(pMap); ++i)
+	{
+		struct MdChunkMapSlot* pSlot = mdChunkMapAt(pMap, i);
+		ASSERT_EQ(mdChunkMapFind(pMap, pSlot->x, pSlot->y, pSlot->z), i);
+		for (i32 dx = -1; dx <= 1; ++dx)
+		{
+			for (i32 dy = -1; dy <= 1; ++dy)
+			{
+				for (i32 dz = -1; dz <= 1; ++dz)
+				{
+					if (dx == 0 && dy == 0 && dz == 0)
+					{
+						continue;
+					}
+					ASSERT_EQ(pSlot->neighborSlots[MD_CHUNK_MAP_NEIGHBOR_INDEX(dx, dy, dz)],
+							  mdChunkMapFind(pMap, pSlot->x + dx, pSlot->y + dy, pSlot->z + dz));
+				}
+			}
+		}
+	}
+}
+} // anonymous namespace
+
+class ChunkMapTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		s_deletedCount = 0;
+		m_pMap		   = mdChunkMapCreate(0, countDeleted);
+	}
+
+	void TearDown() override
+	{
+		mdChunkMapDestroy(m_pMap);
+	}
+
+protected:
+	struct MdChunkMap* m_pMap;
+};
+
+TEST_F(ChunkMapTest, InsertFindAndRemove)
+{
+	EXPECT_EQ(mdChunkMapCount(m_pMap), 0u);
+	EXPECT_EQ(mdChunkMapFind(m_pMap, 0, 0, 0), MD_CHUNK_MAP_NOT_FOUND_INDEX);
+
+	u32 slotIndex = mdChunkMapInsert(m_pMap, 1, -2, 3, payload(1, -2, 3));
+	EXPECT_EQ(mdChunkMapCount(m_pMap), 1u);
+	EXPECT_EQ(mdChunkMapFind(m_pMap, 1, -2, 3), slotIndex);
+	EXPECT_EQ(mdChunkMapGet(m_pMap, 1, -2, 3), payload(1, -2, 3));
+	EXPECT_EQ(mdChunkMapGet(m_pMap, -1, 2, -3), nullptr);
+
+	EXPECT_FALSE(mdChunkMapRemove(m_pMap, 3, -2, 1));
+	EXPECT_TRUE(mdChunkMapRemove(m_pMap, 1, -2, 3));
+	EXPECT_EQ(s_deletedCount, 1u);
+	EXPECT_EQ(mdChunkMapCount(m_pMap), 0u);
+	EXPECT_EQ(mdChunkMapGet(m_pMap, 1, -2, 3), nullptr);
+}
+
+TEST_F(ChunkMapTest, InsertAgainReplacesThePayload)
+{
+	u32 slotIndex = mdChunkMapInsert(m_pMap, 4, 5, 6, payload(0, 0, 1));
+	EXPECT_EQ(mdChunkMapInsert(m_pMap, 4, 5, 6, payload(0, 0, 2)), slotIndex);
+	EXPECT_EQ(mdChunkMapCount(m_pMap), 1u);
+	EXPECT_EQ(s_deletedCount, 1u);
+	EXPECT_EQ(mdChunkMapGet(m_pMap, 4, 5, 6), payload(0, 0, 2));
+}
+
+TEST_F(ChunkMapTest, ExtremeCoordinates)
+{
+	const i32 minimum = MD_CHUNK_MAP_MIN_COORDINATE;
+	const i32 maximum = MD_CHUNK_MAP_MAX_COORDINATE;
+	mdChunkMapInsert(m_pMap, minimum, maximum, minimum, payload(1, 1, 1));
+	mdChunkMapInsert(m_pMap, maximum, minimum, maximum, payload(2, 2, 2));
+	mdChunkMapInsert(m_pMap, -1, -1, -1, payload(3, 3, 3));
+
+	EXPECT_EQ(mdChunkMapGet(m_pMap, minimum, maximum, minimum), payload(1, 1, 1));
+	EXPECT_EQ(mdChunkMapGet(m_pMap, maximum, minimum, maximum), payload(2, 2, 2));
+	EXPECT_EQ(mdChunkMapGet(m_pMap, -1, -1, -1), payload(3, 3, 3));
+	EXPECT_EQ(mdChunkMapGet(m_pMap, maximum, maximum, maximum), nullptr);
+	expectLinksMatchLookups(m_pMap);
+}
+
+TEST_F(ChunkMapTest, NeighborsFollowLoadsAndUnloads)
+{
+	for (i32 x = -1; x <= 1; ++x)
+	{
+		for (i32 y = -1; y <= 1; ++y)
+		{
+			for (i32 z = -1; z <= 1; ++z)
+			{
+				mdChunkMapInsert(m_pMap, x, y, z, payload(x, y, z));
+			}
+		}
+	}
+
+	u32 center = mdChunkMapFind(m_pMap, 0, 0, 0);
+	for (u32 i = 0; i < MD_CHUNK_MAP_NEIGHBORS_COUNT; ++i)
+	{
+		EXPECT_NE(mdChunkMapAt(m_pMap, center)->neighborSlots[i], MD_CHUNK_MAP_NOT_FOUND_INDEX);
+	}
+	EXPECT_EQ(mdChunkMapGetNeighbor(m_pMap, center, 1, -1, 0), payload(1, -1, 0));
+	EXPECT_EQ(mdChunkMapGetNeighbor(m_pMap, center, -1, -1, -1), payload(-1, -1, -1));
+
+	// The first chunk is unloaded: the last slot moves in its place, the links follow.
+	EXPECT_EQ(mdChunkMapFind(m_pMap, -1, -1, -1), 0u);
+	EXPECT_TRUE(mdChunkMapRemove(m_pMap, -1, -1, -1));
+	expectLinksMatchLookups(m_pMap);
+	center = mdChunkMapFind(m_pMap, 0, 0, 0);
+	EXPECT_EQ(mdChunkMapGetNeighbor(m_pMap, center, -1, -1, -1), nullptr);
+	EXPECT_EQ(mdChunkMapGetNeighbor(m_pMap, center, 1, 1, 1), payload(1, 1, 1));
+
+	mdChunkMapInsert(m_pMap, -1, -1, -1, payload(-1, -1, -1));
+	center = mdChunkMapFind(m_pMap, 0, 0, 0);
+	EXPECT_EQ(mdChunkMapGetNeighbor(m_pMap, center, -1, -1, -1), payload(-1, -1, -1));
+	expectLinksMatchLookups(m_pMap);
+}
+
+TEST_F(ChunkMapTest, RandomLoadsAndUnloadsMatchReference)
+{
+	std::map<std::tuple<i32, i32, i32>, void*> reference;
+	u32										   seed = 12345;
+	for (u32 step = 0; step < 20000; ++step)
+	{
+		seed  = seed * 1664525u + 1013904223u;
+		i32 x = (i32)((seed >> 8) % 12) - 6;
+		i32 y = (i32)((seed >> 12) % 6) - 3;
+		i32 z = (i32)((seed >> 16) % 12) - 6;
+		if ((seed >> 28) < 9)
+		{
+			mdChunkMapInsert(m_pMap, x, y, z, payload(x, y, z));
+			reference[std::make_tuple(x, y, z)] = payload(x, y, z);
+		}
+		else
+		{
+			EXPECT_EQ(mdChunkMapRemove(m_pMap, x, y, z), reference.erase(std::make_tuple(x, y, z)) == 1);
+		}
+
+		if (step % 1000 == 0)
+		{
+			expectLinksMatchLookups(m_pMap);
+		}
+	}
+
+	EXPECT_EQ(mdChunkMapCount(m_pMap), (u32)reference.size());
+	for (const auto& entry : reference)
+	{
+		EXPECT_EQ(mdChunkMapGet(m_pMap, std::get<0>(entry.first), std::get<1>(entry.first), std::get<2>(entry.first)),
+				  entry.second);
+	}
+	expectLinksMatchLookups(m_pMap);
+}
+
+TEST_F(ChunkMapTest, QueryBoxFindsTheChunksInside)
+{
+	for (i32 x = 0; x < 10; ++x)
+	{
+		for (i32 z = 0; z < 10; ++z)
+		{
+			mdChunkMapInsert(m_pMap, x, 0, z, payload(x, 0, z));
+		}
+	}
+
+	// A box smaller than the chunks count probes its coordinates, a larger one scans the slots.
+	const i32 boxes[][6] = {{2, -1, 3, 4, 1, 5}, {-5, -5, -5, 20, 20, 7}, {5, 1, 5, 9, 9, 9}};
+	for (const auto& box : boxes)
+	{
+		std::vector<u32> expected;
+		for (u32 i = 0; i < mdChunkMapCount(m_pMap); ++i)
+		{
+			struct MdChunkMapSlot* pSlot = mdChunkMapAt(m_pMap, i);
+			if (pSlot->x >= box[0] && pSlot->y >= box[1] && pSlot->z >= box[2] && pSlot->x <= box[3] &&
+				pSlot->y <= box[4] && pSlot->z <= box[5])
+			{
+				expected.push_back(i);
+			}
+		}
+
+		std::vector<u32> found(100);
+		u32				 foundCount =
+			mdChunkMapQueryBox(m_pMap, box[0], box[1], box[2], box[3], box[4], box[5], found.data(), (u32)found.size());
+		found.resize(foundCount);
+		std::sort(found.begin(), found.end());
+		EXPECT_EQ(found, expected);
+	}
+
+	u32 first;
+	EXPECT_EQ(mdChunkMapQueryBox(m_pMap, 0, 0, 0, 9, 0, 9, &first, 1), 100u);
+	EXPECT_EQ(mdChunkMapQueryBox(m_pMap, 0, 0, 0, 9, 0, 9, nullptr, 0), 100u);
+}
+
+TEST_F(ChunkMapTest, DestroyDeletesThePayloads)
+{
+	struct MdChunkMap* pMap = mdChunkMapCreate(2, countDeleted);
+	for (i32 i = 0; i < 100; ++i)
+	{
+		mdChunkMapInsert(pMap, i, -i, i * 2, payload(i, -i, i * 2));
+	}
+	EXPECT_EQ(mdChunkMapCount(pMap), 100u);
+
+	mdChunkMapDestroy(pMap);
+	EXPECT_EQ(s_deletedCount, 100u);
+}
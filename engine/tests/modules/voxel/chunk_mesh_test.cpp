@@ -0,0 +1,333 @@
+#include "common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
+
+namespace {
+// A unit face: the block, the side, and its block type.
+using Face = std::tuple<i32, i32, i32, u32, u32>;
+
+const i32 s_faceOffsets[MD_CHUNK_FACE_COUNT][3] = {
+	{-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1},
+};
+
+u32 hash(u32 value)
+{
+	value ^= value >> 16;
+	value *= 0x7feb352du;
+	value ^= value >> 15;
+	value *= 0x846ca68bu;
+	return value ^ (value >> 16);
+}
+
+/**
+ * The faces which must be visible, block by block.
+ */
+std::vector<Face> exposedFaces(const std::vector<mdBlockId>& blocks,
+							   const mdBlockId* const		 pNeighborFaces[MD_CHUNK_FACE_COUNT])
+{
+	std::vector<Face> faces;
+	for (i32 y = 0; y < (i32)MD_CHUNK_SIZE; ++y)
+	{
+		for (i32 z = 0; z < (i32)MD_CHUNK_SIZE; ++z)
+		{
+			for (i32 x = 0; x < (i32)MD_CHUNK_SIZE; ++x)
+			{
+				mdBlockId blockId = blocks[MD_CHUNK_BLOCK_INDEX(x, y, z)];
+				if (blockId == MD_BLOCK_ID_EMPTY)
+				{
+					continue;
+				}
+
+				for (u32 face = 0; face < MD_CHUNK_FACE_COUNT; ++face)
+				{
+					const i32* offset	  = s_faceOffsets[face];
+					i32		   c[3]		  = {x + offset[0], y + offset[1], z + offset[2]};
+					mdBlockId  neighborId = MD_BLOCK_ID_EMPTY;
+					if (c[0] >= 0 && c[1] >= 0 && c[2] >= 0 && c[0] < (i32)MD_CHUNK_SIZE &&
+						c[1] < (i32)MD_CHUNK_SIZE && c[2] < (i32)MD_CHUNK_SIZE)
+					{
+						neighborId = blocks[MD_CHUNK_BLOCK_INDEX(c[0], c[1], c[2])];
+					}
+					else if (pNeighborFaces[face] != nullptr)
+					{
+						// The two axes other than the normal of the side, in the order x, y, z.
+						i32 other[2];
+						u32 count = 0;
+						for (u32 axis = 0; axis < 3; ++axis)
+						{
+							if (axis != face / 2)
+							{
+								other[count++] = axis == 0 ? x : (axis == 1 ? y : z);
+							}
+						}
+						neighborId = pNeighborFaces[face][MD_CHUNK_FACE_BLOCK_INDEX(other[0], other[1])];
+					}
+
+					if (neighborId == MD_BLOCK_ID_EMPTY)
+					{
+						faces.emplace_back(x, y, z, face, blockId);
+					}
+				}
+			}
+		}
+	}
+	std::sort(faces.begin(), faces.end());
+	return faces;
+}
+
+/**
+ * Cuts the quads of a mesh back into unit faces, checking each quad on the way.
+ */
+std::vector<Face> meshFaces(const struct MdChunkMesh* pMesh)
+{
+	std::vector<Face> faces;
+	EXPECT_EQ(pMesh->verticesCount, pMesh->quadsCount * MD_CHUNK_MESH_VERTICES_PER_QUAD);
+	for (u32 quad = 0; quad < pMesh->quadsCount; ++quad)
+	{
+		const struct MdChunkMeshVertex* pVertices = &pMesh->pVertices[quad * MD_CHUNK_MESH_VERTICES_PER_QUAD];
+		u32								face	  = pVertices[0].face;
+		u32								normal	  = face / 2;
+
+		f32 minimum[3] = {pVertices[0].position[0], pVertices[0].position[1], pVertices[0].position[2]};
+		f32 maximum[3] = {minimum[0], minimum[1], minimum[2]};
+		for (u32 i = 0; i < MD_CHUNK_MESH_VERTICES_PER_QUAD; ++i)
+		{
+			EXPECT_EQ(pVertices[i].face, face);
+			EXPECT_EQ(pVertices[i].blockId, pVertices[0].blockId);
+			EXPECT_EQ(pVertices[i].textureId, pVertices[0].textureId);
+			for (u32 axis = 0; axis < 3; ++axis)
+			{
+				minimum[axis] = std::min(minimum[axis], pVertices[i].position[axis]);
+				maximum[axis] = std::max(maximum[axis], pVertices[i].position[axis]);
+			}
+		}
+		EXPECT_EQ(minimum[normal], maximum[normal]);
+
+		// Both triangles face outside the block, counter-clockwise.
+		for (u32 triangle = 0; triangle < 2; ++triangle)
+		{
+			const f32* a	= pVertices[triangle * 3].position;
+			const f32* b	= pVertices[triangle * 3 + 1].position;
+			const f32* c	= pVertices[triangle * 3 + 2].position;
+			f32		   e[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+			f32		   f[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+			f32		   n[3] = {e[1] * f[2] - e[2] * f[1], e[2] * f[0] - e[0] * f[2], e[0] * f[1] - e[1] * f[0]};
+			EXPECT_GT(n[normal] * (f32)s_faceOffsets[face][normal], 0.0f);
+		}
+
+		// The blocks of the faces are behind the plane of the quad.
+		i32 first[3];
+		i32 last[3];
+		for (u32 axis = 0; axis < 3; ++axis)
+		{
+			first[axis] = (i32)minimum[axis];
+			last[axis]	= axis == normal ? first[axis] + 1 : (i32)maximum[axis];
+		}
+		if (face % 2 == 1)
+		{
+			first[normal] -= 1;
+			last[normal] -= 1;
+		}
+		for (i32 x = first[0]; x < last[0]; ++x)
+		{
+			for (i32 y = first[1]; y < last[1]; ++y)
+			{
+				for (i32 z = first[2]; z < last[2]; ++z)
+				{
+					faces.emplace_back(x, y, z, face, pVertices[0].blockId);
+				}
+			}
+		}
+	}
+	std::sort(faces.begin(), faces.end());
+	return faces;
+}
+
+u32 textureBySide(mdBlockId blockId, enum MdChunkFace face, void* pUserData)
+{
+	MD_UNUSED(pUserData);
+	return blockId * 10 + (u32)face;
+}
+} // anonymous namespace
+
+class ChunkMeshTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		m_pMesh = mdChunkMeshCreate();
+		m_blocks.assign(MD_CHUNK_VOLUME, MD_BLOCK_ID_EMPTY);
+	}
+
+	void TearDown() override
+	{
+		mdChunkMeshDestroy(m_pMesh);
+	}
+
+	void expectExposedFaces(const mdBlockId* const pNeighborFaces[MD_CHUNK_FACE_COUNT])
+	{
+		mdChunkMeshBuild(m_pMesh, m_blocks.data(), pNeighborFaces, nullptr, nullptr);
+		EXPECT_EQ(meshFaces(m_pMesh), exposedFaces(m_blocks, pNeighborFaces));
+	}
+
+protected:
+	struct MdChunkMesh*	   m_pMesh;
+	std::vector<mdBlockId> m_blocks;
+};
+
+TEST_F(ChunkMeshTest, EmptyChunkHasNoQuads)
+{
+	const mdBlockId* neighborFaces[MD_CHUNK_FACE_COUNT] = {};
+	mdChunkMeshBuild(m_pMesh, m_blocks.data(), neighborFaces, nullptr, nullptr);
+	EXPECT_EQ(m_pMesh->quadsCount, 0u);
+	EXPECT_EQ(m_pMesh->verticesCount, 0u);
+}
+
+TEST_F(ChunkMeshTest, SingleBlockHasSixFaces)
+{
+	m_blocks[MD_CHUNK_BLOCK_INDEX(3, 4, 5)] = 7;
+	const mdBlockId* neighborFaces[MD_CHUNK_FACE_COUNT] = {};
+	expectExposedFaces(neighborFaces);
+	EXPECT_EQ(m_pMesh->quadsCount, 6u);
+}
+
+TEST_F(ChunkMeshTest, FullChunkMergesEachSide)
+{
+	std::fill(m_blocks.begin(), m_blocks.end(), 1);
+	const mdBlockId* neighborFaces[MD_CHUNK_FACE_COUNT] = {};
+	expectExposedFaces(neighborFaces);
+	EXPECT_EQ(m_pMesh->quadsCount, 6u);
+
+	const struct MdChunkMeshVertex* pVertex = &m_pMesh->pVertices[0];
+	EXPECT_EQ(std::max(pVertex[1].uv[0], pVertex[2].uv[0]), (f32)MD_CHUNK_SIZE);
+}
+
+TEST_F(ChunkMeshTest, FlatTerrainMergesByBlockType)
+{
+	// Stone below, a layer of dirt, grass on top.
+	for (u32 y = 0; y < 12; ++y)
+	{
+		for (u32 z = 0; z < MD_CHUNK_SIZE; ++z)
+		{
+			for (u32 x = 0; x < MD_CHUNK_SIZE; ++x)
+			{
+				m_blocks[MD_CHUNK_BLOCK_INDEX(x, y, z)] = y < 10 ? 1 : (y < 11 ? 2 : 3);
+			}
+		}
+	}
+	const mdBlockId* neighborFaces[MD_CHUNK_FACE_COUNT] = {};
+	expectExposedFaces(neighborFaces);
+
+	// Top and bottom, and the three layers on the four sides.
+	EXPECT_EQ(m_pMesh->quadsCount, 2u + 4u * 3u);
+}
+
+TEST_F(ChunkMeshTest, RandomBlocksMatchTheExposedFaces)
+{
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+	{
+		u32 value	= hash(i);
+		m_blocks[i] = (value & 3) == 0 ? (mdBlockId)MD_BLOCK_ID_EMPTY : (mdBlockId)(1 + (value >> 8) % 3);
+	}
+	const mdBlockId* neighborFaces[MD_CHUNK_FACE_COUNT] = {};
+	expectExposedFaces(neighborFaces);
+}
+
+TEST_F(ChunkMeshTest, CheckerboardHasNoMerging)
+{
+	for (u32 y = 0; y < MD_CHUNK_SIZE; ++y)
+	{
+		for (u32 z = 0; z < MD_CHUNK_SIZE; ++z)
+		{
+			for (u32 x = 0; x < MD_CHUNK_SIZE; ++x)
+			{
+				m_blocks[MD_CHUNK_BLOCK_INDEX(x, y, z)] = (x + y + z) % 2 == 0 ? 1 : MD_BLOCK_ID_EMPTY;
+			}
+		}
+	}
+	const mdBlockId* neighborFaces[MD_CHUNK_FACE_COUNT] = {};
+	expectExposedFaces(neighborFaces);
+	EXPECT_EQ(m_pMesh->quadsCount, MD_CHUNK_VOLUME / 2 * 6);
+}
+
+TEST_F(ChunkMeshTest, NeighborFacesHideTheSides)
+{
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+	{
+		u32 value	= hash(i + 1000);
+		m_blocks[i] = (value & 1) == 0 ? (mdBlockId)MD_BLOCK_ID_EMPTY : (mdBlockId)(1 + (value >> 8) % 2);
+	}
+
+	// A neighbor on every side but +z, filled with random blocks too.
+	std::vector<mdBlockId> neighbor(MD_CHUNK_VOLUME);
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+	{
+		neighbor[i] = (hash(i + 5000) & 1) == 0 ? (mdBlockId)MD_BLOCK_ID_EMPTY : (mdBlockId)4;
+	}
+	std::array<std::vector<mdBlockId>, MD_CHUNK_FACE_COUNT> layers;
+	const mdBlockId*										neighborFaces[MD_CHUNK_FACE_COUNT] = {};
+	for (u32 face = 0; face < MD_CHUNK_FACE_POSITIVE_Z; ++face)
+	{
+		// The side of the neighbor which touches this side is the opposite one.
+		layers[face].resize(MD_CHUNK_SIZE * MD_CHUNK_SIZE);
+		mdChunkMeshExtractFace(neighbor.data(), (enum MdChunkFace)(face ^ 1), layers[face].data());
+		neighborFaces[face] = layers[face].data();
+	}
+	expectExposedFaces(neighborFaces);
+
+	// A solid neighbor everywhere hides every side of a full chunk.
+	std::fill(m_blocks.begin(), m_blocks.end(), 1);
+	std::vector<mdBlockId> solid(MD_CHUNK_SIZE * MD_CHUNK_SIZE, 1);
+	for (u32 face = 0; face < MD_CHUNK_FACE_COUNT; ++face)
+	{
+		neighborFaces[face] = solid.data();
+	}
+	mdChunkMeshBuild(m_pMesh, m_blocks.data(), neighborFaces, nullptr, nullptr);
+	EXPECT_EQ(m_pMesh->quadsCount, 0u);
+}
+
+TEST_F(ChunkMeshTest, ExtractFaceCopiesTheSideLayer)
+{
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+	{
+		m_blocks[i] = (mdBlockId)hash(i);
+	}
+
+	std::vector<mdBlockId> layer(MD_CHUNK_SIZE * MD_CHUNK_SIZE);
+	mdChunkMeshExtractFace(m_blocks.data(), MD_CHUNK_FACE_POSITIVE_X, layer.data());
+	EXPECT_EQ(layer[MD_CHUNK_FACE_BLOCK_INDEX(3, 7)], m_blocks[MD_CHUNK_BLOCK_INDEX(31, 3, 7)]);
+	mdChunkMeshExtractFace(m_blocks.data(), MD_CHUNK_FACE_NEGATIVE_Y, layer.data());
+	EXPECT_EQ(layer[MD_CHUNK_FACE_BLOCK_INDEX(3, 7)], m_blocks[MD_CHUNK_BLOCK_INDEX(3, 0, 7)]);
+	mdChunkMeshExtractFace(m_blocks.data(), MD_CHUNK_FACE_POSITIVE_Z, layer.data());
+	EXPECT_EQ(layer[MD_CHUNK_FACE_BLOCK_INDEX(3, 7)], m_blocks[MD_CHUNK_BLOCK_INDEX(3, 7, 31)]);
+}
+
+TEST_F(ChunkMeshTest, TextureFunctionGivesTheTextureBySide)
+{
+	m_blocks[MD_CHUNK_BLOCK_INDEX(0, 0, 0)] = 2;
+	const mdBlockId* neighborFaces[MD_CHUNK_FACE_COUNT] = {};
+	mdChunkMeshBuild(m_pMesh, m_blocks.data(), neighborFaces, textureBySide, nullptr);
+	ASSERT_EQ(m_pMesh->quadsCount, 6u);
+	for (u32 i = 0; i < m_pMesh->verticesCount; ++i)
+	{
+		EXPECT_EQ(m_pMesh->pVertices[i].textureId, 20u + m_pMesh->pVertices[i].face);
+	}
+
+	mdChunkMeshBuild(m_pMesh, m_blocks.data(), neighborFaces, nullptr, nullptr);
+	EXPECT_EQ(m_pMesh->pVertices[0].textureId, 2u);
+}
+
+TEST_F(ChunkMeshTest, WriteVertexCopiesTheLayout)
+{
+	enum MdVertexBufferAttributeType layout[] = MD_CHUNK_MESH_VERTEX_LAYOUT;
+	EXPECT_EQ(MD_ARRAY_SIZE(layout), 3u);
+
+	struct MdChunkMeshVertex vertex = {{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f}, 6, 7, 8};
+	struct MdChunkMeshVertex written;
+	mdChunkMeshWriteVertex((u8*)&written, &vertex);
+	EXPECT_EQ(written.position[2], 3.0f);
+	EXPECT_EQ(written.face, 8u);
+}
@@ -0,0 +1,215 @@
+#include "common.hpp"
+
+#include <vector>
+
+namespace {
+/**
+ * A block type per block, from a small set of `typesCount` types.
+ */
+mdBlockId patternBlock(u32 blockIndex, u32 typesCount)
+{
+	return (mdBlockId)(((blockIndex * 2654435761u) >> 16) % typesCount + 1);
+}
+
+std::vector<mdBlockId> decode(const struct MdChunk* pChunk)
+{
+	std::vector<mdBlockId> blocks(MD_CHUNK_VOLUME);
+	mdChunkDecode(pChunk, blocks.data());
+	return blocks;
+}
+
+void expectBlocks(const struct MdChunk* pChunk, const std::vector<mdBlockId>& expected)
+{
+	for (u32 y = 0; y < MD_CHUNK_SIZE; ++y)
+	{
+		for (u32 z = 0; z < MD_CHUNK_SIZE; ++z)
+		{
+			for (u32 x = 0; x < MD_CHUNK_SIZE; ++x)
+			{
+				ASSERT_EQ(mdChunkGetBlock(pChunk, x, y, z), expected[MD_CHUNK_BLOCK_INDEX(x, y, z)]);
+			}
+		}
+	}
+	ASSERT_EQ(decode(pChunk), expected);
+}
+} // anonymous namespace
+
+TEST(ChunkTest, UniformChunkHasNoIndices)
+{
+	struct MdChunk* pChunk = mdChunkCreate(7);
+
+	EXPECT_EQ(pChunk->bitsPerIndex, 0u);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 31, 31, 31), 7);
+	EXPECT_LE(mdChunkGetMemorySize(pChunk), 64u);
+	expectBlocks(pChunk, std::vector<mdBlockId>(MD_CHUNK_VOLUME, 7));
+
+	mdChunkDestroy(pChunk);
+}
+
+class ChunkWidthTest : public TestWithParam<u32>
+{
+};
+
+TEST_P(ChunkWidthTest, SetBlocksWidenTheIndices)
+{
+	u32					   typesCount = GetParam();
+	struct MdChunk*		   pChunk	  = mdChunkCreate(0);
+	std::vector<mdBlockId> expected(MD_CHUNK_VOLUME, 0);
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; i += 3)
+	{
+		expected[i] = patternBlock(i, typesCount);
+		mdChunkSetBlock(pChunk, i & 31, i >> 10, (i >> 5) & 31, expected[i]);
+	}
+
+	expectBlocks(pChunk, expected);
+	// The types and the 0 of the blocks left unset.
+	u32 expectedBits = 1;
+	while ((1u << expectedBits) < typesCount + 1)
+	{
+		expectedBits *= 2;
+	}
+	EXPECT_EQ(pChunk->bitsPerIndex, expectedBits);
+
+	mdChunkDestroy(pChunk);
+}
+
+TEST_P(ChunkWidthTest, EncodeMatchesDecode)
+{
+	u32					   typesCount = GetParam();
+	std::vector<mdBlockId> expected(MD_CHUNK_VOLUME);
+	for (u32 i = 0; i < MD_CHUNK_VOLUME; ++i)
+	{
+		expected[i] = patternBlock(i, typesCount);
+	}
+
+	struct MdChunk* pChunk = mdChunkCreate(0);
+	mdChunkEncode(pChunk, expected.data());
+	expectBlocks(pChunk, expected);
+
+	mdChunkDestroy(pChunk);
+}
+
+INSTANTIATE_TEST_SUITE_P(Widths, ChunkWidthTest, Values(1u, 3u, 15u, 255u, 1000u));
+
+TEST(ChunkTest, SettingBackToSingleTypeDropsTheIndices)
+{
+	struct MdChunk* pChunk = mdChunkCreate(1);
+	mdChunkSetBlock(pChunk, 1, 2, 3, 2);
+	EXPECT_EQ(pChunk->bitsPerIndex, 1u);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 1, 2, 3), 2);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 3, 2, 1), 1);
+
+	mdChunkSetBlock(pChunk, 1, 2, 3, 1);
+	EXPECT_EQ(pChunk->bitsPerIndex, 0u);
+	EXPECT_EQ(pChunk->pIndices, nullptr);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 1, 2, 3), 1);
+
+	mdChunkDestroy(pChunk);
+}
+
+TEST(ChunkTest, FreedEntriesAreReused)
+{
+	struct MdChunk* pChunk = mdChunkCreate(0);
+	mdChunkSetBlock(pChunk, 0, 0, 0, 1);
+	mdChunkSetBlock(pChunk, 1, 0, 0, 2);
+	mdChunkSetBlock(pChunk, 2, 0, 0, 3);
+	EXPECT_EQ(pChunk->bitsPerIndex, 2u);
+
+	mdChunkSetBlock(pChunk, 0, 0, 0, 0);
+	mdChunkSetBlock(pChunk, 0, 0, 0, 4);
+	EXPECT_EQ(pChunk->paletteCount, 4u);
+	EXPECT_EQ(pChunk->bitsPerIndex, 2u);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 0, 0, 0), 4);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 1, 0, 0), 2);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 2, 0, 0), 3);
+
+	mdChunkDestroy(pChunk);
+}
+
+TEST(ChunkTest, CompactNarrowsTheIndices)
+{
+	struct MdChunk*		   pChunk = mdChunkCreate(0);
+	std::vector<mdBlockId> expected(MD_CHUNK_VOLUME, 0);
+	for (u32 i = 0; i < 20; ++i)
+	{
+		mdChunkSetBlock(pChunk, i, 0, 0, (mdBlockId)(i + 1));
+	}
+	EXPECT_EQ(pChunk->bitsPerIndex, 8u);
+
+	for (u32 i = 2; i < 20; ++i)
+	{
+		mdChunkSetBlock(pChunk, i, 0, 0, 0);
+	}
+	expected[MD_CHUNK_BLOCK_INDEX(0, 0, 0)] = 1;
+	expected[MD_CHUNK_BLOCK_INDEX(1, 0, 0)] = 2;
+	mdSize wideSize							= mdChunkGetMemorySize(pChunk);
+
+	mdChunkCompact(pChunk);
+	EXPECT_EQ(pChunk->bitsPerIndex, 2u);
+	EXPECT_EQ(pChunk->paletteCount, 3u);
+	EXPECT_LT(mdChunkGetMemorySize(pChunk), wideSize);
+	expectBlocks(pChunk, expected);
+
+	mdChunkDestroy(pChunk);
+}
+
+TEST(ChunkTest, CompactGivesThePaletteBack)
+{
+	struct MdChunk* pChunk = mdChunkCreate(0);
+	for (u32 i = 0; i < 300; ++i)
+	{
+		mdChunkSetBlock(pChunk, i & 31, i >> 5, 0, (mdBlockId)(i + 1));
+	}
+	EXPECT_EQ(pChunk->bitsPerIndex, 16u);
+
+	for (u32 i = 3; i < 300; ++i)
+	{
+		mdChunkSetBlock(pChunk, i & 31, i >> 5, 0, 0);
+	}
+	mdChunkCompact(pChunk);
+	EXPECT_EQ(pChunk->bitsPerIndex, 2u);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 2, 0, 0), 3);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 3, 0, 0), 0);
+
+	mdChunkDestroy(pChunk);
+}
+
+TEST(ChunkTest, FillBoxSetsOnlyTheBox)
+{
+	struct MdChunk*		   pChunk = mdChunkCreate(0);
+	std::vector<mdBlockId> expected(MD_CHUNK_VOLUME, 0);
+	for (u32 y = 0; y < 16; ++y)
+	{
+		for (u32 z = 0; z < MD_CHUNK_SIZE; ++z)
+		{
+			for (u32 x = 0; x < MD_CHUNK_SIZE; ++x)
+			{
+				expected[MD_CHUNK_BLOCK_INDEX(x, y, z)] = 1;
+			}
+		}
+	}
+	mdChunkFillBox(pChunk, 0, 0, 0, MD_CHUNK_SIZE, 16, MD_CHUNK_SIZE, 1);
+	for (u32 y = 4; y < 8; ++y)
+	{
+		for (u32 z = 5; z < 9; ++z)
+		{
+			for (u32 x = 6; x < 10; ++x)
+			{
+				expected[MD_CHUNK_BLOCK_INDEX(x, y, z)] = 2;
+			}
+		}
+	}
+	mdChunkFillBox(pChunk, 6, 4, 5, 10, 8, 9, 2);
+	expectBlocks(pChunk, expected);
+
+	// The complement of the first box: the chunk is a single type again.
+	mdChunkFillBox(pChunk, 0, 0, 0, MD_CHUNK_SIZE, 16, MD_CHUNK_SIZE, 0);
+	EXPECT_EQ(pChunk->bitsPerIndex, 0u);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 7, 5, 6), 0);
+
+	mdChunkFill(pChunk, 3);
+	EXPECT_EQ(pChunk->bitsPerIndex, 0u);
+	EXPECT_EQ(mdChunkGetBlock(pChunk, 7, 5, 6), 3);
+
+	mdChunkDestroy(pChunk);
+}
@@ -0,0 +1,82 @@
+#include "common.hpp"
+
+#include <string>
+
+struct PingPong
+{
+	struct MdFiber* pThreadFiber;
+	struct MdFiber* pFiber;
+	std::string		calls;
+};
+
+static void playPingPong(void* pArgument)
+{
+	PingPong* pPingPong = (PingPong*)pArgument;
+	for (;;)
+	{
+		pPingPong->calls += 'f';
+		mdFiberSwitch(pPingPong->pFiber, pPingPong->pThreadFiber);
+	}
+}
+
+TEST(FiberTest, SwitchesResumeWhereTheySuspended)
+{
+	PingPong pingPong	  = {};
+	pingPong.pThreadFiber = mdFiberCreateFromThread();
+	pingPong.pFiber		  = mdFiberCreate(0, playPingPong, &pingPong);
+	ASSERT_NE(pingPong.pFiber, nullptr);
+
+	for (u32 i = 0; i < 3; ++i)
+	{
+		pingPong.calls += 't';
+		mdFiberSwitch(pingPong.pThreadFiber, pingPong.pFiber);
+	}
+	EXPECT_EQ(pingPong.calls, "tftftf");
+
+	mdFiberDestroy(pingPong.pFiber);
+	mdFiberDestroy(pingPong.pThreadFiber);
+}
+
+struct DeepWork
+{
+	struct MdFiber* pThreadFiber;
+	struct MdFiber* pFiber;
+	f64				result;
+	void*			pMemory;
+};
+
+static f64 recurse(u32 depth)
+{
+	// About 64 KiB of stack in total, with a floating-point state the switch must preserve.
+	volatile f64 frame[64];
+	for (u32 i = 0; i < 64; ++i)
+	{
+		frame[i] = (f64)(depth + i) * 0.5;
+	}
+	return depth == 0 ? frame[63] : frame[depth % 64] + recurse(depth - 1);
+}
+
+static void doDeepWork(void* pArgument)
+{
+	DeepWork* pWork = (DeepWork*)pArgument;
+	pWork->result	= recurse(120);
+	pWork->pMemory	= MD_MALLOC(u64); // Captures a backtrace in the debug builds, which stops at the fiber entry.
+	mdFiberSwitch(pWork->pFiber, pWork->pThreadFiber);
+	ADD_FAILURE() << "The fiber is never resumed.";
+}
+
+TEST(FiberTest, FibersRunOnTheirOwnStack)
+{
+	DeepWork work	  = {};
+	work.pThreadFiber = mdFiberCreateFromThread();
+	work.pFiber		  = mdFiberCreate(256 * 1024, doDeepWork, &work);
+	ASSERT_NE(work.pFiber, nullptr);
+
+	mdFiberSwitch(work.pThreadFiber, work.pFiber);
+	EXPECT_DOUBLE_EQ(work.result, recurse(120));
+	EXPECT_NE(work.pMemory, nullptr);
+	MD_FREE(work.pMemory, u64);
+
+	mdFiberDestroy(work.pFiber);
+	mdFiberDestroy(work.pThreadFiber);
+}
@@ -0,0 +1,209 @@
+#include "common.hpp"
+
+#include <string.h>
+
+namespace {
+const char* s_filePath = "meed_file_async_test.bin";
+
+u32						s_callbacksCount = 0;
+struct MdFileCompletion s_lastCallbackCompletion;
+
+void onRequestFinished(const struct MdFileCompletion* pCompletion)
+{
+	s_callbacksCount++;
+	s_lastCallbackCompletion = *pCompletion;
+}
+
+struct MdFileRequestDesc makeRequest(struct MdFileData* pFile, enum MdFileRequestType type, u64 offset, void* pBuffer,
+									 u64 size)
+{
+	struct MdFileRequestDesc desc;
+	mdMemorySet(&desc, 0, sizeof(struct MdFileRequestDesc));
+	desc.pFile	  = pFile;
+	desc.type	  = type;
+	desc.priority = MD_FILE_REQUEST_PRIORITY_NORMAL;
+	desc.offset	  = offset;
+	desc.pBuffer  = pBuffer;
+	desc.size	  = size;
+	return desc;
+}
+} // anonymous namespace
+
+/**
+ * Every test runs once with io_uring (when the kernel allows it) and once with the worker pool.
+ */
+class FileAsyncTest : public TestWithParam<bool>
+{
+protected:
+	void SetUp() override
+	{
+		s_callbacksCount = 0;
+
+		struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_WRITE);
+		mdFileWrite(pFile, "0123456789ABCDEF", 16);
+		mdFileClose(pFile);
+
+		config				  = mdFileAsyncGetDefaultConfig();
+		config.disableIoUring = GetParam();
+	}
+
+	void TearDown() override
+	{
+		mdFileRemove(s_filePath);
+	}
+
+protected:
+	struct MdFileAsyncConfig config;
+};
+
+TEST_P(FileAsyncTest, ReadCompletesWithData)
+{
+	mdFileAsyncInitialize(&config);
+	if (GetParam())
+	{
+		EXPECT_FALSE(mdFileAsyncIsUsingIoUring());
+	}
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ_NO_PRELOAD);
+	char			   buffer[8];
+
+	struct MdFileRequestDesc desc = makeRequest(pFile, MD_FILE_REQUEST_TYPE_READ, 4, buffer, 8);
+	desc.pUserData				  = buffer;
+	mdFileRequestId id			  = mdFileAsyncSubmit(&desc);
+	EXPECT_NE(id, MD_FILE_REQUEST_INVALID_ID);
+
+	mdFileAsyncWaitIdle();
+
+	struct MdFileCompletion completion;
+	ASSERT_EQ(mdFileAsyncPoll(&completion, 1), 1u);
+	EXPECT_EQ(completion.id, id);
+	EXPECT_EQ(completion.status, MD_FILE_REQUEST_STATUS_COMPLETED);
+	EXPECT_EQ(completion.bytesTransferred, 8u);
+	EXPECT_EQ(completion.pUserData, buffer);
+	EXPECT_EQ(memcmp(buffer, "456789AB", 8), 0);
+
+	mdFileAsyncShutdown();
+	mdFileClose(pFile);
+}
+
+TEST_P(FileAsyncTest, ReadPastEndIsShort)
+{
+	mdFileAsyncInitialize(&config);
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ_NO_PRELOAD);
+	char			   buffer[16];
+
+	struct MdFileRequestDesc desc = makeRequest(pFile, MD_FILE_REQUEST_TYPE_READ, 12, buffer, 16);
+	mdFileAsyncSubmit(&desc);
+	mdFileAsyncWaitIdle();
+
+	struct MdFileCompletion completion;
+	ASSERT_EQ(mdFileAsyncPoll(&completion, 1), 1u);
+	EXPECT_EQ(completion.status, MD_FILE_REQUEST_STATUS_COMPLETED);
+	EXPECT_EQ(completion.bytesTransferred, 4u);
+
+	mdFileAsyncShutdown();
+	mdFileClose(pFile);
+}
+
+TEST_P(FileAsyncTest, WriteThenCallback)
+{
+	mdFileAsyncInitialize(&config);
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_WRITE);
+	char			   data[] = "MEED";
+
+	struct MdFileRequestDesc desc = makeRequest(pFile, MD_FILE_REQUEST_TYPE_WRITE, 2, data, 4);
+	desc.callback				  = onRequestFinished;
+	mdFileRequestId id			  = mdFileAsyncSubmit(&desc);
+	mdFileAsyncWaitIdle();
+
+	EXPECT_EQ(mdFileAsyncPoll(nullptr, 0), 0u);
+	EXPECT_EQ(s_callbacksCount, 1u);
+	EXPECT_EQ(s_lastCallbackCompletion.id, id);
+	EXPECT_EQ(s_lastCallbackCompletion.bytesTransferred, 4u);
+
+	mdFileAsyncShutdown();
+	mdFileClose(pFile);
+
+	struct MdFileData* pReadFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ);
+	ASSERT_EQ(pReadFile->size, 6u);
+	EXPECT_EQ(memcmp(pReadFile->content + 2, "MEED", 4), 0);
+	mdFileClose(pReadFile);
+}
+
+TEST_P(FileAsyncTest, CompletionsAreKeptForNextPoll)
+{
+	mdFileAsyncInitialize(&config);
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ_NO_PRELOAD);
+	char			   buffers[3][4];
+
+	for (u32 i = 0; i < 3; ++i)
+	{
+		struct MdFileRequestDesc desc = makeRequest(pFile, MD_FILE_REQUEST_TYPE_READ, i * 4, buffers[i], 4);
+		mdFileAsyncSubmit(&desc);
+	}
+	mdFileAsyncWaitIdle();
+
+	struct MdFileCompletion completions[2];
+	EXPECT_EQ(mdFileAsyncPoll(completions, 2), 2u);
+	EXPECT_EQ(mdFileAsyncPoll(completions, 2), 1u);
+	EXPECT_EQ(mdFileAsyncPoll(completions, 2), 0u);
+
+	mdFileAsyncShutdown();
+	mdFileClose(pFile);
+}
+
+TEST_P(FileAsyncTest, UnknownRequestCannotBeCancelled)
+{
+	mdFileAsyncInitialize(&config);
+	EXPECT_FALSE(mdFileAsyncCancel(12345));
+	mdFileAsyncShutdown();
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, FileAsyncTest, Values(false, true));
+
+TEST(FileAsyncIoUringTest, WaitingRequestIsCancelled)
+{
+	struct MdFileAsyncConfig config = mdFileAsyncGetDefaultConfig();
+	config.queueDepth				= 1;
+	mdFileAsyncInitialize(&config);
+
+	if (!mdFileAsyncIsUsingIoUring())
+	{
+		mdFileAsyncShutdown();
+		GTEST_SKIP() << "io_uring is not available, the waiting requests are taken immediately by the workers.";
+	}
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_WRITE);
+	char			   data[4096];
+	mdMemorySet(data, 'x', sizeof(data));
+
+	// The queue depth is 1, the second request waits behind the first one.
+	struct MdFileRequestDesc desc = makeRequest(pFile, MD_FILE_REQUEST_TYPE_WRITE, 0, data, sizeof(data));
+	mdFileAsyncSubmit(&desc);
+	mdFileRequestId second = mdFileAsyncSubmit(&desc);
+
+	EXPECT_TRUE(mdFileAsyncCancel(second));
+	EXPECT_FALSE(mdFileAsyncCancel(second));
+	mdFileAsyncWaitIdle();
+
+	struct MdFileCompletion completions[2];
+	ASSERT_EQ(mdFileAsyncPoll(completions, 2), 2u);
+	for (u32 i = 0; i < 2; ++i)
+	{
+		if (completions[i].id == second)
+		{
+			EXPECT_EQ(completions[i].status, MD_FILE_REQUEST_STATUS_CANCELLED);
+		}
+		else
+		{
+			EXPECT_EQ(completions[i].status, MD_FILE_REQUEST_STATUS_COMPLETED);
+		}
+	}
+
+	mdFileAsyncShutdown();
+	mdFileClose(pFile);
+	mdFileRemove(s_filePath);
+}
@@ -0,0 +1,218 @@
+#include "common.hpp"
+
+#include <string.h>
+#if PLATFORM_IS_LINUX
+#include <sys/stat.h>
+#endif
+
+namespace {
+const char* s_filePath = "meed_file_test.bin";
+
+void writeFile(const char* content, mdSize size)
+{
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_WRITE);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	mdFileWrite(pFile, content, size);
+	mdFileClose(pFile);
+}
+} // anonymous namespace
+
+class FileTest : public Test
+{
+protected:
+	void TearDown() override
+	{
+		mdFileRemove(s_filePath);
+		mdFileRemove("meed_file_test.bin.tmp");
+	}
+};
+
+TEST_F(FileTest, ReadCopiesContent)
+{
+	writeFile("MEED", 4);
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	EXPECT_EQ(pFile->size, 4u);
+	EXPECT_STREQ(pFile->content, "MEED");
+	mdFileClose(pFile);
+}
+
+TEST_F(FileTest, ReadMappedExposesContent)
+{
+	char content[10000];
+	for (u32 i = 0; i < sizeof(content); ++i)
+	{
+		content[i] = (char)(i * 7u);
+	}
+	writeFile(content, sizeof(content));
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ_MAPPED);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	ASSERT_EQ(pFile->size, sizeof(content));
+	ASSERT_NE(pFile->content, nullptr);
+	EXPECT_EQ(memcmp(pFile->content, content, sizeof(content)), 0);
+	mdFileClose(pFile);
+}
+
+TEST_F(FileTest, ReadMappedEmptyFileHasNoContent)
+{
+	writeFile("", 0);
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ_MAPPED);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	EXPECT_EQ(pFile->size, 0u);
+	EXPECT_EQ(pFile->content, nullptr);
+	mdFileClose(pFile);
+}
+
+TEST_F(FileTest, ReadMappedMissingFileIsNotOpen)
+{
+	struct MdFileData* pFile = mdFileOpen("meed_missing_file.bin", MD_FILE_MODE_READ_MAPPED);
+	EXPECT_FALSE(mdFileIsOpen(pFile));
+	mdFileClose(pFile);
+}
+
+TEST_F(FileTest, NoPreloadOnlyQueriesSize)
+{
+	writeFile("0123456789", 10);
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ_NO_PRELOAD);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	EXPECT_EQ(pFile->size, 10u);
+	EXPECT_EQ(pFile->content, nullptr);
+	mdFileClose(pFile);
+}
+
+TEST_F(FileTest, ReadAtReadsRegion)
+{
+	writeFile("0123456789", 10);
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ_NO_PRELOAD);
+	char			   region[8];
+
+	EXPECT_EQ(mdFileReadAt(pFile, 3, region, 4), 4u);
+	EXPECT_EQ(memcmp(region, "3456", 4), 0);
+
+	// Reads are clamped at the end of the file.
+	EXPECT_EQ(mdFileReadAt(pFile, 8, region, 8), 2u);
+	EXPECT_EQ(memcmp(region, "89", 2), 0);
+	EXPECT_EQ(mdFileReadAt(pFile, 20, region, 8), 0u);
+
+	mdFileClose(pFile);
+}
+
+TEST_F(FileTest, StreamReaderReadsBlocks)
+{
+	writeFile("0123456789", 10);
+
+	struct MdFileData*		   pFile   = mdFileOpen(s_filePath, MD_FILE_MODE_READ_NO_PRELOAD);
+	struct MdFileStreamReader* pReader = mdFileStreamReaderCreate(pFile, 0, 4);
+
+	u64			size	= 0;
+	const char* pFirst	= (const char*)mdFileStreamReaderNext(pReader, &size);
+	ASSERT_NE(pFirst, nullptr);
+	EXPECT_EQ(size, 4u);
+	const char* pSecond = (const char*)mdFileStreamReaderNext(pReader, &size);
+	ASSERT_NE(pSecond, nullptr);
+	EXPECT_EQ(size, 4u);
+
+	// The previous block stays valid while the current one is used.
+	EXPECT_EQ(memcmp(pFirst, "0123", 4), 0);
+	EXPECT_EQ(memcmp(pSecond, "4567", 4), 0);
+
+	const char* pLast = (const char*)mdFileStreamReaderNext(pReader, &size);
+	ASSERT_NE(pLast, nullptr);
+	EXPECT_EQ(size, 2u);
+	EXPECT_EQ(memcmp(pLast, "89", 2), 0);
+	EXPECT_EQ(mdFileStreamReaderNext(pReader, &size), nullptr);
+	EXPECT_EQ(size, 0u);
+
+	mdFileStreamReaderSeek(pReader, 5);
+	const char* pSeek = (const char*)mdFileStreamReaderNext(pReader, &size);
+	ASSERT_NE(pSeek, nullptr);
+	EXPECT_EQ(memcmp(pSeek, "5678", 4), 0);
+
+	mdFileStreamReaderDestroy(pReader);
+	mdFileClose(pFile);
+}
+
+TEST_F(FileTest, AppendCreatesReadableFile)
+{
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_APPEND);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	mdFileWrite(pFile, "MEED", 4);
+	mdFileClose(pFile);
+
+#if PLATFORM_IS_LINUX
+	struct stat fileStat;
+	ASSERT_EQ(stat(s_filePath, &fileStat), 0);
+	EXPECT_EQ(fileStat.st_mode & 0600, 0600u);
+#endif
+
+	pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	EXPECT_STREQ(pFile->content, "MEED");
+	mdFileClose(pFile);
+}
+
+TEST_F(FileTest, AtomicWriteReplacesOnClose)
+{
+	writeFile("previous", 8);
+
+	struct MdFileData* pFile = mdFileOpen(s_filePath, MD_FILE_MODE_WRITE_ATOMIC);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	mdFileWrite(pFile, "new", 3);
+	mdFileSync(pFile);
+
+	// Until the file is closed, the readers still see the previous content.
+	struct MdFileData* pReader = mdFileOpen(s_filePath, MD_FILE_MODE_READ);
+	EXPECT_STREQ(pReader->content, "previous");
+	mdFileClose(pReader);
+
+	mdFileClose(pFile);
+
+	pReader = mdFileOpen(s_filePath, MD_FILE_MODE_READ);
+	EXPECT_STREQ(pReader->content, "new");
+	mdFileClose(pReader);
+	EXPECT_FALSE(mdFileExists("meed_file_test.bin.tmp"));
+}
+
+TEST_F(FileTest, AtomicWriteKeepsItsOwnPath)
+{
+	// The path given when opening is gone by the time the file replaces the previous one.
+	char path[32];
+	snprintf(path, sizeof(path), "%s", s_filePath);
+	struct MdFileData* pFile = mdFileOpen(path, MD_FILE_MODE_WRITE_ATOMIC);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	snprintf(path, sizeof(path), "overwritten");
+	mdFileWrite(pFile, "new", 3);
+	mdFileClose(pFile);
+
+	struct MdFileData* pReader = mdFileOpen(s_filePath, MD_FILE_MODE_READ);
+	EXPECT_STREQ(pReader->content, "new");
+	mdFileClose(pReader);
+	EXPECT_FALSE(mdFileExists("overwritten"));
+}
+
+TEST_F(FileTest, BufferedWriterGathersWrites)
+{
+	struct MdFileData*			 pFile	 = mdFileOpen(s_filePath, MD_FILE_MODE_WRITE);
+	struct MdFileBufferedWriter* pWriter = mdFileBufferedWriterCreate(pFile, 8);
+
+	mdFileBufferedWriterWrite(pWriter, "0123", 4);
+	mdFileBufferedWriterWrite(pWriter, "4567", 4);
+	EXPECT_EQ(pWriter->usedSize, 8u);
+
+	// Does not fit, written together with the buffered data.
+	mdFileBufferedWriterWrite(pWriter, "89ABCDEFGHIJ", 12);
+	EXPECT_EQ(pWriter->usedSize, 0u);
+
+	mdFileBufferedWriterWrite(pWriter, "KL", 2);
+	mdFileBufferedWriterDestroy(pWriter);
+	mdFileClose(pFile);
+
+	pFile = mdFileOpen(s_filePath, MD_FILE_MODE_READ);
+	EXPECT_STREQ(pFile->content, "0123456789ABCDEFGHIJKL");
+	mdFileClose(pFile);
+}
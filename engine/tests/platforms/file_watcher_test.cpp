@@ -0,0 +1,140 @@
+#include "common.hpp"
+
+#if PLATFORM_IS_LINUX
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+const char* s_directoryPath = "meed_watcher_test";
+
+void writeFile(const char* path, const char* content)
+{
+	struct MdFileData* pFile = mdFileOpen(path, MD_FILE_MODE_WRITE);
+	mdFileWrite(pFile, content, strlen(content));
+	mdFileClose(pFile);
+}
+} // anonymous namespace
+
+class FileWatcherTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		mkdir(s_directoryPath, 0755);
+		writeFile("meed_watcher_test/shader.vert", "void main() {}");
+	}
+
+	void TearDown() override
+	{
+		mdFileRemove("meed_watcher_test/shader.vert");
+		mdFileRemove("meed_watcher_test/shader.vert.tmp");
+		mdFileRemove("meed_watcher_test/shader.vert.swp");
+		mdFileRemove("meed_watcher_test/nested/asset.bin");
+		rmdir("meed_watcher_test/nested");
+		rmdir(s_directoryPath);
+	}
+};
+
+TEST_F(FileWatcherTest, MissingPathIsRejected)
+{
+	struct MdFileWatcher* pWatcher = mdFileWatcherCreate(0);
+	EXPECT_EQ(mdFileWatcherAdd(pWatcher, "meed_watcher_test/missing", MD_FALSE), MD_FILE_WATCH_INVALID_ID);
+	mdFileWatcherDestroy(pWatcher);
+}
+
+TEST_F(FileWatcherTest, WritesAreCoalesced)
+{
+	struct MdFileWatcher* pWatcher = mdFileWatcherCreate(0);
+	mdFileWatchId		  id	   = mdFileWatcherAdd(pWatcher, s_directoryPath, MD_FALSE);
+	ASSERT_NE(id, MD_FILE_WATCH_INVALID_ID);
+
+	writeFile("meed_watcher_test/shader.vert", "void main() { a }");
+	writeFile("meed_watcher_test/shader.vert", "void main() { b }");
+
+	struct MdFileWatchEvent events[4];
+	ASSERT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 1u);
+	EXPECT_EQ(events[0].watchId, id);
+	EXPECT_EQ(events[0].type, MD_FILE_WATCH_EVENT_TYPE_MODIFIED);
+	EXPECT_STREQ(events[0].path, "meed_watcher_test/shader.vert");
+
+	EXPECT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 0u);
+	mdFileWatcherDestroy(pWatcher);
+}
+
+TEST_F(FileWatcherTest, EventsWaitForDebounce)
+{
+	struct MdFileWatcher* pWatcher = mdFileWatcherCreate(50);
+	mdFileWatcherAdd(pWatcher, s_directoryPath, MD_FALSE);
+
+	writeFile("meed_watcher_test/shader.vert", "void main() { a }");
+
+	struct MdFileWatchEvent events[4];
+	EXPECT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 0u);
+	usleep(60 * 1000);
+	EXPECT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 1u);
+
+	mdFileWatcherDestroy(pWatcher);
+}
+
+TEST_F(FileWatcherTest, FileSurvivesAtomicReplace)
+{
+	struct MdFileWatcher* pWatcher = mdFileWatcherCreate(0);
+	mdFileWatchId		  id	   = mdFileWatcherAdd(pWatcher, "meed_watcher_test/shader.vert", MD_FALSE);
+	ASSERT_NE(id, MD_FILE_WATCH_INVALID_ID);
+
+	// Saved the way most editors do: a new file renamed over the original, plus a swap file nobody cares about.
+	writeFile("meed_watcher_test/shader.vert.swp", "swap");
+	mdFileRemove("meed_watcher_test/shader.vert.swp");
+	writeFile("meed_watcher_test/shader.vert.tmp", "void main() { a }");
+	mdFileRename("meed_watcher_test/shader.vert.tmp", "meed_watcher_test/shader.vert");
+
+	struct MdFileWatchEvent events[4];
+	ASSERT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 1u);
+	EXPECT_EQ(events[0].type, MD_FILE_WATCH_EVENT_TYPE_MODIFIED);
+	EXPECT_STREQ(events[0].path, "meed_watcher_test/shader.vert");
+
+	// The watch still works on the new file.
+	writeFile("meed_watcher_test/shader.vert", "void main() { b }");
+	EXPECT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 1u);
+
+	mdFileWatcherDestroy(pWatcher);
+}
+
+TEST_F(FileWatcherTest, RecursiveWatchFollowsNewDirectories)
+{
+	struct MdFileWatcher* pWatcher = mdFileWatcherCreate(0);
+	mdFileWatcherAdd(pWatcher, s_directoryPath, MD_TRUE);
+
+	mkdir("meed_watcher_test/nested", 0755);
+	struct MdFileWatchEvent events[4];
+	EXPECT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 0u);
+
+	writeFile("meed_watcher_test/nested/asset.bin", "data");
+	ASSERT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 1u);
+	EXPECT_EQ(events[0].type, MD_FILE_WATCH_EVENT_TYPE_CREATED);
+	EXPECT_STREQ(events[0].path, "meed_watcher_test/nested/asset.bin");
+
+	mdFileRemove("meed_watcher_test/nested/asset.bin");
+	ASSERT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 1u);
+	EXPECT_EQ(events[0].type, MD_FILE_WATCH_EVENT_TYPE_DELETED);
+
+	mdFileWatcherDestroy(pWatcher);
+}
+
+TEST_F(FileWatcherTest, RemovedWatchIsSilent)
+{
+	struct MdFileWatcher* pWatcher = mdFileWatcherCreate(0);
+	mdFileWatchId		  id	   = mdFileWatcherAdd(pWatcher, s_directoryPath, MD_FALSE);
+
+	writeFile("meed_watcher_test/shader.vert", "void main() { a }");
+	mdFileWatcherRemove(pWatcher, id);
+	writeFile("meed_watcher_test/shader.vert", "void main() { b }");
+
+	struct MdFileWatchEvent events[4];
+	EXPECT_EQ(mdFileWatcherPoll(pWatcher, events, 4), 0u);
+	mdFileWatcherDestroy(pWatcher);
+}
+
+#endif // PLATFORM_IS_LINUX
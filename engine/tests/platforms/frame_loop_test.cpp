@@ -0,0 +1,119 @@
+#include "common.hpp"
+
+#include <string>
+#include <vector>
+
+struct FrameLoopRecorder
+{
+	std::string			 calls;
+	std::vector<f64>	 deltas;
+	std::vector<f64>	 alphas;
+	std::vector<mdTicks> renderTicks;
+};
+
+static void recordPollInput(void* pUserData)
+{
+	((FrameLoopRecorder*)pUserData)->calls += 'i';
+}
+
+static void recordUpdate(f64 deltaSeconds, void* pUserData)
+{
+	((FrameLoopRecorder*)pUserData)->calls += 'u';
+	((FrameLoopRecorder*)pUserData)->deltas.push_back(deltaSeconds);
+}
+
+static void recordRender(f64 alpha, void* pUserData)
+{
+	((FrameLoopRecorder*)pUserData)->calls += 'r';
+	((FrameLoopRecorder*)pUserData)->alphas.push_back(alpha);
+	((FrameLoopRecorder*)pUserData)->renderTicks.push_back(mdGetTicks());
+}
+
+static struct MdFrameLoop* createRecordedLoop(const struct MdFrameLoopConfig* pConfig, FrameLoopRecorder* pRecorder)
+{
+	struct MdFrameLoopCallbacks callbacks = {recordPollInput, recordUpdate, recordRender, pRecorder};
+	return mdFrameLoopCreate(pConfig, &callbacks);
+}
+
+TEST(FrameLoopTest, FixedStepsConsumeTheAccumulator)
+{
+	FrameLoopRecorder		 recorder;
+	struct MdFrameLoopConfig config = mdFrameLoopGetDefaultConfig();
+	config.fixedTimestep			= 0.01;
+	struct MdFrameLoop* pLoop		= createRecordedLoop(&config, &recorder);
+
+	EXPECT_EQ(mdFrameLoopAdvance(pLoop, 25 * MD_TICKS_PER_MILLISECOND), 2u);
+	EXPECT_DOUBLE_EQ(recorder.alphas.back(), 0.5);
+	EXPECT_EQ(mdFrameLoopAdvance(pLoop, 5 * MD_TICKS_PER_MILLISECOND), 1u);
+	EXPECT_DOUBLE_EQ(recorder.alphas.back(), 0.0);
+	EXPECT_EQ(mdFrameLoopAdvance(pLoop, 4 * MD_TICKS_PER_MILLISECOND), 0u);
+
+	EXPECT_EQ(recorder.calls, "iuuriurir");
+	EXPECT_THAT(recorder.deltas, Each(DoubleEq(0.01)));
+	EXPECT_EQ(pLoop->stepsCount, 3u);
+	EXPECT_EQ(pLoop->framesCount, 3u);
+
+	mdFrameLoopDestroy(pLoop);
+}
+
+TEST(FrameLoopTest, LateStepsAreDropped)
+{
+	FrameLoopRecorder		 recorder;
+	struct MdFrameLoopConfig config = mdFrameLoopGetDefaultConfig();
+	config.fixedTimestep			= 0.01;
+	config.maxStepsPerFrame			= 4;
+	struct MdFrameLoop* pLoop		= createRecordedLoop(&config, &recorder);
+
+	EXPECT_EQ(mdFrameLoopAdvance(pLoop, 103 * MD_TICKS_PER_MILLISECOND), 4u);
+	EXPECT_EQ(pLoop->droppedStepsCount, 6u);
+	EXPECT_NEAR(recorder.alphas.back(), 0.3, 1e-9);
+
+	mdFrameLoopDestroy(pLoop);
+}
+
+TEST(FrameLoopTest, VariableStepAndLateLatch)
+{
+	FrameLoopRecorder		 recorder;
+	struct MdFrameLoopConfig config = mdFrameLoopGetDefaultConfig();
+	config.fixedTimestep			= 0.0;
+	config.isLateLatched			= MD_TRUE;
+	struct MdFrameLoop* pLoop		= createRecordedLoop(&config, &recorder);
+
+	EXPECT_EQ(mdFrameLoopAdvance(pLoop, 7 * MD_TICKS_PER_MILLISECOND), 1u);
+	EXPECT_EQ(recorder.calls, "iuir");
+	EXPECT_DOUBLE_EQ(recorder.deltas.back(), 0.007);
+	EXPECT_DOUBLE_EQ(recorder.alphas.back(), 1.0);
+
+	mdFrameLoopDestroy(pLoop);
+}
+
+TEST(FrameLoopTest, SleepUntilReachesTheDeadline)
+{
+	mdTicks deadline = mdGetTicks() + 2 * MD_TICKS_PER_MILLISECOND;
+	mdSleepUntil(deadline, 200 * MD_TICKS_PER_MICROSECOND);
+	EXPECT_GE(mdGetTicks(), deadline);
+
+	// A past deadline returns at once without sleeping.
+	EXPECT_EQ(mdSleepUntil(mdGetTicks() - 1, 0), 0u);
+}
+
+TEST(FrameLoopTest, PacedFramesFollowTheTargetRate)
+{
+	FrameLoopRecorder		 recorder;
+	struct MdFrameLoopConfig config = mdFrameLoopGetDefaultConfig();
+	config.targetFrameRate			= 200.0;
+	struct MdFrameLoop* pLoop		= createRecordedLoop(&config, &recorder);
+
+	for (u32 i = 0; i < 21; ++i)
+	{
+		mdFrameLoopRunFrame(pLoop);
+	}
+
+	// The frames are 5 ms apart on average, loose bounds so a loaded machine does not fail the test.
+	f64 averageMilliseconds = mdTicksToMilliseconds(recorder.renderTicks.back() - recorder.renderTicks.front()) / 20.0;
+	EXPECT_GE(averageMilliseconds, 4.9);
+	EXPECT_LE(averageMilliseconds, 7.5);
+	EXPECT_EQ(pLoop->framesCount, 21u);
+
+	mdFrameLoopDestroy(pLoop);
+}
@@ -0,0 +1,268 @@
+#include "common.hpp"
+
+#include <string.h>
+
+namespace {
+const char* s_packPath		 = "meed_pack_test.pack";
+const char* s_patchPackPath = "meed_pack_test_patch.pack";
+
+void openPackedFiles(void* pArgument)
+{
+	u32* pMismatchesCount = (u32*)pArgument;
+	for (u32 i = 0; i < 2000; ++i)
+	{
+		struct MdFileData* pFile = mdFileOpen("assets/shaders/a.vert", MD_FILE_MODE_READ);
+		if (!mdFileIsOpen(pFile) || strcmp(pFile->content, "void main() {}") != 0)
+		{
+			MD_ATOMIC_FETCH_ADD(pMismatchesCount, 1u, MD_MEMORY_ORDER_RELAXED);
+		}
+		mdFileClose(pFile);
+	}
+}
+} // anonymous namespace
+
+class PackTest : public Test
+{
+protected:
+	void SetUp() override
+	{
+		for (u32 i = 0; i < sizeof(compressible); ++i)
+		{
+			compressible[i] = (u8)"MEED voxel engine "[i % 18];
+		}
+
+		// A xorshift sequence, which the compression cannot shrink.
+		u32 state = 0x12345678u;
+		for (u32 i = 0; i < sizeof(random); ++i)
+		{
+			state ^= state << 13;
+			state ^= state >> 17;
+			state ^= state << 5;
+			random[i] = (u8)state;
+		}
+
+		struct MdPackWriter* pWriter = mdPackWriterCreate(s_packPath, 0);
+		ASSERT_NE(pWriter, nullptr);
+		mdPackWriterAddData(pWriter, "shaders/a.vert", "void main() {}", 14, MD_FALSE);
+		mdPackWriterAddData(pWriter, "shaders/b.frag", "out vec4 color;", 15, MD_FALSE);
+		mdPackWriterAddData(pWriter, "compressible.bin", compressible, sizeof(compressible), MD_TRUE);
+		mdPackWriterAddData(pWriter, "random.bin", random, sizeof(random), MD_TRUE);
+		mdPackWriterAddData(pWriter, "empty.txt", nullptr, 0, MD_FALSE);
+		mdPackWriterFinish(pWriter);
+	}
+
+	void TearDown() override
+	{
+		mdFileRemove(s_packPath);
+		mdFileRemove(s_patchPackPath);
+	}
+
+protected:
+	u8 compressible[65536];
+	u8 random[4096];
+};
+
+TEST_F(PackTest, ReadModesResolveInsidePack)
+{
+	ASSERT_TRUE(mdPackMount(s_packPath, "assets"));
+
+	struct MdFileData* pFile = mdFileOpen("assets/shaders/a.vert", MD_FILE_MODE_READ);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	EXPECT_EQ(pFile->size, 14u);
+	EXPECT_STREQ(pFile->content, "void main() {}");
+	mdFileClose(pFile);
+
+	pFile = mdFileOpen("assets/shaders/b.frag", MD_FILE_MODE_READ_MAPPED);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	ASSERT_EQ(pFile->size, 15u);
+	EXPECT_EQ(memcmp(pFile->content, "out vec4 color;", 15), 0);
+	mdFileClose(pFile);
+
+	pFile = mdFileOpen("assets/shaders/b.frag", MD_FILE_MODE_READ_NO_PRELOAD);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	EXPECT_EQ(pFile->content, nullptr);
+	char buffer[8];
+	EXPECT_EQ(mdFileReadAt(pFile, 9, buffer, sizeof(buffer)), 6u);
+	EXPECT_EQ(memcmp(buffer, "color;", 6), 0);
+	mdFileClose(pFile);
+
+	pFile = mdFileOpen("assets/empty.txt", MD_FILE_MODE_READ_MAPPED);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	EXPECT_EQ(pFile->size, 0u);
+	EXPECT_EQ(pFile->content, nullptr);
+	mdFileClose(pFile);
+
+	mdPackUnmount("assets");
+}
+
+TEST_F(PackTest, PathsOutsideMountPointAreNotResolved)
+{
+	ASSERT_TRUE(mdPackMount(s_packPath, "assets/"));
+
+	EXPECT_NE(mdPackFindEntry("assets/shaders/a.vert"), nullptr);
+	EXPECT_EQ(mdPackFindEntry("shaders/a.vert"), nullptr);
+	EXPECT_EQ(mdPackFindEntry("assetsX/shaders/a.vert"), nullptr);
+	EXPECT_EQ(mdPackFindEntry("assets/shaders/missing.vert"), nullptr);
+
+	struct MdFileData* pFile = mdFileOpen("assets/shaders/missing.vert", MD_FILE_MODE_READ);
+	EXPECT_FALSE(mdFileIsOpen(pFile));
+	mdFileClose(pFile);
+
+	mdPackUnmount("assets");
+	EXPECT_EQ(mdPackFindEntry("assets/shaders/a.vert"), nullptr);
+}
+
+TEST_F(PackTest, EntriesAreAligned)
+{
+	ASSERT_TRUE(mdPackMount(s_packPath, ""));
+
+	const char* paths[] = {"shaders/a.vert", "shaders/b.frag", "compressible.bin", "random.bin", "empty.txt"};
+	for (const char* path : paths)
+	{
+		const struct MdPackEntry* pEntry = mdPackFindEntry(path);
+		ASSERT_NE(pEntry, nullptr) << path;
+		EXPECT_EQ(pEntry->offset % MD_PACK_DEFAULT_ALIGNMENT, 0u) << path;
+	}
+
+	mdPackUnmount("");
+}
+
+TEST_F(PackTest, CompressionIsKeptOnlyWhenSmaller)
+{
+	ASSERT_TRUE(mdPackMount(s_packPath, "assets"));
+
+	const struct MdPackEntry* pEntry = mdPackFindEntry("assets/compressible.bin");
+	ASSERT_NE(pEntry, nullptr);
+	EXPECT_TRUE(pEntry->flags & MD_PACK_ENTRY_FLAG_COMPRESSED);
+	EXPECT_LT(pEntry->storedSize, pEntry->size / 8);
+
+	pEntry = mdPackFindEntry("assets/random.bin");
+	ASSERT_NE(pEntry, nullptr);
+	EXPECT_FALSE(pEntry->flags & MD_PACK_ENTRY_FLAG_COMPRESSED);
+	EXPECT_EQ(pEntry->storedSize, sizeof(random));
+
+	struct MdFileData* pFile = mdFileOpen("assets/compressible.bin", MD_FILE_MODE_READ_MAPPED);
+	ASSERT_EQ(pFile->size, sizeof(compressible));
+	EXPECT_EQ(memcmp(pFile->content, compressible, sizeof(compressible)), 0);
+	mdFileClose(pFile);
+
+	pFile = mdFileOpen("assets/random.bin", MD_FILE_MODE_READ);
+	ASSERT_EQ(pFile->size, sizeof(random));
+	EXPECT_EQ(memcmp(pFile->content, random, sizeof(random)), 0);
+	mdFileClose(pFile);
+
+	mdPackUnmount("assets");
+}
+
+TEST_F(PackTest, LastMountedPackOverrides)
+{
+	struct MdPackWriter* pWriter = mdPackWriterCreate(s_patchPackPath, 16);
+	mdPackWriterAddData(pWriter, "shaders/a.vert", "patched", 7, MD_FALSE);
+	mdPackWriterFinish(pWriter);
+
+	ASSERT_TRUE(mdPackMount(s_packPath, "assets"));
+	ASSERT_TRUE(mdPackMount(s_patchPackPath, "assets"));
+
+	struct MdFileData* pFile = mdFileOpen("assets/shaders/a.vert", MD_FILE_MODE_READ);
+	EXPECT_STREQ(pFile->content, "patched");
+	mdFileClose(pFile);
+
+	// The base pack still serves the entries the patch does not have.
+	pFile = mdFileOpen("assets/shaders/b.frag", MD_FILE_MODE_READ);
+	EXPECT_STREQ(pFile->content, "out vec4 color;");
+	mdFileClose(pFile);
+
+	mdPackUnmount("assets");
+	pFile = mdFileOpen("assets/shaders/a.vert", MD_FILE_MODE_READ);
+	EXPECT_STREQ(pFile->content, "void main() {}");
+	mdFileClose(pFile);
+
+	mdPackUnmount("assets");
+}
+
+TEST_F(PackTest, CorruptedEntryIsNotOpen)
+{
+	ASSERT_TRUE(mdPackMount(s_packPath, "assets"));
+	u64 offset = mdPackFindEntry("assets/compressible.bin")->offset;
+	mdPackUnmount("assets");
+
+	// A match at the start of the stream references data before the output, which no valid entry has.
+	struct MdFileData* pFile = mdFileOpen(s_packPath, MD_FILE_MODE_READ);
+	ASSERT_TRUE(mdFileIsOpen(pFile));
+	pFile->content[offset]	   = 0x00;
+	pFile->content[offset + 1] = 0x01;
+	pFile->content[offset + 2] = 0x00;
+	struct MdFileData* pPatch  = mdFileOpen(s_patchPackPath, MD_FILE_MODE_WRITE);
+	mdFileWrite(pPatch, pFile->content, pFile->size);
+	mdFileClose(pPatch);
+	mdFileClose(pFile);
+
+	ASSERT_TRUE(mdPackMount(s_patchPackPath, "assets"));
+	pFile = mdFileOpen("assets/compressible.bin", MD_FILE_MODE_READ);
+	EXPECT_FALSE(mdFileIsOpen(pFile));
+	mdFileClose(pFile);
+
+	pFile = mdFileOpen("assets/shaders/a.vert", MD_FILE_MODE_READ);
+	EXPECT_STREQ(pFile->content, "void main() {}");
+	mdFileClose(pFile);
+
+	// The failed open is not counted, the pack can still be unmounted.
+	mdPackUnmount("assets");
+	EXPECT_EQ(mdPackFindEntry("assets/shaders/a.vert"), nullptr);
+}
+
+TEST_F(PackTest, FilesAreOpenedWhileOtherPacksAreMounted)
+{
+	struct MdPackWriter* pWriter = mdPackWriterCreate(s_patchPackPath, 16);
+	mdPackWriterAddData(pWriter, "other.txt", "other", 5, MD_FALSE);
+	mdPackWriterFinish(pWriter);
+
+	ASSERT_TRUE(mdPackMount(s_packPath, "assets"));
+
+	u32				 mismatchesCount = 0;
+	struct MdThread* threads[4];
+	for (u32 i = 0; i < 4; ++i)
+	{
+		threads[i] = mdThreadCreate(openPackedFiles, &mismatchesCount, "md-test");
+		ASSERT_NE(threads[i], nullptr);
+	}
+	for (u32 i = 0; i < 200; ++i)
+	{
+		ASSERT_TRUE(mdPackMount(s_patchPackPath, "assets"));
+		mdPackUnmount("assets");
+	}
+	for (u32 i = 0; i < 4; ++i)
+	{
+		mdThreadJoin(threads[i]);
+	}
+
+	EXPECT_EQ(mismatchesCount, 0u);
+	mdPackUnmount("assets");
+}
+
+TEST_F(PackTest, DiscardedWriterKeepsPreviousPack)
+{
+	struct MdPackWriter* pWriter = mdPackWriterCreate(s_packPath, 0);
+	mdPackWriterAddData(pWriter, "shaders/a.vert", "discarded", 9, MD_FALSE);
+	mdPackWriterDiscard(pWriter);
+
+	ASSERT_TRUE(mdPackMount(s_packPath, "assets"));
+	struct MdFileData* pFile = mdFileOpen("assets/shaders/a.vert", MD_FILE_MODE_READ);
+	EXPECT_STREQ(pFile->content, "void main() {}");
+	mdFileClose(pFile);
+	mdPackUnmount("assets");
+
+	pFile = mdFileOpen("meed_pack_test.pack.tmp", MD_FILE_MODE_READ);
+	EXPECT_FALSE(mdFileIsOpen(pFile));
+	mdFileClose(pFile);
+}
+
+TEST_F(PackTest, InvalidPackIsRejected)
+{
+	struct MdFileData* pFile = mdFileOpen(s_patchPackPath, MD_FILE_MODE_WRITE);
+	mdFileWrite(pFile, "not a pack, not a pack, not a pack, not a pack", 46);
+	mdFileClose(pFile);
+
+	EXPECT_FALSE(mdPackMount(s_patchPackPath, "assets"));
+	EXPECT_FALSE(mdPackMount("meed_pack_test_missing.pack", "assets"));
+}
@@ -0,0 +1,83 @@
+#include "common.hpp"
+
+namespace {
+u64 sumSquares(u32 count)
+{
+	volatile u64 sum = 0;
+	for (u32 i = 0; i < count; ++i)
+	{
+		sum = sum + (u64)i * i;
+	}
+	return sum;
+}
+} // anonymous namespace
+
+TEST(PerfCountersTest, ReadReportsOnlyAvailableCounters)
+{
+	struct MdPerfCounters* pCounters = mdPerfCountersCreate();
+	ASSERT_NE(pCounters, nullptr);
+
+	mdPerfCountersStart(pCounters);
+	sumSquares(100000);
+	mdPerfCountersStop(pCounters);
+
+	struct MdPerfCounterValues values;
+	mdPerfCountersRead(pCounters, &values);
+
+	// The counters are usually forbidden in containers, the unavailable ones must read as zero.
+	for (u32 i = 0; i < MD_PERF_COUNTER_COUNT; ++i)
+	{
+		b8 isAvailable = (values.availableMask & MD_PERF_COUNTER_BIT(i)) != 0;
+		EXPECT_EQ(isAvailable, mdPerfCountersIsAvailable(pCounters, (enum MdPerfCounter)i));
+		if (!isAvailable)
+		{
+			EXPECT_EQ(values.values[i], 0u);
+		}
+	}
+
+	if (mdPerfCountersIsAvailable(pCounters, MD_PERF_COUNTER_INSTRUCTIONS))
+	{
+		EXPECT_GT(values.values[MD_PERF_COUNTER_INSTRUCTIONS], 100000u);
+	}
+
+	mdPerfCountersDestroy(pCounters);
+}
+
+TEST(PerfCountersTest, CountersRestartFromZero)
+{
+	struct MdPerfCounters* pCounters = mdPerfCountersCreate();
+	if (!mdPerfCountersIsAvailable(pCounters, MD_PERF_COUNTER_INSTRUCTIONS))
+	{
+		mdPerfCountersDestroy(pCounters);
+		GTEST_SKIP() << "Instructions counter unavailable.";
+	}
+
+	struct MdPerfCounterValues large, small;
+	mdPerfCountersStart(pCounters);
+	sumSquares(1000000);
+	mdPerfCountersStop(pCounters);
+	mdPerfCountersRead(pCounters, &large);
+
+	mdPerfCountersStart(pCounters);
+	sumSquares(1000);
+	mdPerfCountersStop(pCounters);
+	mdPerfCountersRead(pCounters, &small);
+
+	EXPECT_LT(small.values[MD_PERF_COUNTER_INSTRUCTIONS], large.values[MD_PERF_COUNTER_INSTRUCTIONS]);
+	mdPerfCountersDestroy(pCounters);
+}
+
+TEST(PerfCountersTest, IPCNeedsCyclesAndInstructions)
+{
+	struct MdPerfCounterValues values = {};
+	EXPECT_EQ(mdPerfCountersGetIPC(&values), 0.0);
+
+	values.values[MD_PERF_COUNTER_CYCLES]		= 200;
+	values.values[MD_PERF_COUNTER_INSTRUCTIONS] = 300;
+	values.availableMask						= MD_PERF_COUNTER_BIT(MD_PERF_COUNTER_INSTRUCTIONS);
+	EXPECT_EQ(mdPerfCountersGetIPC(&values), 0.0);
+
+	values.availableMask |= MD_PERF_COUNTER_BIT(MD_PERF_COUNTER_CYCLES);
+	EXPECT_DOUBLE_EQ(mdPerfCountersGetIPC(&values), 1.5);
+	EXPECT_STREQ(mdPerfCounterGetName(MD_PERF_COUNTER_LLC_MISSES), "LLC misses");
+}
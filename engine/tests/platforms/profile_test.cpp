@@ -0,0 +1,162 @@
+#include "common.hpp"
+
+#include <string>
+#include <thread>
+
+namespace {
+const char* s_tracePath = "meed_profile_test.json";
+
+std::string readTrace()
+{
+	struct MdFileData* pFile = mdFileOpen(s_tracePath, MD_FILE_MODE_READ);
+	std::string		   trace = mdFileIsOpen(pFile) ? std::string(pFile->content, pFile->size) : std::string();
+	mdFileClose(pFile);
+	return trace;
+}
+
+u32 countOf(const std::string& trace, const std::string& pattern)
+{
+	u32 count = 0;
+	for (mdSize position = trace.find(pattern); position != std::string::npos;
+		 position		 = trace.find(pattern, position + 1))
+	{
+		count++;
+	}
+	return count;
+}
+
+#if MD_PROFILE_ENABLED
+void profiledFunction()
+{
+	MD_PROFILE_SCOPE("profiledFunction");
+	MD_PROFILE_SCOPE("second \"zone\"");
+}
+#endif
+} // anonymous namespace
+
+class ProfileTest : public Test
+{
+protected:
+	void TearDown() override
+	{
+		mdProfileShutdown();
+		mdFileRemove(s_tracePath);
+	}
+};
+
+TEST_F(ProfileTest, EventsAreOnlyRecordedDuringCapture)
+{
+	mdProfileBegin("ignored");
+	mdProfileEnd();
+
+	mdProfileCaptureStart(0);
+	EXPECT_FALSE(mdProfileIsCapturing());
+	mdProfileBegin("ignored");
+	mdProfileEnd();
+
+	mdProfileFrameMark();
+	EXPECT_TRUE(mdProfileIsCapturing());
+	mdProfileBegin("recorded");
+	mdProfileEnd();
+	mdProfileCaptureStop();
+
+	ASSERT_TRUE(mdProfileExportChromeTrace(s_tracePath));
+	std::string trace = readTrace();
+	EXPECT_EQ(countOf(trace, "\"ignored\""), 0u);
+	EXPECT_EQ(countOf(trace, "{\"name\":\"recorded\",\"ph\":\"B\""), 1u);
+	EXPECT_EQ(countOf(trace, "{\"name\":\"recorded\",\"ph\":\"E\""), 1u);
+}
+
+TEST_F(ProfileTest, CaptureCoversRequestedFrames)
+{
+	mdProfileCaptureStart(2);
+	mdProfileFrameMark();
+	mdProfileFrameMark();
+	EXPECT_TRUE(mdProfileIsCapturing());
+	mdProfileFrameMark();
+	EXPECT_FALSE(mdProfileIsCapturing());
+
+	ASSERT_TRUE(mdProfileExportChromeTrace(s_tracePath));
+	EXPECT_EQ(countOf(readTrace(), "\"ph\":\"i\""), 2u);
+}
+
+// The macros compile to nothing without the profiler, the functions below them stay available.
+#if MD_PROFILE_ENABLED
+TEST_F(ProfileTest, ScopesEndWithTheirBlock)
+{
+	mdProfileCaptureStart(0);
+	mdProfileFrameMark();
+	profiledFunction();
+	mdProfileCaptureStop();
+
+	ASSERT_TRUE(mdProfileExportChromeTrace(s_tracePath));
+	std::string trace = readTrace();
+
+	// The second zone closes first, its name is escaped.
+	mdSize outerBegin = trace.find("{\"name\":\"profiledFunction\",\"ph\":\"B\"");
+	mdSize innerBegin = trace.find("{\"name\":\"second \\\"zone\\\"\",\"ph\":\"B\"");
+	mdSize innerEnd	  = trace.find("{\"name\":\"second \\\"zone\\\"\",\"ph\":\"E\"");
+	mdSize outerEnd	  = trace.find("{\"name\":\"profiledFunction\",\"ph\":\"E\"");
+	ASSERT_NE(outerBegin, std::string::npos);
+	ASSERT_NE(innerEnd, std::string::npos);
+	EXPECT_LT(outerBegin, innerBegin);
+	EXPECT_LT(innerBegin, innerEnd);
+	EXPECT_LT(innerEnd, outerEnd);
+	EXPECT_NE(outerEnd, std::string::npos);
+}
+#endif
+
+TEST_F(ProfileTest, UnbalancedZonesAreRepaired)
+{
+	// The zone opened before the capture has no begin event, the zone still open at the stop gets an end event.
+	mdProfileCaptureStart(0);
+	mdProfileFrameMark();
+	mdProfileEnd();
+	mdProfileBegin("unfinished");
+	mdProfileCaptureStop();
+
+	ASSERT_TRUE(mdProfileExportChromeTrace(s_tracePath));
+	std::string trace = readTrace();
+	EXPECT_EQ(countOf(trace, "\"ph\":\"B\""), 1u);
+	EXPECT_EQ(countOf(trace, "\"ph\":\"E\""), 1u);
+	EXPECT_EQ(countOf(trace, "{\"name\":\"unfinished\",\"ph\":\"E\""), 1u);
+}
+
+TEST_F(ProfileTest, ThreadsHaveTheirOwnTrack)
+{
+	mdProfileCaptureStart(0);
+	mdProfileFrameMark();
+	mdProfileBegin("main");
+	std::thread worker([]() {
+		mdProfileBegin("worker");
+		mdProfileEnd();
+	});
+	worker.join();
+	mdProfileEnd();
+	mdProfileCaptureStop();
+
+	ASSERT_TRUE(mdProfileExportChromeTrace(s_tracePath));
+	std::string trace = readTrace();
+	EXPECT_EQ(countOf(trace, "\"tid\":1"), 3u);
+	EXPECT_EQ(countOf(trace, "\"tid\":2"), 2u);
+	EXPECT_EQ(countOf(trace, "\"droppedEvents\":0"), 1u);
+}
+
+TEST_F(ProfileTest, NewCaptureDiscardsPreviousEvents)
+{
+	mdProfileCaptureStart(0);
+	mdProfileFrameMark();
+	mdProfileBegin("first");
+	mdProfileEnd();
+
+	mdProfileCaptureStart(0);
+	mdProfileFrameMark();
+	mdProfileBegin("second");
+	mdProfileEnd();
+	mdProfileCaptureStop();
+
+	ASSERT_TRUE(mdProfileExportChromeTrace(s_tracePath));
+	std::string trace = readTrace();
+	EXPECT_EQ(countOf(trace, "\"first\""), 0u);
+	EXPECT_EQ(countOf(trace, "\"second\""), 2u);
+}
@@ -0,0 +1,274 @@
+#include "common.hpp"
+
+#if PLATFORM_IS_LINUX
+#include <sched.h>
+#endif
+
+#define THREADS_COUNT		   4u
+#define INCREMENTS_PER_THREAD 10000u
+
+struct SharedCounter
+{
+	struct MdMutex	  mutex;
+	struct MdSpinlock spinlock;
+	u32				  counter;
+	u32				  atomicCounter;
+};
+
+static void incrementWithMutex(void* pArgument)
+{
+	SharedCounter* pShared = (SharedCounter*)pArgument;
+	for (u32 i = 0; i < INCREMENTS_PER_THREAD; ++i)
+	{
+		mdMutexLock(&pShared->mutex);
+		++pShared->counter;
+		mdMutexUnlock(&pShared->mutex);
+	}
+}
+
+static void incrementWithSpinlock(void* pArgument)
+{
+	SharedCounter* pShared = (SharedCounter*)pArgument;
+	for (u32 i = 0; i < INCREMENTS_PER_THREAD; ++i)
+	{
+		mdSpinlockLock(&pShared->spinlock);
+		++pShared->counter;
+		mdSpinlockUnlock(&pShared->spinlock);
+	}
+}
+
+static void incrementAtomically(void* pArgument)
+{
+	SharedCounter* pShared = (SharedCounter*)pArgument;
+	for (u32 i = 0; i < INCREMENTS_PER_THREAD; ++i)
+	{
+		MD_ATOMIC_FETCH_ADD(&pShared->atomicCounter, 1u, MD_MEMORY_ORDER_RELAXED);
+	}
+}
+
+static void runThreads(MdThreadFunction function, void* pArgument)
+{
+	struct MdThread* threads[THREADS_COUNT];
+	for (u32 i = 0; i < THREADS_COUNT; ++i)
+	{
+		threads[i] = mdThreadCreate(function, pArgument, "md-test");
+		ASSERT_NE(threads[i], nullptr);
+	}
+	for (u32 i = 0; i < THREADS_COUNT; ++i)
+	{
+		mdThreadJoin(threads[i]);
+	}
+}
+
+static void storeThreadId(void* pArgument)
+{
+	*(mdPid*)pArgument = mdThreadGetCurrentId();
+}
+
+TEST(ThreadTest, CreateRunsTheFunctionOnAnotherThread)
+{
+	mdPid threadId = 0;
+	mdThreadJoin(mdThreadCreate(storeThreadId, &threadId, "md-test"));
+
+	EXPECT_NE(threadId, 0);
+	EXPECT_NE(threadId, mdThreadGetCurrentId());
+	EXPECT_EQ(mdThreadGetCurrentId(), mdThreadGetCurrentId());
+	EXPECT_GE(mdThreadGetHardwareConcurrency(), 1u);
+}
+
+TEST(ThreadTest, LocksSerializeTheIncrements)
+{
+	SharedCounter shared = {};
+	mdMutexInitialize(&shared.mutex);
+	runThreads(incrementWithMutex, &shared);
+	EXPECT_EQ(shared.counter, THREADS_COUNT * INCREMENTS_PER_THREAD);
+	mdMutexDestroy(&shared.mutex);
+
+	shared.counter = 0;
+	runThreads(incrementWithSpinlock, &shared);
+	EXPECT_EQ(shared.counter, THREADS_COUNT * INCREMENTS_PER_THREAD);
+	EXPECT_TRUE(mdSpinlockTryLock(&shared.spinlock));
+	EXPECT_FALSE(mdSpinlockTryLock(&shared.spinlock));
+	mdSpinlockUnlock(&shared.spinlock);
+}
+
+TEST(ThreadTest, AtomicOperations)
+{
+	SharedCounter shared = {};
+	runThreads(incrementAtomically, &shared);
+	EXPECT_EQ(MD_ATOMIC_LOAD(&shared.atomicCounter, MD_MEMORY_ORDER_ACQUIRE), THREADS_COUNT * INCREMENTS_PER_THREAD);
+
+	u32 value	 = 5;
+	u32 expected = 4;
+	EXPECT_FALSE(
+		MD_ATOMIC_COMPARE_EXCHANGE(&value, &expected, 7u, MD_MEMORY_ORDER_ACQ_REL, MD_MEMORY_ORDER_ACQUIRE));
+	EXPECT_EQ(expected, 5u);
+	EXPECT_TRUE(MD_ATOMIC_COMPARE_EXCHANGE(&value, &expected, 7u, MD_MEMORY_ORDER_ACQ_REL, MD_MEMORY_ORDER_ACQUIRE));
+	EXPECT_EQ(value, 7u);
+	EXPECT_EQ(MD_ATOMIC_EXCHANGE(&value, 1u, MD_MEMORY_ORDER_SEQ_CST), 7u);
+	EXPECT_EQ(MD_ATOMIC_FETCH_OR(&value, 6u, MD_MEMORY_ORDER_SEQ_CST), 1u);
+	EXPECT_EQ(MD_ATOMIC_FETCH_AND(&value, 3u, MD_MEMORY_ORDER_SEQ_CST), 7u);
+	EXPECT_EQ(value, 3u);
+}
+
+struct ProducerConsumer
+{
+	struct MdMutex				mutex;
+	struct MdConditionVariable	condition;
+	struct MdSemaphore			semaphore;
+	b8							isReady;
+};
+
+static void produce(void* pArgument)
+{
+	ProducerConsumer* pShared = (ProducerConsumer*)pArgument;
+	mdSemaphorePost(&pShared->semaphore, 3);
+
+	mdMutexLock(&pShared->mutex);
+	pShared->isReady = MD_TRUE;
+	mdConditionVariableSignal(&pShared->condition);
+	mdMutexUnlock(&pShared->mutex);
+}
+
+TEST(ThreadTest, SemaphoreAndConditionVariable)
+{
+	ProducerConsumer shared = {};
+	mdMutexInitialize(&shared.mutex);
+	mdConditionVariableInitialize(&shared.condition);
+	mdSemaphoreInitialize(&shared.semaphore, 0);
+
+	EXPECT_FALSE(mdSemaphoreTryWait(&shared.semaphore));
+	struct MdThread* pProducer = mdThreadCreate(produce, &shared, "md-producer");
+	for (u32 i = 0; i < 3; ++i)
+	{
+		mdSemaphoreWait(&shared.semaphore);
+	}
+	EXPECT_FALSE(mdSemaphoreTryWait(&shared.semaphore));
+
+	mdMutexLock(&shared.mutex);
+	while (!shared.isReady)
+	{
+		mdConditionVariableWait(&shared.condition, &shared.mutex);
+	}
+	mdMutexUnlock(&shared.mutex);
+	mdThreadJoin(pProducer);
+
+	// Nobody signals anymore: the wait times out, not before its timeout.
+	mdTicks start = mdGetTicks();
+	mdMutexLock(&shared.mutex);
+	EXPECT_FALSE(mdConditionVariableWaitFor(&shared.condition, &shared.mutex, 2 * MD_TICKS_PER_MILLISECOND));
+	mdMutexUnlock(&shared.mutex);
+	EXPECT_GE(mdGetTicks() - start, 2 * MD_TICKS_PER_MILLISECOND);
+
+	mdSemaphoreDestroy(&shared.semaphore);
+	mdConditionVariableDestroy(&shared.condition);
+	mdMutexDestroy(&shared.mutex);
+}
+
+static mdThreadLocalKey s_threadLocalKey;
+static MD_THREAD_LOCAL u32 s_threadLocalValue = 0;
+
+static void setThreadLocals(void* pArgument)
+{
+	EXPECT_EQ(mdThreadLocalGet(s_threadLocalKey), nullptr);
+	EXPECT_EQ(s_threadLocalValue, 0u);
+	mdThreadLocalSet(s_threadLocalKey, pArgument);
+	s_threadLocalValue = 2;
+	EXPECT_EQ(mdThreadLocalGet(s_threadLocalKey), pArgument);
+}
+
+TEST(ThreadTest, ThreadLocalStorageIsPerThread)
+{
+	ASSERT_TRUE(mdThreadLocalCreate(&s_threadLocalKey, nullptr));
+	u32 mainValue	= 0;
+	u32 threadValue = 0;
+	mdThreadLocalSet(s_threadLocalKey, &mainValue);
+	s_threadLocalValue = 1;
+
+	mdThreadJoin(mdThreadCreate(setThreadLocals, &threadValue, nullptr));
+
+	EXPECT_EQ(mdThreadLocalGet(s_threadLocalKey), &mainValue);
+	EXPECT_EQ(s_threadLocalValue, 1u);
+	mdThreadLocalDestroy(s_threadLocalKey);
+}
+
+TEST(ThreadTest, TopologyGroupsTheLogicalCores)
+{
+	struct MdCpuTopology* pTopology = new MdCpuTopology();
+	mdThreadGetCpuTopology(pTopology);
+
+	u32 concurrency = mdThreadGetHardwareConcurrency();
+	EXPECT_EQ(pTopology->logicalCoresCount, concurrency < MD_CPU_TOPOLOGY_MAX_LOGICAL_CORES
+												? concurrency
+												: MD_CPU_TOPOLOGY_MAX_LOGICAL_CORES);
+	EXPECT_GE(pTopology->physicalCoresCount, 1u);
+	EXPECT_LE(pTopology->physicalCoresCount, pTopology->logicalCoresCount);
+	EXPECT_LE(pTopology->l2GroupsCount, pTopology->physicalCoresCount);
+	EXPECT_LE(pTopology->l3GroupsCount, pTopology->l2GroupsCount);
+	EXPECT_LE(pTopology->packagesCount, pTopology->l3GroupsCount);
+
+	// The groups are numbered in order, each one contiguous.
+	for (u32 i = 1; i < pTopology->logicalCoresCount; ++i)
+	{
+		const struct MdLogicalCore& previous = pTopology->logicalCores[i - 1];
+		const struct MdLogicalCore& core	 = pTopology->logicalCores[i];
+		EXPECT_NE(core.cpuId, previous.cpuId);
+		EXPECT_LE(core.packageIndex - previous.packageIndex, 1u);
+		EXPECT_LE(core.l3GroupIndex - previous.l3GroupIndex, 1u);
+		EXPECT_LE(core.l2GroupIndex - previous.l2GroupIndex, 1u);
+		EXPECT_LE(core.physicalCoreIndex - previous.physicalCoreIndex, 1u);
+		EXPECT_EQ(core.siblingIndex,
+				  core.physicalCoreIndex == previous.physicalCoreIndex ? previous.siblingIndex + 1 : 0u);
+	}
+	EXPECT_EQ(pTopology->logicalCores[pTopology->logicalCoresCount - 1].physicalCoreIndex + 1,
+			  pTopology->physicalCoresCount);
+
+	delete pTopology;
+}
+
+struct Pinning
+{
+	u32 cpuId;
+	b8	isPinned;
+	u32 concurrency;
+	u32 childCoresCount; ///< The cores the thread started by the pinned one can run on.
+};
+
+static void countCurrentCores(void* pArgument)
+{
+#if PLATFORM_IS_LINUX
+	cpu_set_t mask;
+	CPU_ZERO(&mask);
+	sched_getaffinity(0, sizeof(mask), &mask);
+	*(u32*)pArgument = (u32)CPU_COUNT(&mask);
+#else
+	*(u32*)pArgument = mdThreadGetHardwareConcurrency();
+#endif
+}
+
+static void pinCurrentThread(void* pArgument)
+{
+	Pinning* pPinning	  = (Pinning*)pArgument;
+	pPinning->isPinned	  = mdThreadSetCurrentAffinity(pPinning->cpuId);
+	pPinning->concurrency = mdThreadGetHardwareConcurrency();
+	mdThreadJoin(mdThreadCreate(countCurrentCores, &pPinning->childCoresCount, nullptr));
+}
+
+TEST(ThreadTest, PinnedThreadsRunOnOneCore)
+{
+	struct MdCpuTopology* pTopology = new MdCpuTopology();
+	mdThreadGetCpuTopology(pTopology);
+
+	// On another thread: the affinity of the test thread stays untouched.
+	// The pinned thread still sees the cores of the process, and does not pass its pinning to the threads it starts.
+	Pinning pinning = {pTopology->logicalCores[pTopology->logicalCoresCount - 1].cpuId, MD_FALSE, 0, 0};
+	mdThreadJoin(mdThreadCreate(pinCurrentThread, &pinning, nullptr));
+	EXPECT_TRUE(pinning.isPinned);
+	EXPECT_EQ(pinning.concurrency, mdThreadGetHardwareConcurrency());
+	EXPECT_EQ(pinning.childCoresCount, mdThreadGetHardwareConcurrency());
+
+	EXPECT_FALSE(mdThreadSetCurrentAffinity(100000));
+	EXPECT_GE(mdThreadGetHardwareConcurrency(), pTopology->logicalCoresCount);
+
+	delete pTopology;
+}
@@ -0,0 +1,74 @@
+#include "common.hpp"
+
+TEST(TimeTest, TicksAreMonotonic)
+{
+	mdTicks previous = mdGetTicks();
+	for (u32 i = 0; i < 1000; ++i)
+	{
+		mdTicks current = mdGetTicks();
+		EXPECT_GE(current, previous);
+		previous = current;
+	}
+}
+
+TEST(TimeTest, ConversionsRoundTrip)
+{
+	EXPECT_DOUBLE_EQ(mdTicksToSeconds(MD_TICKS_PER_SECOND), 1.0);
+	EXPECT_DOUBLE_EQ(mdTicksToMilliseconds(16 * MD_TICKS_PER_MILLISECOND), 16.0);
+	EXPECT_EQ(mdSecondsToTicks(0.5), MD_TICKS_PER_SECOND / 2);
+	EXPECT_EQ(mdSecondsToTicks(mdTicksToSeconds(123456789)), 123456789u);
+}
+
+TEST(TimeTest, FrameTimerFirstTickStartsMeasuring)
+{
+	struct MdFrameTimer* pTimer = mdFrameTimerCreate(0);
+	EXPECT_EQ(mdFrameTimerTick(pTimer), 0.0);
+	EXPECT_EQ(pTimer->framesCount, 0u);
+
+	EXPECT_GE(mdFrameTimerTick(pTimer), 0.0);
+	EXPECT_EQ(pTimer->framesCount, 1u);
+	mdFrameTimerDestroy(pTimer);
+}
+
+TEST(TimeTest, FrameTimerStatsOverWindow)
+{
+	struct MdFrameTimer* pTimer = mdFrameTimerCreate(100);
+
+	// 1 ms to 100 ms, shuffled so the order does not matter.
+	for (u32 i = 0; i < 100; ++i)
+	{
+		mdFrameTimerAddSample(pTimer, ((i * 37u) % 100u + 1u) * MD_TICKS_PER_MILLISECOND);
+	}
+
+	struct MdFrameTimerStats stats;
+	mdFrameTimerGetStats(pTimer, &stats);
+	EXPECT_EQ(stats.samplesCount, 100u);
+	EXPECT_DOUBLE_EQ(stats.averageMilliseconds, 50.5);
+	EXPECT_DOUBLE_EQ(stats.minMilliseconds, 1.0);
+	EXPECT_DOUBLE_EQ(stats.maxMilliseconds, 100.0);
+	EXPECT_DOUBLE_EQ(stats.p95Milliseconds, 95.0);
+	EXPECT_DOUBLE_EQ(stats.p99Milliseconds, 99.0);
+
+	mdFrameTimerDestroy(pTimer);
+}
+
+TEST(TimeTest, FrameTimerWindowForgetsOldFrames)
+{
+	struct MdFrameTimer* pTimer = mdFrameTimerCreate(4);
+
+	mdFrameTimerAddSample(pTimer, 100 * MD_TICKS_PER_MILLISECOND); // A loading hitch.
+	for (u32 i = 0; i < 4; ++i)
+	{
+		mdFrameTimerAddSample(pTimer, 10 * MD_TICKS_PER_MILLISECOND);
+	}
+
+	struct MdFrameTimerStats stats;
+	mdFrameTimerGetStats(pTimer, &stats);
+	EXPECT_EQ(stats.samplesCount, 4u);
+	EXPECT_DOUBLE_EQ(stats.averageMilliseconds, 10.0);
+	EXPECT_DOUBLE_EQ(stats.maxMilliseconds, 10.0);
+	EXPECT_DOUBLE_EQ(stats.deltaMilliseconds, 10.0);
+	EXPECT_EQ(pTimer->framesCount, 5u);
+
+	mdFrameTimerDestroy(pTimer);
+}
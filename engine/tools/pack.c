@@ -0,0 +1,68 @@
+#include "MEEDEngine/MEEDEngine.h"
+#include <string.h>
+
+/**
+ * Builds a pack from the command line, used by the build to pack the assets.
+ *
+ * Usage: MEEDPack <output> [--compress] <entry path>=<source path>...
+ *
+ * `--compress` compresses the entries given after it, the entry paths are the paths relative to the mount point.
+ */
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		mdPrint("Usage: MEEDPack <output> [--compress] <entry path>=<source path>...\n");
+		return 1;
+	}
+
+	mdMemoryInitialize();
+
+	struct MdPackWriter* pWriter = mdPackWriterCreate(argv[1], MD_PACK_DEFAULT_ALIGNMENT);
+	if (pWriter == MD_NULL)
+	{
+		mdFormatPrint("Failed to create the pack \"%s\".\n", argv[1]);
+		mdMemoryShutdown();
+		return 1;
+	}
+
+	b8	compress	= MD_FALSE;
+	u32 failedCount = 0;
+	for (i32 i = 2; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--compress") == 0)
+		{
+			compress = MD_TRUE;
+			continue;
+		}
+
+		char* separator = strchr(argv[i], '=');
+		if (separator == MD_NULL)
+		{
+			mdFormatPrint("Ignoring \"%s\", expected <entry path>=<source path>.\n", argv[i]);
+			failedCount++;
+			continue;
+		}
+
+		*separator = '\0';
+		if (!mdPackWriterAddFile(pWriter, argv[i], separator + 1, compress))
+		{
+			mdFormatPrint("Failed to read \"%s\".\n", separator + 1);
+			failedCount++;
+		}
+	}
+
+	// A pack missing some of its entries would replace the previous one, the build keeps the previous pack instead.
+	if (failedCount > 0)
+	{
+		mdPackWriterDiscard(pWriter);
+		mdMemoryShutdown();
+		return 1;
+	}
+
+	mdPackWriterFinish(pWriter);
+	mdMemoryShutdown();
+
+	return 0;
+}